@@ -21,7 +21,7 @@ class Configure(config.base.Configure):
     help.addArgument('PETSc', '-with-info=<bool>',             nargs.ArgBool(None, 1, 'Activate PetscInfo() (i.e. -info)  code in PETSc'))
     help.addArgument('PETSc', '-with-ctable=<bool>',           nargs.ArgBool(None, 1, 'Activate CTABLE hashing for certain search functions - to conserve memory'))
     help.addArgument('PETSc', '-with-fortran-kernels=<bool>',  nargs.ArgBool(None, 0, 'Use Fortran for linear algebra kernels'))
-    help.addArgument('PETSc', '-with-avx512-kernels=<bool>',   nargs.ArgBool(None, 0, 'Use AVX-512 intrinsics for linear algebra kernels when available'))
+    help.addArgument('PETSc', '-with-avx512-kernels=<bool>',   nargs.ArgBool(None, 0, 'Use AVX-512 (or AVX2 when only that is available) intrinsics for linear algebra kernels'))
     help.addArgument('PETSc', '-with-is-color-value-type=<char,short>',nargs.ArgString(None, 'short', 'char, short can store 256, 65536 colors'))
     return
 
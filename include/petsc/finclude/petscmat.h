@@ -57,6 +57,7 @@
 #define MATCOLORINGLF      'lf'
 #define MATCOLORINGID      'id'
 #define MATCOLORINGGREEDY  'greedy'
+#define MATCOLORINGGM      'gm'
 #define MATCOLORINGJP      'jp'
 
 #define MATORDERINGNATURAL   'natural'
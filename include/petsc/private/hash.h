@@ -1261,5 +1261,123 @@ PETSC_STATIC_INLINE PetscErrorCode PetscHashIJKLDestroy(PetscHashIJKL *h)
   PetscFunctionReturn(0);
 }
 
+/* HASHIJV */
+KHASH_INIT(HASHIJV,PetscHashIJKey,PetscScalar,1,IJKeyHash,IJKeyEqual)
+
+/* Map from (row,column) pairs to matrix values, used to assemble matrices without preallocation */
+struct _PetscHashIJV {
+  khash_t(HASHIJV) *ht;
+};
+
+typedef struct _PetscHashIJV *PetscHashIJV;
+
+typedef khiter_t              PetscHashIJVIter;
+
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVCreate(PetscHashIJV *h)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(h, 1);
+  ierr = PetscNew((h));CHKERRQ(ierr);
+  (*h)->ht = kh_init(HASHIJV);
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVResize(PetscHashIJV h, PetscInt n)
+{
+  PetscFunctionBegin;
+  (kh_resize(HASHIJV, (h)->ht, (n)));
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVKeySize(PetscHashIJV h, PetscInt *n)
+{
+  PetscFunctionBegin;
+  ((*n) = kh_size((h)->ht));
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscHashIJVSetValue - Insert or add a value for a key in the hash table
+
+  Input Parameters:
++ h - The hash table
+. key - The key, a (row,column) pair
+. value - The value
+- mode - INSERT_VALUES replaces the value already stored for the key, ADD_VALUES adds to it
+
+  Level: developer
+
+.seealso: PetscHashIJVCreate(), PetscHashIJVGetPairs()
+*/
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVSetValue(PetscHashIJV h, PetscHashIJKey key, PetscScalar value, InsertMode mode)
+{
+  PetscHashIJVIter iter;
+  khint_t          missing;
+
+  PetscFunctionBeginHot;
+  iter = kh_put(HASHIJV, (h)->ht, (key), &missing);
+  if (missing || mode == INSERT_VALUES) kh_val((h)->ht, iter)  = value;
+  else                                  kh_val((h)->ht, iter) += value;
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscHashIJVGetPairs - Get all the keys and values in the hash table, in no particular order
+
+  Input Parameter:
+. h - The hash table
+
+  Output Parameters:
++ iarr - The rows of the keys
+. jarr - The columns of the keys
+- varr - The values
+
+  Note: the arrays must hold as many entries as returned by PetscHashIJVKeySize()
+
+  Level: developer
+
+.seealso: PetscHashIJVCreate(), PetscHashIJVSetValue()
+*/
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVGetPairs(PetscHashIJV h, PetscInt iarr[], PetscInt jarr[], PetscScalar varr[])
+{
+  PetscHashIJVIter iter;
+  PetscInt         n = 0;
+
+  PetscFunctionBegin;
+  for (iter = kh_begin((h)->ht); iter != kh_end((h)->ht); ++iter) {
+    if (!kh_exist((h)->ht, iter)) continue;
+    iarr[n] = kh_key((h)->ht, iter).i;
+    jarr[n] = kh_key((h)->ht, iter).j;
+    varr[n] = kh_val((h)->ht, iter);
+    n++;
+  }
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVClear(PetscHashIJV h)
+{
+  PetscFunctionBegin;
+  kh_clear(HASHIJV, (h)->ht);
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode PetscHashIJVDestroy(PetscHashIJV *h)
+{
+  PetscFunctionBegin;
+  PetscValidPointer(h, 1);
+  if ((*h)) {
+    PetscErrorCode ierr;
+
+    if ((*h)->ht) {
+      kh_destroy(HASHIJV, (*h)->ht);
+      (*h)->ht = NULL;
+    }
+    ierr = PetscFree((*h));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #endif /* _KHASH_H */
 
@@ -183,6 +183,10 @@ PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP,PetscBool,KSPNormType*,PCS
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP,PetscInt,const PetscReal*,const PetscReal*);
 
+/* the s-step methods KSPCGSSTEP and KSPGMRESSSTEP */
+PETSC_INTERN PetscErrorCode KSPSStepBasisCoefficients_Private(KSPSStepBasisType,PetscInt,PetscReal,PetscReal,PetscReal[],PetscReal[],PetscReal[]);
+PETSC_INTERN PetscErrorCode KSPSStepEstimateSpectrum_Private(PetscInt,const PetscScalar[],PetscInt,PetscReal*,PetscReal*);
+
 typedef struct _p_DMKSP *DMKSP;
 typedef struct _DMKSPOps *DMKSPOps;
 struct _DMKSPOps {
@@ -270,6 +270,27 @@ typedef struct {
   char        pending;
 } MatStashFrame;
 
+/*
+   Communication schedule recorded from an assembly with MAT_FROZEN_OFF_PROC_ENTRIES. Later assemblies set the same
+   off-process entries in the same order, so only their values are sent and no indices are sorted or searched.
+*/
+typedef struct {
+  PetscBool   ready;            /* the schedule is complete and later assemblies send only values */
+  PetscBool   active;           /* a value-only assembly is in progress */
+  InsertMode  insertmode;       /* of the recorded assembly */
+  PetscMPIInt tag;
+  PetscInt    nstash;           /* number of stashed (block) entries */
+  PetscInt    *stashrows,*stashcols; /* [nstash] indices of the stashed entries in the order they were set */
+  PetscInt    *slots;           /* [nstash] block of the send buffer each stashed entry is combined into */
+  PetscMPIInt nsendranks,nrecvranks;
+  PetscMPIInt *sendranks,*recvranks;
+  PetscInt    *sendstarts,*recvstarts; /* [nsendranks+1], [nrecvranks+1] first block sent to, or received from, each rank */
+  PetscInt    *recvrows,*recvcols;     /* indices of the received blocks, ordered by recvranks[] */
+  PetscScalar *svalues,*rvalues;
+  MPI_Request *sendreqs,*recvreqs;
+  PetscMPIInt nrecvdone;        /* number of receives already handed out */
+} MatStashFrozen;
+
 typedef struct _MatStash MatStash;
 struct _MatStash {
   PetscInt      nmax;                   /* maximum stash size */
@@ -328,6 +349,7 @@ struct _MatStash {
   MPI_Datatype   blocktype;
   size_t         blocktype_size;
   InsertMode     *insertmode;   /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+  MatStashFrozen *frozen;       /* MAT_FROZEN_OFF_PROC_ENTRIES schedule, recorded on the first assembly after the option is set */
 };
 
 PETSC_INTERN PetscErrorCode MatStashCreate_Private(MPI_Comm,PetscInt,MatStash*);
@@ -341,6 +363,8 @@ PETSC_INTERN PetscErrorCode MatStashValuesRowBlocked_Private(MatStash*,PetscInt,
 PETSC_INTERN PetscErrorCode MatStashValuesColBlocked_Private(MatStash*,PetscInt,PetscInt,const PetscInt[],const PetscScalar[],PetscInt,PetscInt,PetscInt);
 PETSC_INTERN PetscErrorCode MatStashScatterBegin_Private(Mat,MatStash*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatStashScatterGetMesg_Private(MatStash*,PetscMPIInt*,PetscInt**,PetscInt**,PetscScalar**,PetscInt*);
+PETSC_INTERN PetscErrorCode MatStashFrozenGetPattern_Private(MatStash*,PetscBool*,PetscInt*,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode MatStashFrozenGetValues_Private(MatStash*,const PetscScalar**);
 PETSC_INTERN PetscErrorCode MatGetInfo_External(Mat,MatInfoType,MatInfo*);
 
 typedef struct {
@@ -392,6 +416,7 @@ struct _p_Mat {
   PetscBool              symmetric_eternal;
   PetscBool              nooffprocentries,nooffproczerorows;
   PetscBool              subsetoffprocentries;
+  PetscBool              frozenoffprocentries;
   PetscBool              submat_singleis; /* for efficient PCSetUP_ASM() */
   PetscBool              structure_only;
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_VECCUDA)
@@ -534,6 +559,10 @@ struct  _p_MatFDColoring{
   PetscBool      fset;             /* indicates that the initial function value F(X) is set */
   PetscErrorCode (*f)(void);       /* function that defines Jacobian */
   void           *fctx;            /* optional user-defined context for use by the function f */
+  PetscErrorCode (*fbatch)(void*,PetscInt,Vec[],Vec[],void*); /* optional function that evaluates several perturbed vectors at once */
+  void           *fbatchctx;       /* optional user-defined context for use by the function fbatch */
+  PetscInt       nbatch;           /* number of vectors in wbatch and ybatch */
+  Vec            *wbatch,*ybatch;  /* perturbed vectors and function values passed to fbatch */
   Vec            vscale;           /* holds FD scaling, i.e. 1/dx for each perturbed column */
   PetscInt       currentcolor;     /* color for which function evaluation is being done now */
   const char     *htype;           /* "wp" or "ds" */
@@ -16,6 +16,8 @@ struct _PCGAMGOps {
   PetscErrorCode (*view)(PC,PetscViewer);
 };
 #define PETSC_GAMG_MAXLEVELS 30
+/* phases of the setup of a level, timed for -pc_gamg_setup_report and logged per level with -pc_gamg_log_levels */
+typedef enum {PCGAMG_PHASE_GRAPH,PCGAMG_PHASE_COARSEN,PCGAMG_PHASE_PROL,PCGAMG_PHASE_OPTPROL,PCGAMG_PHASE_PTAP,PCGAMG_PHASE_REPART,PCGAMG_NUM_PHASES} PCGAMGPhase;
 /* Private context for the GAMG preconditioner */
 typedef struct gamg_TAG {
   PCGAMGType type;
@@ -40,6 +42,22 @@ typedef struct gamg_TAG {
   PetscReal *data;          /* [data_sz] blocked vector of vertex data on fine grid (coordinates/nullspace) */
   PetscReal *orig_data;          /* cache data */
 
+  /* setup cost; the phases that coarsen level k (0 is the finest) are accounted to level k */
+  PetscBool      log_levels;                                             /* log each phase of each level as a separate event */
+  PetscInt       level_rows[PETSC_GAMG_MAXLEVELS];                       /* global number of rows of the operator of each level */
+  PetscLogDouble level_nnz[PETSC_GAMG_MAXLEVELS];                        /* global number of nonzeros of the operator of each level */
+  PetscLogDouble level_mem[PETSC_GAMG_MAXLEVELS];                        /* global memory of the operator of each level */
+  PetscMPIInt    level_nactive[PETSC_GAMG_MAXLEVELS];                    /* number of processes with rows of each level */
+  PetscLogDouble phase_time[PETSC_GAMG_MAXLEVELS][PCGAMG_NUM_PHASES];    /* time of each phase on this process */
+  PetscLogDouble phase_alloc[PETSC_GAMG_MAXLEVELS][PCGAMG_NUM_PHASES];   /* memory allocated and kept by each phase on this process */
+  PetscLogDouble phase_t0,phase_alloc0;                                  /* start of the current phase */
+  PetscLogEvent  phase_event;                                            /* event of the current phase with log_levels */
+
+  /* value refresh of a reused hierarchy, see PCGAMGSetRefreshDrift() */
+  PetscReal refresh_drift;                 /* smooth the prolongators again when the operator has changed more than this, negative for never */
+  Mat       Aref;                          /* fine grid operator when the prolongators were last smoothed */
+  Mat       Ptent[PETSC_GAMG_MAXLEVELS];   /* tentative prolongators, with the columns of the interpolation */
+
   struct _PCGAMGOps *ops;
   char *gamg_type_name;
 
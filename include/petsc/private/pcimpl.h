@@ -58,4 +58,6 @@ struct _p_PC {
 PETSC_EXTERN PetscLogEvent PC_SetUp, PC_SetUpOnBlocks, PC_Apply, PC_ApplyCoarse, PC_ApplyMultiple, PC_ApplySymmetricLeft;
 PETSC_EXTERN PetscLogEvent PC_ApplySymmetricRight, PC_ModifySubMatrices, PC_ApplyOnBlocks, PC_ApplyTransposeOnBlocks;
 
+PETSC_INTERN PetscErrorCode PCCreateBlockDiagonal_Private(PetscInt,Mat[],MatReuse,Mat*);
+
 #endif
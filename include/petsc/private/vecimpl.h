@@ -96,6 +96,9 @@ struct _VecOps {
   PetscErrorCode (*restorelocalvector)(Vec,Vec);
   PetscErrorCode (*getlocalvectorread)(Vec,Vec);
   PetscErrorCode (*restorelocalvectorread)(Vec,Vec);
+  PetscErrorCode (*axpydotnorm2_local)(Vec,PetscScalar,Vec,Vec,PetscScalar*,PetscReal*);   /* y = y + alpha x, local (y,z) and y'*y */
+  PetscErrorCode (*axpbypczdotnorm2_local)(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*); /* z = alpha x + beta y + gamma z, local (z,u) and z'*z */
+  PetscErrorCode (*waxpydotnorm2_local)(Vec,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*); /* w = alpha x + y, local (w,z) and w'*w */
 };
 
 /*
@@ -265,6 +268,11 @@ typedef struct {
   PetscMPIInt            *wcounts,*wdispls;
   MPI_Datatype           *types;
 #endif
+  /* for sending from and receiving into the vector arrays directly with MPI datatypes, -vecscatter_nopack */
+  PetscBool              use_datatypes;
+  MPI_Datatype           *dtypes;       /* [n] entries of the vector array exchanged with each process */
+  PetscBool              dtypes_recv;   /* the indices do not repeat so dtypes may also be received into */
+  PetscMPIInt            tag;           /* tag of the messages sent by this side */
   PetscBool              use_window;    /* these uses windows for communication across all MPI processes */
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
   MPI_Win                window;
@@ -285,6 +293,8 @@ typedef struct {
 
 PETSC_INTERN PetscErrorCode VecScatterGetTypes_Private(VecScatter,VecScatterFormat*,VecScatterFormat*);
 PETSC_INTERN PetscErrorCode VecScatterIsSequential_Private(VecScatter_Common*,PetscBool*);
+PETSC_INTERN PetscErrorCode VecScatterCreateTypes_PtoP_Private(VecScatter_MPI_General*);
+PETSC_INTERN PetscErrorCode VecScatterDestroyTypes_PtoP_Private(VecScatter_MPI_General*);
 
 typedef struct _VecScatterOps *VecScatterOps;
 struct _VecScatterOps {
@@ -37,6 +37,7 @@ typedef const char* KSPType;
 #define KSPPIPECG     "pipecg"
 #define KSPPIPECGRR   "pipecgrr"
 #define KSPPIPELCG     "pipelcg"
+#define KSPCGSSTEP    "cgsstep"
 #define   KSPCGNE       "cgne"
 #define   KSPCGNASH     "nash"
 #define   KSPCGSTCG     "stcg"
@@ -45,6 +46,7 @@ typedef const char* KSPType;
 #define KSPPIPEFCG    "pipefcg"
 #define KSPGMRES      "gmres"
 #define KSPPIPEFGMRES "pipefgmres"
+#define KSPGMRESSSTEP "gmressstep"
 #define   KSPFGMRES     "fgmres"
 #define   KSPLGMRES     "lgmres"
 #define   KSPDGMRES     "dgmres"
@@ -196,6 +198,31 @@ PETSC_EXTERN PetscErrorCode KSPPIPEGCRGetTruncationType(KSP,KSPFCDTruncationType
 PETSC_EXTERN PetscErrorCode KSPPIPEGCRSetUnrollW(KSP,PetscBool);
 PETSC_EXTERN PetscErrorCode KSPPIPEGCRGetUnrollW(KSP,PetscBool*);
 
+/*E
+
+  KSPSStepBasisType - The polynomial basis of the Krylov vectors that the s-step methods compute together
+
+  KSP_SSTEP_BASIS_MONOMIAL uses the powers of the operator, which become numerically dependent for s beyond about 5
+  KSP_SSTEP_BASIS_NEWTON uses products of the operator shifted by Chebyshev points of the estimated spectrum in Leja order
+  KSP_SSTEP_BASIS_CHEBYSHEV uses the Chebyshev polynomials of the estimated spectrum
+
+   Level: intermediate
+.seealso : KSPCGSSTEP,KSPGMRESSSTEP,KSPCGSStepSetBasisType(),KSPGMRESSStepSetBasisType()
+
+E*/
+typedef enum {KSP_SSTEP_BASIS_MONOMIAL,KSP_SSTEP_BASIS_NEWTON,KSP_SSTEP_BASIS_CHEBYSHEV} KSPSStepBasisType;
+PETSC_EXTERN const char *const KSPSStepBasisTypes[];
+
+PETSC_EXTERN PetscErrorCode KSPCGSStepSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPCGSStepGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPCGSStepSetBasisType(KSP,KSPSStepBasisType);
+PETSC_EXTERN PetscErrorCode KSPCGSStepSetEigenvalues(KSP,PetscReal,PetscReal);
+
+PETSC_EXTERN PetscErrorCode KSPGMRESSStepSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGMRESSStepGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPGMRESSStepSetBasisType(KSP,KSPSStepBasisType);
+PETSC_EXTERN PetscErrorCode KSPGMRESSStepSetEigenvalues(KSP,PetscReal,PetscReal);
+
 PETSC_EXTERN PetscErrorCode KSPGMRESSetRestart(KSP, PetscInt);
 PETSC_EXTERN PetscErrorCode KSPGMRESGetRestart(KSP, PetscInt*);
 PETSC_EXTERN PetscErrorCode KSPGMRESSetHapTol(KSP,PetscReal);
@@ -228,7 +255,7 @@ PETSC_EXTERN PetscErrorCode KSPFETIDPSetPressureOperator(KSP,Mat);
           KSPGMRESSetCGSRefinementType(), KSPGMRESGetCGSRefinementType(), KSPGMRESModifiedGramSchmidtOrthogonalization()
 
 E*/
-typedef enum {KSP_GMRES_CGS_REFINE_NEVER, KSP_GMRES_CGS_REFINE_IFNEEDED, KSP_GMRES_CGS_REFINE_ALWAYS} KSPGMRESCGSRefinementType;
+typedef enum {KSP_GMRES_CGS_REFINE_NEVER, KSP_GMRES_CGS_REFINE_IFNEEDED, KSP_GMRES_CGS_REFINE_ALWAYS, KSP_GMRES_CGS_REFINE_LAGGED} KSPGMRESCGSRefinementType;
 PETSC_EXTERN const char *const KSPGMRESCGSRefinementTypes[];
 /*MC
     KSP_GMRES_CGS_REFINE_NEVER - Do the classical (unmodified) Gram-Schmidt process
@@ -272,6 +299,22 @@ M*/
           KSPGMRESModifiedGramSchmidtOrthogonalization()
 M*/
 
+/*MC
+    KSP_GMRES_CGS_REFINE_LAGGED - Do two steps of the classical (unmodified) Gram-Schmidt process, where the
+          second step and the normalization of each Krylov vector are delayed to the next iteration (DCGS2)
+
+   Level: advanced
+
+   Notes: KSPGMRES then needs one global reduction per iteration, which computes the inner products of both steps and
+     the norm together, and streams the Krylov basis from memory once per iteration. Because the normalization is
+     delayed the residual norm of an iteration is known only after the next application of the operator.
+
+     Methods derived from KSPGMRES, such as KSPFGMRES and KSPLGMRES, treat this as KSP_GMRES_CGS_REFINE_ALWAYS.
+
+.seealso: KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESSetOrthogonalization(), KSPGMRESGetOrthogonalization(),
+          KSPGMRESSetCGSRefinementType(), KSPGMRESGetCGSRefinementType(), KSP_GMRES_CGS_REFINE_ALWAYS, KSP_GMRES_CGS_REFINE_NEVER
+M*/
+
 PETSC_EXTERN PetscErrorCode KSPGMRESSetCGSRefinementType(KSP,KSPGMRESCGSRefinementType);
 PETSC_EXTERN PetscErrorCode KSPGMRESGetCGSRefinementType(KSP,KSPGMRESCGSRefinementType*);
 
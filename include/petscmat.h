@@ -367,7 +367,8 @@ typedef enum {MAT_OPTION_MIN = -3,
               MAT_SUBSET_OFF_PROC_ENTRIES = 20,
               MAT_SUBMAT_SINGLEIS = 21,
               MAT_STRUCTURE_ONLY = 22,
-              MAT_OPTION_MAX = 23} MatOption;
+              MAT_FROZEN_OFF_PROC_ENTRIES = 23,
+              MAT_OPTION_MAX = 24} MatOption;
 
 PETSC_EXTERN const char *const *MatOptions;
 PETSC_EXTERN PetscErrorCode MatSetOption(Mat,MatOption,PetscBool);
@@ -1208,6 +1209,7 @@ typedef const  char*           MatColoringType;
 #define MATCOLORINGLF      "lf"
 #define MATCOLORINGID      "id"
 #define MATCOLORINGGREEDY  "greedy"
+#define MATCOLORINGGM      "gm"
 
 /*E
    MatColoringWeightType - Type of weight scheme
@@ -1259,6 +1261,7 @@ PETSC_EXTERN PetscErrorCode MatFDColoringDestroy(MatFDColoring*);
 PETSC_EXTERN PetscErrorCode MatFDColoringView(MatFDColoring,PetscViewer);
 PETSC_EXTERN PetscErrorCode MatFDColoringSetFunction(MatFDColoring,PetscErrorCode (*)(void),void*);
 PETSC_EXTERN PetscErrorCode MatFDColoringGetFunction(MatFDColoring,PetscErrorCode (**)(void),void**);
+PETSC_EXTERN PetscErrorCode MatFDColoringSetFunctionBatch(MatFDColoring,PetscErrorCode (*)(void*,PetscInt,Vec[],Vec[],void*),void*);
 PETSC_EXTERN PetscErrorCode MatFDColoringSetParameters(MatFDColoring,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode MatFDColoringSetFromOptions(MatFDColoring);
 PETSC_EXTERN PetscErrorCode MatFDColoringApply(Mat,MatFDColoring,Vec,void *);
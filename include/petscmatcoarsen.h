@@ -28,6 +28,7 @@ J*/
 typedef const char* MatCoarsenType;
 #define MATCOARSENMIS  "mis"
 #define MATCOARSENHEM  "hem"
+#define MATCOARSENMISK "misk"
 
 /* linked list for aggregates */
 typedef struct _PetscCDIntNd{
@@ -64,6 +65,8 @@ PETSC_EXTERN PetscErrorCode MatCoarsenRegister(const char[],PetscErrorCode (*)(M
 PETSC_EXTERN PetscErrorCode MatCoarsenView(MatCoarsen,PetscViewer);
 PETSC_EXTERN PetscErrorCode MatCoarsenSetFromOptions(MatCoarsen);
 PETSC_EXTERN PetscErrorCode MatCoarsenGetType(MatCoarsen,MatCoarsenType*);
+PETSC_EXTERN PetscErrorCode MatCoarsenMISKSetDistance(MatCoarsen,PetscInt);
+PETSC_EXTERN PetscErrorCode MatCoarsenMISKGetDistance(MatCoarsen,PetscInt*);
 PETSC_STATIC_INLINE PetscErrorCode MatCoarsenViewFromOptions(MatCoarsen A,PetscObject obj,const char name[]) {return PetscObjectViewFromOptions((PetscObject)A,obj,name);}
 
 PETSC_EXTERN PetscErrorCode PetscCDCreate(PetscInt,PetscCoarsenData**);
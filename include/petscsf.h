@@ -16,7 +16,9 @@ PETSC_EXTERN PetscClassId PETSCSF_CLASSID;
    Level: beginner
 
    Notes: The two approaches provided are
-$     PETSCSFBASIC which uses MPI 1 message passing to perform the communication and
+$     PETSCSFBASIC which uses MPI 1 message passing to perform the communication,
+$     PETSCSFPERSISTENT which is PETSCSFBASIC with persistent requests (or MPI-3 neighborhood collectives) created once
+$                   for the fixed communication graph, reducing the latency of repeated communication, and
 $     PETSCSFWINDOW which uses MPI 2 one-sided operations to perform the communication, this may be more efficient,
 $                   but may not be available for all MPI distributions. In particular OpenMPI has bugs in its one-sided
 $                   operations that prevent its use.
@@ -24,14 +26,16 @@ $                   operations that prevent its use.
 .seealso: PetscSFSetType(), PetscSF
 J*/
 typedef const char *PetscSFType;
-#define PETSCSFBASIC  "basic"
-#define PETSCSFWINDOW "window"
+#define PETSCSFBASIC      "basic"
+#define PETSCSFWINDOW     "window"
+#define PETSCSFPERSISTENT "persistent"
 
 /*E
     PetscSFWindowSyncType - Type of synchronization for PETSCSFWINDOW
 
 $  PETSCSF_WINDOW_SYNC_FENCE - simplest model, synchronizing across communicator
-$  PETSCSF_WINDOW_SYNC_LOCK - passive model, less synchronous, requires less setup than PETSCSF_WINDOW_SYNC_ACTIVE, but may require more handshakes
+$  PETSCSF_WINDOW_SYNC_LOCK - passive model, less synchronous, requires less setup than PETSCSF_WINDOW_SYNC_ACTIVE, but may require more handshakes;
+$                             with MPI-3 a single MPI_Win_lock_all() epoch covers all ranks accessed by an operation
 $  PETSCSF_WINDOW_SYNC_ACTIVE - active model, provides most information to MPI implementation, needs to construct 2-way process groups (more setup than PETSCSF_WINDOW_SYNC_LOCK)
 
    Level: advanced
@@ -41,6 +45,20 @@ E*/
 typedef enum {PETSCSF_WINDOW_SYNC_FENCE,PETSCSF_WINDOW_SYNC_LOCK,PETSCSF_WINDOW_SYNC_ACTIVE} PetscSFWindowSyncType;
 PETSC_EXTERN const char *const PetscSFWindowSyncTypes[];
 
+/*E
+    PetscSFWindowFlavorType - Flavor of the MPI windows used by PETSCSFWINDOW
+
+$  PETSCSF_WINDOW_FLAVOR_CREATE - a window is created with MPI_Win_create() on the root array for each communication and freed afterwards
+$  PETSCSF_WINDOW_FLAVOR_DYNAMIC - windows are created once with MPI_Win_create_dynamic() and kept; the root array is attached
+$                                  for each communication and its address is sent only to the ranks that reference it (requires MPI-3)
+
+   Level: advanced
+
+.seealso: PetscSFWindowSetFlavorType(), PetscSFWindowGetFlavorType()
+E*/
+typedef enum {PETSCSF_WINDOW_FLAVOR_CREATE,PETSCSF_WINDOW_FLAVOR_DYNAMIC} PetscSFWindowFlavorType;
+PETSC_EXTERN const char *const PetscSFWindowFlavorTypes[];
+
 /*E
     PetscSFDuplicateOption - Aspects to preserve when duplicating a PetscSF
 
@@ -71,6 +89,10 @@ PETSC_EXTERN PetscErrorCode PetscSFSetFromOptions(PetscSF);
 PETSC_EXTERN PetscErrorCode PetscSFDuplicate(PetscSF,PetscSFDuplicateOption,PetscSF*);
 PETSC_EXTERN PetscErrorCode PetscSFWindowSetSyncType(PetscSF,PetscSFWindowSyncType);
 PETSC_EXTERN PetscErrorCode PetscSFWindowGetSyncType(PetscSF,PetscSFWindowSyncType*);
+PETSC_EXTERN PetscErrorCode PetscSFWindowSetFlavorType(PetscSF,PetscSFWindowFlavorType);
+PETSC_EXTERN PetscErrorCode PetscSFWindowGetFlavorType(PetscSF,PetscSFWindowFlavorType*);
+PETSC_EXTERN PetscErrorCode PetscSFPersistentSetNeighbor(PetscSF,PetscBool);
+PETSC_EXTERN PetscErrorCode PetscSFPersistentGetNeighbor(PetscSF,PetscBool*);
 PETSC_EXTERN PetscErrorCode PetscSFSetRankOrder(PetscSF,PetscBool);
 PETSC_EXTERN PetscErrorCode PetscSFSetGraph(PetscSF,PetscInt,PetscInt,const PetscInt*,PetscCopyMode,const PetscSFNode*,PetscCopyMode);
 PETSC_EXTERN PetscErrorCode PetscSFGetGraph(PetscSF,PetscInt*,PetscInt*,const PetscInt**,const PetscSFNode**);
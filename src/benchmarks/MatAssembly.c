@@ -0,0 +1,79 @@
+static char help[] = "Times the assembly of an AIJ matrix from the bilinear elements of src/ksp/ksp/examples/tutorials/ex3.c\n\
+with exact preallocation, with -mat_use_hash_table and, optionally, without any preallocation.\n\
+  -m <m>       : number of elements in each direction\n\
+  -noprealloc  : also time the assembly without preallocation; its cost grows quadratically with m\n\n";
+
+#include <petscmat.h>
+#include <petsctime.h>
+
+typedef enum {ASSEMBLY_PREALLOCATED,ASSEMBLY_HASH,ASSEMBLY_NOPREALLOC} AssemblyType;
+
+static PetscErrorCode AssembleMatrix(PetscInt m,AssemblyType type,PetscLogDouble *time)
+{
+  Mat            A;
+  PetscInt       i,j,N = (m+1)*(m+1),start,end,idx[4];
+  PetscScalar    Ke[16];
+  PetscMPIInt    rank,size;
+  PetscLogDouble t1,t2;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  for (i=0; i<4; i++) {
+    for (j=0; j<4; j++) Ke[4*i+j] = (i == j) ? 2.0/3.0 : -1.0/6.0;
+  }
+  start = rank*(m*m/size) + ((m*m%size) < rank ? (m*m%size) : rank);
+  end   = start + m*m/size + ((m*m%size) > rank);
+
+  ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  if (type == ASSEMBLY_PREALLOCATED) {
+    ierr = MatSeqAIJSetPreallocation(A,9,NULL);CHKERRQ(ierr);
+    ierr = MatMPIAIJSetPreallocation(A,9,NULL,8,NULL);CHKERRQ(ierr);
+  } else {
+    if (type == ASSEMBLY_HASH) {ierr = MatSetOption(A,MAT_USE_HASH_TABLE,PETSC_TRUE);CHKERRQ(ierr);}
+    ierr = MatSetUp(A);CHKERRQ(ierr);
+  }
+  for (i=start; i<end; i++) {
+    idx[0] = (m+1)*(i/m) + (i % m);
+    idx[1] = idx[0]+1; idx[2] = idx[1] + m + 1; idx[3] = idx[2] - 1;
+    ierr   = MatSetValues(A,4,idx,4,idx,Ke,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  t2  -= t1;
+  ierr = MPIU_Allreduce(&t2,time,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscInt       m = 100;
+  PetscBool      noprealloc = PETSC_FALSE;
+  PetscLogDouble time;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-noprealloc",&noprealloc,NULL);CHKERRQ(ierr);
+
+  PetscPreLoadBegin(PETSC_TRUE,"MatAssembly");
+  ierr = AssembleMatrix(m,ASSEMBLY_PREALLOCATED,&time);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Preallocated     : %g seconds\n",time);CHKERRQ(ierr);
+  ierr = AssembleMatrix(m,ASSEMBLY_HASH,&time);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Hash table       : %g seconds\n",time);CHKERRQ(ierr);
+  if (noprealloc) {
+    ierr = AssembleMatrix(m,ASSEMBLY_NOPREALLOC,&time);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"No preallocation : %g seconds\n",time);CHKERRQ(ierr);
+  }
+  PetscPreLoadEnd();
+
+  ierr = PetscFinalize();
+  return ierr;
+}
@@ -0,0 +1,146 @@
+static char help[] = "Times the SeqAIJ MatMatMult() algorithms on the products of an algebraic multigrid setup, A*P and P^T*(A*P),\n\
+where A is the Laplacian on a structured grid and P the prolongator smoothed from aggregates of 2^dim points.\n\
+  -m <m>              : number of grid points in each direction\n\
+  -dim <dim>          : 2 or 3\n\
+  -its <its>          : number of numeric products timed after each symbolic product\n\
+  -mat_aij_threads <n> : threads of the hash and dense algorithms (requires PETSc configured with --with-openmp)\n\n";
+
+#include <petscmat.h>
+#include <petsctime.h>
+
+static PetscErrorCode CreateLaplacian(PetscInt m,PetscInt dim,Mat *A)
+{
+  PetscInt       n = dim == 2 ? m*m : m*m*m,row,d,nc,cols[7],off[3];
+  PetscScalar    vals[7];
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreate(PETSC_COMM_SELF,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(*A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(*A,2*dim+1,NULL);CHKERRQ(ierr);
+  off[0] = 1; off[1] = m; off[2] = m*m;
+  for (row=0; row<n; row++) {
+    PetscInt ijk[3];
+
+    ijk[0] = row % m; ijk[1] = (row/m) % m; ijk[2] = row/(m*m);
+    nc = 0;
+    for (d=0; d<dim; d++) {
+      if (ijk[d] > 0)   {cols[nc] = row - off[d]; vals[nc++] = -1.0;}
+      if (ijk[d] < m-1) {cols[nc] = row + off[d]; vals[nc++] = -1.0;}
+    }
+    cols[nc] = row; vals[nc++] = 2.0*dim;
+    ierr = MatSetValues(*A,1,&row,nc,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* P = (I - 2/3 D^{-1} A) P0 where P0 is the piecewise constant interpolation from aggregates of 2^dim grid points */
+static PetscErrorCode CreateProlongator(Mat A,PetscInt m,PetscInt dim,Mat *P)
+{
+  PetscInt       n,mc = (m+1)/2,nc = dim == 2 ? mc*mc : mc*mc*mc,row,col;
+  PetscScalar    one = 1.0;
+  Mat            P0,S;
+  Vec            diag;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatGetSize(A,&n,NULL);CHKERRQ(ierr);
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,n,nc,1,NULL,&P0);CHKERRQ(ierr);
+  for (row=0; row<n; row++) {
+    col  = (row % m)/2 + mc*(((row/m) % m)/2) + mc*mc*((row/(m*m))/2);
+    ierr = MatSetValues(P0,1,&row,1,&col,&one,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(P0,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(P0,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatDuplicate(A,MAT_COPY_VALUES,&S);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&diag,NULL);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,diag);CHKERRQ(ierr);
+  ierr = VecReciprocal(diag);CHKERRQ(ierr);
+  ierr = MatDiagonalScale(S,diag,NULL);CHKERRQ(ierr);
+  ierr = MatScale(S,-2.0/3.0);CHKERRQ(ierr);
+  ierr = MatShift(S,1.0);CHKERRQ(ierr);
+  ierr = MatMatMult(S,P0,MAT_INITIAL_MATRIX,PETSC_DEFAULT,P);CHKERRQ(ierr);
+  ierr = VecDestroy(&diag);CHKERRQ(ierr);
+  ierr = MatDestroy(&S);CHKERRQ(ierr);
+  ierr = MatDestroy(&P0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* times C = X*Y with the given algorithm: the symbolic and first numeric product, then the mean of its numeric products */
+static PetscErrorCode TimeProduct(Mat X,Mat Y,const char *alg,PetscInt its,Mat *C,PetscLogDouble *tinit,PetscLogDouble *tnum)
+{
+  PetscInt       it;
+  PetscLogDouble t0,t1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr   = PetscOptionsSetValue(NULL,"-matmatmult_via",alg);CHKERRQ(ierr);
+  ierr   = PetscTime(&t0);CHKERRQ(ierr);
+  ierr   = MatMatMult(X,Y,MAT_INITIAL_MATRIX,PETSC_DEFAULT,C);CHKERRQ(ierr);
+  ierr   = PetscTime(&t1);CHKERRQ(ierr);
+  *tinit = t1 - t0;
+  ierr   = PetscTime(&t0);CHKERRQ(ierr);
+  for (it=0; it<its; it++) {
+    ierr = MatMatMult(X,Y,MAT_REUSE_MATRIX,PETSC_DEFAULT,C);CHKERRQ(ierr);
+  }
+  ierr  = PetscTime(&t1);CHKERRQ(ierr);
+  *tnum = its ? (t1 - t0)/its : 0.0;
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  const char     *algs[] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","hash","dense","auto"};
+  PetscInt       m = 64,dim = 3,its = 5,a;
+  Mat            A,P,R,AP,RAP,APref = NULL,RAPref = NULL;
+  PetscReal      err,nrm;
+  PetscLogDouble t[4];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+  if (dim != 2 && dim != 3) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Dimension %D must be 2 or 3",dim);
+
+  ierr = CreateLaplacian(m,dim,&A);CHKERRQ(ierr);
+  ierr = CreateProlongator(A,m,dim,&P);CHKERRQ(ierr);
+  ierr = MatTranspose(P,MAT_INITIAL_MATRIX,&R);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(R);CHKERRQ(ierr); /* picks up -mat_aij_threads */
+
+  ierr = PetscPrintf(PETSC_COMM_SELF,"%-14s %12s %12s %12s %12s   (seconds; init = symbolic + numeric)\n","algorithm","A*P init","A*P numeric","R*AP init","R*AP numeric");CHKERRQ(ierr);
+  for (a=0; a<(PetscInt)(sizeof(algs)/sizeof(algs[0])); a++) {
+    ierr = TimeProduct(A,P,algs[a],its,&AP,&t[0],&t[1]);CHKERRQ(ierr);
+    ierr = TimeProduct(R,AP,algs[a],its,&RAP,&t[2],&t[3]);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"%-14s %12.4e %12.4e %12.4e %12.4e\n",algs[a],t[0],t[1],t[2],t[3]);CHKERRQ(ierr);
+    if (!APref) {
+      APref = AP; RAPref = RAP;
+      continue;
+    }
+    /* all the algorithms must give the product of the first one */
+    ierr = MatAXPY(AP,-1.0,APref,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(AP,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+    ierr = MatNorm(APref,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+    if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"  A*P differs from %s: %g\n",algs[0],(double)err);CHKERRQ(ierr);}
+    ierr = MatAXPY(RAP,-1.0,RAPref,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(RAP,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+    ierr = MatNorm(RAPref,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+    if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"  R*A*P differs from %s: %g\n",algs[0],(double)err);CHKERRQ(ierr);}
+    ierr = MatDestroy(&AP);CHKERRQ(ierr);
+    ierr = MatDestroy(&RAP);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsClearValue(NULL,"-matmatmult_via");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&APref);CHKERRQ(ierr);
+  ierr = MatDestroy(&RAPref);CHKERRQ(ierr);
+  ierr = MatDestroy(&R);CHKERRQ(ierr);
+  ierr = MatDestroy(&P);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
@@ -0,0 +1,73 @@
+static char help[] = "Times MatSOR() sweeps on the Laplacian of src/ksp/ksp/examples/tutorials/ex2.c.\n\
+Run with libraries configured with and without --with-avx512-kernels to compare the scalar and vectorized sweeps.\n\
+  -m <m>, -n <n> : grid dimensions\n\
+  -bs <bs>       : number of coupled unknowns per grid point; bs > 1 gives inodes of size bs (use -mat_no_inode to compare)\n\
+  -its <its>     : number of sweeps timed\n\n";
+
+#include <petscmat.h>
+#include <petsctime.h>
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  Vec            x,b;
+  PetscInt       m = 300,n = 300,bs = 1,its = 50,row,col,Ii,Jj,i,j,k,l;
+  PetscScalar    v;
+  PetscLogDouble t1,t2;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_SELF,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,m*n*bs,m*n*bs,m*n*bs,m*n*bs);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,5*bs,NULL);CHKERRQ(ierr);
+  for (Ii=0; Ii<m*n; Ii++) {
+    i = Ii/n; j = Ii - i*n;
+    for (k=0; k<5; k++) {
+      if      (k == 0) {if (i == 0)   continue; Jj = Ii - n;}
+      else if (k == 1) {if (i == m-1) continue; Jj = Ii + n;}
+      else if (k == 2) {if (j == 0)   continue; Jj = Ii - 1;}
+      else if (k == 3) {if (j == n-1) continue; Jj = Ii + 1;}
+      else Jj = Ii;
+      /* couple all bs unknowns of neighbouring points so that the rows of a point form an inode */
+      for (l=0; l<bs*bs; l++) {
+        row = Ii*bs + l/bs; col = Jj*bs + l%bs;
+        if (k == 4) v = (row == col) ? 4.0 + 0.1*bs : -0.1;
+        else        v = (l/bs == l%bs) ? -1.0 : -0.01;
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  PetscPreLoadBegin(PETSC_TRUE,"MatSOR");
+  ierr = VecSet(x,0.0);CHKERRQ(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,1.0,SOR_FORWARD_SWEEP,0.0,its,1,x);CHKERRQ(ierr);
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Forward sweep   : %g seconds per sweep\n",(t2-t1)/its);CHKERRQ(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,1.0,SOR_BACKWARD_SWEEP,0.0,its,1,x);CHKERRQ(ierr);
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Backward sweep  : %g seconds per sweep\n",(t2-t1)/its);CHKERRQ(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,1.0,SOR_SYMMETRIC_SWEEP,0.0,its,1,x);CHKERRQ(ierr);
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Symmetric sweep : %g seconds per sweep\n",(t2-t1)/its);CHKERRQ(ierr);
+  PetscPreLoadEnd();
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
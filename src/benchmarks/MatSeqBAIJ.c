@@ -0,0 +1,131 @@
+static char help[] = "Times the SeqBAIJ MatMult(), MatMultAdd(), MatMultTranspose(), MatSOR() and ILU(0) MatSolve() for each block size\n\
+against the generic kernels selected with -mat_no_unroll, on a block five point stencil.\n\
+  -m <m>, -n <n> : grid dimensions\n\
+  -bs_min <bs>, -bs_max <bs> : the block sizes bs_min to bs_max are timed\n\
+  -its <its>     : number of calls timed for each operation\n\n";
+
+#include <petscmat.h>
+#include <petsctime.h>
+
+/* block five point stencil with random off diagonal blocks and a dominant diagonal */
+static PetscErrorCode CreateMatrix(PetscInt m,PetscInt n,PetscInt bs,PetscBool nounroll,PetscRandom rctx,Mat *A)
+{
+  PetscErrorCode ierr;
+  PetscInt       Ii,Jj,i,j,k,l;
+  PetscScalar    *v;
+
+  PetscFunctionBeginUser;
+  if (nounroll) {ierr = PetscOptionsSetValue(NULL,"-mat_no_unroll",NULL);CHKERRQ(ierr);}
+  ierr = MatCreateSeqBAIJ(PETSC_COMM_SELF,bs,m*n*bs,m*n*bs,5,NULL,A);CHKERRQ(ierr);
+  if (nounroll) {ierr = PetscOptionsClearValue(NULL,"-mat_no_unroll");CHKERRQ(ierr);}
+  ierr = PetscMalloc1(bs*bs,&v);CHKERRQ(ierr);
+  for (Ii=0; Ii<m*n; Ii++) {
+    i = Ii/n; j = Ii - i*n;
+    for (k=0; k<5; k++) {
+      if      (k == 0) {if (i == 0)   continue; Jj = Ii - n;}
+      else if (k == 1) {if (i == m-1) continue; Jj = Ii + n;}
+      else if (k == 2) {if (j == 0)   continue; Jj = Ii - 1;}
+      else if (k == 3) {if (j == n-1) continue; Jj = Ii + 1;}
+      else Jj = Ii;
+      /* the random sequence is restarted for every matrix so that both matrices are the same */
+      for (l=0; l<bs*bs; l++) {ierr = PetscRandomGetValue(rctx,&v[l]);CHKERRQ(ierr);}
+      if (Jj == Ii) for (l=0; l<bs; l++) v[l*bs+l] += 5.0*bs;
+      ierr = MatSetValuesBlocked(*A,1,&Ii,1,&Jj,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* times one operation on the matrix with the block size specific kernels (A) and with the generic ones (Aref) */
+static PetscErrorCode TimeOperation(PetscInt op,Mat A,Mat Aref,Vec x,Vec y,Vec z,Vec zref,PetscInt its,PetscLogDouble t[])
+{
+  PetscErrorCode ierr;
+  PetscInt       it,k;
+  PetscLogDouble t0,t1;
+  PetscReal      err,nrm;
+  Mat            B;
+  const char     *name[] = {"MatMult","MatMultAdd","MatMultTranspose","MatSOR"};
+
+  PetscFunctionBeginUser;
+  for (k=0; k<2; k++) {
+    B    = k ? Aref : A;
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it=0; it<its; it++) {
+      switch (op) {
+      case 0: ierr = MatMult(B,x,k ? zref : z);CHKERRQ(ierr); break;
+      case 1: ierr = MatMultAdd(B,x,y,k ? zref : z);CHKERRQ(ierr); break;
+      case 2: ierr = MatMultTranspose(B,x,k ? zref : z);CHKERRQ(ierr); break;
+      case 3: ierr = MatSOR(B,y,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,2,1,k ? zref : z);CHKERRQ(ierr); break;
+      }
+    }
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    t[k] = (t1 - t0)/its;
+  }
+  ierr = VecNorm(zref,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,zref);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-10*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"  %s() differs from the generic kernel by %g\n",name[op],(double)(err/nrm));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,Aref,F;
+  Vec            x,y,z,zref;
+  IS             rperm,cperm;
+  MatFactorInfo  info;
+  PetscInt       m = 60,n = 60,bsmin = 1,bsmax = 16,its = 20,bs,op,it;
+  PetscLogDouble t[8],t0,t1;
+  PetscRandom    rctx;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs_min",&bsmin,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs_max",&bsmax,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rctx);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill = 1.0;
+
+  ierr = PetscPrintf(PETSC_COMM_SELF,"%3s %21s %21s %21s %21s %10s   (seconds per call, block size kernel / generic kernel)\n","bs","MatMult","MatMultAdd","MatMultTranspose","MatSOR","MatSolve");CHKERRQ(ierr);
+  for (bs=bsmin; bs<=bsmax; bs++) {
+    ierr = PetscRandomSetSeed(rctx,0x12345678);CHKERRQ(ierr);
+    ierr = PetscRandomSeed(rctx);CHKERRQ(ierr);
+    ierr = CreateMatrix(m,n,bs,PETSC_FALSE,rctx,&A);CHKERRQ(ierr);
+    ierr = PetscRandomSeed(rctx);CHKERRQ(ierr);
+    ierr = CreateMatrix(m,n,bs,PETSC_TRUE,rctx,&Aref);CHKERRQ(ierr);
+    ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+    ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+    ierr = VecDuplicate(y,&zref);CHKERRQ(ierr);
+    ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+    ierr = VecSetRandom(y,rctx);CHKERRQ(ierr);
+    for (op=0; op<4; op++) {ierr = TimeOperation(op,A,Aref,x,y,z,zref,its,t+2*op);CHKERRQ(ierr);}
+
+    ierr = MatGetOrdering(A,MATORDERINGNATURAL,&rperm,&cperm);CHKERRQ(ierr);
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(F,A,rperm,cperm,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it=0; it<its; it++) {ierr = MatSolve(F,y,z);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+
+    ierr = PetscPrintf(PETSC_COMM_SELF,"%3D %10.4e/%10.4e %10.4e/%10.4e %10.4e/%10.4e %10.4e/%10.4e %10.4e\n",bs,t[0],t[1],t[2],t[3],t[4],t[5],t[6],t[7],(t1 - t0)/its);CHKERRQ(ierr);
+    ierr = MatDestroy(&F);CHKERRQ(ierr);
+    ierr = ISDestroy(&rperm);CHKERRQ(ierr);
+    ierr = ISDestroy(&cperm);CHKERRQ(ierr);
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+    ierr = VecDestroy(&z);CHKERRQ(ierr);
+    ierr = VecDestroy(&zref);CHKERRQ(ierr);
+    ierr = MatDestroy(&A);CHKERRQ(ierr);
+    ierr = MatDestroy(&Aref);CHKERRQ(ierr);
+  }
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
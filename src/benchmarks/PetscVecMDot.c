@@ -0,0 +1,71 @@
+static char help[] = "Times VecMDot() and VecMAXPY() against nv calls of VecDot() and VecAXPY(), as in the orthogonalization of GMRES.\n\
+Run with libraries configured with and without --with-avx512-kernels to compare the scalar and vectorized kernels.\n\
+  -n <n>    : vector length\n\
+  -nv <nv>  : largest number of vectors, the vector counts 1, 2, 4, ... up to nv are timed\n\
+  -its <its> : number of calls timed for each count\n\n";
+
+#include <petscvec.h>
+#include <petsctime.h>
+
+int main(int argc,char **argv)
+{
+  Vec            x,*y;
+  PetscScalar    *z,*zref;
+  PetscInt       n = 100000,nv = 128,its = 20,k,m,it;
+  PetscReal      err;
+  PetscLogDouble t[4],t0,t1;
+  PetscRandom    rctx;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nv,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rctx);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_SELF,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,nv,&y);CHKERRQ(ierr);
+  for (k=0; k<nv; k++) {ierr = VecSetRandom(y[k],rctx);CHKERRQ(ierr);}
+  ierr = PetscMalloc2(nv,&z,nv,&zref);CHKERRQ(ierr);
+
+  ierr = PetscPrintf(PETSC_COMM_SELF,"%6s %12s %12s %12s %12s   (seconds per call)\n","nv","VecMDot","nv VecDot","VecMAXPY","nv VecAXPY");CHKERRQ(ierr);
+  for (m=PetscMin(1,nv); m>0; m=PetscMin(2*m,nv)) {
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it=0; it<its; it++) {ierr = VecMDot(x,m,y,z);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    t[0] = (t1 - t0)/its;
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it=0; it<its; it++) {
+      for (k=0; k<m; k++) {ierr = VecDot(x,y[k],&zref[k]);CHKERRQ(ierr);}
+    }
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    t[1] = (t1 - t0)/its;
+    for (err=0.0, k=0; k<m; k++) err = PetscMax(err,PetscAbsScalar(z[k] - zref[k])/PetscAbsScalar(zref[k]));
+    if (err > 1.e-10) {ierr = PetscPrintf(PETSC_COMM_SELF,"  VecMDot() differs from VecDot() by %g\n",(double)err);CHKERRQ(ierr);}
+
+    /* scale so that x stays bounded over the updates */
+    for (k=0; k<m; k++) z[k] = 1.0/(m*its);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it=0; it<its; it++) {ierr = VecMAXPY(x,m,z,y);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    t[2] = (t1 - t0)/its;
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it=0; it<its; it++) {
+      for (k=0; k<m; k++) {ierr = VecAXPY(x,-z[k],y[k]);CHKERRQ(ierr);}
+    }
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    t[3] = (t1 - t0)/its;
+    ierr = PetscPrintf(PETSC_COMM_SELF,"%6D %12.4e %12.4e %12.4e %12.4e\n",m,t[0],t[1],t[2],t[3]);CHKERRQ(ierr);
+    if (m == nv) break;
+  }
+
+  ierr = PetscFree2(z,zref);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nv,&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
@@ -1,5 +1,5 @@
 #!/usr/bin/env python
-import os
+import os, sys
 from benchmarkExample import PETScExample
 
 savedTiming = {'baconost': {'ElemAssembly': [(0.040919999999999998, 0.0), (0.1242, 0.0), (0.24410000000000001, 0.0), (0.374, 0.0), (0.56259999999999999, 0.0), (0.79049999999999998, 0.0), (1.0880000000000001, 0.0), (1.351, 0.0), (1.6930000000000001, 0.0), (2.0609999999999999, 0.0), (2.4820000000000002, 0.0), (3.0640000000000001, 0.0)],
@@ -83,6 +83,56 @@ def plotSummary(library, num, sizes, nonzeros, times, events):
     show()
   return
 
+def runHashComparison(args):
+  '''Time src/benchmarks/MatAssembly, which assembles the same AIJ matrix with exact preallocation, with -mat_use_hash_table
+     and without preallocation, and plot the time per nonzero against the number of rows'''
+  import re
+  from benchmarkExample import PETSc, PETScExample
+  petsc = PETSc()
+  bdir  = os.path.join(petsc.dir(), 'src', 'benchmarks')
+  exe   = os.path.join(bdir, 'MatAssembly')
+  if not os.path.isfile(exe):
+    out, err, ret = PETScExample.runShellCommand('make MatAssembly', cwd = bdir)
+    if ret: raise RuntimeError('Unable to build MatAssembly:\n'+err+out)
+  if args.small:
+    grid = [25, 50, 75, 100]
+  else:
+    grid = [100, 200, 400, 800, 1600]
+  # Without preallocation the time grows quadratically, so it is only run for small grids
+  maxNoPrealloc = 200
+  procs  = int(args.scaling) if args.scaling and args.scaling.isdigit() else 1
+  mpiexec = petsc.mpiexec() or 'mpiexec'
+  names  = ['Preallocated', 'Hash table', 'No preallocation']
+  events = dict([(name, []) for name in names])
+  sizes  = []
+  for m in grid:
+    cmd = mpiexec+' -n '+str(procs)+' '+exe+' -m '+str(m)
+    if m <= maxNoPrealloc: cmd += ' -noprealloc'
+    out, err, ret = PETScExample.runShellCommand(cmd)
+    if ret: raise RuntimeError('Unable to run MatAssembly:\n'+err+out)
+    times = {}
+    # The last line for each mode is the timed run, the first one is the preload
+    for line in out.split('\n'):
+      match = re.match(r'^(.*\S)\s*:\s*(\S+) seconds', line)
+      if match: times[match.group(1)] = float(match.group(2))
+    sizes.append((m+1)*(m+1))
+    for name in names:
+      events[name].append(times.get(name))
+  print('%10s %12s' % ('Rows', 'Nonzeros')+''.join([' %18s' % name for name in names]))
+  for i, n in enumerate(sizes):
+    print('%10d %12d' % (n, 9*n)+''.join([' %18s' % ('%g' % events[name][i] if events[name][i] is not None else '-') for name in names]))
+  if args.batch: return
+  from pylab import legend, loglog, show, title, xlabel, ylabel
+  for name, style in zip(names, ['b-', 'r-', 'g:']):
+    data = [(n, t/(9*n) * 10**9) for n, t in zip(sizes, events[name]) if t is not None]
+    loglog([d[0] for d in data], [d[1] for d in data], style, label = name)
+  title('MatSetValues() and MatAssemblyEnd() for AIJ on '+str(procs)+' processes')
+  xlabel('Number of rows')
+  ylabel('Time/Nonzero (ns)')
+  legend(loc = 'upper left', shadow = True)
+  show()
+  return
+
 if __name__ == '__main__':
   import argparse
 
@@ -96,9 +146,13 @@ if __name__ == '__main__':
   parser.add_argument('--scaling',                          help='Run parallel scaling test')
   parser.add_argument('--small',   action='store_true', default=False, help='Use small sizes')
   parser.add_argument('--batch',   action='store_true', default=False, help='Generate batch files for the runs instead')
+  parser.add_argument('--hash',    action='store_true', default=False, help='Compare AIJ assembly with preallocation, with -mat_use_hash_table and without preallocation; --scaling gives the number of processes')
 
   args = parser.parse_args()
   print(args)
+  if args.hash:
+    runHashComparison(args)
+    sys.exit(0)
   ex       = PETScExample(args.library, args.num, log_summary_python = None if args.batch else args.module+'.py', preload='off')
   sizes    = []
   nonzeros = []
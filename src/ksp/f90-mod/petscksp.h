@@ -98,10 +98,12 @@
       PetscEnum KSP_GMRES_CGS_REFINE_NEVER
       PetscEnum KSP_GMRES_CGS_REFINE_IFNEEDED
       PetscEnum KSP_GMRES_CGS_REFINE_ALWAYS
+      PetscEnum KSP_GMRES_CGS_REFINE_LAGGED
 !
       parameter (KSP_GMRES_CGS_REFINE_NEVER = 0)
       parameter (KSP_GMRES_CGS_REFINE_IFNEEDED = 1)
       parameter (KSP_GMRES_CGS_REFINE_ALWAYS = 2)
+      parameter (KSP_GMRES_CGS_REFINE_LAGGED = 3)
 !
 !  End of Fortran include file for the KSP package in PETSc
 !
@@ -258,10 +258,20 @@ int main(int argc,char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: lagged
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_lagged
+      output_file: output/ex2_2.out
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: 3_lagged
+      args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_lagged -ksp_gmres_restart 5
+
    test:
       suffix: 4
       args: -pc_type eisenstat -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -272,6 +282,24 @@ int main(int argc,char **args)
       args: -ksp_monitor_short -m 5 -n 5 -mat_view draw -ksp_gmres_cgs_refinement_type refine_always -nox
       output_file: output/ex2_2.out
 
+   test:
+      suffix: aij_threads
+      nsize: 2
+      requires: openmp
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always -mat_aij_threads 2
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: aij_threads_icc
+      requires: openmp
+      args: -ksp_monitor_short -m 15 -n 12 -ksp_type cg -pc_type icc -pc_factor_mat_ordering_type rcm -mat_aij_threads 2
+
+   test:
+      suffix: mult_overlap
+      nsize: 3
+      args: -pc_type bjacobi -pc_bjacobi_blocks 1 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres -mat_mult_overlap 3
+      output_file: output/ex2_bjacobi.out
+
    test:
       suffix: bjacobi
       nsize: 4
@@ -287,6 +315,21 @@ int main(int argc,char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   test:
+      suffix: bjacobi_batch
+      nsize: 2
+      args: -m 20 -n 20 -pc_type bjacobi -pc_bjacobi_blocks 8 -pc_bjacobi_batch -ksp_monitor_short
+
+   test:
+      suffix: asm_batch
+      nsize: 2
+      args: -m 20 -n 20 -pc_type asm -pc_asm_blocks 8 -pc_asm_overlap 1 -pc_asm_batch -ksp_monitor_short
+
+   test:
+      suffix: asm_pipeline
+      nsize: 2
+      args: -m 30 -n 30 -pc_type asm -pc_asm_blocks 8 -pc_asm_overlap 2 -pc_asm_type restrict -pc_asm_pipeline -ksp_monitor_short
+
    test:
       suffix: fbcgs
       args: -ksp_type fbcgs -pc_type ilu
@@ -300,6 +343,34 @@ int main(int argc,char **args)
       suffix: groppcg
       args: -ksp_monitor_short -ksp_type groppcg -m 9 -n 9
 
+   test:
+      suffix: cgsstep
+      args: -ksp_monitor_short -ksp_type cgsstep -m 9 -n 9
+      output_file: output/ex2_groppcg.out
+
+   test:
+      suffix: cgsstep_chebyshev
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cgsstep -ksp_cgsstep_s 3 -ksp_cgsstep_basis chebyshev -m 9 -n 9
+
+   test:
+      suffix: gmressstep
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_type gmressstep -ksp_gmressstep_s 3
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: gmressstep_chebyshev
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_type gmressstep -ksp_gmressstep_s 3 -ksp_gmressstep_basis chebyshev
+      output_file: output/ex2_2.out
+
+   test:
+      suffix: gmressstep_monomial
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_type gmressstep -ksp_gmressstep_s 3 -ksp_gmressstep_basis monomial
+      output_file: output/ex2_2.out
+
    test:
       suffix: mkl_pardiso_cholesky
       requires: mkl_pardiso
@@ -335,6 +406,11 @@ int main(int argc,char **args)
       suffix: sell
       args: -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always -m 9 -n 9 -mat_type sell
 
+   test:
+      suffix: sell_bicg
+      nsize: 3
+      args: -ksp_monitor_short -ksp_type bicg -m 20 -n 17 -mat_type sell
+
    test:
       requires: mumps
       suffix: sell_mumps
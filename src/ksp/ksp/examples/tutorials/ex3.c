@@ -208,4 +208,10 @@ PetscErrorCode FormElementRhs(PetscScalar x,PetscScalar y,PetscReal H,PetscScala
       nsize: 2
       args: -ksp_monitor_short
 
+   test:
+      suffix: hash
+      nsize: 2
+      args: -ksp_monitor_short -mat_use_hash_table
+      output_file: output/ex3_1.out
+
 TEST*/
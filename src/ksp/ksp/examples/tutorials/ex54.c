@@ -220,6 +220,22 @@ int main(int argc,char **args)
       args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type classical -mg_levels_ksp_chebyshev_esteig 0,0.05,0,1.05 -ksp_converged_reason -mg_levels_esteig_ksp_type cg
       output_file: output/ex54_classical.out
 
+   test:
+      suffix: report
+      nsize: 4
+      args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -ksp_converged_reason -mg_levels_esteig_ksp_type cg -pc_gamg_log_levels -pc_gamg_setup_report
+      filter: grep -v "PCGAMG setup" | cut -d, -f1-5
+
+   test:
+      suffix: misk
+      nsize: 4
+      args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -ksp_converged_reason -mg_levels_esteig_ksp_type cg -mat_coarsen_type misk -mat_coarsen_misk_threads 2
+
+   test:
+      suffix: mis2
+      nsize: 4
+      args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -ksp_converged_reason -mg_levels_esteig_ksp_type cg -pc_gamg_square_graph 10 -pc_gamg_square_graph_mis2
+
    test:
       suffix: geo
       nsize: 4
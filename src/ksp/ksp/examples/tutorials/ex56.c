@@ -992,6 +992,11 @@ PetscErrorCode elem_3d_elast_v_25(PetscScalar *dd)
       suffix: nns
       args: -ne 9 -alpha 1.e-3 -ksp_converged_reason -ksp_type cg -ksp_max_it 50 -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -pc_gamg_coarse_eq_limit 1000 -mg_levels_ksp_type chebyshev -mg_levels_pc_type sor -pc_gamg_reuse_interpolation true -two_solves -use_mat_nearnullspace -mg_levels_esteig_ksp_type cg
 
+   test:
+      suffix: nns_refresh
+      args: -ne 9 -alpha 1.e-3 -ksp_converged_reason -ksp_type cg -ksp_max_it 50 -pc_type gamg -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -pc_gamg_coarse_eq_limit 1000 -mg_levels_ksp_type chebyshev -mg_levels_pc_type sor -pc_gamg_reuse_interpolation true -pc_gamg_refresh_drift 0.1 -two_solves -use_mat_nearnullspace -mg_levels_esteig_ksp_type cg
+      output_file: output/ex56_nns.out
+
    test:
       suffix: nns_telescope
       nsize: 2
@@ -25,9 +25,9 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 {
   PetscErrorCode ierr;
   PetscInt       i;
-  PetscScalar    rho,rhoold,alpha,beta,omega,omegaold,d1;
+  PetscScalar    rho,rhonext,rhoold,alpha,beta,omega,omegaold,d1;
   Vec            X,B,V,P,R,RP,T,S;
-  PetscReal      dp    = 0.0,d2;
+  PetscReal      dp    = 0.0,d2,dp2;
   KSP_BCGS       *bcgs = (KSP_BCGS*)ksp->data;
 
   PetscFunctionBegin;
@@ -78,10 +78,11 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
   omegaold = 1.0;
   ierr     = VecSet(P,0.0);CHKERRQ(ierr);
   ierr     = VecSet(V,0.0);CHKERRQ(ierr);
+  ierr     = VecDot(R,RP,&rhonext);CHKERRQ(ierr);
 
   i=0;
   do {
-    ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);       /*   rho <- (r,rp)      */
+    rho  = rhonext;                               /*   rho <- (r,rp)      */
     beta = (rho/rhoold) * (alpha/omegaold);
     ierr = VecAXPBYPCZ(P,1.0,-omegaold*beta,beta,R,V);CHKERRQ(ierr);  /* p <- r - omega * beta* v + beta * p */
     ierr = KSP_PCApplyBAorAB(ksp,P,V,T);CHKERRQ(ierr);  /*   v <- K p           */
@@ -117,9 +118,12 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     }
     omega = d1 / d2;                               /*   w <- (t's) / (t't) */
     ierr  = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
-    ierr  = VecWAXPY(R,-omega,T,S);CHKERRQ(ierr);     /*   r <- s - w t       */
+    /* r <- s - w t together with the next rho = (r,rp) and the norm of r, one reduction */
     if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
+      ierr = VecWAXPYDotNorm2(R,-omega,T,S,RP,&rhonext,&dp2);CHKERRQ(ierr);
+      dp   = PetscSqrtReal(dp2);
+    } else {
+      ierr = VecWAXPYDotNorm2(R,-omega,T,S,RP,&rhonext,NULL);CHKERRQ(ierr);
     }
 
     rhoold   = rho;
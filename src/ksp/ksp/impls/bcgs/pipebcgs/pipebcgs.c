@@ -22,7 +22,7 @@ static PetscErrorCode  KSPSolve_PIPEBCGS(KSP ksp)
   PetscInt       i;
   PetscScalar    rho,rhoold,alpha,beta,omega,d1,d2,d3;
   Vec            X,B,S,R,RP,Y,Q,P2,Q2,R2,S2,W,Z,W2,Z2,T,V;
-  PetscReal      dp    = 0.0;
+  PetscReal      dp    = 0.0,nm;
   KSP_BCGS       *bcgs = (KSP_BCGS*)ksp->data;
   PC             pc;
 
@@ -114,18 +114,16 @@ static PetscErrorCode  KSPSolve_PIPEBCGS(KSP ksp)
     }
     ierr  = VecWAXPY(Q,-alpha,S,R);CHKERRQ(ierr);    /* q  <- r  - alpha s  */
     ierr  = VecWAXPY(Q2,-alpha,S2,R2);CHKERRQ(ierr); /* q2 <- r2 - alpha s2 */
-    ierr  = VecWAXPY(Y,-alpha,Z,W);CHKERRQ(ierr);    /* y  <- w  - alpha z  */
-    
-    ierr = VecDotBegin(Q,Y,&d1);CHKERRQ(ierr); /* d1 <- (q,y) */ 
-    ierr = VecDotBegin(Y,Y,&d2);CHKERRQ(ierr); /* d2 <- (y,y) */
-    
+    ierr  = VecWAXPYDotNorm2Begin(Y,-alpha,Z,W,Q,&d1,&nm);CHKERRQ(ierr); /* y <- w - alpha z, d1 <- (y,q), d2 <- (y,y) */
+
     ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)Q));CHKERRQ(ierr);
     ierr = KSP_PCApply(ksp,Z,Z2);CHKERRQ(ierr); /* z2 <- K z */
     ierr = KSP_MatMult(ksp,pc->mat,Z2,V);CHKERRQ(ierr); /* v <- A z2 */
-    
-    ierr = VecDotEnd(Q,Y,&d1);CHKERRQ(ierr); 
-    ierr = VecDotEnd(Y,Y,&d2);CHKERRQ(ierr); 
-    
+
+    ierr = VecWAXPYDotNorm2End(Y,-alpha,Z,W,Q,&d1,&nm);CHKERRQ(ierr);
+    d1   = PetscConj(d1);
+    d2   = nm;
+
     if (d2 == 0.0) {
       /* y is 0. if q is 0, then alpha s == r, and hence alpha p may be our solution. Give it a try? */
       ierr = VecDot(Q,Q,&d1);CHKERRQ(ierr);
@@ -145,17 +143,14 @@ static PetscErrorCode  KSPSolve_PIPEBCGS(KSP ksp)
     }
     omega = d1/d2; /* omega <- (y'q) / (y'y) */
     ierr = VecAXPBYPCZ(X,alpha,omega,1.0,P2,Q2);CHKERRQ(ierr); /* x <- alpha * p2 + omega * q2 + x */
-    ierr = VecWAXPY(R,-omega,Y,Q);CHKERRQ(ierr);    /* r <- q - omega y */
+    rhoold = rho;
+    /* r <- q - omega y, starting rho <- (r,rp) and the norm of r */
+    ierr = VecWAXPYDotNorm2Begin(R,-omega,Y,Q,RP,&rho,(ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) ? &nm : NULL);CHKERRQ(ierr);
     ierr = VecWAXPY(R2,-alpha,Z2,W2);CHKERRQ(ierr); /* r2 <- w2 - alpha z2 */
     ierr = VecAYPX(R2,-omega,Q2);CHKERRQ(ierr);     /* r2 <- q2 - omega r2 */
     ierr = VecWAXPY(W,-alpha,V,T);CHKERRQ(ierr);    /* w <- t - alpha v */
     ierr = VecAYPX(W,-omega,Y);CHKERRQ(ierr);       /* w <- y - omega w */	
-    rhoold = rho;
     
-    if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr); /* dp <- norm(r) */
-    }
-    ierr = VecDotBegin(R,RP,&rho);CHKERRQ(ierr); /* rho <- (r,rp) */
     ierr = VecDotBegin(S,RP,&d1);CHKERRQ(ierr);  /* d1 <- (s,rp) */
     ierr = VecDotBegin(W,RP,&d2);CHKERRQ(ierr);  /* d2 <- (w,rp) */
     ierr = VecDotBegin(Z,RP,&d3);CHKERRQ(ierr);  /* d3 <- (z,rp) */
@@ -165,9 +160,11 @@ static PetscErrorCode  KSPSolve_PIPEBCGS(KSP ksp)
     ierr = KSP_MatMult(ksp,pc->mat,W2,T);CHKERRQ(ierr); /* t <- A w2 */
     
     if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr); 
+      ierr = VecWAXPYDotNorm2End(R,-omega,Y,Q,RP,&rho,&nm);CHKERRQ(ierr);
+      dp   = PetscSqrtReal(nm);
+    } else {
+      ierr = VecWAXPYDotNorm2End(R,-omega,Y,Q,RP,&rho,NULL);CHKERRQ(ierr);
     }
-    ierr = VecDotEnd(R,RP,&rho);CHKERRQ(ierr); 
     ierr = VecDotEnd(S,RP,&d1);CHKERRQ(ierr);  
     ierr = VecDotEnd(W,RP,&d2);CHKERRQ(ierr);  
     ierr = VecDotEnd(Z,RP,&d3);CHKERRQ(ierr);  
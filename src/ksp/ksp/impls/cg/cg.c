@@ -101,13 +101,18 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   Vec            X,B,Z,R,P,W;
   KSP_CG         *cg;
   Mat            Amat,Pmat;
-  PetscBool      diagonalscale;
+  PetscBool      diagonalscale,dotnorm,havebeta;
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
   if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
 
   cg            = (KSP_CG*)ksp->data;
+#if defined(PETSC_USE_COMPLEX)
+  dotnorm       = (PetscBool)(cg->type == KSP_CG_HERMITIAN); /* beta = z'*r may be fused with the norm of z */
+#else
+  dotnorm       = PETSC_TRUE;
+#endif
   eigs          = ksp->calc_sings;
   stored_max_it = ksp->max_it;
   X             = ksp->vec_sol;
@@ -131,7 +136,13 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   switch (ksp->normtype) {
     case KSP_NORM_PRECONDITIONED:
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*    z <- Br                           */
-      ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*    dp <- z'*z = e'*A'*B'*B*A'*e'     */
+      if (dotnorm) {
+        ierr = VecDotNorm2(R,Z,&beta,&dp);CHKERRQ(ierr);       /*    beta <- z'*r, dp <- z'*z in one pass */
+        beta = PetscConj(beta);
+        dp   = PetscSqrtReal(dp);
+      } else {
+        ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);            /*    dp <- z'*z = e'*A'*B'*B*A'*e'     */
+      }
       break;
     case KSP_NORM_UNPRECONDITIONED:
       ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*    dp <- r'*r = e'*A'*A*e            */
@@ -157,10 +168,10 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   if (ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) {
     ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);                /*     z <- Br                           */
   }
-  if (ksp->normtype != KSP_NORM_NATURAL) {
+  if (ksp->normtype != KSP_NORM_NATURAL && !(ksp->normtype == KSP_NORM_PRECONDITIONED && dotnorm)) {
     ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                  /*     beta <- z'*r                      */
-    KSPCheckDot(ksp,beta);
   }
+  KSPCheckDot(ksp,beta);
 
   i = 0;
   do {
@@ -201,19 +212,31 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     a = beta/dpi;                                              /*     a = beta/p'w                     */
     if (eigs) d[i] = PetscSqrtReal(PetscAbsScalar(b))*e[i] + 1.0/a;
     ierr = VecAXPY(X,a,P);CHKERRQ(ierr);                       /*     x <- x + ap                      */
-    ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                      /*     r <- r - aw                      */
-    if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
-      ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- z'*z                       */
-    } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- r'*r                       */
-    } else if (ksp->normtype == KSP_NORM_NATURAL) {
-      ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
-      ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                 /*     beta <- r'*z                     */
-      KSPCheckDot(ksp,beta);
-      dp = PetscSqrtReal(PetscAbsScalar(beta));
+    havebeta = PETSC_FALSE;
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
+      ierr = VecAXPYDotNorm2(R,-a,W,NULL,NULL,&dp);CHKERRQ(ierr); /*  r <- r - aw, dp <- r'*r in one pass */
+      dp   = PetscSqrtReal(dp);
     } else {
-      dp = 0.0;
+      ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                    /*     r <- r - aw                      */
+      if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i+2) {
+        ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);             /*     z <- Br                          */
+        if (dotnorm) {
+          ierr     = VecDotNorm2(R,Z,&beta,&dp);CHKERRQ(ierr); /*     beta <- z'*r, dp <- z'*z         */
+          KSPCheckDot(ksp,beta);
+          beta     = PetscConj(beta);
+          dp       = PetscSqrtReal(dp);
+          havebeta = PETSC_TRUE;
+        } else {
+          ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);          /*     dp <- z'*z                       */
+        }
+      } else if (ksp->normtype == KSP_NORM_NATURAL) {
+        ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);             /*     z <- Br                          */
+        ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);               /*     beta <- r'*z                     */
+        KSPCheckDot(ksp,beta);
+        dp = PetscSqrtReal(PetscAbsScalar(beta));
+      } else {
+        dp = 0.0;
+      }
     }
     ksp->rnorm = dp;
     ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
@@ -225,7 +248,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     if ((ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) || (ksp->chknorm >= i+2)) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
     }
-    if ((ksp->normtype != KSP_NORM_NATURAL) || (ksp->chknorm >= i+2)) {
+    if (((ksp->normtype != KSP_NORM_NATURAL) || (ksp->chknorm >= i+2)) && !havebeta) {
       ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                 /*     beta <- z'*r                     */
       KSPCheckDot(ksp,beta);
     }
@@ -0,0 +1,548 @@
+/*
+    Communication avoiding s-step conjugate gradient method
+
+    Every s iterations the basis Y = [P_0,...,P_s,U_0,...,U_{s-1}] of the Krylov spaces of the current search direction
+    p = P_0 and preconditioned residual u = U_0 is built with the matrix powers kernel, together with the companions
+    Z = [Q_0,...,Q_s,R_0,...,R_{s-1}], Y = B Z, B the preconditioner. The polynomials of the basis satisfy the three term
+    recurrence of KSPSStepBasisCoefficients_Private() so that A Y = Z T with a sparse change of basis matrix T.
+    A single reduction gives the Gram matrix G = Z^H Y, after which the s CG iterations only update the coordinates of
+    p, r and x in the basis and every inner product is a quadratic form in G.
+*/
+#include <petsc/private/kspimpl.h>
+
+typedef struct {
+  PetscInt          s;              /* number of iterations per block */
+  KSPSStepBasisType basis;
+  PetscBool         eigset;         /* emin, emax were given by the user, otherwise estimated in the first block of each solve */
+  PetscReal         emin,emax;      /* estimate of the real parts of the spectrum of the preconditioned operator */
+  Vec               *Y,*Z;          /* the basis and its companions, Y = B Z */
+  PetscScalar       *G,*N,*T;       /* Z^H Y, Gram matrix of the norm, change of basis A Y = Z T */
+  PetscScalar       *cp,*cr,*cx,*cw;/* coordinates of p (and q), r (and u), the update of x and of A p */
+  PetscReal         *a,*b,*c;       /* coefficients of the basis recurrence */
+  PetscReal         *la,*lb;        /* alpha and beta of the first block, for the Lanczos estimate of the spectrum */
+  PetscScalar       *L;
+} KSP_CGSStep;
+
+/* x^H G y for the column major n by n matrix G */
+PETSC_STATIC_INLINE PetscScalar CGSStepForm(PetscInt n,const PetscScalar *G,const PetscScalar *x,const PetscScalar *y)
+{
+  PetscInt    i,j;
+  PetscScalar sum = 0.0,t;
+
+  for (j=0; j<n; j++) {
+    if (y[j] == 0.0) continue;
+    for (t=0.0,i=0; i<n; i++) t += PetscConj(x[i])*G[i+j*n];
+    sum += t*y[j];
+  }
+  return sum;
+}
+
+/* Generates Y[1..m] and Z[1..m] from Y[0] = B Z[0] with Z[i+1] = (A Y[i] - b_i Z[i] - c_i Z[i-1])/a_i, Y[i+1] = B Z[i+1] */
+static PetscErrorCode KSPCGSStepMatrixPowers_Private(KSP ksp,Mat Amat,PetscInt m,Vec *Y,Vec *Z,const PetscReal *a,const PetscReal *b,const PetscReal *c)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    ierr = KSP_MatMult(ksp,Amat,Y[i],Z[i+1]);CHKERRQ(ierr);
+    if (i) {
+      ierr = VecAXPBYPCZ(Z[i+1],-b[i]/a[i],-c[i]/a[i],1.0/a[i],Z[i],Z[i-1]);CHKERRQ(ierr);
+    } else {
+      ierr = VecAXPBY(Z[i+1],-b[i]/a[i],1.0/a[i],Z[i]);CHKERRQ(ierr);
+    }
+    ierr = KSP_PCApply(ksp,Z[i+1],Y[i+1]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetUp_CGSSTEP(KSP ksp)
+{
+  KSP_CGSStep    *cgs = (KSP_CGSStep*)ksp->data;
+  PetscInt       s = cgs->s,nmax = 2*s+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetWorkVecs(ksp,4);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],nmax,&cgs->Y);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],nmax,&cgs->Z);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,nmax,cgs->Y);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,nmax,cgs->Z);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nmax*nmax,&cgs->G,nmax*nmax,&cgs->N,nmax*nmax,&cgs->T);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nmax,&cgs->cp,nmax,&cgs->cr,nmax,&cgs->cx,nmax,&cgs->cw);CHKERRQ(ierr);
+  ierr = PetscMalloc6(s,&cgs->a,s,&cgs->b,s,&cgs->c,s,&cgs->la,s,&cgs->lb,s*s,&cgs->L);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_CGSSTEP(KSP ksp)
+{
+  KSP_CGSStep    *cgs = (KSP_CGSStep*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (cgs->Y) {
+    ierr = VecDestroyVecs(2*cgs->s+1,&cgs->Y);CHKERRQ(ierr);
+    ierr = VecDestroyVecs(2*cgs->s+1,&cgs->Z);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(cgs->G,cgs->N,cgs->T);CHKERRQ(ierr);
+  ierr = PetscFree4(cgs->cp,cgs->cr,cgs->cx,cgs->cw);CHKERRQ(ierr);
+  ierr = PetscFree6(cgs->a,cgs->b,cgs->c,cgs->la,cgs->lb,cgs->L);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_CGSSTEP(KSP ksp)
+{
+  KSP_CGSStep    *cgs = (KSP_CGSStep*)ksp->data;
+  PetscInt       s = cgs->s,n,i,j,blk,nsteps;
+  PetscScalar    *G = cgs->G,*N = cgs->N,*T = cgs->T,*cp = cgs->cp,*cr = cgs->cr,*cx = cgs->cx,*cw = cgs->cw;
+  PetscScalar    alpha,beta,gamma,gammanew,delta,deltaold = 0.0;
+  PetscReal      dp = 0.0;
+  Vec            X,B,*Y = cgs->Y,*Z = cgs->Z;
+  Mat            Amat,Pmat;
+  MPI_Comm       comm;
+  PetscBool      diagonalscale,estimate;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+
+  X    = ksp->vec_sol;
+  B    = ksp->vec_rhs;
+  comm = PetscObjectComm((PetscObject)X);
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+
+  /* without eigenvalues from the user the first block is monomial and the following ones use its Ritz values */
+  estimate = (PetscBool)(cgs->basis != KSP_SSTEP_BASIS_MONOMIAL && !cgs->eigset);
+  if (estimate) cgs->emin = cgs->emax = 0.0;
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,X,Z[0]);CHKERRQ(ierr);         /*   r <- b - Ax   */
+    ierr = VecAYPX(Z[0],-1.0,B);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(B,Z[0]);CHKERRQ(ierr);                      /*   r <- b (x is 0)   */
+  }
+  ierr = KSP_PCApply(ksp,Z[0],Y[0]);CHKERRQ(ierr);             /*   p = u <- Br   */
+
+  for (blk=0; ; blk++) {
+    /* the first block has p = u so only P is needed */
+    n    = blk ? 2*s+1 : s+1;
+    ierr = KSPSStepBasisCoefficients_Private(cgs->basis,s,cgs->emin,cgs->emax,cgs->a,cgs->b,cgs->c);CHKERRQ(ierr);
+    ierr = KSPCGSStepMatrixPowers_Private(ksp,Amat,s,Y,Z,cgs->a,cgs->b,cgs->c);CHKERRQ(ierr);
+    if (blk) {ierr = KSPCGSStepMatrixPowers_Private(ksp,Amat,s-1,Y+s+1,Z+s+1,cgs->a,cgs->b,cgs->c);CHKERRQ(ierr);}
+
+    /* the change of basis: the column of P_i has a_i, b_i and c_i on the rows of P_{i+1}, P_i and P_{i-1} */
+    ierr = PetscMemzero(T,n*n*sizeof(PetscScalar));CHKERRQ(ierr);
+    for (i=0; i<s; i++) {
+      T[i+1+i*n] = cgs->a[i];
+      T[i+i*n]   = cgs->b[i];
+      if (i) T[i-1+i*n] = cgs->c[i];
+      if (blk && i < s-1) {
+        PetscInt k = s+1+i;
+        T[k+1+k*n] = cgs->a[i];
+        T[k+k*n]   = cgs->b[i];
+        if (i) T[k-1+k*n] = cgs->c[i];
+      }
+    }
+
+    /* the single reduction of the block: the upper triangles of Z^H Y and of the Gram matrix of the norm */
+    for (j=0; j<n; j++) {ierr = VecMDotBegin(Y[j],j+1,Z,G+j*n);CHKERRQ(ierr);}
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      for (j=0; j<n; j++) {ierr = VecMDotBegin(Z[j],j+1,Z,N+j*n);CHKERRQ(ierr);}
+    } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+      for (j=0; j<n; j++) {ierr = VecMDotBegin(Y[j],j+1,Y,N+j*n);CHKERRQ(ierr);}
+    }
+    ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+    for (j=0; j<n; j++) {ierr = VecMDotEnd(Y[j],j+1,Z,G+j*n);CHKERRQ(ierr);}
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      for (j=0; j<n; j++) {ierr = VecMDotEnd(Z[j],j+1,Z,N+j*n);CHKERRQ(ierr);}
+    } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+      for (j=0; j<n; j++) {ierr = VecMDotEnd(Y[j],j+1,Y,N+j*n);CHKERRQ(ierr);}
+    }
+    for (j=0; j<n; j++) {
+      for (i=j+1; i<n; i++) G[i+j*n] = PetscConj(G[j+i*n]);
+    }
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED || ksp->normtype == KSP_NORM_PRECONDITIONED) {
+      for (j=0; j<n; j++) {
+        for (i=j+1; i<n; i++) N[i+j*n] = PetscConj(N[j+i*n]);
+      }
+    }
+
+    /* p = P_0, r = R_0 (Q_0 in the first block) and the update of x starts from 0 */
+    ierr  = PetscMemzero(cp,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr  = PetscMemzero(cr,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr  = PetscMemzero(cx,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    cp[0] = 1.0;
+    cr[blk ? s+1 : 0] = 1.0;
+    gamma = CGSStepForm(n,G,cr,cr);                            /*   gamma <- r'u   */
+    KSPCheckDot(ksp,gamma);
+
+    for (nsteps=0; nsteps<s; nsteps++) {
+      switch (ksp->normtype) {
+      case KSP_NORM_PRECONDITIONED:
+      case KSP_NORM_UNPRECONDITIONED:
+        dp = PetscSqrtReal(PetscAbsScalar(CGSStepForm(n,N,cr,cr)));
+        break;
+      case KSP_NORM_NATURAL:
+        dp = PetscSqrtReal(PetscAbsScalar(gamma));
+        break;
+      default:
+        dp = 0.0;
+      }
+      KSPCheckNorm(ksp,dp);
+      ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm = dp;
+      ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr       = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr       = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+      ierr       = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason) break;
+      if (ksp->its >= ksp->max_it) {ksp->reason = KSP_DIVERGED_ITS; break;}
+      if (gamma == 0.0) {
+        ksp->reason = KSP_CONVERGED_ATOL;
+        ierr        = PetscInfo(ksp,"converged due to gamma = 0\n");CHKERRQ(ierr);
+        break;
+#if !defined(PETSC_USE_COMPLEX)
+      } else if (gamma < 0.0) {
+        ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+        ierr        = PetscInfo(ksp,"diverging due to indefinite preconditioner\n");CHKERRQ(ierr);
+        break;
+#endif
+      }
+
+      for (i=0; i<n; i++) {                                    /*   w = A p <- Z T cp   */
+        PetscInt k;
+        for (cw[i]=0.0,k=PetscMax(i-1,0); k<PetscMin(i+2,n); k++) cw[i] += T[i+k*n]*cp[k];
+      }
+      delta = CGSStepForm(n,G,cp,cw);                          /*   delta <- p'Ap   */
+      KSPCheckDot(ksp,delta);
+      if ((delta == 0.0) || ((ksp->its > 0) && (PetscRealPart(delta*deltaold) <= 0.0))) {
+        ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+        ierr        = PetscInfo(ksp,"diverging due to indefinite or negative definite matrix\n");CHKERRQ(ierr);
+        break;
+      }
+      deltaold = delta;
+      alpha    = gamma/delta;
+      for (i=0; i<n; i++) {
+        cx[i] += alpha*cp[i];                                  /*   x <- x + alpha p   */
+        cr[i] -= alpha*cw[i];                                  /*   r <- r - alpha w   */
+      }
+      gammanew = CGSStepForm(n,G,cr,cr);
+      KSPCheckDot(ksp,gammanew);
+      beta  = gammanew/gamma;
+      gamma = gammanew;
+      for (i=0; i<n; i++) cp[i] = cr[i] + beta*cp[i];          /*   p <- u + beta p   */
+      if (estimate && !blk) {
+        cgs->la[nsteps] = PetscRealPart(alpha);
+        cgs->lb[nsteps] = PetscRealPart(beta);
+      }
+      ksp->its++;
+    }
+
+    ierr = VecMAXPY(X,n,cx,Y);CHKERRQ(ierr);
+    if (ksp->reason) break;
+
+    /* the vectors of the next block from their coordinates */
+    for (i=0; i<4; i++) {ierr = VecSet(ksp->work[i],0.0);CHKERRQ(ierr);}
+    ierr = VecMAXPY(ksp->work[0],n,cp,Y);CHKERRQ(ierr);
+    ierr = VecMAXPY(ksp->work[1],n,cp,Z);CHKERRQ(ierr);
+    ierr = VecMAXPY(ksp->work[2],n,cr,Y);CHKERRQ(ierr);
+    ierr = VecMAXPY(ksp->work[3],n,cr,Z);CHKERRQ(ierr);
+    ierr = VecCopy(ksp->work[0],Y[0]);CHKERRQ(ierr);
+    ierr = VecCopy(ksp->work[1],Z[0]);CHKERRQ(ierr);
+    ierr = VecCopy(ksp->work[2],Y[s+1]);CHKERRQ(ierr);
+    ierr = VecCopy(ksp->work[3],Z[s+1]);CHKERRQ(ierr);
+
+    if (estimate && !blk) {
+      /* the Lanczos tridiagonal matrix of the first s iterations */
+      PetscScalar *L = cgs->L;
+
+      ierr = PetscMemzero(L,s*s*sizeof(PetscScalar));CHKERRQ(ierr);
+      for (j=0; j<s; j++) {
+        L[j+j*s] = 1.0/cgs->la[j];
+        if (j) L[j+j*s] += cgs->lb[j-1]/cgs->la[j-1];
+        if (j < s-1) L[j+1+j*s] = L[j+(j+1)*s] = PetscSqrtReal(PetscAbsReal(cgs->lb[j]))/cgs->la[j];
+      }
+      ierr = KSPSStepEstimateSpectrum_Private(s,L,s,&cgs->emin,&cgs->emax);CHKERRQ(ierr);
+      ierr = PetscInfo2(ksp,"Estimated spectrum [%g, %g]\n",(double)cgs->emin,(double)cgs->emax);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_CGSSTEP(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_CGSSTEP(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepSetEigenvalues_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_CGSSTEP(KSP ksp,PetscViewer viewer)
+{
+  KSP_CGSStep    *cgs = (KSP_CGSStep*)ksp->data;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  steps per block %D, %s basis\n",cgs->s,KSPSStepBasisTypes[cgs->basis]);CHKERRQ(ierr);
+    if (cgs->basis != KSP_SSTEP_BASIS_MONOMIAL) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue %s [%g, %g]\n",cgs->eigset ? "bounds" : "estimate",(double)cgs->emin,(double)cgs->emax);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_CGSSTEP(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_CGSStep       *cgs = (KSP_CGSStep*)ksp->data;
+  PetscInt          s,neig = 2;
+  PetscReal         eigs[2];
+  KSPSStepBasisType basis;
+  PetscBool         flg;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step CG options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_cgsstep_s","Number of iterations per block","KSPCGSStepSetSteps",cgs->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCGSStepSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_cgsstep_basis","Polynomial basis of the block","KSPCGSStepSetBasisType",KSPSStepBasisTypes,(PetscEnum)cgs->basis,(PetscEnum*)&basis,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCGSStepSetBasisType(ksp,basis);CHKERRQ(ierr);}
+  ierr = PetscOptionsRealArray("-ksp_cgsstep_eigenvalues","Bounds of the spectrum of the preconditioned operator","KSPCGSStepSetEigenvalues",eigs,&neig,&flg);CHKERRQ(ierr);
+  if (flg) {
+    if (neig != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_cgsstep_eigenvalues: must specify emin,emax");
+    ierr = KSPCGSStepSetEigenvalues(ksp,eigs[0],eigs[1]);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCGSStepSetSteps_CGSSTEP(KSP ksp,PetscInt s)
+{
+  KSP_CGSStep    *cgs = (KSP_CGSStep*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps per block %D must be positive",s);
+  if (s != cgs->s && ksp->setupstage) {
+    ierr = KSPReset_CGSSTEP(ksp);CHKERRQ(ierr);
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  cgs->s = s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCGSStepGetSteps_CGSSTEP(KSP ksp,PetscInt *s)
+{
+  KSP_CGSStep *cgs = (KSP_CGSStep*)ksp->data;
+
+  PetscFunctionBegin;
+  *s = cgs->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCGSStepSetBasisType_CGSSTEP(KSP ksp,KSPSStepBasisType basis)
+{
+  KSP_CGSStep *cgs = (KSP_CGSStep*)ksp->data;
+
+  PetscFunctionBegin;
+  cgs->basis = basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCGSStepSetEigenvalues_CGSSTEP(KSP ksp,PetscReal emin,PetscReal emax)
+{
+  KSP_CGSStep *cgs = (KSP_CGSStep*)ksp->data;
+
+  PetscFunctionBegin;
+  if (emax <= emin) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"Maximum eigenvalue %g must be larger than the minimum %g",(double)emax,(double)emin);
+  cgs->emin   = emin;
+  cgs->emax   = emax;
+  cgs->eigset = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCGSStepSetSteps - Sets the number of iterations KSPCGSSTEP computes from one matrix powers kernel and one reduction
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  s - the number of iterations per block, 4 by default
+
+   Options Database:
+.  -ksp_cgsstep_s <s>
+
+   Notes:
+   A block stores 4s+2 vectors. With the monomial basis s above about 5 loses the convergence of CG in floating point.
+
+   Level: intermediate
+
+.seealso: KSPCGSSTEP, KSPCGSStepGetSteps(), KSPCGSStepSetBasisType()
+@*/
+PetscErrorCode KSPCGSStepSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPCGSStepSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCGSStepGetSteps - Gets the number of iterations KSPCGSSTEP computes per block
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  s - the number of iterations per block
+
+   Level: intermediate
+
+.seealso: KSPCGSSTEP, KSPCGSStepSetSteps()
+@*/
+PetscErrorCode KSPCGSStepGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPCGSStepGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCGSStepSetBasisType - Sets the polynomial basis of the blocks of KSPCGSSTEP
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  basis - KSP_SSTEP_BASIS_MONOMIAL, KSP_SSTEP_BASIS_NEWTON (default) or KSP_SSTEP_BASIS_CHEBYSHEV
+
+   Options Database:
+.  -ksp_cgsstep_basis <monomial,newton,chebyshev>
+
+   Notes:
+   The Newton and Chebyshev bases need an interval containing the spectrum of the preconditioned operator. Unless it
+   is given with KSPCGSStepSetEigenvalues() the first block of each solve uses the monomial basis and the interval is
+   estimated from its Lanczos coefficients.
+
+   Level: intermediate
+
+.seealso: KSPCGSSTEP, KSPSStepBasisType, KSPCGSStepSetEigenvalues()
+@*/
+PetscErrorCode KSPCGSStepSetBasisType(KSP ksp,KSPSStepBasisType basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,basis,2);
+  ierr = PetscTryMethod(ksp,"KSPCGSStepSetBasisType_C",(KSP,KSPSStepBasisType),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCGSStepSetEigenvalues - Sets the interval of the spectrum of the preconditioned operator used by the Newton and
+   Chebyshev bases of KSPCGSSTEP
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+.  emin - the smallest eigenvalue estimate
+-  emax - the largest eigenvalue estimate
+
+   Options Database:
+.  -ksp_cgsstep_eigenvalues <emin,emax>
+
+   Level: intermediate
+
+.seealso: KSPCGSSTEP, KSPCGSStepSetBasisType(), KSPChebyshevSetEigenvalues()
+@*/
+PetscErrorCode KSPCGSStepSetEigenvalues(KSP ksp,PetscReal emin,PetscReal emax)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveReal(ksp,emin,2);
+  PetscValidLogicalCollectiveReal(ksp,emax,3);
+  ierr = PetscTryMethod(ksp,"KSPCGSStepSetEigenvalues_C",(KSP,PetscReal,PetscReal),(ksp,emin,emax));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPCGSSTEP - The s-step (communication avoiding) preconditioned conjugate gradient method
+
+   Options Database Keys:
++   -ksp_cgsstep_s <s> - number of iterations per block
+.   -ksp_cgsstep_basis <monomial,newton,chebyshev> - polynomial basis of the blocks
+-   -ksp_cgsstep_eigenvalues <emin,emax> - interval of the spectrum for the Newton and Chebyshev bases
+
+   Level: intermediate
+
+   Notes:
+   Every s iterations the method applies the operator and the preconditioner 2s-1 times in a row to build the Krylov
+   bases of the search direction and of the residual, then performs a single global reduction for their Gram matrix
+   and carries out the s iterations on the coordinates in these bases. Compared to KSPCG this replaces 2s reductions
+   by one at the price of more vector operations, which pays off when the reduction latency dominates.
+
+   The matrix and preconditioner must be symmetric positive definite. Only left preconditioning is supported.
+   Because the inner products are computed from the Gram matrix, the attainable accuracy is lower than that of KSPCG
+   and decreases with s and with the conditioning of the basis; the Newton and Chebyshev bases keep s around 8 usable.
+
+   References:
+.  1. - A. T. Chronopoulos and C. W. Gear, s-step iterative methods for symmetric linear systems, J. Comput. Appl. Math., 1989.
+.  2. - E. Carson, Communication-avoiding Krylov subspace methods in theory and practice, PhD thesis, UC Berkeley, 2015.
+
+.seealso: KSPCreate(), KSPSetType(), KSPCG, KSPPIPECG, KSPPIPELCG, KSPGMRESSSTEP, KSPCGSStepSetSteps(), KSPCGSStepSetBasisType()
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CGSSTEP(KSP ksp)
+{
+  KSP_CGSStep    *cgs;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&cgs);CHKERRQ(ierr);
+  ksp->data  = (void*)cgs;
+  cgs->s     = 4;
+  cgs->basis = KSP_SSTEP_BASIS_NEWTON;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_CGSSTEP;
+  ksp->ops->solve          = KSPSolve_CGSSTEP;
+  ksp->ops->reset          = KSPReset_CGSSTEP;
+  ksp->ops->destroy        = KSPDestroy_CGSSTEP;
+  ksp->ops->view           = KSPView_CGSSTEP;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CGSSTEP;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepSetSteps_C",KSPCGSStepSetSteps_CGSSTEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepGetSteps_C",KSPCGSStepGetSteps_CGSSTEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepSetBasisType_C",KSPCGSStepSetBasisType_CGSSTEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCGSStepSetEigenvalues_C",KSPCGSStepSetEigenvalues_CGSSTEP);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -29,7 +29,7 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
   PetscErrorCode ierr;
   PetscInt       i;
   PetscScalar    alpha = 0.0,beta = 0.0,gamma = 0.0,gammaold = 0.0,delta = 0.0;
-  PetscReal      dp    = 0.0;
+  PetscReal      dp    = 0.0,dp2;
   Vec            X,B,Z,P,W,Q,U,M,N,R,S;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
@@ -97,29 +97,32 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
 
   i = 0;
   do {
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormBegin(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
+    /* for i > 0 the reductions were started by the fused updates of u, w and r at the end of the previous iteration */
+    if (i == 0) {
+      if (ksp->normtype != KSP_NORM_NATURAL) {
+        ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
+      }
+      ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
     }
-    ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
     ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
 
     ierr = KSP_PCApply(ksp,W,M);CHKERRQ(ierr);           /*   m <- Bw       */
     ierr = KSP_MatMult(ksp,Amat,M,N);CHKERRQ(ierr);      /*   n <- Am       */
 
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormEnd(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
+    if (i == 0) {
+      if (ksp->normtype != KSP_NORM_NATURAL) {
+        ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
+      }
+      ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
+    } else {
+      if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+        ierr = VecAXPYDotNorm2End(U,-alpha,Q,NULL,NULL,&dp2);CHKERRQ(ierr);
+        dp   = PetscSqrtReal(dp2);
+      }
+      ierr = VecAXPYDotNorm2End(W,-alpha,Z,U,&delta,NULL);CHKERRQ(ierr);
+      ierr = VecAXPYDotNorm2End(R,-alpha,S,U,&gamma,ksp->normtype == KSP_NORM_UNPRECONDITIONED ? &dp2 : NULL);CHKERRQ(ierr);
+      if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) dp = PetscSqrtReal(dp2);
     }
-    ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
 
     if (i > 0) {
       if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
@@ -147,12 +150,23 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
       ierr  = VecAYPX(S,beta,W);CHKERRQ(ierr);   /*     s <- w + beta * s   */
     }
     ierr     = VecAXPY(X, alpha,P);CHKERRQ(ierr); /*     x <- x + alpha * p   */
-    ierr     = VecAXPY(U,-alpha,Q);CHKERRQ(ierr); /*     u <- u - alpha * q   */
-    ierr     = VecAXPY(W,-alpha,Z);CHKERRQ(ierr); /*     w <- w - alpha * z   */
-    ierr     = VecAXPY(R,-alpha,S);CHKERRQ(ierr); /*     r <- r - alpha * s   */
     gammaold = gamma;
     i++;
     ksp->its = i;
+    if (i < ksp->max_it) {
+      /* the updates also start the norm, delta <- w'*u and gamma <- r'*u of the next iteration */
+      if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+        ierr = VecAXPYDotNorm2Begin(U,-alpha,Q,NULL,NULL,&dp2);CHKERRQ(ierr); /* u <- u - alpha * q */
+      } else {
+        ierr = VecAXPY(U,-alpha,Q);CHKERRQ(ierr);
+      }
+      ierr = VecAXPYDotNorm2Begin(W,-alpha,Z,U,&delta,NULL);CHKERRQ(ierr);  /* w <- w - alpha * z */
+      ierr = VecAXPYDotNorm2Begin(R,-alpha,S,U,&gamma,ksp->normtype == KSP_NORM_UNPRECONDITIONED ? &dp2 : NULL);CHKERRQ(ierr); /* r <- r - alpha * s */
+    } else {
+      ierr = VecAXPY(U,-alpha,Q);CHKERRQ(ierr);   /*     u <- u - alpha * q   */
+      ierr = VecAXPY(W,-alpha,Z);CHKERRQ(ierr);   /*     w <- w - alpha * z   */
+      ierr = VecAXPY(R,-alpha,S);CHKERRQ(ierr);   /*     r <- r - alpha * s   */
+    }
 
     /* if (i%50 == 0) { */
     /*   ierr = KSP_MatMult(ksp,Amat,X,R);CHKERRQ(ierr);            /\*     w <- b - Ax     *\/ */
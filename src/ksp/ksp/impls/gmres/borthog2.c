@@ -20,11 +20,15 @@
 
    Options Database Keys:
 +   -ksp_gmres_classicalgramschmidt - Activates KSPGMRESClassicalGramSchmidtOrthogonalization()
--   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is
+-   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always,refine_lagged> - determine if iterative refinement is
                                    used to increase the stability of the classical Gram-Schmidt  orthogonalization.
 
     Notes: Use KSPGMRESSetCGSRefinementType() to determine if iterative refinement is to be used
 
+    KSPGMRES performs KSP_GMRES_CGS_REFINE_LAGGED in its own cycle, with KSPGMRESLaggedMDot_Private() and
+    KSPGMRESLaggedUpdate_Private(); when this routine is called with that refinement type, as by KSPFGMRES,
+    it performs KSP_GMRES_CGS_REFINE_ALWAYS.
+
    Level: intermediate
 
 .seelaso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESSetCGSRefinementType(),
@@ -38,7 +42,7 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   PetscInt       j;
   PetscScalar    *hh,*hes,*lhh;
   PetscReal      hnrm, wnrm;
-  PetscBool      refine = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS);
+  PetscBool      refine = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS || gmres->cgstype == KSP_GMRES_CGS_REFINE_LAGGED);
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
@@ -115,3 +119,113 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
 
 
 
+
+/*
+   The kernels of classical Gram-Schmidt with lagged refinement and normalization, see KSPGMRESLaggedCycle().
+   Both sweep the local parts of the vectors in blocks of KSPGMRES_LAGGED_BLOCK entries, so that the block of
+   the one or two vectors being worked on stays in cache while the Krylov basis VV(0),...,VV(j-1) is read
+   from memory once.
+*/
+#define KSPGMRES_LAGGED_BLOCK 1024
+
+PetscErrorCode KSPGMRESLaggedGetWork_Private(KSP ksp)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!gmres->laggedwork) {
+    ierr = PetscMalloc2(8*(gmres->max_k+2),&gmres->laggedwork,gmres->max_k+3,&gmres->laggedarrays);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)ksp,8*(gmres->max_k+2)*sizeof(PetscScalar)+(gmres->max_k+3)*sizeof(PetscScalar*));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPGMRESLaggedMDot_Private - Computes dots[l*(j+1)+i] = VV(i)^H VV(j+l) for i = 0,...,j and l < nx (nx is 1 or 2)
+   with a single global reduction.
+*/
+PetscErrorCode KSPGMRESLaggedMDot_Private(KSP ksp,PetscInt j,PetscInt nx,PetscScalar *dots)
+{
+  KSP_GMRES         *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode    ierr;
+  PetscInt          n,i,k,k0,kend,m = j+1;
+  PetscScalar       *work,s0,s1;
+  const PetscScalar **q,*qi,*x0,*x1;
+
+  PetscFunctionBegin;
+  ierr = KSPGMRESLaggedGetWork_Private(ksp);CHKERRQ(ierr);
+  work = gmres->laggedwork + 6*(gmres->max_k+2); /* the cycle uses the beginning */
+  q    = gmres->laggedarrays;
+  ierr = VecGetLocalSize(VEC_VV(0),&n);CHKERRQ(ierr);
+  for (i=0; i<j+nx; i++) {ierr = VecGetArrayRead(VEC_VV(i),&q[i]);CHKERRQ(ierr);}
+  ierr = PetscMemzero(work,nx*m*sizeof(PetscScalar));CHKERRQ(ierr);
+  x0   = q[j];
+  x1   = nx > 1 ? q[j+1] : NULL;
+  for (k0=0; k0<n; k0+=KSPGMRES_LAGGED_BLOCK) {
+    kend = PetscMin(n,k0+KSPGMRES_LAGGED_BLOCK);
+    for (i=0; i<m; i++) {
+      qi = q[i];
+      s0 = 0.0;
+      if (x1) {
+        s1 = 0.0;
+        for (k=k0; k<kend; k++) {
+          s0 += PetscConj(qi[k])*x0[k];
+          s1 += PetscConj(qi[k])*x1[k];
+        }
+        work[m+i] += s1;
+      } else {
+        for (k=k0; k<kend; k++) s0 += PetscConj(qi[k])*x0[k];
+      }
+      work[i] += s0;
+    }
+  }
+  for (i=0; i<j+nx; i++) {ierr = VecRestoreArrayRead(VEC_VV(i),&q[i]);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(2.0*nx*m*n);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,dots,nx*m,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)ksp));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPGMRESLaggedUpdate_Private - Computes VV(j) = scale*(VV(j) - sum_i coef[i] VV(i)) and, if nx is 2,
+   VV(j+1) = scale*(VV(j+1) - sum_i coef[j+i] VV(i) - gj*(VV(j) - sum_i coef[i] VV(i))), the sums over i < j.
+*/
+PetscErrorCode KSPGMRESLaggedUpdate_Private(KSP ksp,PetscInt j,PetscInt nx,const PetscScalar *coef,PetscScalar gj,PetscScalar scale)
+{
+  KSP_GMRES         *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode    ierr;
+  PetscInt          n,i,k,k0,kend;
+  PetscScalar       *x0,*x1 = NULL,c0,c1;
+  const PetscScalar **q,*qi;
+
+  PetscFunctionBegin;
+  ierr = KSPGMRESLaggedGetWork_Private(ksp);CHKERRQ(ierr);
+  q    = gmres->laggedarrays;
+  ierr = VecGetLocalSize(VEC_VV(0),&n);CHKERRQ(ierr);
+  for (i=0; i<j; i++) {ierr = VecGetArrayRead(VEC_VV(i),&q[i]);CHKERRQ(ierr);}
+  ierr = VecGetArray(VEC_VV(j),&x0);CHKERRQ(ierr);
+  if (nx > 1) {ierr = VecGetArray(VEC_VV(j+1),&x1);CHKERRQ(ierr);}
+  for (k0=0; k0<n; k0+=KSPGMRES_LAGGED_BLOCK) {
+    kend = PetscMin(n,k0+KSPGMRES_LAGGED_BLOCK);
+    for (i=0; i<j; i++) {
+      qi = q[i];
+      c0 = coef[i];
+      if (x1) {
+        c1 = coef[j+i];
+        for (k=k0; k<kend; k++) {
+          x0[k] -= c0*qi[k];
+          x1[k] -= c1*qi[k];
+        }
+      } else {
+        for (k=k0; k<kend; k++) x0[k] -= c0*qi[k];
+      }
+    }
+    if (x1) for (k=k0; k<kend; k++) x1[k] = scale*(x1[k] - gj*x0[k]);
+    for (k=k0; k<kend; k++) x0[k] *= scale;
+  }
+  for (i=0; i<j; i++) {ierr = VecRestoreArrayRead(VEC_VV(i),&q[i]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(VEC_VV(j),&x0);CHKERRQ(ierr);
+  if (x1) {ierr = VecRestoreArray(VEC_VV(j+1),&x1);CHKERRQ(ierr);}
+  ierr = PetscLogFlops(2.0*nx*j*n + 4.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -210,6 +210,153 @@ PetscErrorCode KSPGMRESCycle(PetscInt *itcount,KSP ksp)
   PetscFunctionReturn(0);
 }
 
+/*
+    KSPGMRESLaggedCycle - The GMRES cycle for classical Gram-Schmidt with lagged refinement and normalization
+    (KSP_GMRES_CGS_REFINE_LAGGED), which needs one global reduction per iteration.
+
+    On entry to step j of the loop VV(0),...,VV(j-1) are orthonormal and VV(j) holds u_j, which is op*VV(j-1) after
+    one classical Gram-Schmidt pass, the coefficients of that pass being in hp[]. Step j applies the operator to
+    u_j instead of to VV(j) and computes, in a single reduction, a = Q^H u_j, Q^H w, u_j^H u_j and u_j^H w with
+    Q = [VV(0),...,VV(j-1)] and w = op*u_j. This gives the second pass for u_j and its norm nu, hence column j-1
+    of the Hessenberg matrix, and, since op*VV(j) = (w - op*Q a)/nu with op*Q a = [Q VV(j)] H a, the first pass
+    for op*VV(j). For j = 0 the step normalizes the initial residual. The residual norm of an iteration is thus
+    known one application of the operator late, the step ending the cycle does the reduction only.
+*/
+static PetscErrorCode KSPGMRESLaggedCycle(PetscInt *itcount,KSP ksp)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscReal      res = 0.0,hapbnd,nu,nu2,alpha;
+  PetscErrorCode ierr;
+  PetscInt       i,l,j,m,it = 0,max_k = gmres->max_k,K = gmres->max_k+2;
+  PetscBool      hapend = PETSC_FALSE,last,refined;
+  PetscScalar    *dots,*coef,*hp,*g,qw;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  ierr = KSPGMRESLaggedGetWork_Private(ksp);CHKERRQ(ierr);
+  dots = gmres->laggedwork;
+  coef = dots + 2*K;
+  hp   = dots + 4*K;
+  g    = dots + 5*K;
+  for (j=0; ; j++) {
+    m    = j+1;
+    last = (PetscBool)(j == max_k || ksp->its + (j ? 1 : 0) >= ksp->max_it);
+    if (!last) {
+      if (gmres->vv_allocated <= j + VEC_OFFSET + 1) {
+        ierr = KSPGMRESGetNewVectors(ksp,j+1);CHKERRQ(ierr);
+      }
+      ierr = KSP_PCApplyBAorAB(ksp,VEC_VV(j),VEC_VV(1+j),VEC_TEMP_MATOP);CHKERRQ(ierr);
+    }
+
+    /* dots[i] = VV(i)^H u_j and dots[m+i] = VV(i)^H w for i < j, dots[j] = u_j^H u_j and dots[m+j] = u_j^H w */
+    ierr  = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+    ierr  = KSPGMRESLaggedMDot_Private(ksp,j,last ? 1 : 2,dots);CHKERRQ(ierr);
+    ierr  = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+    alpha = PetscRealPart(dots[j]);
+    nu2   = alpha;
+    for (i=0; i<j; i++) {
+      KSPCheckDot(ksp,dots[i]);
+      nu2     -= PetscRealPart(PetscConj(dots[i])*dots[i]);
+      coef[i]  = dots[i];
+    }
+    refined = PETSC_FALSE;
+    if (nu2 <= 0.5*alpha) {
+      /* u_j was far from orthogonal to Q, the norm after the second pass must be computed */
+      ierr    = PetscInfo2(ksp,"Norm of the refined vector computed explicitly, %g of %g\n",(double)nu2,(double)alpha);CHKERRQ(ierr);
+      ierr    = KSPGMRESLaggedUpdate_Private(ksp,j,1,coef,0.0,1.0);CHKERRQ(ierr);
+      ierr    = VecNorm(VEC_VV(j),NORM_2,&nu);CHKERRQ(ierr);
+      refined = PETSC_TRUE;
+    } else nu = PetscSqrtReal(nu2);
+    KSPCheckNorm(ksp,nu);
+
+    if (!j) {
+      res        = nu;
+      *GRS(0)    = nu;
+      ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm = res;
+      ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      gmres->it  = -1;
+      if (!res) {
+        ierr        = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+        ierr        = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+        ksp->reason = KSP_CONVERGED_ATOL;
+        ierr        = PetscInfo(ksp,"Converged due to zero residual norm on entry\n");CHKERRQ(ierr);
+        break;
+      }
+    } else {
+      /* column j-1 of the Hessenberg matrix: both passes and the norm */
+      for (i=0; i<j; i++) *HH(i,j-1) = *HES(i,j-1) = hp[i] + dots[i];
+      *HH(j,j-1) = *HES(j,j-1) = nu;
+
+      /* check for the happy breakdown */
+      hapbnd = PetscAbsScalar(nu / *GRS(j-1));
+      if (hapbnd > gmres->haptol) hapbnd = gmres->haptol;
+      if (nu < hapbnd) {
+        ierr   = PetscInfo2(ksp,"Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n",(double)hapbnd,(double)nu);CHKERRQ(ierr);
+        hapend = PETSC_TRUE;
+      }
+      ierr = KSPGMRESUpdateHessenberg(ksp,j-1,hapend,&res);CHKERRQ(ierr);
+
+      it        = j;
+      gmres->it = (it-1);   /* For converged */
+      ksp->its++;
+      ksp->rnorm = res;
+      if (ksp->reason) break;
+    }
+    ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+
+    /* Catch error in happy breakdown and signal convergence and break from loop */
+    if (hapend && !ksp->reason) {
+      if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"You reached the happy break down, but convergence was not indicated. Residual norm = %g",(double)res);
+      else ksp->reason = KSP_DIVERGED_BREAKDOWN;
+    }
+
+    /* the residual at the end of a cycle is monitored at the start of the next one */
+    if (!j || ksp->reason || ksp->its >= ksp->max_it || j < max_k) {
+      ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+    }
+    if (ksp->reason) break;
+    if (last) {
+      /* complete the last vector of a full cycle, used for the Ritz pairs */
+      if (j == max_k) {
+        if (refined) for (i=0; i<j; i++) coef[i] = 0.0;
+        ierr = KSPGMRESLaggedUpdate_Private(ksp,j,1,coef,0.0,1.0/nu);CHKERRQ(ierr);
+      }
+      break;
+    }
+
+    /* g = H(0:j,0:j-1) a */
+    for (i=0; i<=j; i++) {
+      g[i] = 0.0;
+      for (l=PetscMax(i-1,0); l<j; l++) g[i] += *HES(i,l)*dots[l];
+    }
+    /* first pass for op*VV(j): hp = Q^H op*VV(j) with VV(j)^H w = (u_j^H w - a^H Q^H w)/nu */
+    qw = dots[m+j];
+    for (i=0; i<j; i++) {
+      KSPCheckDot(ksp,dots[m+i]);
+      qw -= PetscConj(dots[i])*dots[m+i];
+    }
+    for (i=0; i<j; i++) hp[i] = (dots[m+i] - g[i])/nu;
+    hp[j] = (qw/nu - g[j])/nu;
+
+    /* VV(j) = (u_j - Q a)/nu and u_{j+1} = op*VV(j) - [Q VV(j)] hp = w/nu - [Q VV(j)] (g/nu + hp) in one sweep */
+    for (i=0; i<=j; i++) g[i] = g[i]/nu + hp[i];
+    for (i=0; i<j; i++) {
+      if (refined) coef[i] = 0.0;
+      coef[j+i] = nu*g[i];
+    }
+    ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+    ierr = KSPGMRESLaggedUpdate_Private(ksp,j,2,coef,g[j],1.0/nu);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  }
+  if (itcount) *itcount = it;
+
+  /* Form the solution (or the solution so far) */
+  ierr = KSPGMRESBuildSoln(GRS(0),ksp->vec_sol,ksp->vec_sol,ksp,it-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode KSPSolve_GMRES(KSP ksp)
 {
   PetscErrorCode ierr;
@@ -231,7 +378,11 @@ PetscErrorCode KSPSolve_GMRES(KSP ksp)
   ksp->reason = KSP_CONVERGED_ITERATING;
   while (!ksp->reason) {
     ierr     = KSPInitialResidual(ksp,ksp->vec_sol,VEC_TEMP,VEC_TEMP_MATOP,VEC_VV(0),ksp->vec_rhs);CHKERRQ(ierr);
-    ierr     = KSPGMRESCycle(&its,ksp);CHKERRQ(ierr);
+    if (gmres->orthog == KSPGMRESClassicalGramSchmidtOrthogonalization && gmres->cgstype == KSP_GMRES_CGS_REFINE_LAGGED) {
+      ierr = KSPGMRESLaggedCycle(&its,ksp);CHKERRQ(ierr);
+    } else {
+      ierr = KSPGMRESCycle(&its,ksp);CHKERRQ(ierr);
+    }
     /* Store the Hessenberg matrix and the basis vectors of the Krylov subspace
     if the cycle is complete for the computation of the Ritz pairs */
     if (its == gmres->max_k) {
@@ -287,6 +438,7 @@ PetscErrorCode KSPReset_GMRES(KSP ksp)
   ierr = PetscFree(gmres->Rsvd);CHKERRQ(ierr);
   ierr = PetscFree(gmres->Dsvd);CHKERRQ(ierr);
   ierr = PetscFree(gmres->orthogwork);CHKERRQ(ierr);
+  ierr = PetscFree2(gmres->laggedwork,gmres->laggedarrays);CHKERRQ(ierr);
 
   gmres->sol_temp       = 0;
   gmres->vv_allocated   = 0;
@@ -502,6 +654,9 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
     case (KSP_GMRES_CGS_REFINE_IFNEEDED):
       cstr = "Classical (unmodified) Gram-Schmidt Orthogonalization with one step of iterative refinement when needed";
       break;
+    case (KSP_GMRES_CGS_REFINE_LAGGED):
+      cstr = "Classical (unmodified) Gram-Schmidt Orthogonalization with one step of lagged iterative refinement and lagged normalization";
+      break;
     default:
       SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Unknown orthogonalization");
     }
@@ -685,7 +840,7 @@ PetscErrorCode  KSPGMRESGetCGSRefinementType_GMRES(KSP ksp,KSPGMRESCGSRefinement
 -  type - the type of refinement
 
   Options Database:
-.  -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always>
+.  -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always,refine_lagged>
 
    Level: intermediate
 
@@ -841,8 +996,8 @@ PetscErrorCode  KSPGMRESSetHapTol(KSP ksp,PetscReal tol)
                              vectors are allocated as needed)
 .   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
-.   -ksp_gmres_cgs_refinement_type <never,ifneeded,always> - determine if iterative refinement is used to increase the
-                                   stability of the classical Gram-Schmidt  orthogonalization.
+.   -ksp_gmres_cgs_refinement_type <never,ifneeded,always,lagged> - determine if iterative refinement is used to increase the
+                                   stability of the classical Gram-Schmidt  orthogonalization; lagged uses one global reduction per iteration.
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
 
    Level: beginner
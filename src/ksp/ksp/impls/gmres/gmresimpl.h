@@ -18,6 +18,8 @@
   PetscScalar *rs_origin;   /* holds the right-hand-side of the Hessenberg system */ \
                                                                         \
   PetscScalar *orthogwork; /* holds dot products computed in orthogonalization */ \
+  PetscScalar *laggedwork;          /* work space of the lagged classical Gram-Schmidt, KSP_GMRES_CGS_REFINE_LAGGED */ \
+  const PetscScalar **laggedarrays; /* the local arrays of the Krylov vectors in the lagged classical Gram-Schmidt */ \
                                                                         \
   /* Work space for computing eigenvalues/singular values */            \
   PetscReal   *Dsvd;                                                    \
@@ -61,6 +63,10 @@ PETSC_INTERN PetscErrorCode KSPComputeRitz_GMRES(KSP,PetscBool,PetscBool,PetscIn
 PETSC_INTERN PetscErrorCode KSPReset_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPDestroy_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPGMRESGetNewVectors(KSP,PetscInt);
+PETSC_INTERN PetscErrorCode KSPBuildSolution_GMRES(KSP,Vec,Vec*);
+PETSC_INTERN PetscErrorCode KSPGMRESLaggedGetWork_Private(KSP);
+PETSC_INTERN PetscErrorCode KSPGMRESLaggedMDot_Private(KSP,PetscInt,PetscInt,PetscScalar*);
+PETSC_INTERN PetscErrorCode KSPGMRESLaggedUpdate_Private(KSP,PetscInt,PetscInt,const PetscScalar*,PetscScalar,PetscScalar);
 
 typedef PetscErrorCode (*FCN)(KSP,PetscInt); /* force argument to next function to not be extern C*/
 
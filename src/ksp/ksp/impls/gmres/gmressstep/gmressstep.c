@@ -0,0 +1,623 @@
+/*
+    Communication avoiding s-step GMRES
+
+    Each block computes s basis vectors W_1,...,W_s from the last orthonormal vector W_0 = V_k with the matrix powers
+    kernel op W_j = a_j W_{j+1} + b_j W_j + c_j W_{j-1}, then orthonormalizes them against V_0,...,V_k and among themselves
+    with one reduction: block classical Gram-Schmidt followed by a Cholesky QR of the projected block, whose Gram matrix
+    is obtained from the one of W by the Pythagorean identity. The Hessenberg columns of the block follow from the change
+    of basis. The least squares problem is the one of KSPGMRES.
+*/
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>       /*I  "petscksp.h"  I*/
+#define GMRES_DELTA_DIRECTIONS 10
+#define GMRES_DEFAULT_MAXK     30
+
+typedef struct {
+  KSPGMRESHEADER
+
+  PetscInt          s;            /* number of basis vectors per block */
+  KSPSStepBasisType basis;
+  PetscBool         eigset;       /* emin, emax were given by the user, otherwise estimated in the first block of each solve */
+  PetscReal         emin,emax;    /* estimate of the real parts of the spectrum of the preconditioned operator */
+  PetscScalar       *C;           /* V^H W of the block, (max_k+1) by s */
+  PetscScalar       *Gram,*R;     /* W^H W and the Cholesky factor of the projected block, s by s */
+  PetscScalar       *Rf,*H;       /* coordinates of W in the new orthonormal basis and the new Hessenberg columns */
+  PetscScalar       *coef;
+  PetscReal         *a,*b,*c;     /* coefficients of the basis recurrence */
+} KSP_GMRESSSTEP;
+
+static PetscErrorCode KSPSetUp_GMRESSSTEP(KSP ksp)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscInt       s = gmres->s,ld = gmres->max_k+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetUp_GMRES(ksp);CHKERRQ(ierr);
+  ierr = PetscFree6(gmres->C,gmres->Gram,gmres->R,gmres->Rf,gmres->H,gmres->coef);CHKERRQ(ierr);
+  ierr = PetscFree3(gmres->a,gmres->b,gmres->c);CHKERRQ(ierr);
+  ierr = PetscMalloc6(ld*s,&gmres->C,s*s,&gmres->Gram,s*s,&gmres->R,ld*(s+1),&gmres->Rf,ld*s,&gmres->H,ld,&gmres->coef);CHKERRQ(ierr);
+  ierr = PetscMalloc3(s,&gmres->a,s,&gmres->b,s,&gmres->c);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(ld*(3*s+2) + 2*s*s)*sizeof(PetscScalar) + 3*s*sizeof(PetscReal));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_GMRESSSTEP(KSP ksp)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree6(gmres->C,gmres->Gram,gmres->R,gmres->Rf,gmres->H,gmres->coef);CHKERRQ(ierr);
+  ierr = PetscFree3(gmres->a,gmres->b,gmres->c);CHKERRQ(ierr);
+  ierr = KSPReset_GMRES(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Applies the previous plane rotations to the new column of the Hessenberg matrix and computes the new one,
+   as in KSPGMRES. Returns the new residual norm.
+ */
+static PetscErrorCode KSPGMRESSStepUpdateHessenberg(KSP ksp,PetscInt it,PetscBool hapend,PetscReal *res)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscScalar    *hh,*cc,*ss,tt;
+  PetscInt       j;
+
+  PetscFunctionBegin;
+  hh = HH(0,it);
+  cc = CC(0);
+  ss = SS(0);
+  for (j=1; j<=it; j++) {
+    tt  = *hh;
+    *hh = PetscConj(*cc) * tt + *ss * *(hh+1);
+    hh++;
+    *hh = *cc++ * *hh - (*ss++ * tt);
+  }
+  if (!hapend) {
+    tt = PetscSqrtScalar(PetscConj(*hh) * *hh + PetscConj(*(hh+1)) * *(hh+1));
+    if (tt == 0.0) {
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(0);
+    }
+    *cc        = *hh / tt;
+    *ss        = *(hh+1) / tt;
+    *GRS(it+1) = -(*ss * *GRS(it));
+    *GRS(it)   = PetscConj(*cc) * *GRS(it);
+    *hh        = PetscConj(*cc) * *hh + *ss * *(hh+1);
+    *res       = PetscAbsScalar(*GRS(it+1));
+  } else {
+    *res = 0.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes and orthonormalizes the basis vectors VEC_VV(k+1),...,VEC_VV(k+sb) of a block and stores the Hessenberg
+   columns k,...,k+se-1 in gmres->H. The block is truncated to se < sb vectors when the Cholesky factorization finds
+   them numerically dependent.
+*/
+static PetscErrorCode KSPGMRESSStepBlock(KSP ksp,PetscInt k,PetscInt sb,PetscBool monomial,PetscInt *se)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscInt       s = gmres->s,ld = gmres->max_k+1,i,j,l,n;
+  PetscScalar    *C = gmres->C,*Gm = gmres->Gram,*R = gmres->R,*Rf = gmres->Rf,*H = gmres->H,*coef = gmres->coef,m;
+  PetscReal      *a = gmres->a,*b = gmres->b,*c = gmres->c,tt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSStepBasisCoefficients_Private(gmres->basis,sb,monomial ? 0.0 : gmres->emin,monomial ? 0.0 : gmres->emax,a,b,c);CHKERRQ(ierr);
+
+  /* the matrix powers kernel */
+  for (j=0; j<sb; j++) {
+    ierr = KSP_PCApplyBAorAB(ksp,VEC_VV(k+j),VEC_VV(k+j+1),VEC_TEMP_MATOP);CHKERRQ(ierr);
+    if (j) {
+      ierr = VecAXPBYPCZ(VEC_VV(k+j+1),-b[j]/a[j],-c[j]/a[j],1.0/a[j],VEC_VV(k+j),VEC_VV(k+j-1));CHKERRQ(ierr);
+    } else {
+      ierr = VecAXPBY(VEC_VV(k+1),-b[0]/a[0],1.0/a[0],VEC_VV(k));CHKERRQ(ierr);
+    }
+  }
+
+  /* the single reduction: C(:,j) = V^H W_j and the upper triangle of W^H W */
+  for (j=1; j<=sb; j++) {
+    ierr = VecMDotBegin(VEC_VV(k+j),k+1,&VEC_VV(0),C+(j-1)*ld);CHKERRQ(ierr);
+    ierr = VecMDotBegin(VEC_VV(k+j),j,&VEC_VV(k+1),Gm+(j-1)*s);CHKERRQ(ierr);
+  }
+  ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(0)));CHKERRQ(ierr);
+  for (j=1; j<=sb; j++) {
+    ierr = VecMDotEnd(VEC_VV(k+j),k+1,&VEC_VV(0),C+(j-1)*ld);CHKERRQ(ierr);
+    ierr = VecMDotEnd(VEC_VV(k+j),j,&VEC_VV(k+1),Gm+(j-1)*s);CHKERRQ(ierr);
+  }
+
+  /* Cholesky factorization R^H R = W^H W - C^H C of the Gram matrix of the projected block */
+  *se = sb;
+  for (j=1; j<=sb && *se == sb; j++) {
+    for (i=1; i<=j; i++) {
+      m = Gm[(j-1)*s+i-1];
+      for (l=0; l<=k; l++) m -= PetscConj(C[(i-1)*ld+l])*C[(j-1)*ld+l];
+      for (l=1; l<i; l++)  m -= PetscConj(R[(i-1)*s+l-1])*R[(j-1)*s+l-1];
+      if (i < j) R[(j-1)*s+i-1] = m/R[(i-1)*s+i-1];
+      else if (PetscRealPart(m) > PETSC_SQRT_MACHINE_EPSILON*PetscRealPart(Gm[(j-1)*s+j-1])) R[(j-1)*s+j-1] = PetscSqrtReal(PetscRealPart(m));
+      else *se = j-1;
+    }
+  }
+  if (*se < sb) {ierr = PetscInfo2(ksp,"Block of %D vectors truncated to %D by the Cholesky factorization\n",sb,*se);CHKERRQ(ierr);}
+
+  if (!*se) {
+    /* W_1 is numerically in the span of V: orthogonalize it explicitly, as KSPGMRES would, to detect the happy breakdown */
+    for (l=0; l<=k; l++) coef[l] = -C[l];
+    ierr = VecMAXPY(VEC_VV(k+1),k+1,coef,&VEC_VV(0));CHKERRQ(ierr);
+    ierr = VecNormalize(VEC_VV(k+1),&tt);CHKERRQ(ierr);
+    R[0] = tt;
+    *se  = 1;
+  } else {
+    /* Q_j = (W_j - V C(:,j) - sum_{l<j} Q_l R(l,j))/R(j,j) */
+    for (j=1; j<=*se; j++) {
+      for (l=0; l<=k; l++) coef[l]   = -C[(j-1)*ld+l];
+      for (l=1; l<j; l++)  coef[k+l] = -R[(j-1)*s+l-1];
+      ierr = VecMAXPY(VEC_VV(k+j),k+j,coef,&VEC_VV(0));CHKERRQ(ierr);
+      ierr = VecScale(VEC_VV(k+j),1.0/R[(j-1)*s+j-1]);CHKERRQ(ierr);
+    }
+  }
+
+  /* the coordinates of W_0,...,W_se in V_0,...,V_{k+se} */
+  n    = k + *se + 1;
+  ierr = PetscMemzero(Rf,ld*(*se+1)*sizeof(PetscScalar));CHKERRQ(ierr);
+  Rf[k] = 1.0;
+  for (j=1; j<=*se; j++) {
+    for (l=0; l<=k; l++) Rf[j*ld+l]   = C[(j-1)*ld+l];
+    for (l=1; l<=j; l++) Rf[j*ld+k+l] = R[(j-1)*s+l-1];
+  }
+
+  /*
+     op [W_0 ... W_{se-1}] = [W_0 ... W_se] T with the tridiagonal recurrence T, and W_j = V_{0..k-1} Rf(0:k-1,j) + V_{k..k+se-1} Rf(k:k+se-1,j)
+     where op V_{0..k-1} = V_{0..k} HES, hence the new columns op V_{k..k+se-1} = V (Rf T - HES Rf(0:k-1,:)) Rf(k:k+se-1,:)^{-1}
+  */
+  for (j=0; j<*se; j++) {
+    for (i=0; i<n; i++) {
+      m = a[j]*Rf[(j+1)*ld+i] + b[j]*Rf[j*ld+i];
+      if (j) m += c[j]*Rf[(j-1)*ld+i];
+      if (i <= k) {
+        for (l=PetscMax(i-1,0); l<k; l++) m -= *HES(i,l)*Rf[j*ld+l];
+      }
+      H[j*ld+i] = m;
+    }
+    for (l=0; l<j; l++) {
+      for (i=0; i<n; i++) H[j*ld+i] -= H[l*ld+i]*Rf[j*ld+k+l];
+    }
+    for (i=0; i<n; i++) H[j*ld+i] /= Rf[j*ld+k+j];
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+    One cycle of GMRESSSTEP. On entry VEC_VV(0) holds the initial residual. Without eigenvalue estimates the first
+    block uses the monomial basis and the estimate is then computed from the Hessenberg matrix.
+ */
+static PetscErrorCode KSPGMRESSStepCycle(PetscInt *itcount,KSP ksp,PetscBool *estimate)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscReal      res_norm,res,hapbnd,tt;
+  PetscInt       it = 0,max_k = gmres->max_k,k,sb,se = 0,i,j;
+  PetscBool      hapend = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  ierr    = VecNormalize(VEC_VV(0),&res_norm);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,res_norm);
+  res     = res_norm;
+  *GRS(0) = res_norm;
+
+  /* check for the convergence */
+  ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->rnorm = res;
+  ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  gmres->it  = (it - 1);
+  ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+  ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    ierr        = PetscInfo(ksp,"Converged due to zero residual norm on entry\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
+    k  = it;
+    sb = PetscMin(gmres->s,PetscMin(max_k - k,ksp->max_it - ksp->its));
+    while (gmres->vv_allocated <= k + sb + VEC_OFFSET) {
+      ierr = KSPGMRESGetNewVectors(ksp,gmres->vv_allocated - VEC_OFFSET);CHKERRQ(ierr);
+    }
+    ierr = KSPGMRESSStepBlock(ksp,k,sb,*estimate,&se);CHKERRQ(ierr);
+
+    for (j=0; j<se; j++) {
+      if (it) {
+        ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+        ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+      }
+      for (i=0; i<=it+1; i++) *HH(i,it) = *HES(i,it) = gmres->H[j*(max_k+1)+i];
+
+      /* check for the happy breakdown */
+      tt     = PetscAbsScalar(*HES(it+1,it));
+      hapbnd = PetscAbsScalar(tt / *GRS(it));
+      if (hapbnd > gmres->haptol) hapbnd = gmres->haptol;
+      if (tt < hapbnd) {
+        ierr   = PetscInfo2(ksp,"Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n",(double)hapbnd,(double)tt);CHKERRQ(ierr);
+        hapend = PETSC_TRUE;
+      }
+      ierr = KSPGMRESSStepUpdateHessenberg(ksp,it,hapend,&res);CHKERRQ(ierr);
+
+      it++;
+      gmres->it = (it-1);   /* For converged */
+      ksp->its++;
+      ksp->rnorm = res;
+      if (ksp->reason) break;
+
+      ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+
+      /* Catch error in happy breakdown and signal convergence and break from loop */
+      if (hapend) {
+        if (!ksp->reason) {
+          if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"You reached the happy break down, but convergence was not indicated. Residual norm = %g",(double)res);
+          else ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        }
+        break;
+      }
+      if (ksp->reason) break;
+    }
+
+    if (*estimate) {
+      ierr = KSPSStepEstimateSpectrum_Private(it,HES(0,0),max_k+1,&gmres->emin,&gmres->emax);CHKERRQ(ierr);
+      ierr = PetscInfo2(ksp,"Estimated spectrum [%g, %g]\n",(double)gmres->emin,(double)gmres->emax);CHKERRQ(ierr);
+      *estimate = PETSC_FALSE;
+    }
+  }
+
+  /* Monitor if we know that we will not return for a restart */
+  if (it && (ksp->reason || ksp->its >= ksp->max_it)) {
+    ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  }
+
+  if (itcount) *itcount = it;
+
+  /* Form the solution (or the solution so far) */
+  ierr = KSPBuildSolution_GMRES(ksp,ksp->vec_sol,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_GMRESSSTEP(KSP ksp)
+{
+  KSP_GMRESSSTEP *gmres      = (KSP_GMRESSSTEP*)ksp->data;
+  PetscBool      guess_zero = ksp->guess_zero,estimate;
+  PetscInt       its,itcount;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ksp->calc_sings && !gmres->Rsvd) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ORDER,"Must call KSPSetComputeSingularValues() before KSPSetUp() is called");
+
+  estimate = (PetscBool)(gmres->basis != KSP_SSTEP_BASIS_MONOMIAL && !gmres->eigset);
+  if (estimate) gmres->emin = gmres->emax = 0.0;
+
+  ierr     = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr     = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  itcount     = 0;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  while (!ksp->reason) {
+    ierr     = KSPInitialResidual(ksp,ksp->vec_sol,VEC_TEMP,VEC_TEMP_MATOP,VEC_VV(0),ksp->vec_rhs);CHKERRQ(ierr);
+    ierr     = KSPGMRESSStepCycle(&its,ksp,&estimate);CHKERRQ(ierr);
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_GMRESSSTEP(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_GMRESSSTEP(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepSetEigenvalues_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroy_GMRES(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_GMRESSSTEP(KSP ksp,PetscViewer viewer)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscBool      iascii,isstring;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERSTRING,&isstring);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, vectors per block %D, %s basis\n",gmres->max_k,gmres->s,KSPSStepBasisTypes[gmres->basis]);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  block classical Gram-Schmidt and Cholesky QR in one reduction per block\n");CHKERRQ(ierr);
+    if (gmres->basis != KSP_SSTEP_BASIS_MONOMIAL) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue %s [%g, %g]\n",gmres->eigset ? "bounds" : "estimate",(double)gmres->emin,(double)gmres->emax);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPrintf(viewer,"  happy breakdown tolerance %g\n",(double)gmres->haptol);CHKERRQ(ierr);
+  } else if (isstring) {
+    ierr = PetscViewerStringSPrintf(viewer,"restart %D s %D",gmres->max_k,gmres->s);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_GMRESSSTEP(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_GMRESSSTEP    *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscInt          s,neig = 2;
+  PetscReal         eigs[2];
+  KSPSStepBasisType basis;
+  PetscBool         flg;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetFromOptions_GMRES(PetscOptionsObject,ksp);CHKERRQ(ierr);
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step GMRES Options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_gmressstep_s","Number of basis vectors per block","KSPGMRESSStepSetSteps",gmres->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSStepSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_gmressstep_basis","Polynomial basis of the block","KSPGMRESSStepSetBasisType",KSPSStepBasisTypes,(PetscEnum)gmres->basis,(PetscEnum*)&basis,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSStepSetBasisType(ksp,basis);CHKERRQ(ierr);}
+  ierr = PetscOptionsRealArray("-ksp_gmressstep_eigenvalues","Bounds of the real parts of the spectrum of the preconditioned operator","KSPGMRESSStepSetEigenvalues",eigs,&neig,&flg);CHKERRQ(ierr);
+  if (flg) {
+    if (neig != 2) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"-ksp_gmressstep_eigenvalues: must specify emin,emax");
+    ierr = KSPGMRESSStepSetEigenvalues(ksp,eigs[0],eigs[1]);CHKERRQ(ierr);
+  }
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSStepSetSteps_GMRESSSTEP(KSP ksp,PetscInt s)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors per block %D must be positive",s);
+  if (s != gmres->s && ksp->setupstage) {
+    ierr = KSPReset_GMRESSSTEP(ksp);CHKERRQ(ierr);
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  gmres->s = s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSStepGetSteps_GMRESSSTEP(KSP ksp,PetscInt *s)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+
+  PetscFunctionBegin;
+  *s = gmres->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSStepSetBasisType_GMRESSSTEP(KSP ksp,KSPSStepBasisType basis)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+
+  PetscFunctionBegin;
+  gmres->basis = basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSStepSetEigenvalues_GMRESSSTEP(KSP ksp,PetscReal emin,PetscReal emax)
+{
+  KSP_GMRESSSTEP *gmres = (KSP_GMRESSSTEP*)ksp->data;
+
+  PetscFunctionBegin;
+  if (emax <= emin) SETERRQ2(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_INCOMP,"Maximum eigenvalue %g must be larger than the minimum %g",(double)emax,(double)emin);
+  gmres->emin   = emin;
+  gmres->emax   = emax;
+  gmres->eigset = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPGMRESSStepSetSteps - Sets the number of basis vectors KSPGMRESSSTEP computes from one matrix powers kernel and
+   orthogonalizes with one reduction
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  s - the number of vectors per block, 5 by default
+
+   Options Database:
+.  -ksp_gmressstep_s <s>
+
+   Notes:
+   A block never crosses a restart, so the restart should be a multiple of s.
+
+   Level: intermediate
+
+.seealso: KSPGMRESSSTEP, KSPGMRESSStepGetSteps(), KSPGMRESSStepSetBasisType(), KSPGMRESSetRestart()
+@*/
+PetscErrorCode KSPGMRESSStepSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPGMRESSStepSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPGMRESSStepGetSteps - Gets the number of basis vectors KSPGMRESSSTEP computes per block
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  s - the number of vectors per block
+
+   Level: intermediate
+
+.seealso: KSPGMRESSSTEP, KSPGMRESSStepSetSteps()
+@*/
+PetscErrorCode KSPGMRESSStepGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPGMRESSStepGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPGMRESSStepSetBasisType - Sets the polynomial basis of the blocks of KSPGMRESSSTEP
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  basis - KSP_SSTEP_BASIS_MONOMIAL, KSP_SSTEP_BASIS_NEWTON (default) or KSP_SSTEP_BASIS_CHEBYSHEV
+
+   Options Database:
+.  -ksp_gmressstep_basis <monomial,newton,chebyshev>
+
+   Notes:
+   The Newton and Chebyshev bases need an interval containing the real parts of the spectrum of the preconditioned
+   operator. Unless it is given with KSPGMRESSStepSetEigenvalues() the first block of each solve uses the monomial
+   basis and the interval is estimated from the Ritz values of its Hessenberg matrix. The shifts are real, so operators
+   with large imaginary parts in their spectrum may need a smaller s.
+
+   Level: intermediate
+
+.seealso: KSPGMRESSSTEP, KSPSStepBasisType, KSPGMRESSStepSetEigenvalues()
+@*/
+PetscErrorCode KSPGMRESSStepSetBasisType(KSP ksp,KSPSStepBasisType basis)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,basis,2);
+  ierr = PetscTryMethod(ksp,"KSPGMRESSStepSetBasisType_C",(KSP,KSPSStepBasisType),(ksp,basis));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPGMRESSStepSetEigenvalues - Sets the interval of the real parts of the spectrum of the preconditioned operator used
+   by the Newton and Chebyshev bases of KSPGMRESSSTEP
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+.  emin - the smallest real part
+-  emax - the largest real part
+
+   Options Database:
+.  -ksp_gmressstep_eigenvalues <emin,emax>
+
+   Level: intermediate
+
+.seealso: KSPGMRESSSTEP, KSPGMRESSStepSetBasisType()
+@*/
+PetscErrorCode KSPGMRESSStepSetEigenvalues(KSP ksp,PetscReal emin,PetscReal emax)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveReal(ksp,emin,2);
+  PetscValidLogicalCollectiveReal(ksp,emax,3);
+  ierr = PetscTryMethod(ksp,"KSPGMRESSStepSetEigenvalues_C",(KSP,PetscReal,PetscReal),(ksp,emin,emax));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPGMRESSSTEP - The s-step (communication avoiding) GMRES method
+
+   Options Database Keys:
++   -ksp_gmres_restart <restart> - the number of Krylov directions to orthogonalize against
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+.   -ksp_gmressstep_s <s> - number of basis vectors per block
+.   -ksp_gmressstep_basis <monomial,newton,chebyshev> - polynomial basis of the blocks
+-   -ksp_gmressstep_eigenvalues <emin,emax> - interval of the real parts of the spectrum for the Newton and Chebyshev bases
+
+   Level: intermediate
+
+   Notes:
+   Each block applies the operator s times in a row and orthonormalizes the s new vectors against the previous basis
+   and among themselves with a single global reduction (block classical Gram-Schmidt and a Cholesky QR whose Gram matrix
+   is corrected with the Pythagorean identity), where KSPGMRES with classical Gram-Schmidt needs two reductions per
+   iteration. When the Cholesky factorization detects that the block lost its linear independence the block is
+   truncated, so the method degrades gracefully towards KSPGMRES; the Newton and Chebyshev bases keep the blocks well
+   conditioned for s up to about 10.
+
+   Supports left preconditioning with the preconditioned norm and right preconditioning with the unpreconditioned norm.
+
+   References:
++  1. - M. Hoemmen, Communication-avoiding Krylov subspace methods, PhD thesis, UC Berkeley, 2010.
+-  2. - E. Carson, K. Lund, M. Rozloznik and S. Thomas, Block Gram-Schmidt algorithms and their stability properties, Linear Algebra Appl., 2022.
+
+.seealso: KSPCreate(), KSPSetType(), KSPGMRES, KSPPGMRES, KSPPIPEFGMRES, KSPCGSSTEP, KSPGMRESSStepSetSteps(), KSPGMRESSStepSetBasisType(),
+          KSPGMRESSetRestart()
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_GMRESSSTEP(KSP ksp)
+{
+  KSP_GMRESSSTEP *gmres;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr      = PetscNewLog(ksp,&gmres);CHKERRQ(ierr);
+  ksp->data = (void*)gmres;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_RIGHT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_RIGHT,1);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->buildsolution                = KSPBuildSolution_GMRES;
+  ksp->ops->setup                        = KSPSetUp_GMRESSSTEP;
+  ksp->ops->solve                        = KSPSolve_GMRESSSTEP;
+  ksp->ops->reset                        = KSPReset_GMRESSSTEP;
+  ksp->ops->destroy                      = KSPDestroy_GMRESSSTEP;
+  ksp->ops->view                         = KSPView_GMRESSSTEP;
+  ksp->ops->setfromoptions               = KSPSetFromOptions_GMRESSSTEP;
+  ksp->ops->computeextremesingularvalues = KSPComputeExtremeSingularValues_GMRES;
+  ksp->ops->computeeigenvalues           = KSPComputeEigenvalues_GMRES;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetPreAllocateVectors_C",KSPGMRESSetPreAllocateVectors_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetRestart_C",KSPGMRESSetRestart_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetRestart_C",KSPGMRESGetRestart_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepSetSteps_C",KSPGMRESSStepSetSteps_GMRESSSTEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepGetSteps_C",KSPGMRESSStepGetSteps_GMRESSSTEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepSetBasisType_C",KSPGMRESSStepSetBasisType_GMRESSSTEP);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSStepSetEigenvalues_C",KSPGMRESSStepSetEigenvalues_GMRESSSTEP);CHKERRQ(ierr);
+
+  gmres->haptol         = 1.0e-30;
+  gmres->q_preallocate  = 0;
+  gmres->delta_allocate = GMRES_DELTA_DIRECTIONS;
+  gmres->orthog         = 0;
+  gmres->nrs            = 0;
+  gmres->sol_temp       = 0;
+  gmres->max_k          = GMRES_DEFAULT_MAXK;
+  gmres->Rsvd           = 0;
+  gmres->orthogwork     = 0;
+  gmres->cgstype        = KSP_GMRES_CGS_REFINE_NEVER;
+  gmres->s              = 5;
+  gmres->basis          = KSP_SSTEP_BASIS_NEWTON;
+  PetscFunctionReturn(0);
+}
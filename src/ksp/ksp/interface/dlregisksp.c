@@ -98,7 +98,7 @@ PetscErrorCode  PCInitializePackage(void)
 }
 
 const char *const KSPCGTypes[]                  = {"SYMMETRIC","HERMITIAN","KSPCGType","KSP_CG_",0};
-const char *const KSPGMRESCGSRefinementTypes[]  = {"REFINE_NEVER", "REFINE_IFNEEDED", "REFINE_ALWAYS","KSPGMRESRefinementType","KSP_GMRES_CGS_",0};
+const char *const KSPGMRESCGSRefinementTypes[]  = {"REFINE_NEVER", "REFINE_IFNEEDED", "REFINE_ALWAYS","REFINE_LAGGED","KSPGMRESRefinementType","KSP_GMRES_CGS_",0};
 const char *const KSPNormTypes_Shifted[]        = {"DEFAULT","NONE","PRECONDITIONED","UNPRECONDITIONED","NATURAL","KSPNormType","KSP_NORM_",0};
 const char *const*const KSPNormTypes = KSPNormTypes_Shifted + 1;
 const char *const KSPConvergedReasons_Shifted[] = {"DIVERGED_PCSETUP_FAILED","DIVERGED_INDEFINITE_MAT","DIVERGED_NANORINF","DIVERGED_INDEFINITE_PC",
@@ -109,6 +109,7 @@ const char *const KSPConvergedReasons_Shifted[] = {"DIVERGED_PCSETUP_FAILED","DI
                                                    "CONVERGED_HAPPY_BREAKDOWN","CONVERGED_ATOL_NORMAL","KSPConvergedReason","KSP_",0};
 const char *const*KSPConvergedReasons = KSPConvergedReasons_Shifted + 11;
 const char *const KSPFCDTruncationTypes[] = {"STANDARD","NOTAY","KSPFCDTruncationTypes","KSP_FCD_TRUNC_TYPE_",0};
+const char *const KSPSStepBasisTypes[]    = {"MONOMIAL","NEWTON","CHEBYSHEV","KSPSStepBasisType","KSP_SSTEP_BASIS_",0};
 
 static PetscBool KSPPackageInitialized = PETSC_FALSE;
 /*@C
@@ -387,3 +387,108 @@ PetscErrorCode KSPPlotEigenContours_Private(KSP ksp,PetscInt neig,const PetscRea
   ierr = PetscFree3(xloc,yloc,value);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*
+   KSPSStepBasisCoefficients_Private - the coefficients of the three term recurrence
+     op(rho_j) = a[j] rho_{j+1} + b[j] rho_j + c[j] rho_{j-1},  j = 0,...,s-1
+   that defines the polynomial basis rho_0 = 1,...,rho_s of the s-step Krylov methods, given the estimate [emin,emax] of
+   the real parts of the spectrum of the operator. Without an estimate (emax <= emin) the basis is monomial.
+*/
+PetscErrorCode KSPSStepBasisCoefficients_Private(KSPSStepBasisType type,PetscInt s,PetscReal emin,PetscReal emax,PetscReal a[],PetscReal b[],PetscReal c[])
+{
+  PetscInt       i,j,k;
+  PetscReal      c0 = 0.5*(emax + emin),d = 0.5*(emax - emin),prod,best,t;
+  PetscBool      *used;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (type == KSP_SSTEP_BASIS_MONOMIAL || emax <= emin) {
+    for (j=0; j<s; j++) {a[j] = 1.0; b[j] = 0.0; c[j] = 0.0;}
+  } else if (type == KSP_SSTEP_BASIS_NEWTON) {
+    /* shifts at the Chebyshev points of [emin,emax] in Leja order: each maximizes the product of its distances to the previous ones */
+    ierr = PetscCalloc1(s,&used);CHKERRQ(ierr);
+    for (j=0; j<s; j++) {
+      k = -1; best = -1.0;
+      for (i=0; i<s; i++) {
+        if (used[i]) continue;
+        t    = c0 + d*PetscCosReal(PETSC_PI*(2*i+1)/(2*s));
+        prod = PetscAbsReal(t);
+        if (j) {
+          PetscInt l;
+          for (prod=1.0,l=0; l<j; l++) prod *= PetscAbsReal(t - b[l]);
+        }
+        if (prod > best) {best = prod; k = i;}
+      }
+      used[k] = PETSC_TRUE;
+      a[j]    = d;
+      b[j]    = c0 + d*PetscCosReal(PETSC_PI*(2*k+1)/(2*s));
+      c[j]    = 0.0;
+    }
+    ierr = PetscFree(used);CHKERRQ(ierr);
+  } else {
+    /* Chebyshev polynomials of (op - c0)/d: T_1 = (op - c0)/d and T_{j+1} = 2 (op - c0)/d T_j - T_{j-1} */
+    a[0] = d; b[0] = c0; c[0] = 0.0;
+    for (j=1; j<s; j++) {a[j] = 0.5*d; b[j] = c0; c[j] = 0.5*d;}
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPSStepEstimateSpectrum_Private - an interval [emin,emax] containing the real parts of the eigenvalues of the n by n
+   (column major, leading dimension ldh) Hessenberg or tridiagonal matrix H of the first s steps of an s-step method,
+   widened by a tenth of its width on both sides since the Ritz values lie inside the spectrum
+*/
+PetscErrorCode KSPSStepEstimateSpectrum_Private(PetscInt n,const PetscScalar H[],PetscInt ldh,PetscReal *emin,PetscReal *emax)
+{
+  PetscInt       i,j;
+  PetscReal      lo = PETSC_MAX_REAL,hi = PETSC_MIN_REAL,w;
+#if !defined(PETSC_HAVE_ESSL) && !defined(PETSC_MISSING_LAPACK_GEEV)
+  PetscScalar    *R,*work,sdummy = 0;
+  PetscBLASInt   bn,lwork,idummy = 1,lierr;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscReal      *realpart,*imagpart;
+#else
+  PetscScalar    *eigs;
+  PetscReal      *rwork;
+#endif
+  PetscErrorCode ierr;
+#endif
+
+  PetscFunctionBegin;
+  *emin = 0.0; *emax = 0.0;
+  if (n < 1) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_ESSL) || defined(PETSC_MISSING_LAPACK_GEEV)
+  /* Gershgorin discs */
+  for (i=0; i<n; i++) {
+    for (w=0.0,j=0; j<n; j++) if (j != i) w += PetscAbsScalar(H[i+j*ldh]);
+    lo = PetscMin(lo,PetscRealPart(H[i+i*ldh]) - w);
+    hi = PetscMax(hi,PetscRealPart(H[i+i*ldh]) + w);
+  }
+#else
+  ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(5*n,&lwork);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n*n,&R,5*n,&work);CHKERRQ(ierr);
+  for (j=0; j<n; j++) {
+    for (i=0; i<n; i++) R[i+j*n] = H[i+j*ldh];
+  }
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = PetscMalloc2(n,&realpart,n,&imagpart);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,R,&bn,realpart,imagpart,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,&lierr));
+  for (i=0; i<n; i++) {lo = PetscMin(lo,realpart[i]); hi = PetscMax(hi,realpart[i]);}
+  ierr = PetscFree2(realpart,imagpart);CHKERRQ(ierr);
+#else
+  ierr = PetscMalloc2(n,&eigs,2*n,&rwork);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,R,&bn,eigs,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,rwork,&lierr));
+  for (i=0; i<n; i++) {lo = PetscMin(lo,PetscRealPart(eigs[i])); hi = PetscMax(hi,PetscRealPart(eigs[i]));}
+  ierr = PetscFree2(eigs,rwork);CHKERRQ(ierr);
+#endif
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (lierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)lierr);
+  ierr = PetscFree2(R,work);CHKERRQ(ierr);
+#endif
+  w     = hi - lo;
+  *emin = lo - 0.1*w;
+  *emax = hi + 0.1*w;
+  PetscFunctionReturn(0);
+}
@@ -35,6 +35,16 @@ typedef struct {
   MatType    sub_mat_type;        /* the type of Mat used for subdomain solves (can be MATSAME or NULL) */
   /* For multiplicative solve */
   Mat       *lmats;               /* submatrices for overlapping multiplicative (process) subdomain */
+  /* For batched solve */
+  PetscBool  batch;               /* solve all the subdomains of the process with one KSP */
+  Mat        bpmat;               /* block diagonal matrix of the subdomain matrices */
+  Vec        bx, by;              /* work vectors of the block diagonal matrix */
+  VecScatter brestriction;        /* mapping from overlapping (process) subdomain to the concatenated subdomains */
+  VecScatter bprolongation;       /* mapping from the non-overlapping parts of the concatenated subdomains to the overlapping (process) subdomain */
+  /* For pipelined solve */
+  PetscBool  pipeline;            /* solve the interior subdomains while the restriction is communicating */
+  PetscInt   n_interior;          /* number of subdomains with no ghost points */
+  PetscInt   *order;              /* the interior subdomains followed by the others */
 } PC_ASM;
 
 static PetscErrorCode PCView_ASM(PC pc,PetscViewer viewer)
@@ -56,9 +66,11 @@ static PetscErrorCode PCView_ASM(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  %s, %s\n",blocks,overlaps);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  restriction/interpolation type - %s\n",PCASMTypes[osm->type]);CHKERRQ(ierr);
     if (osm->dm_subdomains) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: using DM to define subdomains\n");CHKERRQ(ierr);}
+    if (osm->batch) {ierr = PetscViewerASCIIPrintf(viewer,"  the subdomains of each process are solved together as one block diagonal matrix\n");CHKERRQ(ierr);}
+    else if (osm->pipeline) {ierr = PetscViewerASCIIPrintf(viewer,"  the interior subdomains are solved while the restriction is communicating\n");CHKERRQ(ierr);}
     if (osm->loctype != PC_COMPOSITE_ADDITIVE) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: local solve composition type - %s\n",PCCompositeTypes[osm->loctype]);CHKERRQ(ierr);}
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
-    if (osm->same_local_solves) {
+    if (osm->same_local_solves || osm->batch) {
       if (osm->ksp) {
         ierr = PetscViewerASCIIPrintf(viewer,"  Local solve is same for all blocks, in the following KSP and PC objects:\n");CHKERRQ(ierr);
         ierr = PetscViewerGetSubViewer(viewer,PETSC_COMM_SELF,&sviewer);CHKERRQ(ierr);
@@ -176,10 +188,10 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
 {
   PC_ASM         *osm = (PC_ASM*)pc->data;
   PetscErrorCode ierr;
-  PetscBool      symset,flg;
-  PetscInt       i,m,m_local;
+  PetscBool      symset,flg,bprolong;
+  PetscInt       i,m,m_local,nksp,offset = 0;
   MatReuse       scall = MAT_REUSE_MATRIX;
-  IS             isl;
+  IS             isl,*bis = NULL,*bisp = NULL,*bisp_local = NULL;
   KSP            ksp;
   PC             subpc;
   const char     *prefix,*pprefix;
@@ -190,6 +202,7 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
   if (!pc->setupcalled) {
     PetscInt m;
 
+    if (osm->batch && osm->loctype == PC_COMPOSITE_MULTIPLICATIVE) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot batch the subdomain solves of the multiplicative local composition");
     if (!osm->type_set) {
       ierr = MatIsSymmetricKnown(pc->pmat,&symset,&flg);CHKERRQ(ierr);
       if (symset && flg) osm->type = PC_ASM_BASIC;
@@ -275,12 +288,13 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
     }
 
     if (!osm->ksp) {
-      /* Create the local solvers */
-      ierr = PetscMalloc1(osm->n_local_true,&osm->ksp);CHKERRQ(ierr);
-      if (domain_dm) {
+      /* Create the local solvers, a single one on the block diagonal matrix of all the subdomains when batched */
+      nksp = osm->batch ? 1 : osm->n_local_true;
+      ierr = PetscMalloc1(nksp,&osm->ksp);CHKERRQ(ierr);
+      if (domain_dm && !osm->batch) {
         ierr = PetscInfo(pc,"Setting up ASM subproblems using the embedded DM\n");CHKERRQ(ierr);
       }
-      for (i=0; i<osm->n_local_true; i++) {
+      for (i=0; i<nksp; i++) {
         ierr = KSPCreate(PETSC_COMM_SELF,&ksp);CHKERRQ(ierr);
         ierr = KSPSetErrorIfNotConverged(ksp,pc->erroriffailure);CHKERRQ(ierr);
         ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)ksp);CHKERRQ(ierr);
@@ -290,7 +304,7 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
         ierr = PCGetOptionsPrefix(pc,&prefix);CHKERRQ(ierr);
         ierr = KSPSetOptionsPrefix(ksp,prefix);CHKERRQ(ierr);
         ierr = KSPAppendOptionsPrefix(ksp,"sub_");CHKERRQ(ierr);
-        if (domain_dm) {
+        if (domain_dm && !osm->batch) {
           ierr = KSPSetDM(ksp, domain_dm[i]);CHKERRQ(ierr);
           ierr = KSPSetDMActive(ksp, PETSC_FALSE);CHKERRQ(ierr);
           ierr = DMDestroy(&domain_dm[i]);CHKERRQ(ierr);
@@ -298,6 +312,9 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
         osm->ksp[i] = ksp;
       }
       if (domain_dm) {
+        if (osm->batch) {
+          for (i=0; i<osm->n_local_true; i++) {ierr = DMDestroy(&domain_dm[i]);CHKERRQ(ierr);}
+        }
         ierr = PetscFree(domain_dm);CHKERRQ(ierr);
       }
     }
@@ -331,8 +348,8 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
     }
   }
 
-  /* Convert the types of the submatrices (if needbe) */
-  if (osm->sub_mat_type) {
+  /* Convert the types of the submatrices (if needbe); when batched the block diagonal matrix is converted instead */
+  if (osm->sub_mat_type && !osm->batch) {
     for (i=0; i<osm->n_local_true; i++) {
       ierr = MatConvert(osm->pmat[i],osm->sub_mat_type,MAT_INPLACE_MATRIX,&(osm->pmat[i]));CHKERRQ(ierr);
     }
@@ -343,12 +360,17 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
     ierr = MatCreateVecs(pc->pmat,&vec,0);CHKERRQ(ierr);
     
     if (osm->is_local && (osm->type == PC_ASM_INTERPOLATE || osm->type == PC_ASM_NONE )) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot use interpolate or none PCASMType if is_local was provided to PCASMSetLocalSubdomains()"); 
-    if (osm->is_local && osm->type == PC_ASM_RESTRICT && osm->loctype == PC_COMPOSITE_ADDITIVE) {
-      ierr = PetscMalloc1(osm->n_local_true,&osm->lprolongation);CHKERRQ(ierr);
+    bprolong = (PetscBool)(osm->batch && osm->is_local && osm->type == PC_ASM_RESTRICT);
+    if (osm->batch) {
+      ierr = PetscCalloc3(osm->n_local_true,&bis,osm->n_local_true,&bisp,osm->n_local_true,&bisp_local);CHKERRQ(ierr);
+    } else {
+      if (osm->is_local && osm->type == PC_ASM_RESTRICT && osm->loctype == PC_COMPOSITE_ADDITIVE) {
+        ierr = PetscMalloc1(osm->n_local_true,&osm->lprolongation);CHKERRQ(ierr);
+      }
+      ierr = PetscMalloc1(osm->n_local_true,&osm->lrestriction);CHKERRQ(ierr);
+      ierr = PetscMalloc1(osm->n_local_true,&osm->x);CHKERRQ(ierr);
+      ierr = PetscMalloc1(osm->n_local_true,&osm->y);CHKERRQ(ierr);
     }
-    ierr = PetscMalloc1(osm->n_local_true,&osm->lrestriction);CHKERRQ(ierr);
-    ierr = PetscMalloc1(osm->n_local_true,&osm->x);CHKERRQ(ierr);
-    ierr = PetscMalloc1(osm->n_local_true,&osm->y);CHKERRQ(ierr);
         
     ierr = ISGetLocalSize(osm->lis,&m);CHKERRQ(ierr);
     ierr = ISCreateStride(PETSC_COMM_SELF,m,0,1,&isl);CHKERRQ(ierr);
@@ -362,10 +384,11 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
       const PetscInt         *idx_is;
       PetscInt               *idx_lis,nout;
 
-      ierr = ISGetLocalSize(osm->is[i],&m);CHKERRQ(ierr);
-      ierr = MatCreateVecs(osm->pmat[i],&osm->x[i],NULL);CHKERRQ(ierr);
-      ierr = VecDuplicate(osm->x[i],&osm->y[i]);CHKERRQ(ierr);
-      
+      if (!osm->batch) {
+        ierr = MatCreateVecs(osm->pmat[i],&osm->x[i],NULL);CHKERRQ(ierr);
+        ierr = VecDuplicate(osm->x[i],&osm->y[i]);CHKERRQ(ierr);
+      }
+
       /* generate a scatter from ly to y[i] picking all the overlapping is[i] entries */
       ierr = ISLocalToGlobalMappingCreateIS(osm->lis,&ltog);CHKERRQ(ierr);
       ierr = ISGetLocalSize(osm->is[i],&m);CHKERRQ(ierr);
@@ -376,11 +399,15 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
       ierr = ISRestoreIndices(osm->is[i], &idx_is);CHKERRQ(ierr);
       ierr = ISCreateGeneral(PETSC_COMM_SELF,m,idx_lis,PETSC_OWN_POINTER,&isll);CHKERRQ(ierr);
       ierr = ISLocalToGlobalMappingDestroy(&ltog);CHKERRQ(ierr);
-      ierr = ISCreateStride(PETSC_COMM_SELF,m,0,1,&isl);CHKERRQ(ierr);
-      ierr = VecScatterCreate(osm->ly,isll,osm->y[i],isl,&osm->lrestriction[i]);CHKERRQ(ierr);
-      ierr = ISDestroy(&isll);CHKERRQ(ierr);
-      ierr = ISDestroy(&isl);CHKERRQ(ierr);
-      if (osm->lprolongation) { /* generate a scatter from y[i] to ly picking only the the non-overalapping is_local[i] entries */
+      if (osm->batch) {
+        bis[i] = isll;
+      } else {
+        ierr = ISCreateStride(PETSC_COMM_SELF,m,0,1,&isl);CHKERRQ(ierr);
+        ierr = VecScatterCreate(osm->ly,isll,osm->y[i],isl,&osm->lrestriction[i]);CHKERRQ(ierr);
+        ierr = ISDestroy(&isll);CHKERRQ(ierr);
+        ierr = ISDestroy(&isl);CHKERRQ(ierr);
+      }
+      if (osm->lprolongation || bprolong) { /* generate a scatter from y[i] to ly picking only the the non-overalapping is_local[i] entries */
 	ISLocalToGlobalMapping ltog;
         IS                     isll,isll_local;
         const PetscInt         *idx_local;
@@ -394,6 +421,10 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
 	ierr = ISGlobalToLocalMappingApply(ltog,IS_GTOLM_DROP,m_local,idx_local,&nout,idx1);CHKERRQ(ierr);
         ierr = ISLocalToGlobalMappingDestroy(&ltog);CHKERRQ(ierr);
         if (nout != m_local) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"is_local not a subset of is");
+        if (osm->batch) { /* position in the concatenated subdomains */
+          PetscInt j;
+          for (j=0; j<m_local; j++) idx1[j] += offset;
+        }
         ierr = ISCreateGeneral(PETSC_COMM_SELF,m_local,idx1,PETSC_OWN_POINTER,&isll);CHKERRQ(ierr);
 	
 	ierr = ISLocalToGlobalMappingCreateIS(osm->lis,&ltog);CHKERRQ(ierr);
@@ -404,11 +435,64 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
         ierr = ISCreateGeneral(PETSC_COMM_SELF,m_local,idx2,PETSC_OWN_POINTER,&isll_local);CHKERRQ(ierr);
 	
 	ierr = ISRestoreIndices(osm->is_local[i], &idx_local);CHKERRQ(ierr);
-	ierr = VecScatterCreate(osm->y[i],isll,osm->ly,isll_local,&osm->lprolongation[i]);CHKERRQ(ierr);
-	
+        if (osm->batch) {
+          bisp[i]       = isll;
+          bisp_local[i] = isll_local;
+        } else {
+          ierr = VecScatterCreate(osm->y[i],isll,osm->ly,isll_local,&osm->lprolongation[i]);CHKERRQ(ierr);
+          ierr = ISDestroy(&isll);CHKERRQ(ierr);
+          ierr = ISDestroy(&isll_local);CHKERRQ(ierr);
+        }
+      }
+      offset += m;
+    }
+    if (osm->batch) { /* the scatters between the overlapping (process) subdomain and the concatenated subdomains */
+      IS isll;
+
+      ierr = ISConcatenate(PETSC_COMM_SELF,osm->n_local_true,bis,&isll);CHKERRQ(ierr);
+      ierr = ISGetLocalSize(isll,&m);CHKERRQ(ierr);
+      ierr = VecCreateSeq(PETSC_COMM_SELF,m,&osm->bx);CHKERRQ(ierr);
+      ierr = VecDuplicate(osm->bx,&osm->by);CHKERRQ(ierr);
+      ierr = ISCreateStride(PETSC_COMM_SELF,m,0,1,&isl);CHKERRQ(ierr);
+      ierr = VecScatterCreate(osm->lx,isll,osm->bx,isl,&osm->brestriction);CHKERRQ(ierr);
+      ierr = ISDestroy(&isll);CHKERRQ(ierr);
+      ierr = ISDestroy(&isl);CHKERRQ(ierr);
+      if (bprolong) {
+        IS isll_local;
+
+        ierr = ISConcatenate(PETSC_COMM_SELF,osm->n_local_true,bisp,&isll);CHKERRQ(ierr);
+        ierr = ISConcatenate(PETSC_COMM_SELF,osm->n_local_true,bisp_local,&isll_local);CHKERRQ(ierr);
+        ierr = VecScatterCreate(osm->bx,isll,osm->ly,isll_local,&osm->bprolongation);CHKERRQ(ierr);
         ierr = ISDestroy(&isll);CHKERRQ(ierr);
-	ierr = ISDestroy(&isll_local);CHKERRQ(ierr);
-      }    
+        ierr = ISDestroy(&isll_local);CHKERRQ(ierr);
+      }
+      for (i=0; i<osm->n_local_true; i++) {
+        ierr = ISDestroy(&bis[i]);CHKERRQ(ierr);
+        ierr = ISDestroy(&bisp[i]);CHKERRQ(ierr);
+        ierr = ISDestroy(&bisp_local[i]);CHKERRQ(ierr);
+      }
+      ierr = PetscFree3(bis,bisp,bisp_local);CHKERRQ(ierr);
+    }
+    if (osm->pipeline && !osm->batch) {
+      /* order the subdomains lying entirely in the rows of this process first, they need no ghost values */
+      PetscInt       rstart,rend,j,n,nb = 0,*border;
+      const PetscInt *idx;
+
+      ierr = VecGetOwnershipRange(vec,&rstart,&rend);CHKERRQ(ierr);
+      ierr = PetscMalloc1(osm->n_local_true,&osm->order);CHKERRQ(ierr);
+      ierr = PetscMalloc1(osm->n_local_true,&border);CHKERRQ(ierr);
+      osm->n_interior = 0;
+      for (i=0; i<osm->n_local_true; i++) {
+        ierr = ISGetLocalSize(osm->is[i],&n);CHKERRQ(ierr);
+        ierr = ISGetIndices(osm->is[i],&idx);CHKERRQ(ierr);
+        for (j=0; j<n; j++) if (idx[j] < rstart || idx[j] >= rend) break;
+        ierr = ISRestoreIndices(osm->is[i],&idx);CHKERRQ(ierr);
+        if (j == n) osm->order[osm->n_interior++] = i;
+        else        border[nb++] = i;
+      }
+      ierr = PetscMemcpy(osm->order+osm->n_interior,border,nb*sizeof(PetscInt));CHKERRQ(ierr);
+      ierr = PetscFree(border);CHKERRQ(ierr);
+      ierr = PetscInfo2(pc,"%D of %D subdomains are solved while the restriction is communicating\n",osm->n_interior,osm->n_local_true);CHKERRQ(ierr);
     }
     ierr = VecDestroy(&vec);CHKERRQ(ierr);
   }
@@ -427,6 +511,25 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
      different boundary conditions for the submatrices than for the global problem) */
   ierr = PCModifySubMatrices(pc,osm->n_local_true,osm->is,osm->is,osm->pmat,pc->modifysubmatricesP);CHKERRQ(ierr);
 
+  if (osm->batch) {
+    /* Place the subdomain matrices on the diagonal of the one matrix solved by the local ksp */
+    if (scall == MAT_INITIAL_MATRIX) {ierr = MatDestroy(&osm->bpmat);CHKERRQ(ierr);}
+    ierr = PCCreateBlockDiagonal_Private(osm->n_local_true,osm->pmat,scall,&osm->bpmat);CHKERRQ(ierr);
+    if (scall == MAT_INITIAL_MATRIX) {
+      ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)osm->bpmat);CHKERRQ(ierr);
+      ierr = PetscObjectGetOptionsPrefix((PetscObject)pc->pmat,&pprefix);CHKERRQ(ierr);
+      ierr = PetscObjectSetOptionsPrefix((PetscObject)osm->bpmat,pprefix);CHKERRQ(ierr);
+      if (osm->sub_mat_type) {
+        ierr = MatConvert(osm->bpmat,osm->sub_mat_type,MAT_INPLACE_MATRIX,&osm->bpmat);CHKERRQ(ierr);
+      }
+    }
+    ierr = KSPSetOperators(osm->ksp[0],osm->bpmat,osm->bpmat);CHKERRQ(ierr);
+    if (!pc->setupcalled) {
+      ierr = KSPSetFromOptions(osm->ksp[0]);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
+
   /*
      Loop over subdomains putting them into local ksp
   */
@@ -447,7 +550,7 @@ static PetscErrorCode PCSetUpOnBlocks_ASM(PC pc)
   KSPConvergedReason reason;
 
   PetscFunctionBegin;
-  for (i=0; i<osm->n_local_true; i++) {
+  for (i=0; i<(osm->batch ? 1 : osm->n_local_true); i++) {
     ierr = KSPSetUp(osm->ksp[i]);CHKERRQ(ierr);
     ierr = KSPGetConvergedReason(osm->ksp[i],&reason);CHKERRQ(ierr);
     if (reason == KSP_DIVERGED_PCSETUP_FAILED) {
@@ -457,6 +560,98 @@ static PetscErrorCode PCSetUpOnBlocks_ASM(PC pc)
   PetscFunctionReturn(0);
 }
 
+/* all the subdomains are solved at once on the block diagonal matrix; forward and reverse are the modes of the global restriction */
+static PetscErrorCode PCApply_ASM_Batch(PC pc,Vec x,Vec y,ScatterMode forward,ScatterMode reverse,PetscBool transpose)
+{
+  PC_ASM         *osm = (PC_ASM*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* zero the global and the local solutions */
+  ierr = VecZeroEntries(y);CHKERRQ(ierr);
+  ierr = VecSet(osm->ly, 0.0);CHKERRQ(ierr);
+
+  /* Copy the global RHS to local RHS including the ghost nodes */
+  ierr = VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, forward);CHKERRQ(ierr);
+  ierr = VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, forward);CHKERRQ(ierr);
+
+  /* Restrict local RHS to the RHS of all the overlapping blocks */
+  ierr = VecScatterBegin(osm->brestriction, osm->lx, osm->bx, INSERT_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(osm->brestriction, osm->lx, osm->bx, INSERT_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+
+  if (transpose) {
+    ierr = KSPSolveTranspose(osm->ksp[0], osm->bx, osm->by);CHKERRQ(ierr);
+  } else {
+    ierr = KSPSolve(osm->ksp[0], osm->bx, osm->by);CHKERRQ(ierr);
+  }
+
+  if (osm->bprolongation) { /* interpolate the non-overlapping block solutions to the local solution */
+    ierr = VecScatterBegin(osm->bprolongation, osm->by, osm->ly, ADD_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(osm->bprolongation, osm->by, osm->ly, ADD_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+  } else { /* interpolate the overlapping block solutions to the local solution */
+    ierr = VecScatterBegin(osm->brestriction, osm->by, osm->ly, ADD_VALUES, SCATTER_REVERSE);CHKERRQ(ierr);
+    ierr = VecScatterEnd(osm->brestriction, osm->by, osm->ly, ADD_VALUES, SCATTER_REVERSE);CHKERRQ(ierr);
+  }
+
+  /* Add the local solution to the global solution including the ghost nodes */
+  ierr = VecScatterBegin(osm->restriction, osm->ly, y, ADD_VALUES, reverse);CHKERRQ(ierr);
+  ierr = VecScatterEnd(osm->restriction, osm->ly, y, ADD_VALUES, reverse);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* solve the overlapping i-block from the local RHS and add its solution to the local solution */
+static PetscErrorCode PCASMSolveBlock_Private(PC pc,PetscInt i,ScatterMode forward,ScatterMode reverse)
+{
+  PC_ASM         *osm = (PC_ASM*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecScatterBegin(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+  ierr = VecScatterEnd(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+  ierr = KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
+  if (osm->lprolongation) {
+    ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+    ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+    ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The additive solve with the interior subdomains solved between the begin and end of the restriction. The
+   process owned part of the local RHS is filled first by a local only pass of the same scatter, so this does
+   not depend on when a VecScatter implementation copies its local entries.
+*/
+static PetscErrorCode PCApply_ASM_Pipelined(PC pc,Vec x,Vec y,ScatterMode reverse)
+{
+  PC_ASM         *osm = (PC_ASM*)pc->data;
+  PetscErrorCode ierr;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  /* zero the global and the local solutions */
+  ierr = VecZeroEntries(y);CHKERRQ(ierr);
+  ierr = VecSet(osm->ly, 0.0);CHKERRQ(ierr);
+
+  ierr = VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, SCATTER_FORWARD_LOCAL);CHKERRQ(ierr);
+  ierr = VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, SCATTER_FORWARD_LOCAL);CHKERRQ(ierr);
+  ierr = VecScatterBegin(osm->restriction, x, osm->lx, INSERT_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+  for (k = 0; k < osm->n_interior; ++k) {
+    ierr = PCASMSolveBlock_Private(pc,osm->order[k],SCATTER_FORWARD,reverse);CHKERRQ(ierr);
+  }
+  ierr = VecScatterEnd(osm->restriction, x, osm->lx, INSERT_VALUES, SCATTER_FORWARD);CHKERRQ(ierr);
+  for (k = osm->n_interior; k < osm->n_local_true; ++k) {
+    ierr = PCASMSolveBlock_Private(pc,osm->order[k],SCATTER_FORWARD,reverse);CHKERRQ(ierr);
+  }
+
+  /* Add the local solution to the global solution including the ghost nodes */
+  ierr = VecScatterBegin(osm->restriction, osm->ly, y, ADD_VALUES, reverse);CHKERRQ(ierr);
+  ierr = VecScatterEnd(osm->restriction, osm->ly, y, ADD_VALUES, reverse);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCApply_ASM(PC pc,Vec x,Vec y)
 {
   PC_ASM         *osm = (PC_ASM*)pc->data;
@@ -477,6 +672,14 @@ static PetscErrorCode PCApply_ASM(PC pc,Vec x,Vec y)
   if (!(osm->type & PC_ASM_INTERPOLATE)) {
     reverse = SCATTER_REVERSE_LOCAL;
   }
+  if (osm->batch) {
+    ierr = PCApply_ASM_Batch(pc,x,y,forward,reverse,PETSC_FALSE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (osm->order && osm->loctype == PC_COMPOSITE_ADDITIVE && forward == SCATTER_FORWARD) {
+    ierr = PCApply_ASM_Pipelined(pc,x,y,reverse);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
     
   if(osm->loctype == PC_COMPOSITE_MULTIPLICATIVE || osm->loctype == PC_COMPOSITE_ADDITIVE){
     /* zero the global and the local solutions */
@@ -549,6 +752,10 @@ static PetscErrorCode PCApplyTranspose_ASM(PC pc,Vec x,Vec y)
     ierr = VecSet(osm->lx, 0.0);CHKERRQ(ierr);
   }
   if (!(osm->type & PC_ASM_RESTRICT)) reverse = SCATTER_REVERSE_LOCAL;
+  if (osm->batch) {
+    ierr = PCApply_ASM_Batch(pc,x,y,forward,reverse,PETSC_TRUE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
 
   /* zero the global and the local solutions */
   ierr = VecZeroEntries(y);CHKERRQ(ierr);
@@ -599,7 +806,7 @@ static PetscErrorCode PCReset_ASM(PC pc)
 
   PetscFunctionBegin;
   if (osm->ksp) {
-    for (i=0; i<osm->n_local_true; i++) {
+    for (i=0; i<(osm->batch ? 1 : osm->n_local_true); i++) {
       ierr = KSPReset(osm->ksp[i]);CHKERRQ(ierr);
     }
   }
@@ -608,8 +815,8 @@ static PetscErrorCode PCReset_ASM(PC pc)
       ierr = MatDestroySubMatrices(osm->n_local_true,&osm->pmat);CHKERRQ(ierr);
     }
   }
+  ierr = VecScatterDestroy(&osm->restriction);CHKERRQ(ierr);
   if (osm->lrestriction) {
-    ierr = VecScatterDestroy(&osm->restriction);CHKERRQ(ierr);
     for (i=0; i<osm->n_local_true; i++) {
       ierr = VecScatterDestroy(&osm->lrestriction[i]);CHKERRQ(ierr);
       if (osm->lprolongation) {ierr = VecScatterDestroy(&osm->lprolongation[i]);CHKERRQ(ierr);}
@@ -622,6 +829,12 @@ static PetscErrorCode PCReset_ASM(PC pc)
     ierr = PetscFree(osm->y);CHKERRQ(ierr);
     
   }
+  ierr = PetscFree(osm->order);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&osm->brestriction);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&osm->bprolongation);CHKERRQ(ierr);
+  ierr = VecDestroy(&osm->bx);CHKERRQ(ierr);
+  ierr = VecDestroy(&osm->by);CHKERRQ(ierr);
+  ierr = MatDestroy(&osm->bpmat);CHKERRQ(ierr);
   ierr = PCASMDestroySubdomains(osm->n_local_true,osm->is,osm->is_local);CHKERRQ(ierr);
   ierr = ISDestroy(&osm->lis);CHKERRQ(ierr);
   ierr = VecDestroy(&osm->lx);CHKERRQ(ierr);
@@ -646,7 +859,7 @@ static PetscErrorCode PCDestroy_ASM(PC pc)
   PetscFunctionBegin;
   ierr = PCReset_ASM(pc);CHKERRQ(ierr);
   if (osm->ksp) {
-    for (i=0; i<osm->n_local_true; i++) {
+    for (i=0; i<(osm->batch ? 1 : osm->n_local_true); i++) {
       ierr = KSPDestroy(&osm->ksp[i]);CHKERRQ(ierr);
     }
     ierr = PetscFree(osm->ksp);CHKERRQ(ierr);
@@ -689,6 +902,10 @@ static PetscErrorCode PCSetFromOptions_ASM(PetscOptionItems *PetscOptionsObject,
   flg  = PETSC_FALSE;
   ierr = PetscOptionsEnum("-pc_asm_local_type","Type of local solver composition","PCASMSetLocalType",PCCompositeTypes,(PetscEnum)osm->loctype,(PetscEnum*)&loctype,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCASMSetLocalType(pc,loctype);CHKERRQ(ierr); }
+  ierr = PetscOptionsBool("-pc_asm_pipeline","Solve the interior subdomains while the restriction is communicating","None",osm->pipeline,&osm->pipeline,NULL);CHKERRQ(ierr);
+  if (!osm->ksp) {
+    ierr = PetscOptionsBool("-pc_asm_batch","Solve the subdomains of each process as one block diagonal matrix","None",osm->batch,&osm->batch,NULL);CHKERRQ(ierr);
+  }
   ierr = PetscOptionsFList("-pc_asm_sub_mat_type","Subsolve Matrix Type","PCASMSetSubMatType",MatList,NULL,sub_mat_type,256,&flg);CHKERRQ(ierr);
   if(flg){
     ierr = PCASMSetSubMatType(pc,sub_mat_type);CHKERRQ(ierr);
@@ -838,14 +1055,15 @@ static PetscErrorCode  PCASMGetSubKSP_ASM(PC pc,PetscInt *n_local,PetscInt *firs
 {
   PC_ASM         *osm = (PC_ASM*)pc->data;
   PetscErrorCode ierr;
+  PetscInt       nksp = osm->batch ? 1 : osm->n_local_true; /* one KSP on the block diagonal matrix when batched */
 
   PetscFunctionBegin;
   if (osm->n_local_true < 1) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ORDER,"Need to call PCSetUP() on PC (or KSPSetUp() on the outer KSP object) before calling here");
 
-  if (n_local) *n_local = osm->n_local_true;
+  if (n_local) *n_local = nksp;
   if (first_local) {
-    ierr          = MPI_Scan(&osm->n_local_true,first_local,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
-    *first_local -= osm->n_local_true;
+    ierr          = MPI_Scan(&nksp,first_local,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)pc));CHKERRQ(ierr);
+    *first_local -= nksp;
   }
   if (ksp) {
     /* Assume that local solves are now different; not necessarily
@@ -1243,7 +1461,9 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
 +  -pc_asm_blocks <blks> - Sets total blocks
 .  -pc_asm_overlap <ovl> - Sets overlap
 .  -pc_asm_type [basic,restrict,interpolate,none] - Sets ASM type, default is restrict
--  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+.  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+.  -pc_asm_batch - solve all the subdomains of a process with one KSP on the block diagonal matrix of the subdomains
+-  -pc_asm_pipeline - solve the subdomains with no ghost points while the restriction is communicating
 
      IMPORTANT: If you run with, for example, 3 blocks on 1 processor or 3 blocks on 3 processors you
       will get a different convergence rate due to the default option of -pc_asm_type restrict. Use
@@ -1259,6 +1479,16 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
          and set the options directly on the resulting KSP object (you can access its PC
          with KSPGetPC())
 
+     With -pc_asm_batch and several subdomains per process the subdomain matrices are placed on the diagonal of one
+     matrix that is factored and solved by the single KSP returned by PCASMGetSubKSP(). This replaces many small
+     solves by one large one, which the threaded triangular solves of -mat_aij_threads can then run concurrently.
+     It is only available with the additive local type.
+
+     With -pc_asm_pipeline the additive solve starts the restriction, solves the subdomains that lie entirely in the
+     rows of the process while the ghost values are in transit, and then solves the remaining subdomains. It pays off
+     when the restriction is communication bound, as with larger overlaps; the restricted and basic types give the same
+     result as without it, up to the order in which overlapping solutions are summed.
+
    Level: beginner
 
    Concepts: additive Schwarz method
@@ -7,6 +7,7 @@
 
 static PetscErrorCode PCSetUp_BJacobi_Singleblock(PC,Mat,Mat);
 static PetscErrorCode PCSetUp_BJacobi_Multiblock(PC,Mat,Mat);
+static PetscErrorCode PCSetUp_BJacobi_Batch(PC,Mat,Mat);
 static PetscErrorCode PCSetUp_BJacobi_Multiproc(PC);
 
 static PetscErrorCode PCSetUp_BJacobi(PC pc)
@@ -134,6 +135,8 @@ end_1:
   */
   if (jac->n_local == 1) {
     ierr = PCSetUp_BJacobi_Singleblock(pc,mat,pmat);CHKERRQ(ierr);
+  } else if (jac->batch) {
+    ierr = PCSetUp_BJacobi_Batch(pc,mat,pmat);CHKERRQ(ierr);
   } else {
     ierr = PCSetUp_BJacobi_Multiblock(pc,mat,pmat);CHKERRQ(ierr);
   }
@@ -167,10 +170,12 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PetscOptionItems *PetscOptionsObj
   if (flg) {
     ierr = PCBJacobiSetTotalBlocks(pc,blocks,NULL);CHKERRQ(ierr);
   }
-  if (jac->ksp) {
+  if (!jac->ksp) {
+    ierr = PetscOptionsBool("-pc_bjacobi_batch","Solve the blocks of each process as one block diagonal matrix","None",jac->batch,&jac->batch,NULL);CHKERRQ(ierr);
+  } else {
     /* The sub-KSP has already been set up (e.g., PCSetUp_BJacobi_Singleblock), but KSPSetFromOptions was not called
      * unless we had already been called. */
-    for (i=0; i<jac->n_local; i++) {
+    for (i=0; i<(jac->batch ? 1 : jac->n_local); i++) {
       ierr = KSPSetFromOptions(jac->ksp[i]);CHKERRQ(ierr);
     }
   }
@@ -198,6 +203,9 @@ static PetscErrorCode PCView_BJacobi(PC pc,PetscViewer viewer)
       ierr = PetscViewerASCIIPrintf(viewer,"  using Amat local matrix, number of blocks = %D\n",jac->n);CHKERRQ(ierr);
     }
     ierr = PetscViewerASCIIPrintf(viewer,"  number of blocks = %D\n",jac->n);CHKERRQ(ierr);
+    if (jac->batch) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  the blocks of each process are solved together as one block diagonal matrix\n");CHKERRQ(ierr);
+    }
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
     if (jac->same_local_solves) {
       ierr = PetscViewerASCIIPrintf(viewer,"  Local solve is same for all blocks, in the following KSP and PC objects:\n");CHKERRQ(ierr);
@@ -227,7 +235,7 @@ static PetscErrorCode PCView_BJacobi(PC pc,PetscViewer viewer)
                                                 rank,jac->n_local,jac->first_local);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
       ierr = PetscViewerGetSubViewer(viewer,PETSC_COMM_SELF,&sviewer);CHKERRQ(ierr);
-      for (i=0; i<jac->n_local; i++) {
+      for (i=0; i<(jac->batch ? 1 : jac->n_local); i++) {
         ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] local block number %D\n",rank,i);CHKERRQ(ierr);
         ierr = KSPView(jac->ksp[i],sviewer);CHKERRQ(ierr);
         ierr = PetscViewerASCIISynchronizedPrintf(viewer,"- - - - - - - - - - - - - - - - - -\n");CHKERRQ(ierr);
@@ -269,7 +277,7 @@ static PetscErrorCode  PCBJacobiGetSubKSP_BJacobi(PC pc,PetscInt *n_local,PetscI
   PetscFunctionBegin;
   if (!pc->setupcalled) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_WRONGSTATE,"Must call KSPSetUp() or PCSetUp() first");
 
-  if (n_local) *n_local = jac->n_local;
+  if (n_local) *n_local = jac->batch ? 1 : jac->n_local;
   if (first_local) *first_local = jac->first_local;
   *ksp                   = jac->ksp;
   jac->same_local_solves = PETSC_FALSE;        /* Assume that local solves are now different;
@@ -512,7 +520,8 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
    Options Database Keys:
 +  -pc_use_amat - use Amat to apply block of operator in inner Krylov method
--  -pc_bjacobi_blocks <n> - use n total blocks
+.  -pc_bjacobi_blocks <n> - use n total blocks
+-  -pc_bjacobi_batch - solve all the blocks of a process with one KSP on the block diagonal matrix of the blocks
 
    Notes: Each processor can have one or more blocks, or a single block can be shared by several processes. Defaults to one block per processor.
 
@@ -529,6 +538,12 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
      The options prefix for each block is sub_, for example -sub_pc_type lu.
 
+     With -pc_bjacobi_batch and several blocks per process the blocks are placed on the diagonal of one matrix that
+         is factored and solved once, removing the cost of one KSP per block. With -sub_ksp_type preonly this gives the
+         same preconditioner; a sub Krylov method instead iterates on all the blocks at once. With -mat_aij_threads the
+         triangular solves of the factor run the independent blocks on concurrent threads. PCBJacobiGetSubKSP() then
+         returns the single KSP, and -pc_use_amat is not supported.
+
      When multiple processes share a single block, each block encompasses exactly all the unknowns owned its set of processes.
 
    Level: beginner
@@ -1111,6 +1126,167 @@ static PetscErrorCode PCSetUp_BJacobi_Multiblock(PC pc,Mat mat,Mat pmat)
   PetscFunctionReturn(0);
 }
 
+/* ---------------------------------------------------------------------------------------------*/
+/*
+      These are for multiple blocks per processor that are placed on the diagonal of one matrix and
+   solved with a single KSP
+*/
+static PetscErrorCode PCReset_BJacobi_Batch(PC pc)
+{
+  PC_BJacobi       *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batch *bjac = (PC_BJacobi_Batch*)jac->data;
+  PetscErrorCode   ierr;
+  PetscInt         i;
+
+  PetscFunctionBegin;
+  ierr = KSPReset(jac->ksp[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&bjac->x);CHKERRQ(ierr);
+  ierr = VecDestroy(&bjac->y);CHKERRQ(ierr);
+  if (bjac->pmat) {ierr = MatDestroyMatrices(jac->n_local,&bjac->pmat);CHKERRQ(ierr);}
+  ierr = MatDestroy(&bjac->bpmat);CHKERRQ(ierr);
+  for (i=0; i<jac->n_local; i++) {
+    ierr = ISDestroy(&bjac->is[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(jac->l_lens);CHKERRQ(ierr);
+  ierr = PetscFree(jac->g_lens);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCDestroy_BJacobi_Batch(PC pc)
+{
+  PC_BJacobi       *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batch *bjac = (PC_BJacobi_Batch*)jac->data;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PCReset_BJacobi_Batch(pc);CHKERRQ(ierr);
+  ierr = KSPDestroy(&jac->ksp[0]);CHKERRQ(ierr);
+  ierr = PetscFree(jac->ksp);CHKERRQ(ierr);
+  ierr = PetscFree(bjac->is);CHKERRQ(ierr);
+  ierr = PetscFree(bjac);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApply_BJacobi_Batch(PC pc,Vec x,Vec y)
+{
+  PetscErrorCode   ierr;
+  PC_BJacobi       *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batch *bjac = (PC_BJacobi_Batch*)jac->data;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalVectorRead(x,bjac->x);CHKERRQ(ierr);
+  ierr = VecGetLocalVector(y,bjac->y);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PC_ApplyOnBlocks,jac->ksp[0],bjac->x,bjac->y,0);CHKERRQ(ierr);
+  ierr = KSPSolve(jac->ksp[0],bjac->x,bjac->y);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(PC_ApplyOnBlocks,jac->ksp[0],bjac->x,bjac->y,0);CHKERRQ(ierr);
+  ierr = VecRestoreLocalVectorRead(x,bjac->x);CHKERRQ(ierr);
+  ierr = VecRestoreLocalVector(y,bjac->y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyTranspose_BJacobi_Batch(PC pc,Vec x,Vec y)
+{
+  PetscErrorCode   ierr;
+  PC_BJacobi       *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batch *bjac = (PC_BJacobi_Batch*)jac->data;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalVectorRead(x,bjac->x);CHKERRQ(ierr);
+  ierr = VecGetLocalVector(y,bjac->y);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PC_ApplyTransposeOnBlocks,jac->ksp[0],bjac->x,bjac->y,0);CHKERRQ(ierr);
+  ierr = KSPSolveTranspose(jac->ksp[0],bjac->x,bjac->y);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(PC_ApplyTransposeOnBlocks,jac->ksp[0],bjac->x,bjac->y,0);CHKERRQ(ierr);
+  ierr = VecRestoreLocalVectorRead(x,bjac->x);CHKERRQ(ierr);
+  ierr = VecRestoreLocalVector(y,bjac->y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCSetUp_BJacobi_Batch(PC pc,Mat mat,Mat pmat)
+{
+  PC_BJacobi       *jac = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batch *bjac = (PC_BJacobi_Batch*)jac->data;
+  PetscErrorCode   ierr;
+  PetscInt         i,start,n_local = jac->n_local;
+  const char       *prefix,*pprefix;
+  KSP              ksp;
+  MatReuse         scall;
+  PetscBool        wasSetup = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  if (pc->useAmat) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot use -pc_use_amat with -pc_bjacobi_batch");
+  if (!pc->setupcalled) {
+    scall = MAT_INITIAL_MATRIX;
+
+    if (!jac->ksp) {
+      wasSetup = PETSC_FALSE;
+
+      ierr = KSPCreate(PETSC_COMM_SELF,&ksp);CHKERRQ(ierr);
+      ierr = KSPSetErrorIfNotConverged(ksp,pc->erroriffailure);CHKERRQ(ierr);
+      ierr = PetscObjectIncrementTabLevel((PetscObject)ksp,(PetscObject)pc,1);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPSetType(ksp,KSPPREONLY);CHKERRQ(ierr);
+      ierr = PCGetOptionsPrefix(pc,&prefix);CHKERRQ(ierr);
+      ierr = KSPSetOptionsPrefix(ksp,prefix);CHKERRQ(ierr);
+      ierr = KSPAppendOptionsPrefix(ksp,"sub_");CHKERRQ(ierr);
+
+      pc->ops->reset          = PCReset_BJacobi_Batch;
+      pc->ops->destroy        = PCDestroy_BJacobi_Batch;
+      pc->ops->apply          = PCApply_BJacobi_Batch;
+      pc->ops->applytranspose = PCApplyTranspose_BJacobi_Batch;
+      pc->ops->setuponblocks  = PCSetUpOnBlocks_BJacobi_Singleblock;
+
+      ierr        = PetscMalloc1(1,&jac->ksp);CHKERRQ(ierr);
+      jac->ksp[0] = ksp;
+
+      ierr      = PetscNewLog(pc,&bjac);CHKERRQ(ierr);
+      ierr      = PetscMalloc1(n_local,&bjac->is);CHKERRQ(ierr);
+      ierr      = PetscLogObjectMemory((PetscObject)pc,n_local*sizeof(IS));CHKERRQ(ierr);
+      jac->data = (void*)bjac;
+    } else {
+      ksp  = jac->ksp[0];
+      bjac = (PC_BJacobi_Batch*)jac->data;
+    }
+
+    start = 0;
+    for (i=0; i<n_local; i++) {
+      ierr   = ISCreateStride(PETSC_COMM_SELF,jac->l_lens[i],start,1,&bjac->is[i]);CHKERRQ(ierr);
+      ierr   = PetscLogObjectParent((PetscObject)pc,(PetscObject)bjac->is[i]);CHKERRQ(ierr);
+      start += jac->l_lens[i];
+    }
+    /* the arrays are provided with VecGetLocalVector() just before the solve */
+    ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,1,start,NULL,&bjac->x);CHKERRQ(ierr);
+    ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,1,start,NULL,&bjac->y);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)bjac->x);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)bjac->y);CHKERRQ(ierr);
+  } else {
+    ksp  = jac->ksp[0];
+    bjac = (PC_BJacobi_Batch*)jac->data;
+    if (pc->flag == DIFFERENT_NONZERO_PATTERN) {
+      ierr  = MatDestroyMatrices(n_local,&bjac->pmat);CHKERRQ(ierr);
+      ierr  = MatDestroy(&bjac->bpmat);CHKERRQ(ierr);
+      scall = MAT_INITIAL_MATRIX;
+    } else scall = MAT_REUSE_MATRIX;
+  }
+
+  ierr = MatCreateSubMatrices(pmat,n_local,bjac->is,bjac->is,scall,&bjac->pmat);CHKERRQ(ierr);
+  /* Return control to the user so that the submatrices can be modified (e.g., to apply
+     different boundary conditions for the submatrices than for the global problem) */
+  ierr = PCModifySubMatrices(pc,n_local,bjac->is,bjac->is,bjac->pmat,pc->modifysubmatricesP);CHKERRQ(ierr);
+  ierr = PCCreateBlockDiagonal_Private(n_local,bjac->pmat,scall,&bjac->bpmat);CHKERRQ(ierr);
+  if (scall == MAT_INITIAL_MATRIX) {
+    ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)bjac->bpmat);CHKERRQ(ierr);
+    ierr = PetscObjectGetOptionsPrefix((PetscObject)pmat,&pprefix);CHKERRQ(ierr);
+    ierr = PetscObjectSetOptionsPrefix((PetscObject)bjac->bpmat,pprefix);CHKERRQ(ierr);
+  }
+  ierr = KSPSetOperators(ksp,bjac->bpmat,bjac->bpmat);CHKERRQ(ierr);
+  if (!wasSetup && pc->setfromoptionscalled) {
+    /* If PCSetFromOptions_BJacobi is called later, KSPSetFromOptions will be called at that time. */
+    ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /* ---------------------------------------------------------------------------------------------*/
 /*
       These are for a single block with multiple processes;
@@ -21,6 +21,7 @@ typedef struct {
   PetscInt     *l_lens;           /* lens of each block */
   PetscInt     *g_lens;
   PetscSubcomm psubcomm;          /* for multiple processors per block */
+  PetscBool    batch;             /* solve the blocks of a process together as one block diagonal matrix */
 } PC_BJacobi;
 
 /*
@@ -35,6 +36,14 @@ typedef struct {
   IS       *is;                       /* for gathering the submatrices */
 } PC_BJacobi_Multiblock;
 
+/*  This is for multiple blocks per processor solved by one KSP */
+typedef struct {
+  Vec      x,y;                       /* work vectors for the solve on all the blocks */
+  Mat      *pmat;                     /* submatrices for each block */
+  Mat      bpmat;                     /* the submatrices placed on the diagonal of one matrix */
+  IS       *is;                       /* for gathering the submatrices */
+} PC_BJacobi_Batch;
+
 /*  This is for a single block per processor */
 typedef struct {
   Vec x,y;
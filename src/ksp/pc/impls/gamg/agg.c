@@ -12,6 +12,7 @@ typedef struct {
   PetscInt  nsmooths;
   PetscBool sym_graph;
   PetscInt  square_graph;
+  PetscBool square_graph_mis2; /* aggregate with a distance 2 MIS instead of squaring the graph */
 } PC_GAMG_AGG;
 
 /*@
@@ -107,7 +108,7 @@ static PetscErrorCode PCGAMGSetSymGraph_AGG(PC pc, PetscBool n)
 
    Concepts: Aggregation AMG preconditioner
 
-.seealso: PCGAMGSetSymGraph()
+.seealso: PCGAMGSetSymGraph(), PCGAMGSetSquareGraphMIS2()
 @*/
 PetscErrorCode PCGAMGSetSquareGraph(PC pc, PetscInt n)
 {
@@ -130,6 +131,50 @@ static PetscErrorCode PCGAMGSetSquareGraph_AGG(PC pc, PetscInt n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetSquareGraphMIS2 - On the levels where the graph is squared aggregate with a maximal independent set at distance 2 of the graph instead
+
+   Not Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE or PETSC_FALSE
+
+   Options Database Key:
+.  -pc_gamg_square_graph_mis2 <true,default=false> - use MATCOARSENMISK at distance 2 on the levels given by -pc_gamg_square_graph
+
+   Notes: the aggregates are about as large as those of the squared graph, but neither the square nor the smoothing of the
+   aggregates on it are computed. The coarsener type is set to MATCOARSENMISK on these levels, its other options are taken
+   from the options database.
+
+   Level: intermediate
+
+   Concepts: Aggregation AMG preconditioner
+
+.seealso: PCGAMGSetSquareGraph(), MATCOARSENMISK, MatCoarsenMISKSetDistance()
+@*/
+PetscErrorCode PCGAMGSetSquareGraphMIS2(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,n,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetSquareGraphMIS2_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetSquareGraphMIS2_AGG(PC pc, PetscBool n)
+{
+  PC_MG       *mg          = (PC_MG*)pc->data;
+  PC_GAMG     *pc_gamg     = (PC_GAMG*)mg->innerctx;
+  PC_GAMG_AGG *pc_gamg_agg = (PC_GAMG_AGG*)pc_gamg->subctx;
+
+  PetscFunctionBegin;
+  pc_gamg_agg->square_graph_mis2 = n;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCSetFromOptions_GAMG_AGG(PetscOptionItems *PetscOptionsObject,PC pc)
 {
   PetscErrorCode ierr;
@@ -143,6 +188,7 @@ static PetscErrorCode PCSetFromOptions_GAMG_AGG(PetscOptionItems *PetscOptionsOb
     ierr = PetscOptionsInt("-pc_gamg_agg_nsmooths","smoothing steps for smoothed aggregation, usually 1","PCGAMGSetNSmooths",pc_gamg_agg->nsmooths,&pc_gamg_agg->nsmooths,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_sym_graph","Set for asymmetric matrices","PCGAMGSetSymGraph",pc_gamg_agg->sym_graph,&pc_gamg_agg->sym_graph,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsInt("-pc_gamg_square_graph","Number of levels to square graph for faster coarsening and lower coarse grid complexity","PCGAMGSetSquareGraph",pc_gamg_agg->square_graph,&pc_gamg_agg->square_graph,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-pc_gamg_square_graph_mis2","Aggregate with a distance 2 maximal independent set instead of squaring the graph","PCGAMGSetSquareGraphMIS2",pc_gamg_agg->square_graph_mis2,&pc_gamg_agg->square_graph_mis2,NULL);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -840,7 +886,7 @@ static PetscErrorCode PCView_GAMG_AGG(PC pc,PetscViewer viewer)
   PetscFunctionBegin;
   ierr = PetscViewerASCIIPrintf(viewer,"      AGG specific options\n");CHKERRQ(ierr);
   ierr = PetscViewerASCIIPrintf(viewer,"        Symmetric graph %s\n",pc_gamg_agg->sym_graph ? "true" : "false");CHKERRQ(ierr);
-  ierr = PetscViewerASCIIPrintf(viewer,"        Number of levels to square graph %D\n",pc_gamg_agg->square_graph);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"        Number of levels to square graph %D%s\n",pc_gamg_agg->square_graph,pc_gamg_agg->square_graph_mis2 ? " (distance 2 MIS)" : "");CHKERRQ(ierr);
   ierr = PetscViewerASCIIPrintf(viewer,"        Number smoothing steps %D\n",pc_gamg_agg->nsmooths);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -910,6 +956,7 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   PetscReal      hashfact;
   PetscInt       iSwapIndex;
   PetscRandom    random;
+  PetscBool      mis2 = PETSC_FALSE;
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(PC_GAMGCoarsen_AGG,0,0,0,0);CHKERRQ(ierr);
@@ -920,7 +967,11 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   if (bs != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"bs %D must be 1",bs);
   nloc = n/bs;
 
-  if (pc_gamg->current_level < pc_gamg_agg->square_graph) {
+  if (pc_gamg->current_level < pc_gamg_agg->square_graph && pc_gamg_agg->square_graph_mis2) {
+    ierr  = PetscInfo2(a_pc,"Distance 2 MIS on level %d of %d to square\n",pc_gamg->current_level+1,pc_gamg_agg->square_graph);CHKERRQ(ierr);
+    Gmat2 = Gmat1;
+    mis2  = PETSC_TRUE;
+  } else if (pc_gamg->current_level < pc_gamg_agg->square_graph) {
     ierr = PetscInfo2(a_pc,"Square Graph on level %d of %d to square\n",pc_gamg->current_level+1,pc_gamg_agg->square_graph);CHKERRQ(ierr);
     ierr = MatTransposeMatMult(Gmat1, Gmat1, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Gmat2);CHKERRQ(ierr);
   } else Gmat2 = Gmat1;
@@ -950,6 +1001,10 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET4],0,0,0,0);CHKERRQ(ierr);
 #endif
   ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
+  if (mis2) {
+    ierr = MatCoarsenSetType(crs, MATCOARSENMISK);CHKERRQ(ierr);
+    ierr = MatCoarsenMISKSetDistance(crs, 2);CHKERRQ(ierr);
+  }
   ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
   ierr = MatCoarsenSetGreedyOrdering(crs, perm);CHKERRQ(ierr);
   ierr = MatCoarsenSetAdjacency(crs, Gmat2);CHKERRQ(ierr);
@@ -1255,14 +1310,16 @@ PetscErrorCode  PCCreateGAMG_AGG(PC pc)
   pc_gamg->ops->createdefaultdata = PCSetData_AGG;
   pc_gamg->ops->view              = PCView_GAMG_AGG;
 
-  pc_gamg_agg->square_graph = 1;
-  pc_gamg_agg->sym_graph    = PETSC_FALSE;
+  pc_gamg_agg->square_graph      = 1;
+  pc_gamg_agg->square_graph_mis2 = PETSC_FALSE;
+  pc_gamg_agg->sym_graph         = PETSC_FALSE;
   pc_gamg_agg->nsmooths     = 1;
 
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNSmooths_C",PCGAMGSetNSmooths_AGG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetSymGraph_C",PCGAMGSetSymGraph_AGG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetSquareGraph_C",PCGAMGSetSquareGraph_AGG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetSquareGraphMIS2_C",PCGAMGSetSquareGraphMIS2_AGG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSetCoordinates_C",PCSetCoordinates_AGG);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
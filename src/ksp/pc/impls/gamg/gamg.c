@@ -4,6 +4,7 @@
 #include <petsc/private/matimpl.h>
 #include <../src/ksp/pc/impls/gamg/gamg.h>           /*I "petscpc.h" I*/
 #include <../src/ksp/pc/impls/bjacobi/bjacobi.h> /* Hack to access same_local_solves */
+#include <petsctime.h>
 
 #if defined PETSC_GAMG_USE_LOG
 PetscLogEvent petsc_gamg_setup_events[NUM_SET];
@@ -33,11 +34,139 @@ PetscErrorCode PCReset_GAMG(PC pc)
   PetscErrorCode ierr;
   PC_MG          *mg      = (PC_MG*)pc->data;
   PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  PetscInt       level;
 
   PetscFunctionBegin;
   if (pc_gamg->data) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_PLIB,"This should not happen, cleaned up in SetUp\n");
   pc_gamg->data_sz = 0;
   ierr = PetscFree(pc_gamg->orig_data);CHKERRQ(ierr);
+  ierr = MatDestroy(&pc_gamg->Aref);CHKERRQ(ierr);
+  for (level=0; level<PETSC_GAMG_MAXLEVELS; level++) {
+    ierr = MatDestroy(&pc_gamg->Ptent[level]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*
+   PCGAMGPhaseBegin_Private/PCGAMGPhaseEnd_Private - time a phase of the setup of the current level and, with
+   -pc_gamg_log_levels, log it as the event PCGAMG<phase>_L<level>. The events are registered when first used so
+   that only the levels that exist appear in -log_view.
+*/
+static const char *const PCGAMGPhaseNames[] = {"Graph","Coarsen","Prol","OptProl","PtAP","Repart"};
+
+static PetscErrorCode PCGAMGPhaseBegin_Private(PC pc,PCGAMGPhase phase)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_LOG)
+  if (pc_gamg->log_levels) {
+    char name[64];
+
+    ierr = PetscSNPrintf(name,sizeof(name),"PCGAMG%s_L%D",PCGAMGPhaseNames[phase],pc_gamg->current_level);CHKERRQ(ierr);
+    ierr = PetscLogEventRegister(name,PC_CLASSID,&pc_gamg->phase_event);CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(pc_gamg->phase_event,0,0,0,0);CHKERRQ(ierr);
+  }
+#endif
+  ierr = PetscMallocGetCurrentUsage(&pc_gamg->phase_alloc0);CHKERRQ(ierr);
+  ierr = PetscTime(&pc_gamg->phase_t0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGPhaseEnd_Private(PC pc,PCGAMGPhase phase)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  PetscInt       level    = pc_gamg->current_level;
+  PetscLogDouble t,alloc;
+
+  PetscFunctionBegin;
+  ierr = PetscTime(&t);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&alloc);CHKERRQ(ierr);
+  pc_gamg->phase_time[level][phase]  += t - pc_gamg->phase_t0;
+  pc_gamg->phase_alloc[level][phase] += alloc - pc_gamg->phase_alloc0;
+#if defined(PETSC_USE_LOG)
+  if (pc_gamg->log_levels) {ierr = PetscLogEventEnd(pc_gamg->phase_event,0,0,0,0);CHKERRQ(ierr);}
+#endif
+  PetscFunctionReturn(0);
+}
+
+/* records the size of the operator of a level */
+static PetscErrorCode PCGAMGSetLevelInfo_Private(PC pc,PetscInt level,Mat A,PetscMPIInt nactive)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  MatInfo        info;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,&pc_gamg->level_rows[level],NULL);CHKERRQ(ierr);
+  ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+  pc_gamg->level_nnz[level]     = info.nz_used;
+  pc_gamg->level_mem[level]     = info.memory;
+  pc_gamg->level_nactive[level] = nactive;
+  PetscFunctionReturn(0);
+}
+
+/*
+   PCGAMGSetUpReport_Private - writes the cost of the last setup as comma separated values, one line per level:
+   the size of its operator, then the time (maximum over the processes) and the memory allocated and kept (sum
+   over the processes, zero unless PETSc traces its allocations) by each phase that coarsened it.
+*/
+static PetscErrorCode PCGAMGSetUpReport_Private(PC pc,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PC_MG          *mg      = (PC_MG*)pc->data;
+  PC_GAMG        *pc_gamg = (PC_GAMG*)mg->innerctx;
+  PetscLogDouble time[PETSC_GAMG_MAXLEVELS][PCGAMG_NUM_PHASES],alloc[PETSC_GAMG_MAXLEVELS][PCGAMG_NUM_PHASES],nnz = 0.0,rows = 0.0,ttot = 0.0;
+  PetscInt       level,phase,nlevels = pc_gamg->Nlevels;
+  PetscBool      iascii;
+  MPI_Comm       comm;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(pc_gamg->phase_time,time,PETSC_GAMG_MAXLEVELS*PCGAMG_NUM_PHASES,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(pc_gamg->phase_alloc,alloc,PETSC_GAMG_MAXLEVELS*PCGAMG_NUM_PHASES,MPIU_PETSCLOGDOUBLE,MPI_SUM,comm);CHKERRQ(ierr);
+  for (level=0; level<nlevels; level++) {
+    nnz  += pc_gamg->level_nnz[level];
+    rows += pc_gamg->level_rows[level];
+    for (phase=0; phase<PCGAMG_NUM_PHASES; phase++) ttot += time[level][phase];
+  }
+  ierr = PetscViewerASCIIPrintf(viewer,"# PCGAMG setup %D: %D levels, operator complexity %g, grid complexity %g, time %g\n",pc_gamg->setup_count,nlevels,pc_gamg->level_nnz[0] > 0.0 ? nnz/pc_gamg->level_nnz[0] : 0.0,pc_gamg->level_rows[0] ? rows/pc_gamg->level_rows[0] : 0.0,ttot);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"level,rows,nnz,nnz_per_row,active_processes,memory");CHKERRQ(ierr);
+  for (phase=0; phase<PCGAMG_NUM_PHASES; phase++) {ierr = PetscViewerASCIIPrintf(viewer,",time_%s",PCGAMGPhaseNames[phase]);CHKERRQ(ierr);}
+  for (phase=0; phase<PCGAMG_NUM_PHASES; phase++) {ierr = PetscViewerASCIIPrintf(viewer,",alloc_%s",PCGAMGPhaseNames[phase]);CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIPrintf(viewer,"\n");CHKERRQ(ierr);
+  for (level=0; level<nlevels; level++) {
+    ierr = PetscViewerASCIIPrintf(viewer,"%D,%D,%.0f,%.1f,%d,%.0f",level,pc_gamg->level_rows[level],pc_gamg->level_nnz[level],pc_gamg->level_rows[level] ? pc_gamg->level_nnz[level]/pc_gamg->level_rows[level] : 0.0,pc_gamg->level_nactive[level],pc_gamg->level_mem[level]);CHKERRQ(ierr);
+    for (phase=0; phase<PCGAMG_NUM_PHASES; phase++) {ierr = PetscViewerASCIIPrintf(viewer,",%.4e",time[level][phase]);CHKERRQ(ierr);}
+    for (phase=0; phase<PCGAMG_NUM_PHASES; phase++) {ierr = PetscViewerASCIIPrintf(viewer,",%.0f",alloc[level][phase]);CHKERRQ(ierr);}
+    ierr = PetscViewerASCIIPrintf(viewer,"\n");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetUpView_Private(PC pc)
+{
+  PetscErrorCode    ierr;
+  PetscViewer       viewer;
+  PetscViewerFormat format;
+  PetscBool         flg;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsGetViewer(PetscObjectComm((PetscObject)pc),((PetscObject)pc)->prefix,"-pc_gamg_setup_report",&viewer,&format,&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = PetscViewerPushFormat(viewer,format);CHKERRQ(ierr);
+    ierr = PCGAMGSetUpReport_Private(pc,viewer);CHKERRQ(ierr);
+    ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -73,7 +202,9 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
   ierr = MatGetBlockSize(Amat_fine, &f_bs);CHKERRQ(ierr);
+  ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_PTAP);CHKERRQ(ierr);
   ierr = MatPtAP(Amat_fine, Pold, MAT_INITIAL_MATRIX, 2.0, &Cmat);CHKERRQ(ierr);
+  ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_PTAP);CHKERRQ(ierr);
 
   /* set 'ncrs' (nodes), 'ncrs_eq' (equations)*/
   ierr = MatGetLocalSize(Cmat, &ncrs_eq, NULL);CHKERRQ(ierr);
@@ -104,6 +235,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
 
     nloc_old = ncrs_eq/cr_bs;
     if (ncrs_eq % cr_bs) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"ncrs_eq %D not divisible by cr_bs %D",ncrs_eq,cr_bs);
+    ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_REPART);CHKERRQ(ierr);
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET12],0,0,0,0);CHKERRQ(ierr);
 #endif
@@ -236,6 +368,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
 #if defined PETSC_GAMG_USE_LOG
         ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET12],0,0,0,0);CHKERRQ(ierr);
 #endif
+        ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_REPART);CHKERRQ(ierr);
         PetscFunctionReturn(0);
       }
 
@@ -394,6 +527,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
     ierr = ISDestroy(&new_eq_indices);CHKERRQ(ierr);
 
     *a_nactive_proc = new_size; /* output */
+    ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_REPART);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -420,12 +554,15 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   IS             *ASMLocalIDsArr[PETSC_GAMG_MAXLEVELS];
   PetscLogDouble nnz0=0.,nnztot=0.;
   MatInfo        info;
-  PetscBool      is_last = PETSC_FALSE;
+  PetscBool      is_last = PETSC_FALSE,keep_tent;
+  IS             colperm = NULL;
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscMemzero(pc_gamg->phase_time,sizeof(pc_gamg->phase_time));CHKERRQ(ierr);
+  ierr = PetscMemzero(pc_gamg->phase_alloc,sizeof(pc_gamg->phase_alloc));CHKERRQ(ierr);
 
   if (pc_gamg->setup_count++ > 0) {
     if ((PetscBool)(!pc_gamg->reuse_prol)) {
@@ -436,6 +573,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       PC_MG_Levels **mglevels = mg->levels;
       /* just do Galerkin grids */
       Mat          B,dA,dB;
+      PetscBool    resmooth = PETSC_FALSE;
 
       if (!pc->setupcalled) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PCSetUp() has not been called yet");
       if (pc_gamg->Nlevels > 1) {
@@ -444,7 +582,38 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
         /* (re)set to get dirty flag */
         ierr = KSPSetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,dA,dB);CHKERRQ(ierr);
 
+        /* smooth the kept tentative prolongators again if the operator has drifted from the one they were smoothed with */
+        if (pc_gamg->Aref) {
+          PetscReal nrm,drift;
+
+          ierr = MatNorm(pc_gamg->Aref,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+          ierr = MatAXPY(pc_gamg->Aref,-1.0,dB,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+          ierr = MatNorm(pc_gamg->Aref,NORM_FROBENIUS,&drift);CHKERRQ(ierr);
+          if (nrm > 0.0) drift /= nrm;
+          resmooth = (PetscBool)(drift > pc_gamg->refresh_drift);
+          if (resmooth) {
+            ierr = MatCopy(dB,pc_gamg->Aref,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+          } else {
+            ierr = MatAXPY(pc_gamg->Aref,1.0,dB,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+          }
+          ierr = PetscInfo3(pc,"Relative change of the operator %g, drift tolerance %g: %s\n",(double)drift,(double)pc_gamg->refresh_drift,resmooth ? "smoothing the prolongators again" : "keeping the prolongators");CHKERRQ(ierr);
+        }
+
         for (level=pc_gamg->Nlevels-2; level>=0; level--) {
+          /* the operator of mglevels[level] is the coarsening of GAMG level Nlevels-2-level */
+          pc_gamg->current_level = pc_gamg->Nlevels-2-level;
+          if (resmooth && pc_gamg->Ptent[pc_gamg->current_level+1]) {
+            Mat P;
+
+            ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_OPTPROL);CHKERRQ(ierr);
+            ierr = MatDuplicate(pc_gamg->Ptent[pc_gamg->current_level+1],MAT_COPY_VALUES,&P);CHKERRQ(ierr);
+            ierr = pc_gamg->ops->optprolongator(pc,dB,&P);CHKERRQ(ierr);
+            /* the operator has the nonzero pattern it was first smoothed with so the interpolation keeps its pattern */
+            ierr = MatCopy(P,mglevels[level+1]->interpolate,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+            ierr = MatDestroy(&P);CHKERRQ(ierr);
+            ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_OPTPROL);CHKERRQ(ierr);
+          }
+          ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_PTAP);CHKERRQ(ierr);
           /* the first time through the matrix structure has changed from repartitioning */
           if (pc_gamg->setup_count==2) {
             ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_INITIAL_MATRIX,1.0,&B);CHKERRQ(ierr);
@@ -455,12 +624,14 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
             ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&B);CHKERRQ(ierr);
             ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_REUSE_MATRIX,1.0,&B);CHKERRQ(ierr);
           }
+          ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_PTAP);CHKERRQ(ierr);
           ierr = KSPSetOperators(mglevels[level]->smoothd,B,B);CHKERRQ(ierr);
           dB   = B;
         }
       }
 
       ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
+      ierr = PCGAMGSetUpView_Private(pc);CHKERRQ(ierr);
       PetscFunctionReturn(0);
     }
   }
@@ -490,6 +661,13 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     pc_gamg->orig_data_cell_cols = pc_gamg->data_cell_cols;
   }
 
+  /* keep the tentative prolongators to smooth them again in later setups that reuse the hierarchy */
+  keep_tent = (PetscBool)(pc_gamg->reuse_prol && pc_gamg->refresh_drift >= 0.0 && pc_gamg->ops->optprolongator);
+  ierr      = MatDestroy(&pc_gamg->Aref);CHKERRQ(ierr);
+  for (level=0; level<PETSC_GAMG_MAXLEVELS; level++) {
+    ierr = MatDestroy(&pc_gamg->Ptent[level]);CHKERRQ(ierr);
+  }
+
   /* get basic dims */
   ierr = MatGetBlockSize(Pmat, &bs);CHKERRQ(ierr);
   ierr = MatGetSize(Pmat, &M, &N);CHKERRQ(ierr);
@@ -497,6 +675,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
   ierr = MatGetInfo(Pmat,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr); /* global reduction */
   nnz0   = info.nz_used;
   nnztot = info.nz_used;
+  ierr   = PCGAMGSetLevelInfo_Private(pc,0,Pmat,size);CHKERRQ(ierr);
   ierr = PetscInfo6(pc,"level %d) N=%D, n data rows=%d, n data cols=%d, nnz/row (ave)=%d, np=%d\n",0,M,pc_gamg->data_cell_rows,pc_gamg->data_cell_cols,(int)(nnz0/(PetscReal)M+0.5),size);CHKERRQ(ierr);
 
   /* Get A_i and R_i */
@@ -514,9 +693,15 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       PetscCoarsenData *agg_lists;
       Mat              Prol11;
 
+      ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_GRAPH);CHKERRQ(ierr);
       ierr = pc_gamg->ops->graph(pc,Aarr[level], &Gmat);CHKERRQ(ierr);
+      ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_GRAPH);CHKERRQ(ierr);
+      ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_COARSEN);CHKERRQ(ierr);
       ierr = pc_gamg->ops->coarsen(pc, &Gmat, &agg_lists);CHKERRQ(ierr);
+      ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_COARSEN);CHKERRQ(ierr);
+      ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_PROL);CHKERRQ(ierr);
       ierr = pc_gamg->ops->prolongator(pc,Aarr[level],Gmat,agg_lists,&Prol11);CHKERRQ(ierr);
+      ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_PROL);CHKERRQ(ierr);
 
       /* could have failed to create new level */
       if (Prol11) {
@@ -525,7 +710,10 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
 
         if (pc_gamg->ops->optprolongator) {
           /* smooth */
+          if (keep_tent) {ierr = MatDuplicate(Prol11,MAT_COPY_VALUES,&pc_gamg->Ptent[level1]);CHKERRQ(ierr);}
+          ierr = PCGAMGPhaseBegin_Private(pc,PCGAMG_PHASE_OPTPROL);CHKERRQ(ierr);
           ierr = pc_gamg->ops->optprolongator(pc, Aarr[level], &Prol11);CHKERRQ(ierr);
+          ierr = PCGAMGPhaseEnd_Private(pc,PCGAMG_PHASE_OPTPROL);CHKERRQ(ierr);
         }
 
         Parr[level1] = Prol11;
@@ -558,13 +746,29 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (is_last) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Is last ????????");
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels-1) is_last = PETSC_TRUE;
-    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last);CHKERRQ(ierr);
+    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, pc_gamg->Ptent[level1] ? &colperm : NULL, is_last);CHKERRQ(ierr);
+    if (colperm) { /* the coarse grid was redistributed, permute the columns of the kept tentative prolongator as those of the interpolation */
+      IS       findices;
+      PetscInt Istart,Iend;
+      Mat      Pnew;
+
+      ierr = MatGetOwnershipRange(pc_gamg->Ptent[level1],&Istart,&Iend);CHKERRQ(ierr);
+      ierr = ISCreateStride(comm,Iend-Istart,Istart,1,&findices);CHKERRQ(ierr);
+      ierr = MatGetBlockSize(Aarr[level],&qq);CHKERRQ(ierr);
+      ierr = ISSetBlockSize(findices,qq);CHKERRQ(ierr);
+      ierr = MatCreateSubMatrix(pc_gamg->Ptent[level1],findices,colperm,MAT_INITIAL_MATRIX,&Pnew);CHKERRQ(ierr);
+      ierr = ISDestroy(&findices);CHKERRQ(ierr);
+      ierr = ISDestroy(&colperm);CHKERRQ(ierr);
+      ierr = MatDestroy(&pc_gamg->Ptent[level1]);CHKERRQ(ierr);
+      pc_gamg->Ptent[level1] = Pnew;
+    }
 
 #if defined PETSC_GAMG_USE_LOG
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
 #endif
     ierr = MatGetSize(Aarr[level1], &M, &N);CHKERRQ(ierr); /* M is loop test variables */
     ierr = MatGetInfo(Aarr[level1], MAT_GLOBAL_SUM, &info);CHKERRQ(ierr);
+    ierr = PCGAMGSetLevelInfo_Private(pc,level1,Aarr[level1],nactivepe);CHKERRQ(ierr);
     nnztot += info.nz_used;
     ierr = PetscInfo5(pc,"%d) N=%D, n data cols=%d, nnz/row (ave)=%d, %d active pes\n",level1,M,pc_gamg->data_cell_cols,(int)(info.nz_used/(PetscReal)M),nactivepe);CHKERRQ(ierr);
 
@@ -579,6 +783,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     }
   } /* levels */
   ierr                  = PetscFree(pc_gamg->data);CHKERRQ(ierr);
+  if (keep_tent) {ierr = MatDuplicate(Pmat,MAT_COPY_VALUES,&pc_gamg->Aref);CHKERRQ(ierr);}
 
   ierr = PetscInfo2(pc,"%D levels, grid complexity = %g\n",level+1,nnztot/nnz0);CHKERRQ(ierr);
   pc_gamg->Nlevels = level + 1;
@@ -676,6 +881,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     ierr = KSPSetType(smoother, KSPPREONLY);CHKERRQ(ierr);
     ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
   }
+  ierr = PCGAMGSetUpView_Private(pc);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -868,6 +1074,50 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetRefreshDrift - Sets when the prolongators are smoothed again in setups that reuse the hierarchy
+
+   Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  drift - the relative change of the operator, in the Frobenius norm, since the prolongators were last smoothed above which they are smoothed again, or a negative value to never smooth them again
+
+   Options Database Key:
+.  -pc_gamg_refresh_drift <drift>
+
+   Level: intermediate
+
+   Notes: this has an effect only with PCGAMGSetReuseInterpolation(). The aggregates and the tentative prolongators of the first setup are then kept
+          and a new operator with the same nonzero pattern only costs the numeric Galerkin products and the numeric setup of the smoothers, unless
+          it differs from the one the prolongators were smoothed with by more than drift; then the kept tentative prolongators are also smoothed
+          with the new operators. Keeping them costs the memory of the tentative prolongators and of a copy of the fine grid operator.
+
+   Concepts: Unstructured multigrid preconditioner
+
+.seealso: PCGAMGSetReuseInterpolation()
+@*/
+PetscErrorCode PCGAMGSetRefreshDrift(PC pc, PetscReal drift)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveReal(pc,drift,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetRefreshDrift_C",(PC,PetscReal),(pc,drift));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetRefreshDrift_GAMG(PC pc, PetscReal drift)
+{
+  PC_MG   *mg      = (PC_MG*)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG*)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->refresh_drift = drift;
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCGAMGASMSetUseAggs - Have the PCGAMG smoother on each level use the aggregates defined by the coarsening process as the subdomains for the additive Schwarz preconditioner.
 
@@ -1202,6 +1452,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
     }
     ierr = PetscOptionsBool("-pc_gamg_repartition","Repartion coarse grids","PCGAMGSetRepartition",pc_gamg->repart,&pc_gamg->repart,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_reuse_interpolation","Reuse prolongation operator","PCGAMGReuseInterpolation",pc_gamg->reuse_prol,&pc_gamg->reuse_prol,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-pc_gamg_refresh_drift","Relative change of the operator above which reused prolongators are smoothed again (negative for never)","PCGAMGSetRefreshDrift",pc_gamg->refresh_drift,&pc_gamg->refresh_drift,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_asm_use_agg","Use aggregation aggregates for ASM smoother","PCGAMGASMSetUseAggs",pc_gamg->use_aggs_in_asm,&pc_gamg->use_aggs_in_asm,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver","Use parallel coarse grid solver (otherwise put last grid on one process)","PCGAMGSetUseParallelCoarseGridSolve",pc_gamg->use_parallel_coarse_grid_solver,&pc_gamg->use_parallel_coarse_grid_solver,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsInt("-pc_gamg_process_eq_limit","Limit (goal) on number of equations per process on coarse grids","PCGAMGSetProcEqLim",pc_gamg->min_eq_proc,&pc_gamg->min_eq_proc,NULL);CHKERRQ(ierr);
@@ -1215,6 +1466,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
       do {pc_gamg->threshold[i] = pc_gamg->threshold[i-1]*pc_gamg->threshold_scale;} while (++i<PETSC_GAMG_MAXLEVELS);
     }
     ierr = PetscOptionsInt("-pc_mg_levels","Set number of MG levels","PCGAMGSetNlevels",pc_gamg->Nlevels,&pc_gamg->Nlevels,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-pc_gamg_log_levels","Log each phase of the setup of each level as a separate event","None",pc_gamg->log_levels,&pc_gamg->log_levels,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsName("-pc_gamg_setup_report","Write the cost of each level and phase of the setup as comma separated values","None",&flag);CHKERRQ(ierr);
 
     /* set options for subtype */
     if (pc_gamg->ops->setfromoptions) {ierr = (*pc_gamg->ops->setfromoptions)(PetscOptionsObject,pc);CHKERRQ(ierr);}
@@ -1233,17 +1486,23 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
 +   -pc_gamg_type <type> - one of agg, geo, or classical
 .   -pc_gamg_repartition  <true,default=false> - repartition the degrees of freedom accross the coarse grids as they are determined
 .   -pc_gamg_reuse_interpolation <true,default=false> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations
+.   -pc_gamg_refresh_drift <drift,default=-1> - with reused interpolations smooth the kept tentative prolongators again when the operator changed more than drift
 .   -pc_gamg_asm_use_agg <true,default=false> - use the aggregates from the coasening process to defined the subdomains on each level for the PCASM smoother
 .   -pc_gamg_process_eq_limit <limit, default=50> - GAMG will reduce the number of MPI processes used directly on the coarse grids so that there are around <limit>
                                         equations on each process that has degrees of freedom
 .   -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 .   -pc_gamg_threshold[] <thresh,default=0> - Before aggregating the graph GAMG will remove small values from the graph on each level
--   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
+.   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
+.   -pc_gamg_log_levels - log the graph, coarsening, prolongator, prolongator smoothing, Galerkin product and repartitioning of each level
+                          as separate events PCGAMGGraph_L<level> ... PCGAMGRepart_L<level> in -log_view
+-   -pc_gamg_setup_report [viewer] - after each setup write, as comma separated values, the rows, nonzeros, processes and memory of the operator
+                          of each level with the time and memory allocation of each of these phases on that level
 
    Options Database Keys for default Aggregation:
 +  -pc_gamg_agg_nsmooths <nsmooth, default=1> - number of smoothing steps to use with smooth aggregation
 .  -pc_gamg_sym_graph <true,default=false> - symmetrize the graph before computing the aggregation
--  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+.  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+-  -pc_gamg_square_graph_mis2 <true,default=false> - on these levels aggregate with a distance 2 maximal independent set instead of squaring the graph
 
    Multigrid options:
 +  -pc_mg_cycles <v> - v or w, see PCMGSetCycleType()
@@ -1262,7 +1521,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
   Concepts: algebraic multigrid
 
 .seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
-           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation()
+           PCGAMGSetCoarseEqLim(), PCGAMGSetRepartition(), PCGAMGRegister(), PCGAMGSetReuseInterpolation(), PCGAMGASMSetUseAggs(), PCGAMGSetUseParallelCoarseGridSolve(), PCGAMGSetNlevels(), PCGAMGSetThreshold(), PCGAMGGetType(), PCGAMGSetReuseInterpolation(), PCGAMGSetRefreshDrift()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
@@ -1303,6 +1562,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetCoarseEqLim_C",PCGAMGSetCoarseEqLim_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRepartition_C",PCGAMGSetRepartition_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetReuseInterpolation_C",PCGAMGSetReuseInterpolation_GAMG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetRefreshDrift_C",PCGAMGSetRefreshDrift_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGASMSetUseAggs_C",PCGAMGASMSetUseAggs_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetUseParallelCoarseGridSolve_C",PCGAMGSetUseParallelCoarseGridSolve_GAMG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetThreshold_C",PCGAMGSetThreshold_GAMG);CHKERRQ(ierr);
@@ -1312,6 +1572,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNlevels_C",PCGAMGSetNlevels_GAMG);CHKERRQ(ierr);
   pc_gamg->repart           = PETSC_FALSE;
   pc_gamg->reuse_prol       = PETSC_FALSE;
+  pc_gamg->refresh_drift    = -1.0;
   pc_gamg->use_aggs_in_asm  = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->min_eq_proc      = 50;
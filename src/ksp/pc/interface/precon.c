@@ -1055,6 +1055,59 @@ PetscErrorCode  PCModifySubMatrices(PC pc,PetscInt nsub,const IS row[],const IS
   PetscFunctionReturn(0);
 }
 
+/*
+   PCCreateBlockDiagonal_Private - Places the sequential submatrices of a block preconditioner on the diagonal of one
+   SeqAIJ matrix, so that all the subdomains can be factored and solved by a single KSP.
+
+   With MAT_REUSE_MATRIX the submatrices must have the nonzero structure they had when B was created.
+*/
+PetscErrorCode PCCreateBlockDiagonal_Private(PetscInt n,Mat mats[],MatReuse scall,Mat *B)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,j,k,l,m,row,rstart,ncols,maxcols = 0,*nnz,*bcols = NULL;
+  const PetscInt    *cols;
+  const PetscScalar *vals;
+
+  PetscFunctionBegin;
+  for (i=0,m=0; i<n; i++) {
+    ierr = MatGetSize(mats[i],&k,NULL);CHKERRQ(ierr);
+    m   += k;
+  }
+  if (scall == MAT_INITIAL_MATRIX) {
+    ierr = PetscMalloc1(m,&nnz);CHKERRQ(ierr);
+    for (i=0,row=0; i<n; i++) {
+      ierr = MatGetSize(mats[i],&k,NULL);CHKERRQ(ierr);
+      for (j=0; j<k; j++,row++) {
+        ierr     = MatGetRow(mats[i],j,&ncols,NULL,NULL);CHKERRQ(ierr);
+        nnz[row] = ncols;
+        ierr     = MatRestoreRow(mats[i],j,&ncols,NULL,NULL);CHKERRQ(ierr);
+      }
+    }
+    ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,m,m,0,nnz,B);CHKERRQ(ierr);
+    ierr = PetscFree(nnz);CHKERRQ(ierr);
+  }
+  for (i=0,rstart=0; i<n; i++) {
+    ierr = MatGetSize(mats[i],&k,NULL);CHKERRQ(ierr);
+    for (j=0; j<k; j++) {
+      ierr = MatGetRow(mats[i],j,&ncols,&cols,&vals);CHKERRQ(ierr);
+      if (ncols > maxcols) {
+        ierr    = PetscFree(bcols);CHKERRQ(ierr);
+        maxcols = ncols;
+        ierr    = PetscMalloc1(maxcols,&bcols);CHKERRQ(ierr);
+      }
+      for (l=0; l<ncols; l++) bcols[l] = cols[l] + rstart;
+      row  = rstart + j;
+      ierr = MatSetValues(*B,1,&row,ncols,bcols,vals,INSERT_VALUES);CHKERRQ(ierr);
+      ierr = MatRestoreRow(mats[i],j,&ncols,&cols,&vals);CHKERRQ(ierr);
+    }
+    rstart += k;
+  }
+  ierr = PetscFree(bcols);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(*B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCSetOperators - Sets the matrix associated with the linear system and
    a (possibly) different one associated with the preconditioner.
@@ -0,0 +1,584 @@
+#include <petsc/private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+#define MISK_UNDECIDED 0
+#define MISK_SELECTED  1
+#define MISK_DELETED   2
+#define MISK_REMOVED   3
+
+typedef struct {
+  PetscInt distance;  /* 1 or 2 */
+  PetscInt nthreads;  /* OpenMP threads of the vertex sweeps */
+} MatCoarsen_MISK;
+
+/* vertices are ordered by their priority and then their global index; the layout is that of MPIU_2INT */
+typedef struct {
+  PetscInt prio,gid;
+} MISKKey;
+
+#define MISKKeyGreater(a,b) ((a).prio > (b).prio || ((a).prio == (b).prio && (a).gid > (b).gid))
+
+/*
+   The local graph: the diagonal block with local column indices, the off-diagonal block with ghost indices and the
+   state of the local and ghost vertices. The sweeps below only write the entries of their own vertex so that the
+   vertices are shared among threads without synchronization; a sweep that changes states first records its decisions
+   in flag[] and applies them in a second loop.
+*/
+typedef struct {
+  PetscInt       nloc,nghost,nt;
+  const PetscInt *ai,*aj,*bi,*bj;
+  MISKKey        *key,*gkey;
+  PetscInt       *state,*gstate;
+  PetscInt       *parent;        /* global index of the root of the aggregate of each local vertex, -1 if none yet */
+  MISKKey        *m,*gm;         /* largest key over the closed neighbourhood of each local and ghost vertex */
+  PetscBool      *flag;
+} MISKGraph;
+
+/* flag the vertices in state s that are adjacent to a selected vertex and set their parent to the one with the largest key */
+static void MISKAdjacentRoot_Private(MISKGraph *g,PetscInt s)
+{
+  PetscInt v;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static)
+#endif
+  for (v=0; v<g->nloc; v++) {
+    const MISKKey *best = NULL;
+    PetscInt      j;
+
+    g->flag[v] = PETSC_FALSE;
+    if (g->state[v] != s) continue;
+    for (j=g->ai[v]; j<g->ai[v+1]; j++) {
+      const PetscInt u = g->aj[j];
+      if (g->state[u] == MISK_SELECTED && (!best || MISKKeyGreater(g->key[u],*best))) best = &g->key[u];
+    }
+    if (g->nghost) {
+      for (j=g->bi[v]; j<g->bi[v+1]; j++) {
+        const PetscInt u = g->bj[j];
+        if (g->gstate[u] == MISK_SELECTED && (!best || MISKKeyGreater(g->gkey[u],*best))) best = &g->gkey[u];
+      }
+    }
+    if (best) {
+      g->parent[v] = best->gid;
+      g->flag[v]   = PETSC_TRUE;
+    }
+  }
+}
+
+/* applies the decisions of a sweep: the flagged vertices go to state s */
+static PetscInt MISKApplyFlags_Private(MISKGraph *g,PetscInt s)
+{
+  PetscInt v,n = 0;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static) reduction(+:n)
+#endif
+  for (v=0; v<g->nloc; v++) {
+    if (g->flag[v]) {
+      g->state[v] = s;
+      if (s == MISK_SELECTED) g->parent[v] = g->key[v].gid;
+      n++;
+    }
+  }
+  return n;
+}
+
+/* Luby step at distance 1: select the undecided vertices whose key is larger than that of all their undecided neighbours */
+static PetscInt MISKSelect1_Private(MISKGraph *g)
+{
+  PetscInt v;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static)
+#endif
+  for (v=0; v<g->nloc; v++) {
+    PetscBool sel = (PetscBool)(g->state[v] == MISK_UNDECIDED);
+    PetscInt  j;
+
+    for (j=g->ai[v]; sel && j<g->ai[v+1]; j++) {
+      const PetscInt u = g->aj[j];
+      if (u != v && g->state[u] == MISK_UNDECIDED && MISKKeyGreater(g->key[u],g->key[v])) sel = PETSC_FALSE;
+    }
+    if (g->nghost) {
+      for (j=g->bi[v]; sel && j<g->bi[v+1]; j++) {
+        const PetscInt u = g->bj[j];
+        if (g->gstate[u] == MISK_UNDECIDED && MISKKeyGreater(g->gkey[u],g->key[v])) sel = PETSC_FALSE;
+      }
+    }
+    g->flag[v] = sel;
+  }
+  return MISKApplyFlags_Private(g,MISK_SELECTED);
+}
+
+/* m[w] = the largest key of the vertices in state s in the closed neighbourhood of each local vertex w, prio -1 if none */
+static void MISKNeighbourhoodMax_Private(MISKGraph *g,PetscInt s)
+{
+  PetscInt w;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static)
+#endif
+  for (w=0; w<g->nloc; w++) {
+    MISKKey  best;
+    PetscInt j;
+
+    best.prio = -1; best.gid = -1;
+    if (g->state[w] == s) best = g->key[w];
+    for (j=g->ai[w]; j<g->ai[w+1]; j++) {
+      const PetscInt u = g->aj[j];
+      if (g->state[u] == s && MISKKeyGreater(g->key[u],best)) best = g->key[u];
+    }
+    if (g->nghost) {
+      for (j=g->bi[w]; j<g->bi[w+1]; j++) {
+        const PetscInt u = g->bj[j];
+        if (g->gstate[u] == s && MISKKeyGreater(g->gkey[u],best)) best = g->gkey[u];
+      }
+    }
+    g->m[w] = best;
+  }
+}
+
+/* the largest m[] over the closed neighbourhood of v */
+PETSC_STATIC_INLINE MISKKey MISKDistance2Max_Private(MISKGraph *g,PetscInt v)
+{
+  MISKKey  best = g->m[v];
+  PetscInt j;
+
+  for (j=g->ai[v]; j<g->ai[v+1]; j++) {
+    if (MISKKeyGreater(g->m[g->aj[j]],best)) best = g->m[g->aj[j]];
+  }
+  if (g->nghost) {
+    for (j=g->bi[v]; j<g->bi[v+1]; j++) {
+      if (MISKKeyGreater(g->gm[g->bj[j]],best)) best = g->gm[g->bj[j]];
+    }
+  }
+  return best;
+}
+
+/* Luby step at distance 2, with m[] of the undecided vertices: select the undecided vertices whose key is the largest within distance 2 */
+static PetscInt MISKSelect2_Private(MISKGraph *g)
+{
+  PetscInt v;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static)
+#endif
+  for (v=0; v<g->nloc; v++) {
+    g->flag[v] = PETSC_FALSE;
+    if (g->state[v] == MISK_UNDECIDED) g->flag[v] = (PetscBool)(MISKDistance2Max_Private(g,v).gid == g->key[v].gid);
+  }
+  return MISKApplyFlags_Private(g,MISK_SELECTED);
+}
+
+/* with m[] of the selected vertices: delete the undecided vertices within distance 2 of a selected vertex */
+static PetscInt MISKDelete2_Private(MISKGraph *g)
+{
+  PetscInt v;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static)
+#endif
+  for (v=0; v<g->nloc; v++) {
+    g->flag[v] = PETSC_FALSE;
+    if (g->state[v] == MISK_UNDECIDED) g->flag[v] = (PetscBool)(MISKDistance2Max_Private(g,v).prio >= 0);
+  }
+  return MISKApplyFlags_Private(g,MISK_DELETED);
+}
+
+static PetscInt MISKCountUndecided_Private(MISKGraph *g)
+{
+  PetscInt v,n = 0;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static) reduction(+:n)
+#endif
+  for (v=0; v<g->nloc; v++) n += (g->state[v] == MISK_UNDECIDED);
+  return n;
+}
+
+/*
+   Attaches the vertices deleted at distance 2 to an aggregate through a neighbour that is a root or adjacent to one.
+   A vertex is only attached when it is a ghost of the process of the root, that is when the neighbour is owned by
+   that process, since the aggregates are built from the rows and ghosts of the graph. The rest become roots and
+   take their local neighbours that are not needed to connect another aggregate.
+   gok[u] tells if ghost u and the root of its aggregate, gparent[u], are owned by the same process.
+*/
+static PetscInt MISKAttachDistance2_Private(MISKGraph *g,const PetscInt gparent[],const PetscBool gok[],PetscInt my0,PetscInt Iend)
+{
+  PetscInt v,nroots = 0;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(g->nt) schedule(static)
+#endif
+  for (v=0; v<g->nloc; v++) {
+    const MISKKey *best = NULL;
+    PetscInt      j,p = -1;
+
+    g->m[v].gid = -1;
+    g->flag[v]  = PETSC_FALSE;
+    if (g->state[v] != MISK_DELETED || g->parent[v] >= 0) continue;
+    for (j=g->ai[v]; j<g->ai[v+1]; j++) {
+      const PetscInt u = g->aj[j];
+      if (g->parent[u] >= my0 && g->parent[u] < Iend && (!best || MISKKeyGreater(g->key[u],*best))) {best = &g->key[u]; p = g->parent[u];}
+    }
+    if (g->nghost) {
+      for (j=g->bi[v]; j<g->bi[v+1]; j++) {
+        const PetscInt u = g->bj[j];
+        if (gparent[u] >= 0 && (gok[u] || (gparent[u] >= my0 && gparent[u] < Iend)) && (!best || MISKKeyGreater(g->gkey[u],*best))) {best = &g->gkey[u]; p = gparent[u];}
+      }
+    }
+    g->m[v].gid = p;
+  }
+  for (v=0; v<g->nloc; v++) {
+    if (g->state[v] == MISK_DELETED && g->parent[v] < 0 && g->m[v].gid >= 0) {
+      g->parent[v] = g->m[v].gid;
+      g->flag[v]   = PETSC_TRUE;
+    }
+  }
+  /* the remaining vertices are aggregated greedily with their local neighbours that are unassigned or were attached above */
+  for (v=0; v<g->nloc; v++) {
+    PetscInt j;
+
+    if (g->state[v] != MISK_DELETED || g->parent[v] >= 0) continue;
+    g->state[v]  = MISK_SELECTED;
+    g->parent[v] = g->key[v].gid;
+    nroots++;
+    for (j=g->ai[v]; j<g->ai[v+1]; j++) {
+      const PetscInt u = g->aj[j];
+      if (g->state[u] == MISK_DELETED && (g->parent[u] < 0 || g->flag[u])) {
+        g->parent[u] = g->key[v].gid;
+        g->flag[u]   = PETSC_FALSE;
+      }
+    }
+  }
+  return nroots;
+}
+
+/*
+   MatCoarsenApply_MISK - Luby's randomized maximal independent set at distance 1 or 2 and the strict aggregates around it.
+
+   In each round every undecided vertex whose key (its priority from the greedy ordering, then its global index) is
+   the largest among the undecided vertices within the distance is selected and the undecided vertices within the
+   distance of a selected vertex are deleted. At distance 1 the rounds repeat locally until no vertex can be decided
+   without new ghost states, so that a process exchanges states with its neighbours only when its boundary is blocked.
+   At distance 2 the largest key in the neighbourhood of each vertex is exchanged instead of the states of the
+   neighbours of the ghosts, which avoids forming the square of the graph.
+*/
+static PetscErrorCode MatCoarsenApply_MISK(MatCoarsen coarse)
+{
+  MatCoarsen_MISK  *misk = (MatCoarsen_MISK*)coarse->subctx;
+  Mat              Gmat  = coarse->graph;
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *matA,*matB = NULL;
+  Mat_MPIAIJ       *mpimat = NULL;
+  MISKGraph        g;
+  PetscSF          sf = NULL;
+  PetscLayout      layout;
+  PetscBool        isMPI,isAIJ,*gok = NULL;
+  const PetscInt   *perm_ix;
+  PetscInt         my0,Iend,k,v,j,n,nundecided,nrounds = 0,nremoved = 0,nselected = 0,nextra = 0,*gparent = NULL;
+  PetscMPIInt      owner,gowner;
+  MPI_Comm         comm;
+  PetscCoarsenData *agg_lists;
+
+  PetscFunctionBegin;
+  if (!coarse->strict_aggs) SETERRQ(PetscObjectComm((PetscObject)coarse),PETSC_ERR_SUP,"MATCOARSENMISK only builds strict aggregates");
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+  } else {
+    ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Require AIJ matrix.");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+
+  g.nloc   = Gmat->rmap->n;
+  g.nghost = mpimat ? mpimat->B->cmap->n : 0;
+  g.nt     = misk->nthreads;
+  g.ai     = matA->i;
+  g.aj     = matA->j;
+  g.bi     = matB ? matB->i : NULL;
+  g.bj     = matB ? matB->j : NULL;
+  ierr = PetscMalloc5(g.nloc,&g.key,g.nloc,&g.state,g.nloc,&g.parent,g.nloc,&g.m,g.nloc,&g.flag);CHKERRQ(ierr);
+  ierr = PetscMalloc5(g.nghost,&g.gkey,g.nghost,&g.gstate,g.nghost,&g.gm,g.nghost,&gparent,g.nghost,&gok);CHKERRQ(ierr);
+
+  /* the earlier a vertex is in the greedy ordering the higher its priority */
+  for (v=0; v<g.nloc; v++) {
+    g.key[v].prio = g.nloc - v;
+    g.key[v].gid  = my0 + v;
+  }
+  if (coarse->perm) {
+    ierr = ISGetLocalSize(coarse->perm,&n);CHKERRQ(ierr);
+    if (n != g.nloc) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Greedy ordering has %D entries, graph has %D local vertices",n,g.nloc);
+    ierr = ISGetIndices(coarse->perm,&perm_ix);CHKERRQ(ierr);
+    for (k=0; k<g.nloc; k++) g.key[perm_ix[k]].prio = g.nloc - k;
+    ierr = ISRestoreIndices(coarse->perm,&perm_ix);CHKERRQ(ierr);
+  }
+  /* isolated vertices are in no aggregate */
+  for (v=0; v<g.nloc; v++) {
+    g.state[v]  = MISK_REMOVED;
+    g.parent[v] = -1;
+    for (j=g.ai[v]; j<g.ai[v+1]; j++) if (g.aj[j] != v) g.state[v] = MISK_UNDECIDED;
+    if (g.nghost && g.bi[v+1] > g.bi[v]) g.state[v] = MISK_UNDECIDED;
+    if (g.state[v] == MISK_REMOVED) nremoved++;
+  }
+  if (mpimat) {
+    ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr = MatGetLayouts(Gmat,&layout,NULL);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf,layout,g.nghost,NULL,PETSC_COPY_VALUES,mpimat->garray);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf,MPIU_2INT,g.key,g.gkey);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_2INT,g.key,g.gkey);CHKERRQ(ierr);
+    for (j=0; j<g.nghost; j++) g.gstate[j] = MISK_UNDECIDED; /* isolated vertices are nobody's ghost */
+  }
+
+  if (misk->distance == 1) {
+    for (;;) {
+      nrounds++;
+      do {
+        MISKAdjacentRoot_Private(&g,MISK_UNDECIDED);
+        (void)MISKApplyFlags_Private(&g,MISK_DELETED);
+      } while (MISKSelect1_Private(&g));
+      nundecided = MISKCountUndecided_Private(&g);
+      if (!sf) break;
+      ierr = PetscSFBcastBegin(sf,MPIU_INT,g.state,g.gstate);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT,g.state,g.gstate);CHKERRQ(ierr);
+      MISKAdjacentRoot_Private(&g,MISK_UNDECIDED);
+      nundecided -= MISKApplyFlags_Private(&g,MISK_DELETED);
+      ierr = MPIU_Allreduce(MPI_IN_PLACE,&nundecided,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+      if (!nundecided) break;
+    }
+  } else {
+    for (;;) {
+      nrounds++;
+      MISKNeighbourhoodMax_Private(&g,MISK_UNDECIDED);
+      if (sf) {
+        ierr = PetscSFBcastBegin(sf,MPIU_2INT,g.m,g.gm);CHKERRQ(ierr);
+        ierr = PetscSFBcastEnd(sf,MPIU_2INT,g.m,g.gm);CHKERRQ(ierr);
+      }
+      (void)MISKSelect2_Private(&g);
+      if (sf) {
+        ierr = PetscSFBcastBegin(sf,MPIU_INT,g.state,g.gstate);CHKERRQ(ierr);
+        ierr = PetscSFBcastEnd(sf,MPIU_INT,g.state,g.gstate);CHKERRQ(ierr);
+      }
+      MISKNeighbourhoodMax_Private(&g,MISK_SELECTED);
+      if (sf) {
+        ierr = PetscSFBcastBegin(sf,MPIU_2INT,g.m,g.gm);CHKERRQ(ierr);
+        ierr = PetscSFBcastEnd(sf,MPIU_2INT,g.m,g.gm);CHKERRQ(ierr);
+      }
+      (void)MISKDelete2_Private(&g);
+      nundecided = MISKCountUndecided_Private(&g);
+      if (sf) {ierr = MPIU_Allreduce(MPI_IN_PLACE,&nundecided,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);}
+      if (!nundecided) break;
+    }
+    /* aggregates: the neighbours of the roots, then the vertices adjacent to those */
+    for (v=0; v<g.nloc; v++) if (g.state[v] == MISK_DELETED) g.parent[v] = -1;
+    MISKAdjacentRoot_Private(&g,MISK_DELETED);
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT,g.parent,gparent);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT,g.parent,gparent);CHKERRQ(ierr);
+      for (j=0; j<g.nghost; j++) {
+        gok[j] = PETSC_FALSE;
+        if (gparent[j] < 0) continue;
+        ierr   = PetscLayoutFindOwner(layout,gparent[j],&owner);CHKERRQ(ierr);
+        ierr   = PetscLayoutFindOwner(layout,g.gkey[j].gid,&gowner);CHKERRQ(ierr);
+        gok[j] = (PetscBool)(owner == gowner);
+      }
+    }
+    nextra = MISKAttachDistance2_Private(&g,gparent,gok,my0,Iend);
+  }
+
+  /* the strict aggregates with global indices: the local vertices and the ghosts whose root is local */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,g.parent,gparent);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,g.parent,gparent);CHKERRQ(ierr);
+  }
+  ierr = PetscCDCreate(g.nloc,&agg_lists);CHKERRQ(ierr);
+  for (v=0; v<g.nloc; v++) {
+    if (g.state[v] == MISK_SELECTED) {
+      ierr = PetscCDAppendID(agg_lists,v,my0+v);CHKERRQ(ierr);
+      nselected++;
+    }
+  }
+  for (v=0; v<g.nloc; v++) {
+    if (g.state[v] == MISK_DELETED && g.parent[v] >= my0 && g.parent[v] < Iend) {
+      ierr = PetscCDAppendID(agg_lists,g.parent[v]-my0,my0+v);CHKERRQ(ierr);
+    }
+  }
+  for (j=0; j<g.nghost; j++) {
+    if (gparent[j] >= my0 && gparent[j] < Iend) {
+      ierr = PetscCDAppendID(agg_lists,gparent[j]-my0,g.gkey[j].gid);CHKERRQ(ierr);
+    }
+  }
+  coarse->agg_lists = agg_lists;
+  ierr = PetscInfo6(Gmat,"distance %D: %D rounds, removed %D of %D vertices, %D selected, %D of them unreachable at distance 2\n",misk->distance,nrounds,nremoved,g.nloc,nselected,nextra);CHKERRQ(ierr);
+
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree5(g.key,g.state,g.parent,g.m,g.flag);CHKERRQ(ierr);
+  ierr = PetscFree5(g.gkey,g.gstate,g.gm,gparent,gok);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenSetFromOptions_MISK(PetscOptionItems *PetscOptionsObject,MatCoarsen coarse)
+{
+  MatCoarsen_MISK *misk = (MatCoarsen_MISK*)coarse->subctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"MISK coarsening options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_coarsen_misk_distance","Distance of the maximal independent set, 1 or 2","MatCoarsenMISKSetDistance",misk->distance,&misk->distance,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_coarsen_misk_threads","Number of OpenMP threads of the vertex sweeps","None",misk->nthreads,&misk->nthreads,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  if (misk->distance != 1 && misk->distance != 2) SETERRQ1(PetscObjectComm((PetscObject)coarse),PETSC_ERR_ARG_OUTOFRANGE,"Distance %D must be 1 or 2",misk->distance);
+  if (misk->nthreads < 1) SETERRQ1(PetscObjectComm((PetscObject)coarse),PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",misk->nthreads);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenView_MISK(MatCoarsen coarse,PetscViewer viewer)
+{
+  MatCoarsen_MISK *misk = (MatCoarsen_MISK*)coarse->subctx;
+  PetscErrorCode  ierr;
+  PetscBool       iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  MISK aggregator, distance %D, %D threads\n",misk->distance,misk->nthreads);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenDestroy_MISK(MatCoarsen coarse)
+{
+  MatCoarsen_MISK *misk = (MatCoarsen_MISK*)coarse->subctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscObjectComposeFunction((PetscObject)coarse,"MatCoarsenMISKSetDistance_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)coarse,"MatCoarsenMISKGetDistance_C",NULL);CHKERRQ(ierr);
+  ierr = PetscFree(misk);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenMISKSetDistance_MISK(MatCoarsen coarse,PetscInt k)
+{
+  MatCoarsen_MISK *misk = (MatCoarsen_MISK*)coarse->subctx;
+
+  PetscFunctionBegin;
+  if (k != 1 && k != 2) SETERRQ1(PetscObjectComm((PetscObject)coarse),PETSC_ERR_ARG_OUTOFRANGE,"Distance %D must be 1 or 2",k);
+  misk->distance = k;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatCoarsenMISKGetDistance_MISK(MatCoarsen coarse,PetscInt *k)
+{
+  MatCoarsen_MISK *misk = (MatCoarsen_MISK*)coarse->subctx;
+
+  PetscFunctionBegin;
+  *k = misk->distance;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatCoarsenMISKSetDistance - Sets the distance of the maximal independent set of a MATCOARSENMISK coarsener
+
+   Logically Collective on MatCoarsen
+
+   Input Parameters:
++  coarse - the coarsen context
+-  k - 1 for a maximal independent set of the graph, 2 for one of its square
+
+   Options Database Key:
+.  -mat_coarsen_misk_distance <k>
+
+   Notes: the aggregates at distance 2 are about as large as those of MATCOARSENMIS on the squared graph
+   but the square is never formed.
+
+   Level: advanced
+
+.seealso: MATCOARSENMISK, MatCoarsenMISKGetDistance()
+@*/
+PetscErrorCode MatCoarsenMISKSetDistance(MatCoarsen coarse,PetscInt k)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  PetscValidLogicalCollectiveInt(coarse,k,2);
+  ierr = PetscTryMethod(coarse,"MatCoarsenMISKSetDistance_C",(MatCoarsen,PetscInt),(coarse,k));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatCoarsenMISKGetDistance - Gets the distance of the maximal independent set of a MATCOARSENMISK coarsener
+
+   Not Collective
+
+   Input Parameter:
+.  coarse - the coarsen context
+
+   Output Parameter:
+.  k - the distance
+
+   Level: advanced
+
+.seealso: MATCOARSENMISK, MatCoarsenMISKSetDistance()
+@*/
+PetscErrorCode MatCoarsenMISKGetDistance(MatCoarsen coarse,PetscInt *k)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  PetscValidIntPointer(k,2);
+  ierr = PetscUseMethod(coarse,"MatCoarsenMISKGetDistance_C",(MatCoarsen,PetscInt*),(coarse,k));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENMISK - A coarsener that aggregates around a randomized (Luby) maximal independent set at distance 1 or 2
+
+   Options Database Keys:
++  -mat_coarsen_misk_distance <1> - 1 for a maximal independent set of the graph, 2 for one of its square, see MatCoarsenMISKSetDistance()
+-  -mat_coarsen_misk_threads <1> - number of OpenMP threads of the vertex sweeps (requires PETSc configured with --with-openmp)
+
+   Notes: unlike MATCOARSENMIS, whose processes decide their boundary vertices in the order of their ranks, every vertex
+   whose key is the largest among its undecided neighbours is decided in the same round, so the number of rounds, each with
+   one exchange of the ghost states and one reduction, grows with the logarithm of the size of the graph rather than with
+   the length of chains of processes. The vertices of a process are swept by threads and the greedy ordering given with
+   MatCoarsenSetGreedyOrdering() sets the priorities of the vertices. Only strict aggregates are built.
+
+   Level: beginner
+
+.keywords: Coarsen, create, context
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MatCoarsenCreate(), MATCOARSENMIS, MatCoarsenMISKSetDistance(), PCGAMGSetSquareGraphMIS2()
+
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MISK(MatCoarsen coarse)
+{
+  PetscErrorCode  ierr;
+  MatCoarsen_MISK *misk;
+
+  PetscFunctionBegin;
+  ierr           = PetscNewLog(coarse,&misk);CHKERRQ(ierr);
+  misk->distance = 1;
+  misk->nthreads = 1;
+  coarse->subctx = (void*)misk;
+
+  coarse->ops->apply          = MatCoarsenApply_MISK;
+  coarse->ops->setfromoptions = MatCoarsenSetFromOptions_MISK;
+  coarse->ops->view           = MatCoarsenView_MISK;
+  coarse->ops->destroy        = MatCoarsenDestroy_MISK;
+  ierr = PetscObjectComposeFunction((PetscObject)coarse,"MatCoarsenMISKSetDistance_C",MatCoarsenMISKSetDistance_MISK);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)coarse,"MatCoarsenMISKGetDistance_C",MatCoarsenMISKGetDistance_MISK);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
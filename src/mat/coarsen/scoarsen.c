@@ -4,6 +4,7 @@
 
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS(MatCoarsen);
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_HEM(MatCoarsen);
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MISK(MatCoarsen);
 
 /*@C
   MatCoarsenRegisterAll - Registers all of the matrix Coarsen routines in PETSc.
@@ -37,6 +38,7 @@ PetscErrorCode  MatCoarsenRegisterAll(void)
 
   ierr = MatCoarsenRegister(MATCOARSENMIS,MatCoarsenCreate_MIS);CHKERRQ(ierr);
   ierr = MatCoarsenRegister(MATCOARSENHEM,MatCoarsenCreate_HEM);CHKERRQ(ierr);
+  ierr = MatCoarsenRegister(MATCOARSENMISK,MatCoarsenCreate_MISK);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
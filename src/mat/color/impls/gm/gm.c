@@ -0,0 +1,300 @@
+#include <petsc/private/matimpl.h>      /*I "petscmat.h"  I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+typedef struct {
+  PetscInt  recolor;            /* maximum number of recoloring passes */
+  PetscBool symmetric;          /* the nonzero structure of the matrix is symmetric */
+} MC_GM;
+
+/* the graph that is one-colored: the local rows, the ghost columns and the communication from owners to ghosts */
+typedef struct {
+  PetscInt       n,no,rstart;
+  const PetscInt *di,*dj,*oi,*oj,*garray;
+  PetscSF        sf;
+  PetscInt       *mask,stamp,maxdeg;
+} MC_GM_Graph;
+
+static PetscErrorCode MatColoringDestroy_GM(MatColoring mc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(mc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   the smallest color not taken by a local or ghost neighbor of v, negative colors are not yet assigned; the result
+   is at most the local maximum degree, so larger colors (from ghosts or from recoloring) are not recorded in the mask
+*/
+PETSC_STATIC_INLINE PetscInt MCGMFirstFit_Private(MC_GM_Graph *g,PetscInt v,const PetscInt *dcolors,const PetscInt *ocolors)
+{
+  PetscInt j,c,stamp = ++g->stamp,*mask = g->mask,maxdeg = g->maxdeg;
+
+  for (j=g->di[v]; j<g->di[v+1]; j++) if ((c = dcolors[g->dj[j]]) >= 0 && c <= maxdeg) mask[c] = stamp;
+  if (g->sf) {
+    for (j=g->oi[v]; j<g->oi[v+1]; j++) if ((c = ocolors[g->oj[j]]) >= 0 && c <= maxdeg) mask[c] = stamp;
+  }
+  for (c=0; mask[c] == stamp; c++) ;
+  return c;
+}
+
+/*
+   Gebremedhin-Manne speculative coloring: every process first-fit colors its uncolored vertices as if it were alone,
+   the colors are sent to the ghosts in one round and of each pair of equally colored neighbors on different processes
+   the one with the smaller weight (then the smaller global index) is uncolored and colored again in the next round.
+*/
+static PetscErrorCode MCGMColorSpeculative_Private(MatColoring mc,MC_GM_Graph *g,const PetscReal *wts,const PetscReal *owts,const PetscInt *lperm,PetscInt *dcolors,PetscInt *ocolors)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,v,u,nwork,nconf,nconf_global,nrounds = 0,*work;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(g->n,&work);CHKERRQ(ierr);
+  for (i=0; i<g->n; i++) {dcolors[i] = -1; work[i] = lperm[i];}
+  for (i=0; i<g->no; i++) ocolors[i] = -1;
+  nwork = g->n;
+  while (PETSC_TRUE) {
+    nrounds++;
+    ierr = PetscLogEventBegin(MATCOLORING_Local,mc,0,0,0);CHKERRQ(ierr);
+    for (i=0; i<nwork; i++) {
+      v          = work[i];
+      dcolors[v] = MCGMFirstFit_Private(g,v,dcolors,ocolors);
+    }
+    ierr = PetscLogEventEnd(MATCOLORING_Local,mc,0,0,0);CHKERRQ(ierr);
+    if (!g->sf) break;
+    ierr = PetscLogEventBegin(MATCOLORING_Comm,mc,0,0,0);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(g->sf,MPIU_INT,dcolors,ocolors);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(g->sf,MPIU_INT,dcolors,ocolors);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(MATCOLORING_Comm,mc,0,0,0);CHKERRQ(ierr);
+    /* only vertices colored in this round can conflict, and only with ghosts colored in this round */
+    nconf = 0;
+    for (i=0; i<nwork; i++) {
+      v = work[i];
+      for (j=g->oi[v]; j<g->oi[v+1]; j++) {
+        u = g->oj[j];
+        if (ocolors[u] == dcolors[v] && (owts[u] > wts[v] || (owts[u] == wts[v] && g->garray[u] > g->rstart+v))) {
+          work[nconf++] = v;
+          break;
+        }
+      }
+    }
+    for (i=0; i<nconf; i++) dcolors[work[i]] = -1;
+    nwork = nconf;
+    ierr  = MPIU_Allreduce(&nconf,&nconf_global,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)mc));CHKERRQ(ierr);
+    if (!nconf_global) break;
+  }
+  ierr = PetscInfo1(mc,"Speculative coloring done in %D rounds\n",nrounds);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Culberson's iterated greedy: the vertices are first-fit colored again one color class at a time, in reverse order of
+   the classes.  The vertices of a class are independent, so every process colors its part of a class at once and the
+   new colors are sent to the ghosts before the next class; the coloring stays valid and never gets more colors.
+*/
+static PetscErrorCode MCGMRecolor_Private(MatColoring mc,MC_GM_Graph *g,PetscInt ncolors,const PetscInt *dcolors,PetscInt *rcolors,PetscInt *orcolors)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,c,*cstart,*order;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(ncolors+1,&cstart);CHKERRQ(ierr);
+  ierr = PetscMalloc1(g->n,&order);CHKERRQ(ierr);
+  for (i=0; i<g->n; i++) cstart[dcolors[i]+1]++;
+  for (c=0; c<ncolors; c++) cstart[c+1] += cstart[c];
+  for (i=0; i<g->n; i++) order[cstart[dcolors[i]]++] = i;
+  for (c=ncolors; c>0; c--) cstart[c] = cstart[c-1];
+  cstart[0] = 0;
+  for (i=0; i<g->n; i++) rcolors[i] = -1;
+  for (i=0; i<g->no; i++) orcolors[i] = -1;
+  for (c=ncolors-1; c>=0; c--) {
+    ierr = PetscLogEventBegin(MATCOLORING_Local,mc,0,0,0);CHKERRQ(ierr);
+    for (i=cstart[c]; i<cstart[c+1]; i++) rcolors[order[i]] = MCGMFirstFit_Private(g,order[i],rcolors,orcolors);
+    ierr = PetscLogEventEnd(MATCOLORING_Local,mc,0,0,0);CHKERRQ(ierr);
+    if (g->sf && c) {
+      ierr = PetscLogEventBegin(MATCOLORING_Comm,mc,0,0,0);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(g->sf,MPIU_INT,rcolors,orcolors);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(g->sf,MPIU_INT,rcolors,orcolors);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(MATCOLORING_Comm,mc,0,0,0);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(cstart);CHKERRQ(ierr);
+  ierr = PetscFree(order);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatColoringApply_GM(MatColoring mc,ISColoring *iscoloring)
+{
+  MC_GM           *gm = (MC_GM*)mc->data;
+  PetscErrorCode  ierr;
+  Mat             m = mc->mat,G;
+  MC_GM_Graph     graph;
+  PetscBool       isMPIAIJ,isSEQAIJ;
+  PetscLayout     layout;
+  PetscReal       *wts,*owts = NULL;
+  PetscInt        i,pass,maxdeg,maxcolors,ncolors,ncolors_new,mcol,*lperm,*dcolors,*ocolors,*rcolors,*orcolors;
+  ISColoringValue *colors;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectBaseTypeCompare((PetscObject)m,MATMPIAIJ,&isMPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectBaseTypeCompare((PetscObject)m,MATSEQAIJ,&isSEQAIJ);CHKERRQ(ierr);
+  if (!isMPIAIJ && !isSEQAIJ) SETERRQ(PetscObjectComm((PetscObject)mc),PETSC_ERR_ARG_WRONG,"Matrix must be AIJ for gm coloring");
+  /* a distance two coloring of m is a distance one coloring of the graph of its column intersections */
+  if (mc->dist == 1) {
+    G = m;
+  } else if (mc->dist == 2) {
+    if (gm->symmetric) {
+      ierr = MatMatMult(m,m,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&G);CHKERRQ(ierr);
+    } else {
+      ierr = MatTransposeMatMult(m,m,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&G);CHKERRQ(ierr);
+    }
+  } else SETERRQ(PetscObjectComm((PetscObject)mc),PETSC_ERR_ARG_OUTOFRANGE,"Only distance 1 and distance 2 supported by MatColoringGM");
+
+  ierr = PetscMemzero(&graph,sizeof(graph));CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(G,&graph.rstart,NULL);CHKERRQ(ierr);
+  if (isMPIAIJ) {
+    Mat_MPIAIJ *aij  = (Mat_MPIAIJ*)G->data;
+    Mat_SeqAIJ *dseq = (Mat_SeqAIJ*)aij->A->data,*oseq = (Mat_SeqAIJ*)aij->B->data;
+
+    graph.n      = aij->A->rmap->n;
+    graph.di     = dseq->i;
+    graph.dj     = dseq->j;
+    graph.oi     = oseq->i;
+    graph.oj     = oseq->j;
+    graph.garray = aij->garray;
+    ierr = VecGetLocalSize(aij->lvec,&graph.no);CHKERRQ(ierr);
+    ierr = PetscSFCreate(PetscObjectComm((PetscObject)mc),&graph.sf);CHKERRQ(ierr);
+    ierr = MatGetLayouts(G,&layout,NULL);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(graph.sf,layout,graph.no,NULL,PETSC_COPY_VALUES,aij->garray);CHKERRQ(ierr);
+  } else {
+    Mat_SeqAIJ *dseq = (Mat_SeqAIJ*)G->data;
+
+    graph.n  = G->rmap->n;
+    graph.di = dseq->i;
+    graph.dj = dseq->j;
+  }
+  /* first fit never uses more colors than a vertex has neighbors */
+  maxdeg = 0;
+  for (i=0; i<graph.n; i++) {
+    PetscInt deg = graph.di[i+1] - graph.di[i] + (graph.sf ? graph.oi[i+1] - graph.oi[i] : 0);
+    if (deg > maxdeg) maxdeg = deg;
+  }
+  graph.maxdeg = maxdeg;
+  ierr = PetscCalloc1(maxdeg+1,&graph.mask);CHKERRQ(ierr);
+
+  if (!mc->user_weights) {
+    ierr = MatColoringCreateWeights(mc,&wts,&lperm);CHKERRQ(ierr);
+  } else {
+    wts   = mc->user_weights;
+    lperm = mc->user_lperm;
+  }
+  ierr = PetscMalloc4(graph.n,&dcolors,graph.no,&ocolors,graph.n,&rcolors,graph.no,&orcolors);CHKERRQ(ierr);
+  if (graph.sf) {
+    ierr = PetscMalloc1(graph.no,&owts);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(graph.sf,MPIU_REAL,wts,owts);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(graph.sf,MPIU_REAL,wts,owts);CHKERRQ(ierr);
+  }
+
+  ierr = MCGMColorSpeculative_Private(mc,&graph,wts,owts,lperm,dcolors,ocolors);CHKERRQ(ierr);
+  mcol = -1;
+  for (i=0; i<graph.n; i++) mcol = PetscMax(mcol,dcolors[i]);
+  ierr = MPIU_Allreduce(&mcol,&ncolors,1,MPIU_INT,MPI_MAX,PetscObjectComm((PetscObject)mc));CHKERRQ(ierr);
+  ncolors++;
+  ierr = PetscInfo1(mc,"Speculative coloring uses %D colors\n",ncolors);CHKERRQ(ierr);
+  for (pass=0; pass<gm->recolor; pass++) {
+    ierr = MCGMRecolor_Private(mc,&graph,ncolors,dcolors,rcolors,orcolors);CHKERRQ(ierr);
+    mcol = -1;
+    for (i=0; i<graph.n; i++) mcol = PetscMax(mcol,rcolors[i]);
+    ierr = MPIU_Allreduce(&mcol,&ncolors_new,1,MPIU_INT,MPI_MAX,PetscObjectComm((PetscObject)mc));CHKERRQ(ierr);
+    ncolors_new++;
+    ierr = PetscInfo2(mc,"Recoloring pass %D uses %D colors\n",pass,ncolors_new);CHKERRQ(ierr);
+    if (ncolors_new >= ncolors) break;
+    ncolors = ncolors_new;
+    ierr    = PetscMemcpy(dcolors,rcolors,graph.n*sizeof(PetscInt));CHKERRQ(ierr);
+  }
+
+  ierr = MatColoringGetMaxColors(mc,&maxcolors);CHKERRQ(ierr);
+  ierr = PetscMalloc1(graph.n,&colors);CHKERRQ(ierr);
+  for (i=0; i<graph.n; i++) colors[i] = (ISColoringValue)PetscMin(dcolors[i],maxcolors);
+  ierr = PetscLogEventBegin(MATCOLORING_ISCreate,mc,0,0,0);CHKERRQ(ierr);
+  ierr = ISColoringCreate(PetscObjectComm((PetscObject)mc),PetscMin(ncolors,maxcolors+1),graph.n,colors,PETSC_OWN_POINTER,iscoloring);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MATCOLORING_ISCreate,mc,0,0,0);CHKERRQ(ierr);
+
+  ierr = PetscFree4(dcolors,ocolors,rcolors,orcolors);CHKERRQ(ierr);
+  ierr = PetscFree(owts);CHKERRQ(ierr);
+  ierr = PetscFree(graph.mask);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&graph.sf);CHKERRQ(ierr);
+  if (!mc->user_weights) {
+    ierr = PetscFree(wts);CHKERRQ(ierr);
+    ierr = PetscFree(lperm);CHKERRQ(ierr);
+  }
+  if (G != m) {ierr = MatDestroy(&G);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatColoringSetFromOptions_GM(PetscOptionItems *PetscOptionsObject,MatColoring mc)
+{
+  MC_GM          *gm = (MC_GM*)mc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"GM options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_coloring_gm_recolor","Maximum number of recoloring passes","",gm->recolor,&gm->recolor,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_coloring_gm_symmetric","Flag for assuming a symmetric nonzero structure","",gm->symmetric,&gm->symmetric,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  MATCOLORINGGM - Gebremedhin-Manne speculative parallel coloring with iterated greedy recoloring, for distance 1 and 2.
+
+   Options Database Keys:
++  -mat_coloring_gm_recolor <2> - maximum number of recoloring passes, 0 keeps the speculative coloring
+-  -mat_coloring_gm_symmetric <false> - the matrix has a symmetric nonzero structure, so the distance two graph is
+                                        formed with MatMatMult() instead of MatTransposeMatMult()
+
+   Level: intermediate
+
+   Notes:
+   A distance two coloring is computed as a distance one coloring of the graph of the column intersections of the
+   matrix, so that a conflict between two columns is always between neighbors and is seen by the processes owning them.
+   Each process first-fit colors its uncolored columns, the colors are sent to the neighbor processes in a single
+   round, and of each pair of equally colored neighbors on different processes the one with the lower weight is
+   colored again.  Only process boundary columns can conflict, so this takes few rounds.
+
+   The coloring is then improved by recoloring passes that first-fit color the columns one color class at a time,
+   starting with the last class.  This never increases the number of colors, and since the columns of a class are not
+   neighbors it needs no conflict resolution; it costs one neighbor communication per color.  The passes stop once a
+   pass does not remove a color.  Fewer colors means fewer function evaluations in MatFDColoringApply().
+
+   References:
++  1. - A. H. Gebremedhin and F. Manne, "Scalable parallel graph coloring algorithms",
+   Concurrency: Practice and Experience 12 (2000)
+.  2. - D. Bozdag et al., "A framework for scalable greedy coloring on distributed-memory parallel computers",
+   J. Parallel Distrib. Comput. 68 (2008)
+-  3. - J. C. Culberson, "Iterated greedy graph coloring and the difficulty landscape", Technical Report 92-07,
+   University of Alberta (1992)
+
+.seealso: MatColoringCreate(), MatColoring, MatColoringSetType(), MatColoringType, MATCOLORINGGREEDY
+M*/
+PETSC_EXTERN PetscErrorCode MatColoringCreate_GM(MatColoring mc)
+{
+  MC_GM          *gm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr                    = PetscNewLog(mc,&gm);CHKERRQ(ierr);
+  mc->data                = gm;
+  mc->ops->apply          = MatColoringApply_GM;
+  mc->ops->view           = NULL;
+  mc->ops->destroy        = MatColoringDestroy_GM;
+  mc->ops->setfromoptions = MatColoringSetFromOptions_GM;
+
+  gm->recolor   = 2;
+  gm->symmetric = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
@@ -4,6 +4,7 @@
 
 PETSC_EXTERN PetscErrorCode MatColoringCreate_JP(MatColoring);
 PETSC_EXTERN PetscErrorCode MatColoringCreate_Greedy(MatColoring);
+PETSC_EXTERN PetscErrorCode MatColoringCreate_GM(MatColoring);
 PETSC_EXTERN PetscErrorCode MatColoringCreate_Power(MatColoring);
 PETSC_EXTERN PetscErrorCode MatColoringCreate_Natural(MatColoring);
 PETSC_EXTERN PetscErrorCode MatColoringCreate_SL(MatColoring);
@@ -35,6 +36,7 @@ PetscErrorCode  MatColoringRegisterAll(void)
   MatColoringRegisterAllCalled = PETSC_TRUE;
   ierr = MatColoringRegister(MATCOLORINGJP,MatColoringCreate_JP);CHKERRQ(ierr);
   ierr = MatColoringRegister(MATCOLORINGGREEDY,MatColoringCreate_Greedy);CHKERRQ(ierr);
+  ierr = MatColoringRegister(MATCOLORINGGM,MatColoringCreate_GM);CHKERRQ(ierr);
   ierr = MatColoringRegister(MATCOLORINGPOWER,MatColoringCreate_Power);CHKERRQ(ierr);
   ierr = MatColoringRegister(MATCOLORINGNATURAL,MatColoringCreate_Natural);CHKERRQ(ierr);
   ierr = MatColoringRegister(MATCOLORINGSL,MatColoringCreate_SL);CHKERRQ(ierr);
@@ -5,12 +5,13 @@ static char help[] = "Test MatMatMult() for AIJ and Dense matrices.\n\n";
 int main(int argc,char **argv)
 {
   Mat            A,B,C,D;
+  Vec            x,y,z;
   PetscInt       i,M,N,Istart,Iend,n=7,j,J,Ii,m=8,am,an;
   PetscScalar    v;
   PetscErrorCode ierr;
   PetscRandom    r;
   PetscBool      equal=PETSC_FALSE;
-  PetscReal      fill = 1.0;
+  PetscReal      fill = 1.0,norm;
   PetscMPIInt    size;
 
   ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
@@ -60,6 +61,21 @@ int main(int argc,char **argv)
   ierr = MatMatMult(A,B,MAT_INITIAL_MATRIX,fill,&C);CHKERRQ(ierr);
   ierr = MatMatMult(A,B,MAT_REUSE_MATRIX,fill,&C);CHKERRQ(ierr);
 
+  /* Check C = A*B column by column */
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  for (j=0; j<M; j++) {
+    ierr = MatGetColumnVector(B,x,j);CHKERRQ(ierr);
+    ierr = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr = MatGetColumnVector(C,z,j);CHKERRQ(ierr);
+    ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    if (norm > 100*PETSC_MACHINE_EPSILON) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Column %D of C != A*B, error %g",j,(double)norm);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+
   ierr = MatMatMultSymbolic(A,B,fill,&D);CHKERRQ(ierr);
   for (i=0; i<2; i++) {
     ierr = MatMatMultNumeric(A,B,D);CHKERRQ(ierr);
@@ -39,7 +39,7 @@ int main(int argc,char **args)
    test:
       nsize: {{1 3}}
       requires: datafilespath !complex double !define(PETSC_USE_64BIT_INDICES)
-      args: -f ${DATAFILESPATH}/matrices/arco1 -mat_coloring_type {{ jp power natural greedy}} -mat_coloring_distance {{ 1 2}}
+      args: -f ${DATAFILESPATH}/matrices/arco1 -mat_coloring_type {{ jp power natural greedy gm}} -mat_coloring_distance {{ 1 2}}
 
    test:
       suffix: 2
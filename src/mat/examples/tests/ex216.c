@@ -0,0 +1,84 @@
+static char help[] = "Tests repeated assembly of off-process entries with MAT_FROZEN_OFF_PROC_ENTRIES.\n\
+  -m <m>   : number of elements in each direction\n\
+  -its <n> : number of assemblies\n\n";
+
+#include <petscmat.h>
+
+/* Adds the bilinear element matrices of src/ksp/ksp/examples/tutorials/ex3.c, scaled by element and assembly */
+static PetscErrorCode AssembleElements(Mat A,PetscInt m,PetscInt it)
+{
+  PetscInt       e,estart,eend,i,j,idx[4];
+  PetscScalar    Ke[16];
+  PetscMPIInt    rank,size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr   = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr   = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  estart = rank*(m*m/size) + ((m*m%size) < rank ? (m*m%size) : rank);
+  eend   = estart + m*m/size + ((m*m%size) > rank);
+  for (e=estart; e<eend; e++) {
+    idx[0] = (m+1)*(e/m) + (e % m);
+    idx[1] = idx[0]+1; idx[2] = idx[1] + m + 1; idx[3] = idx[2] - 1;
+    for (i=0; i<4; i++) {
+      for (j=0; j<4; j++) Ke[4*i+j] = ((i == j) ? 2.0/3.0 : -1.0/6.0)*(1 + e%7)*(it+1);
+    }
+    ierr = MatSetValues(A,4,idx,4,idx,Ke,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       m = 8,N,its = 3,it;
+  PetscReal      norm,dnorm;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+  N    = (m+1)*(m+1);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_FROZEN_OFF_PROC_ENTRIES,PETSC_TRUE);CHKERRQ(ierr);
+  for (it=0; it<its; it++) {
+    if (it) {ierr = MatZeroEntries(A);CHKERRQ(ierr);}
+    ierr = AssembleElements(A,m,it);CHKERRQ(ierr);
+
+    /* the same matrix assembled from scratch without the option */
+    ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&B);CHKERRQ(ierr);
+    ierr = MatSetOption(B,MAT_FROZEN_OFF_PROC_ENTRIES,PETSC_FALSE);CHKERRQ(ierr);
+    ierr = AssembleElements(B,m,it);CHKERRQ(ierr);
+    ierr = MatAXPY(B,-1.0,A,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(B,NORM_FROBENIUS,&dnorm);CHKERRQ(ierr);
+    ierr = MatNorm(A,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Assembly %D: norm %g, %s\n",it,(double)norm,dnorm < 1.e-12*norm ? "matches the assembly without MAT_FROZEN_OFF_PROC_ENTRIES" : "differs");CHKERRQ(ierr);
+    ierr = MatDestroy(&B);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+
+/*TEST
+
+  testset:
+    nsize: 3
+    output_file: output/ex216_1.out
+    test:
+      suffix: 1
+    test:
+      suffix: 2
+      args: -mat_type baij
+    test:
+      suffix: legacy
+      args: -matstash_legacy
+
+TEST*/
@@ -0,0 +1,116 @@
+static char help[] = "Tests MatColoring on a graph whose processes have very different vertex degrees.\n\
+The lower processes own a path, the last process a clique joined to the end of the path.\n\
+  -nclique <n> : the number of vertices of the clique\n\
+  -npath <n>   : the number of vertices of the path on each of the other processes\n\n";
+
+#include <petscmat.h>
+
+/* counts the pairs of equally colored vertices that the coloring of the given distance must separate */
+static PetscErrorCode CountConflicts(Mat A,PetscInt dist,ISColoring iscoloring,PetscInt *nconflicts)
+{
+  PetscErrorCode    ierr;
+  Vec               c,call;
+  VecScatter        scatter;
+  IS                *is;
+  PetscInt          ncolors,k,l,i,j,n,rstart,rend,ncols,bad = 0;
+  const PetscInt    *idx,*cols;
+  const PetscScalar *ca;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateVecs(A,&c,NULL);CHKERRQ(ierr);
+  ierr = ISColoringGetIS(iscoloring,&ncolors,&is);CHKERRQ(ierr);
+  for (k=0; k<ncolors; k++) {
+    ierr = ISGetLocalSize(is[k],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is[k],&idx);CHKERRQ(ierr);
+    for (l=0; l<n; l++) {ierr = VecSetValue(c,idx[l],(PetscScalar)k,INSERT_VALUES);CHKERRQ(ierr);}
+    ierr = ISRestoreIndices(is[k],&idx);CHKERRQ(ierr);
+  }
+  ierr = ISColoringRestoreIS(iscoloring,&is);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(c);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(c);CHKERRQ(ierr);
+  ierr = VecScatterCreateToAll(c,&scatter,&call);CHKERRQ(ierr);
+  ierr = VecScatterBegin(scatter,c,call,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecScatterEnd(scatter,c,call,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+
+  ierr = VecGetArrayRead(call,&ca);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = MatGetRow(A,i,&ncols,&cols,NULL);CHKERRQ(ierr);
+    for (k=0; k<ncols; k++) {
+      if (dist == 1) {
+        if (cols[k] != i && ca[cols[k]] == ca[i]) bad++;
+      } else {
+        for (j=k+1; j<ncols; j++) if (ca[cols[k]] == ca[cols[j]]) bad++;
+      }
+    }
+    ierr = MatRestoreRow(A,i,&ncols,&cols,NULL);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArrayRead(call,&ca);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&bad,nconflicts,1,MPIU_INT,MPI_SUM,PetscObjectComm((PetscObject)A));CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&scatter);CHKERRQ(ierr);
+  ierr = VecDestroy(&call);CHKERRQ(ierr);
+  ierr = VecDestroy(&c);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A;
+  MatColoring    mc;
+  ISColoring     iscoloring;
+  PetscMPIInt    rank,size;
+  PetscInt       nclique = 50,npath = 10,npathtotal,m,rstart,rend,i,j,dist,ncolors,nconflicts;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nclique",&nclique,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-npath",&npath,NULL);CHKERRQ(ierr);
+  npathtotal = npath*(size-1);
+  m          = (rank == size-1) ? nclique : npath;
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,m,m,PETSC_DETERMINE,PETSC_DETERMINE,nclique+1,NULL,nclique+1,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = MatSetValue(A,i,i,1.0,INSERT_VALUES);CHKERRQ(ierr);
+    if (i < npathtotal) {
+      if (i > 0) {ierr = MatSetValue(A,i,i-1,1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      ierr = MatSetValue(A,i,i+1,1.0,INSERT_VALUES);CHKERRQ(ierr);
+    } else {
+      for (j=npathtotal; j<npathtotal+nclique; j++) {ierr = MatSetValue(A,i,j,1.0,INSERT_VALUES);CHKERRQ(ierr);}
+      if (i == npathtotal && npathtotal) {ierr = MatSetValue(A,i,i-1,1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  for (dist=1; dist<=2; dist++) {
+    ierr = MatColoringCreate(A,&mc);CHKERRQ(ierr);
+    ierr = MatColoringSetDistance(mc,dist);CHKERRQ(ierr);
+    ierr = MatColoringSetFromOptions(mc);CHKERRQ(ierr);
+    ierr = MatColoringApply(mc,&iscoloring);CHKERRQ(ierr);
+    ierr = ISColoringGetIS(iscoloring,&ncolors,NULL);CHKERRQ(ierr);
+    ierr = CountConflicts(A,dist,iscoloring,&nconflicts);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"distance %D: %D colors, %D conflicts\n",dist,ncolors,nconflicts);CHKERRQ(ierr);
+    ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+    ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: 2
+      args: -mat_coloring_type gm
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -mat_coloring_type gm -mat_coloring_gm_recolor 0 -npath 5
+      output_file: output/ex219_1.out
+
+TEST*/
@@ -0,0 +1,186 @@
+static char help[] = "Compares the SeqBAIJ block size specific kernels against the generic ones selected with -mat_no_unroll.\n\
+Checks MatMult(), MatMultAdd(), MatMultTranspose(), MatMultTransposeAdd(), MatSOR() and the natural ordering\n\
+MatSolve() of ILU on a block five point stencil, and the products again on a matrix with compressed rows.\n\
+  -m <m>, -n <n>             : grid dimensions\n\
+  -bs_min <bs>, -bs_max <bs> : the block sizes bs_min to bs_max are checked\n\n";
+
+#include <petscmat.h>
+
+/* block five point stencil with random off diagonal blocks and a dominant diagonal; only every
+   every-th block row is set so that every > 2 gives a matrix stored with compressed rows */
+static PetscErrorCode CreateMatrix(PetscInt m,PetscInt n,PetscInt bs,PetscInt every,PetscBool nounroll,PetscRandom rctx,Mat *A)
+{
+  PetscErrorCode ierr;
+  PetscInt       Ii,Jj,i,j,k,l;
+  PetscScalar    *v;
+
+  PetscFunctionBeginUser;
+  if (nounroll) {ierr = PetscOptionsSetValue(NULL,"-mat_no_unroll",NULL);CHKERRQ(ierr);}
+  ierr = MatCreateSeqBAIJ(PETSC_COMM_SELF,bs,m*n*bs,m*n*bs,5,NULL,A);CHKERRQ(ierr);
+  if (nounroll) {ierr = PetscOptionsClearValue(NULL,"-mat_no_unroll");CHKERRQ(ierr);}
+  ierr = PetscMalloc1(bs*bs,&v);CHKERRQ(ierr);
+  for (Ii=0; Ii<m*n; Ii+=every) {
+    i = Ii/n; j = Ii - i*n;
+    for (k=0; k<5; k++) {
+      if      (k == 0) {if (i == 0)   continue; Jj = Ii - n;}
+      else if (k == 1) {if (i == m-1) continue; Jj = Ii + n;}
+      else if (k == 2) {if (j == 0)   continue; Jj = Ii - 1;}
+      else if (k == 3) {if (j == n-1) continue; Jj = Ii + 1;}
+      else Jj = Ii;
+      /* the random sequence is restarted for every matrix so that both matrices are the same */
+      for (l=0; l<bs*bs; l++) {ierr = PetscRandomGetValue(rctx,&v[l]);CHKERRQ(ierr);}
+      if (Jj == Ii) for (l=0; l<bs; l++) v[l*bs+l] += 5.0*bs;
+      ierr = MatSetValuesBlocked(*A,1,&Ii,1,&Jj,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* prints a message if z differs from the reference result zref; z is overwritten */
+static PetscErrorCode CheckResult(const char name[],PetscInt bs,Vec z,Vec zref)
+{
+  PetscErrorCode ierr;
+  PetscReal      err,nrm;
+
+  PetscFunctionBeginUser;
+  ierr = VecNorm(zref,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,zref);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-10*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"bs %D: %s differs from the generic kernel by %g\n",bs,name,(double)(err/nrm));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* compares the products of the matrix with the block size specific kernels (A) and with the generic ones (Aref) */
+static PetscErrorCode CheckProducts(const char name[],PetscInt bs,Mat A,Mat Aref,Vec x,Vec y,Vec z,Vec zref)
+{
+  PetscErrorCode ierr;
+  char           str[64];
+
+  PetscFunctionBeginUser;
+  ierr = MatMult(A,x,z);CHKERRQ(ierr);
+  ierr = MatMult(Aref,x,zref);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(str,sizeof(str),"%s MatMult()",name);CHKERRQ(ierr);
+  ierr = CheckResult(str,bs,z,zref);CHKERRQ(ierr);
+
+  ierr = MatMultAdd(A,x,y,z);CHKERRQ(ierr);
+  ierr = MatMultAdd(Aref,x,y,zref);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(str,sizeof(str),"%s MatMultAdd()",name);CHKERRQ(ierr);
+  ierr = CheckResult(str,bs,z,zref);CHKERRQ(ierr);
+
+  ierr = VecCopy(y,z);CHKERRQ(ierr);
+  ierr = VecCopy(y,zref);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,z,z);CHKERRQ(ierr);
+  ierr = MatMultAdd(Aref,x,zref,zref);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(str,sizeof(str),"%s in place MatMultAdd()",name);CHKERRQ(ierr);
+  ierr = CheckResult(str,bs,z,zref);CHKERRQ(ierr);
+
+  ierr = MatMultTranspose(A,x,z);CHKERRQ(ierr);
+  ierr = MatMultTranspose(Aref,x,zref);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(str,sizeof(str),"%s MatMultTranspose()",name);CHKERRQ(ierr);
+  ierr = CheckResult(str,bs,z,zref);CHKERRQ(ierr);
+
+  ierr = MatMultTransposeAdd(A,x,y,z);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(Aref,x,y,zref);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(str,sizeof(str),"%s MatMultTransposeAdd()",name);CHKERRQ(ierr);
+  ierr = CheckResult(str,bs,z,zref);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,Aref,F,Fref;
+  Vec            x,y,z,zref;
+  IS             rperm,cperm,rev;
+  MatFactorInfo  info;
+  PetscInt       m = 5,n = 4,bsmin = 6,bsmax = 16,bs,k;
+  PetscRandom    rctx;
+  char           str[64];
+  const PetscInt sorits[] = {1,2,1,2},sorlits[] = {1,1,2,1};
+  const MatSORType sortype[] = {(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),SOR_LOCAL_FORWARD_SWEEP,(MatSORType)(SOR_LOCAL_BACKWARD_SWEEP | SOR_ZERO_INITIAL_GUESS),SOR_SYMMETRIC_SWEEP};
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs_min",&bsmin,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs_max",&bsmax,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rctx);CHKERRQ(ierr);
+
+  for (bs=bsmin; bs<=bsmax; bs++) {
+    ierr = PetscRandomSetSeed(rctx,0x12345678);CHKERRQ(ierr);
+    ierr = PetscRandomSeed(rctx);CHKERRQ(ierr);
+    ierr = CreateMatrix(m,n,bs,1,PETSC_FALSE,rctx,&A);CHKERRQ(ierr);
+    ierr = PetscRandomSeed(rctx);CHKERRQ(ierr);
+    ierr = CreateMatrix(m,n,bs,1,PETSC_TRUE,rctx,&Aref);CHKERRQ(ierr);
+    ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+    ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+    ierr = VecDuplicate(y,&zref);CHKERRQ(ierr);
+    ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+    ierr = VecSetRandom(y,rctx);CHKERRQ(ierr);
+    ierr = CheckProducts("",bs,A,Aref,x,y,z,zref);CHKERRQ(ierr);
+
+    for (k=0; k<4; k++) {
+      /* the sweeps without SOR_ZERO_INITIAL_GUESS start from x */
+      ierr = VecCopy(x,z);CHKERRQ(ierr);
+      ierr = VecCopy(x,zref);CHKERRQ(ierr);
+      ierr = MatSOR(A,y,1.0,sortype[k],0.0,sorits[k],sorlits[k],z);CHKERRQ(ierr);
+      ierr = MatSOR(Aref,y,1.0,sortype[k],0.0,sorits[k],sorlits[k],zref);CHKERRQ(ierr);
+      ierr = PetscSNPrintf(str,sizeof(str),"MatSOR() type %d its %D lits %D",(int)sortype[k],sorits[k],sorlits[k]);CHKERRQ(ierr);
+      ierr = CheckResult(str,bs,z,zref);CHKERRQ(ierr);
+    }
+
+    /* -mat_no_unroll does not reach the factors, so the natural ordering solve is compared against the
+       solve with a reversed ordering; enough levels of fill make both factorizations exact */
+    ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+    info.fill   = 1.0;
+    info.levels = m*n;
+    ierr = MatGetOrdering(A,MATORDERINGNATURAL,&rperm,&cperm);CHKERRQ(ierr);
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(F,A,rperm,cperm,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF,m*n,m*n-1,-1,&rev);CHKERRQ(ierr);
+    ierr = MatGetFactor(Aref,MATSOLVERPETSC,MAT_FACTOR_ILU,&Fref);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(Fref,Aref,rev,rev,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(Fref,Aref,&info);CHKERRQ(ierr);
+    ierr = MatSolve(F,y,z);CHKERRQ(ierr);
+    ierr = MatSolve(Fref,y,zref);CHKERRQ(ierr);
+    ierr = CheckResult("ILU MatSolve()",bs,z,zref);CHKERRQ(ierr);
+    ierr = MatDestroy(&F);CHKERRQ(ierr);
+    ierr = MatDestroy(&Fref);CHKERRQ(ierr);
+    ierr = ISDestroy(&rperm);CHKERRQ(ierr);
+    ierr = ISDestroy(&cperm);CHKERRQ(ierr);
+    ierr = ISDestroy(&rev);CHKERRQ(ierr);
+    ierr = MatDestroy(&A);CHKERRQ(ierr);
+    ierr = MatDestroy(&Aref);CHKERRQ(ierr);
+
+    /* most block rows empty, so the matrices are stored with compressed rows */
+    ierr = PetscRandomSeed(rctx);CHKERRQ(ierr);
+    ierr = CreateMatrix(m,n,bs,3,PETSC_FALSE,rctx,&A);CHKERRQ(ierr);
+    ierr = PetscRandomSeed(rctx);CHKERRQ(ierr);
+    ierr = CreateMatrix(m,n,bs,3,PETSC_TRUE,rctx,&Aref);CHKERRQ(ierr);
+    ierr = CheckProducts("compressed row",bs,A,Aref,x,y,z,zref);CHKERRQ(ierr);
+    ierr = MatDestroy(&A);CHKERRQ(ierr);
+    ierr = MatDestroy(&Aref);CHKERRQ(ierr);
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+    ierr = VecDestroy(&z);CHKERRQ(ierr);
+    ierr = VecDestroy(&zref);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Compared block sizes %D to %D\n",bsmin,bsmax);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+   test:
+      suffix: 2
+      args: -bs_min 11 -bs_max 11 -m 7 -n 3
+
+TEST*/
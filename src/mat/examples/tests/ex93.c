@@ -237,6 +237,12 @@ PetscErrorCode testPTAPRectangular(void)
       args: -A_matptap_via scalable
       output_file: output/ex93_2.out
 
+   test:
+      suffix: 5
+      nsize: 2
+      args: -A_matptap_via allatonce
+      output_file: output/ex93_2.out
+
    test:
       suffix: btheap
       args: -B_matmatmult_via btheap
@@ -247,6 +253,33 @@ PetscErrorCode testPTAPRectangular(void)
       args: -B_matmatmult_via heap
       output_file: output/ex93_1.out
 
+   test:
+      suffix: hash
+      args: -B_matmatmult_via hash -C_matmatmult_via hash
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: dense
+      args: -B_matmatmult_via dense -C_matmatmult_via dense
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: auto
+      args: -B_matmatmult_via auto -C_matmatmult_via auto
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: hash_threads
+      requires: openmp
+      args: -B_matmatmult_via hash -C_matmatmult_via hash -mat_aij_threads 2
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: dense_threads
+      requires: openmp
+      args: -B_matmatmult_via dense -C_matmatmult_via dense -mat_aij_threads 2
+      output_file: output/ex93_1.out
+
    test:
       suffix: hypre
       nsize: 3
@@ -279,4 +279,10 @@ int main(int argc,char **argv)
       nsize: 3
       args: -Mx 10 -My 5
 
+   test:
+      suffix: allatonce
+      nsize: 3
+      args: -Mx 10 -My 5 -matptap_via allatonce
+      output_file: output/ex96_1.out
+
 TEST*/
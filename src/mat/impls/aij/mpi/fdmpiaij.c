@@ -226,6 +226,26 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
   if (coloring->bcols > 1) { /* use blocked insertion of Jentry */
     PetscInt    i,m=J->rmap->n,nbcols,bcols=coloring->bcols;
     PetscScalar *dy=coloring->dy,*dy_k;
+    PetscBool   isseq;
+
+    if (coloring->fbatch && coloring->nbatch < bcols) {
+      /* the perturbed vectors of a block of colors are all formed before the batch function is called */
+      ierr = VecDestroyVecs(coloring->nbatch,&coloring->wbatch);CHKERRQ(ierr);
+      ierr = VecDestroyVecs(coloring->nbatch,&coloring->ybatch);CHKERRQ(ierr);
+      ierr = VecDuplicateVecs(x1,bcols,&coloring->wbatch);CHKERRQ(ierr);
+      ierr = PetscMalloc1(bcols,&coloring->ybatch);CHKERRQ(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)w2,VECSEQ,&isseq);CHKERRQ(ierr);
+      for (i=0; i<bcols; i++) { /* the arrays are the columns of dy, placed before each call */
+        if (isseq) {
+          ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,1,m,NULL,&coloring->ybatch[i]);CHKERRQ(ierr);
+        } else {
+          ierr = VecCreateMPIWithArray(PetscObjectComm((PetscObject)w2),1,m,PETSC_DETERMINE,NULL,&coloring->ybatch[i]);CHKERRQ(ierr);
+        }
+      }
+      ierr = PetscLogObjectParents(coloring,bcols,coloring->wbatch);CHKERRQ(ierr);
+      ierr = PetscLogObjectParents(coloring,bcols,coloring->ybatch);CHKERRQ(ierr);
+      coloring->nbatch = bcols;
+    }
 
     nbcols = 0;
     for (k=0; k<ncolors; k+=bcols) {
@@ -239,6 +259,7 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
       if (k + bcols > ncolors) bcols = ncolors - k;
       for (i=0; i<bcols; i++) {
         coloring->currentcolor = k+i;
+        if (coloring->fbatch) w3 = coloring->wbatch[i];
 
         ierr = VecCopy(x1,w3);CHKERRQ(ierr);
         ierr = VecGetArray(w3,&w3_array);CHKERRQ(ierr);
@@ -263,6 +284,11 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
          (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
                            w2 = F(x1 + dx) - F(x1)
          */
+        if (coloring->fbatch) { /* evaluated below for the whole block of colors */
+          ierr = VecPlaceArray(coloring->ybatch[i],dy_k);CHKERRQ(ierr);
+          dy_k += m;
+          continue;
+        }
         ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
         ierr = VecPlaceArray(w2,dy_k);CHKERRQ(ierr); /* place w2 to the array dy_i */
         ierr = (*f)(sctx,w3,w2,fctx);CHKERRQ(ierr);
@@ -271,6 +297,16 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
         ierr = VecResetArray(w2);CHKERRQ(ierr);
         dy_k += m; /* points to dy+i*nxloc */
       }
+      if (coloring->fbatch) {
+        coloring->currentcolor = -1;
+        ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
+        ierr = (*coloring->fbatch)(sctx,bcols,coloring->wbatch,coloring->ybatch,coloring->fbatchctx);CHKERRQ(ierr);
+        ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
+        for (i=0; i<bcols; i++) {
+          ierr = VecAXPY(coloring->ybatch[i],-1.0,w1);CHKERRQ(ierr);
+          ierr = VecResetArray(coloring->ybatch[i]);CHKERRQ(ierr);
+        }
+      }
 
       /*
        (3-3) Loop over block rows of vector, putting results into Jacobian matrix
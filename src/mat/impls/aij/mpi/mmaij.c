@@ -166,6 +166,7 @@ PetscErrorCode MatDisAssemble_MPIAIJ(Mat A)
   /* free stuff related to matrix-vec multiply */
   ierr = VecGetSize(aij->lvec,&ec);CHKERRQ(ierr); /* needed for PetscLogObjectMemory below */
   ierr = VecDestroy(&aij->lvec);CHKERRQ(ierr);
+  ierr = MatMultOverlapDestroy_MPIAIJ(&aij->mover);CHKERRQ(ierr);
   if (aij->colmap) {
 #if defined(PETSC_USE_CTABLE)
     ierr = PetscTableDestroy(&aij->colmap);CHKERRQ(ierr);
@@ -519,6 +519,60 @@ PetscErrorCode MatSetValuesRow_MPIAIJ(Mat A,PetscInt row,const PetscScalar v[])
   PetscFunctionReturn(0);
 }
 
+/*
+   MatSetValues_MPIAIJ() before the first final assembly with MAT_USE_HASH_TABLE: the local entries go to the hash
+   tables of the diagonal and off-diagonal blocks (the latter with global column indices) and the others are stashed
+*/
+static PetscErrorCode MatSetValues_MPIAIJ_Hash(Mat mat,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode addv)
+{
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ     *a   = (Mat_SeqAIJ*)aij->A->data,*b = (Mat_SeqAIJ*)aij->B->data;
+  PetscInt       i,j,rstart = mat->rmap->rstart,rend = mat->rmap->rend;
+  PetscInt       cstart = mat->cmap->rstart,cend = mat->cmap->rend;
+  PetscBool      roworiented = aij->roworiented,ignorezeroentries = a->ignorezeroentries;
+  PetscHashIJKey key;
+  PetscScalar    value;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    if (im[i] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+    if (im[i] >= mat->rmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",im[i],mat->rmap->N-1);
+#endif
+    if (im[i] >= rstart && im[i] < rend) {
+      key.i = im[i] - rstart;
+      for (j=0; j<n; j++) {
+        if (in[j] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+        if (in[j] >= mat->cmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",in[j],mat->cmap->N-1);
+#endif
+        if (roworiented) value = v[i*n+j];
+        else             value = v[i+j*m];
+        if (ignorezeroentries && value == 0.0 && (addv == ADD_VALUES) && im[i] != in[j]) continue;
+        if (in[j] >= cstart && in[j] < cend) {
+          key.j = in[j] - cstart;
+          ierr  = PetscHashIJVSetValue(a->ht,key,value,addv);CHKERRQ(ierr);
+        } else {
+          key.j = in[j];
+          ierr  = PetscHashIJVSetValue(b->ht,key,value,addv);CHKERRQ(ierr);
+        }
+      }
+    } else {
+      if (mat->nooffprocentries) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Setting off process row %D even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set",im[i]);
+      if (!aij->donotstash) {
+        mat->assembled = PETSC_FALSE;
+        if (roworiented) {
+          ierr = MatStashValuesRow_Private(&mat->stash,im[i],n,in,v+i*n,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        } else {
+          ierr = MatStashValuesCol_Private(&mat->stash,im[i],n,in,v+i,m,(PetscBool)(ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetValues_MPIAIJ(Mat mat,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode addv)
 {
   Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
@@ -544,6 +598,10 @@ PetscErrorCode MatSetValues_MPIAIJ(Mat mat,PetscInt m,const PetscInt im[],PetscI
   MatScalar *ap1,*ap2;
 
   PetscFunctionBegin;
+  if (a->ht) {
+    ierr = MatSetValues_MPIAIJ_Hash(mat,m,im,n,in,v,addv);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   for (i=0; i<m; i++) {
     if (im[i] < 0) continue;
 #if defined(PETSC_USE_DEBUG)
@@ -667,6 +725,73 @@ PetscErrorCode MatGetValues_MPIAIJ(Mat mat,PetscInt m,const PetscInt idxm[],Pets
 
 extern PetscErrorCode MatMultDiagonalBlock_MPIAIJ(Mat,Vec,Vec);
 
+/*
+   With MAT_FROZEN_OFF_PROC_ENTRIES every assembly receives the same entries, so their locations in the values of A and
+   B are computed once and the received values are added there directly. This is skipped, and the values go through
+   MatSetValues_MPIAIJ(), until the matrix has been assembled and while A or B have unused preallocated space, since
+   their assembly moves entries.
+*/
+static PetscErrorCode MatAssemblyEndFrozenStash_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ        *aij = (Mat_MPIAIJ*)mat->data;
+  Mat_SeqAIJ        *a   = (Mat_SeqAIJ*)aij->A->data,*b = (Mat_SeqAIJ*)aij->B->data;
+  PetscObjectState  state = aij->A->nonzerostate + aij->B->nonzerostate;
+  PetscInt          m = mat->rmap->n,rstart = mat->rmap->rstart,cstart = mat->cmap->rstart,cend = mat->cmap->rend;
+  PetscInt          n,k,row,col,loc;
+  const PetscInt    *rows,*cols;
+  const PetscScalar *vals;
+  PetscBool         active;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatStashFrozenGetPattern_Private(&mat->stash,&active,&n,&rows,&cols);CHKERRQ(ierr);
+  if (!active || !mat->was_assembled || mat->structure_only || a->nz != a->i[m] || b->nz != b->i[m]) PetscFunctionReturn(0);
+  if (!aij->stashslots || aij->stashslotsstate != state || aij->stashslotsBid != ((PetscObject)aij->B)->id) {
+    ierr = PetscFree(aij->stashslots);CHKERRQ(ierr);
+    ierr = PetscMalloc1(n,&aij->stashslots);CHKERRQ(ierr);
+    if (!aij->colmap) {ierr = MatCreateColmap_MPIAIJ_Private(mat);CHKERRQ(ierr);}
+    for (k=0; k<n; k++) {
+      row = rows[k] - rstart;
+      if (cols[k] >= cstart && cols[k] < cend) {
+        ierr = PetscFindInt(cols[k]-cstart,a->i[row+1]-a->i[row],a->j+a->i[row],&loc);CHKERRQ(ierr);
+        if (loc < 0) break;
+        aij->stashslots[k] = a->i[row] + loc;
+      } else {
+#if defined(PETSC_USE_CTABLE)
+        ierr = PetscTableFind(aij->colmap,cols[k]+1,&col);CHKERRQ(ierr);
+        col--;
+#else
+        col = aij->colmap[cols[k]] - 1;
+#endif
+        loc = -1;
+        if (col >= 0) {ierr = PetscFindInt(col,b->i[row+1]-b->i[row],b->j+b->i[row],&loc);CHKERRQ(ierr);}
+        if (loc < 0) break;
+        aij->stashslots[k] = -(b->i[row] + loc + 1);
+      }
+    }
+    if (k < n) { /* a received entry is not a nonzero yet, MatSetValues_MPIAIJ() inserts it */
+      ierr = PetscFree(aij->stashslots);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    aij->stashslotsstate = state;
+    aij->stashslotsBid   = ((PetscObject)aij->B)->id;
+    ierr = PetscInfo1(mat,"Located the %D entries received with MAT_FROZEN_OFF_PROC_ENTRIES\n",n);CHKERRQ(ierr);
+  }
+  ierr = MatStashFrozenGetValues_Private(&mat->stash,&vals);CHKERRQ(ierr);
+  if (mat->insertmode == ADD_VALUES) {
+    for (k=0; k<n; k++) {
+      if (aij->stashslots[k] >= 0) a->a[aij->stashslots[k]]    += vals[k];
+      else                         b->a[-aij->stashslots[k]-1] += vals[k];
+    }
+  } else {
+    for (k=0; k<n; k++) {
+      if (aij->stashslots[k] >= 0) a->a[aij->stashslots[k]]    = vals[k];
+      else                         b->a[-aij->stashslots[k]-1] = vals[k];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAssemblyBegin_MPIAIJ(Mat mat,MatAssemblyType mode)
 {
   Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
@@ -697,6 +822,7 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
 
   PetscFunctionBegin;
   if (!aij->donotstash && !mat->nooffprocentries) {
+    ierr = MatAssemblyEndFrozenStash_MPIAIJ(mat);CHKERRQ(ierr);
     while (1) {
       ierr = MatStashScatterGetMesg_Private(&mat->stash,&n,&row,&col,&val,&flg);CHKERRQ(ierr);
       if (!flg) break;
@@ -716,6 +842,10 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
     }
     ierr = MatStashScatterEnd_Private(&mat->stash);CHKERRQ(ierr);
   }
+  /* with MAT_USE_HASH_TABLE the structure of B is needed by MatSetUpMultiply_MPIAIJ() before B is assembled */
+  if (mode == MAT_FINAL_ASSEMBLY) {
+    ierr = MatSeqAIJCompressHashTable_Private(aij->B);CHKERRQ(ierr);
+  }
   ierr = MatAssemblyBegin(aij->A,mode);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(aij->A,mode);CHKERRQ(ierr);
 
@@ -930,6 +1060,209 @@ PetscErrorCode MatZeroRowsColumns_MPIAIJ(Mat A,PetscInt N,const PetscInt rows[],
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatMultOverlapReset_MPIAIJ(Mat_MultOverlap *mover)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree5(mover->rwaits,mover->swaits,mover->statuses,mover->done,mover->svalues);CHKERRQ(ierr);
+  ierr = PetscFree2(mover->lstarts,mover->pstarts);CHKERRQ(ierr);
+  ierr = PetscFree3(mover->prow,mover->poff,mover->plen);CHKERRQ(ierr);
+  mover->usable = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultOverlapDestroy_MPIAIJ(Mat_MultOverlap **mover)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*mover) PetscFunctionReturn(0);
+  ierr = MatMultOverlapReset_MPIAIJ(*mover);CHKERRQ(ierr);
+  ierr = PetscFree(*mover);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Prepares the overlapped MatMult_MPIAIJ(): the ghost values are received with the communication pattern of a->Mvctx
+   directly into lvec, and the rows of the off-diagonal block are split into pieces that each use the values received
+   from a single neighbour so the neighbours can be applied one at a time in the order their messages arrive.
+
+   Collective: it is called when the matrix nonzero state or a->Mvctx changed, which all processes see together, and
+   the processes agree on whether the overlap is used since they must all take the same MatMult() path.
+*/
+static PetscErrorCode MatMultOverlapSetUp_MPIAIJ(Mat A)
+{
+  Mat_MPIAIJ             *a = (Mat_MPIAIJ*)A->data;
+  Mat_SeqAIJ             *b;
+  Mat_MultOverlap        *mover;
+  VecScatter_MPI_General *gen_to,*gen_from;
+  VecScatterType         type;
+  PetscBool              mpi1,aijA,aijB,usable;
+  PetscInt               i,j,k,t,np,nrecvs,nsends,bs,*rstarts,*cnt,*colmsg,nlvec;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  if (!a->mover) {
+    ierr = PetscNewLog(A,&a->mover);CHKERRQ(ierr);
+    ierr = PetscObjectGetNewTag((PetscObject)A,&a->mover->tag);CHKERRQ(ierr);
+  } else {
+    ierr = MatMultOverlapReset_MPIAIJ(a->mover);CHKERRQ(ierr);
+  }
+  mover = a->mover;
+  mover->ctxid        = ((PetscObject)a->Mvctx)->id;
+  mover->nonzerostate = A->nonzerostate;
+
+  /* the overlap uses the plain point to point pattern of the MPI1 scatter and the CSR storage of the blocks */
+  ierr   = VecScatterGetType(a->Mvctx,&type);CHKERRQ(ierr);
+  ierr   = PetscStrcmp(type,VECSCATTERMPI1,&mpi1);CHKERRQ(ierr);
+  ierr   = PetscObjectTypeCompare((PetscObject)a->A,MATSEQAIJ,&aijA);CHKERRQ(ierr);
+  ierr   = PetscObjectTypeCompare((PetscObject)a->B,MATSEQAIJ,&aijB);CHKERRQ(ierr);
+  usable = (PetscBool)(mpi1 && aijA && aijB && !a->Mvctx->beginandendtogether && !((VecScatter_MPI_General*)a->Mvctx->todata)->local.n);
+  if (usable) {
+    /* the values from each neighbour must land in a contiguous part of lvec */
+    gen_from = (VecScatter_MPI_General*)a->Mvctx->fromdata;
+    for (k=0; k<gen_from->n && usable; k++) {
+      for (t=gen_from->starts[k]+1; t<gen_from->starts[k+1]; t++) {
+        if (gen_from->indices[t] != gen_from->indices[t-1] + gen_from->bs) {usable = PETSC_FALSE; break;}
+      }
+    }
+  }
+  ierr = MPIU_Allreduce(&usable,&mover->usable,1,MPIU_BOOL,MPI_LAND,PetscObjectComm((PetscObject)A));CHKERRQ(ierr);
+  if (!mover->usable) {
+    ierr = PetscInfo(A,"Matrix or scatter type or ghost value layout does not support -mat_mult_overlap, using the standard MatMult()\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  gen_to   = (VecScatter_MPI_General*)a->Mvctx->todata;
+  gen_from = (VecScatter_MPI_General*)a->Mvctx->fromdata;
+  nrecvs   = gen_from->n;
+  nsends   = gen_to->n;
+  rstarts  = gen_from->starts;
+  bs       = gen_from->bs;
+
+  ierr = PetscMalloc5(nrecvs,&mover->rwaits,nsends,&mover->swaits,PetscMax(nrecvs,nsends),&mover->statuses,nrecvs,&mover->done,bs*gen_to->starts[nsends],&mover->svalues);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nrecvs,&mover->lstarts,nrecvs+1,&mover->pstarts);CHKERRQ(ierr);
+  for (k=0; k<nrecvs; k++) mover->lstarts[k] = rstarts[k+1] > rstarts[k] ? gen_from->indices[rstarts[k]] : 0;
+
+  /* split each row of the off-diagonal block into runs of columns received from the same neighbour */
+  b     = (Mat_SeqAIJ*)a->B->data;
+  ierr  = VecGetLocalSize(a->lvec,&nlvec);CHKERRQ(ierr);
+  ierr  = PetscMalloc2(nlvec,&colmsg,nrecvs+1,&cnt);CHKERRQ(ierr);
+  for (j=0; j<nlvec; j++) colmsg[j] = -1;
+  for (k=0; k<nrecvs; k++) {
+    for (t=bs*rstarts[k]; t<bs*rstarts[k+1]; t++) colmsg[mover->lstarts[k] + t - bs*rstarts[k]] = k;
+  }
+  for (j=0; j<nlvec; j++) {
+    if (colmsg[j] < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Ghost value %D is not received from any process",j);
+  }
+  ierr = PetscMemzero(cnt,(nrecvs+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<a->B->rmap->n; i++) {
+    for (t=b->i[i]; t<b->i[i+1]; t++) {
+      if (t == b->i[i] || colmsg[b->j[t]] != colmsg[b->j[t-1]]) cnt[colmsg[b->j[t]]+1]++;
+    }
+  }
+  mover->pstarts[0] = 0;
+  for (k=0; k<nrecvs; k++) mover->pstarts[k+1] = mover->pstarts[k] + cnt[k+1];
+  np   = mover->pstarts[nrecvs];
+  ierr = PetscMalloc3(np,&mover->prow,np,&mover->poff,np,&mover->plen);CHKERRQ(ierr);
+  ierr = PetscMemcpy(cnt,mover->pstarts,nrecvs*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<a->B->rmap->n; i++) {
+    for (t=b->i[i]; t<b->i[i+1]; t++) {
+      k = colmsg[b->j[t]];
+      if (t == b->i[i] || k != colmsg[b->j[t-1]]) {
+        mover->prow[cnt[k]] = i;
+        mover->poff[cnt[k]] = t;
+        mover->plen[cnt[k]] = 0;
+        cnt[k]++;
+      }
+      mover->plen[cnt[k]-1]++;
+    }
+  }
+  ierr = PetscFree2(colmsg,cnt);CHKERRQ(ierr);
+  ierr = PetscInfo3(A,"Overlapping MatMult() with %D receives in %D pieces of rows, %D chunks\n",nrecvs,np,a->multoverlap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatMult_MPIAIJ_Overlap - y = A x where the diagonal block is multiplied in a->multoverlap chunks of rows. Between
+   the chunks MPI_Testsome() progresses the receives of the ghost values and the off-diagonal block is applied for each
+   neighbour whose values have arrived, so little of the communication time is left exposed at the end.
+*/
+static PetscErrorCode MatMult_MPIAIJ_Overlap(Mat A,Vec xx,Vec yy)
+{
+  Mat_MPIAIJ             *a   = (Mat_MPIAIJ*)A->data;
+  Mat_SeqAIJ             *ad  = (Mat_SeqAIJ*)a->A->data,*bd = (Mat_SeqAIJ*)a->B->data;
+  Mat_MultOverlap        *mover = a->mover;
+  VecScatter_MPI_General *gen_to   = (VecScatter_MPI_General*)a->Mvctx->todata;
+  VecScatter_MPI_General *gen_from = (VecScatter_MPI_General*)a->Mvctx->fromdata;
+  MPI_Comm               comm;
+  const PetscScalar      *x;
+  PetscScalar            *y,*lv,*sv = mover->svalues,sum;
+  const PetscInt         *sidx = gen_to->indices,*sstarts = gen_to->starts,*rstarts = gen_from->starts,*idx;
+  const MatScalar        *v;
+  PetscInt               m = A->rmap->n,bs = gen_from->bs,nrecvs = gen_from->n,nsends = gen_to->n;
+  PetscInt               i,k,l,p,c,r0,r1,chunk,nleft,n;
+  PetscMPIInt            outcount,kk;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  ierr = VecGetArray(a->lvec,&lv);CHKERRQ(ierr);
+
+  /* receive the ghost values directly into lvec, pack and send ours */
+  for (k=0; k<nrecvs; k++) {
+    ierr = MPI_Irecv(lv+mover->lstarts[k],bs*(rstarts[k+1]-rstarts[k]),MPIU_SCALAR,gen_from->procs[k],mover->tag,comm,mover->rwaits+k);CHKERRQ(ierr);
+  }
+  for (k=0; k<nsends; k++) {
+    for (i=sstarts[k]; i<sstarts[k+1]; i++) {
+      for (l=0; l<bs; l++) sv[bs*i+l] = x[sidx[i]+l];
+    }
+    ierr = MPI_Isend(sv+bs*sstarts[k],bs*(sstarts[k+1]-sstarts[k]),MPIU_SCALAR,gen_to->procs[k],mover->tag,comm,mover->swaits+k);CHKERRQ(ierr);
+  }
+
+  /* the off-diagonal pieces may be added to rows before the diagonal block reaches them */
+  ierr  = PetscMemzero(y,m*sizeof(PetscScalar));CHKERRQ(ierr);
+  nleft = nrecvs;
+  chunk = (m + a->multoverlap - 1)/a->multoverlap;
+  for (r0=0; r0<m || nleft; r0=r1) {
+    r1 = PetscMin(r0+chunk,m);
+    for (i=r0; i<r1; i++) {
+      n    = ad->i[i+1] - ad->i[i];
+      idx  = ad->j + ad->i[i];
+      v    = ad->a + ad->i[i];
+      sum  = 0.0;
+      PetscSparseDensePlusDot(sum,x,v,idx,n);
+      y[i] += sum;
+    }
+    if (!nleft) continue;
+    if (r1 < m) {
+      ierr = MPI_Testsome((PetscMPIInt)nrecvs,mover->rwaits,&outcount,mover->done,mover->statuses);CHKERRQ(ierr);
+    } else {
+      ierr = MPI_Waitsome((PetscMPIInt)nrecvs,mover->rwaits,&outcount,mover->done,mover->statuses);CHKERRQ(ierr);
+    }
+    for (c=0; c<outcount; c++) {
+      kk = mover->done[c];
+      for (p=mover->pstarts[kk]; p<mover->pstarts[kk+1]; p++) {
+        idx = bd->j + mover->poff[p];
+        v   = bd->a + mover->poff[p];
+        sum = 0.0;
+        PetscSparseDensePlusDot(sum,lv,v,idx,mover->plen[p]);
+        y[mover->prow[p]] += sum;
+      }
+    }
+    nleft -= outcount;
+  }
+  if (nsends) {ierr = MPI_Waitall((PetscMPIInt)nsends,mover->swaits,mover->statuses);CHKERRQ(ierr);}
+
+  ierr = VecRestoreArray(a->lvec,&lv);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*(ad->nz + bd->nz) - ad->nonzerorowcnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatMult_MPIAIJ(Mat A,Vec xx,Vec yy)
 {
   Mat_MPIAIJ     *a = (Mat_MPIAIJ*)A->data;
@@ -941,6 +1274,14 @@ PetscErrorCode MatMult_MPIAIJ(Mat A,Vec xx,Vec yy)
   ierr = VecGetLocalSize(xx,&nt);CHKERRQ(ierr);
   if (nt != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Incompatible partition of A (%D) and xx (%D)",A->cmap->n,nt);
 
+  if (a->multoverlap > 0) {
+    /* both the scatter id and the nonzero state of the matrix change on all processes together */
+    if (!a->mover || a->mover->ctxid != ((PetscObject)Mvctx)->id || a->mover->nonzerostate != A->nonzerostate) {ierr = MatMultOverlapSetUp_MPIAIJ(A);CHKERRQ(ierr);}
+    if (a->mover->usable) {
+      ierr = MatMult_MPIAIJ_Overlap(A,xx,yy);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
   ierr = VecScatterBegin(Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
   ierr = (*a->A->ops->mult)(a->A,xx,yy);CHKERRQ(ierr);
   ierr = VecScatterEnd(Mvctx,xx,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
@@ -1117,6 +1458,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = VecDestroy(&aij->lvec);CHKERRQ(ierr);
   ierr = VecScatterDestroy(&aij->Mvctx);CHKERRQ(ierr);
   if (aij->Mvctx_mpi1) {ierr = VecScatterDestroy(&aij->Mvctx_mpi1);CHKERRQ(ierr);}
+  ierr = MatMultOverlapDestroy_MPIAIJ(&aij->mover);CHKERRQ(ierr);
+  ierr = PetscFree(aij->stashslots);CHKERRQ(ierr);
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
@@ -1727,6 +2070,13 @@ PetscErrorCode MatSetOption_MPIAIJ(Mat A,MatOption op,PetscBool flg)
   case MAT_IGNORE_OFF_PROC_ENTRIES:
     a->donotstash = flg;
     break;
+  case MAT_USE_HASH_TABLE:
+    a->usehashtable = flg;
+    if (A->preallocated) {
+      ierr = MatSetOption(a->A,op,flg);CHKERRQ(ierr);
+      ierr = MatSetOption(a->B,op,flg);CHKERRQ(ierr);
+    }
+    break;
   case MAT_SPD:
     A->spd_set = PETSC_TRUE;
     A->spd     = flg;
@@ -2440,8 +2790,9 @@ PetscErrorCode MatMPIAIJSetUseScalableIncreaseOverlap(Mat A,PetscBool sc)
 
 PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
 {
+  Mat_MPIAIJ           *a = (Mat_MPIAIJ*)A->data;
   PetscErrorCode       ierr;
-  PetscBool            sc = PETSC_FALSE,flg;
+  PetscBool            sc = PETSC_FALSE,flg,set;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"MPIAIJ options");CHKERRQ(ierr);
@@ -2451,6 +2802,11 @@ PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat
     if (flg) {
       ierr = MatMPIAIJSetUseScalableIncreaseOverlap(A,sc);CHKERRQ(ierr);
     }
+    flg  = a->usehashtable;
+    ierr = PetscOptionsBool("-mat_use_hash_table","Accumulate the entries in a hash table until the first assembly, no preallocation needed","MatSetOption",flg,&flg,&set);CHKERRQ(ierr);
+    if (set) {ierr = MatSetOption(A,MAT_USE_HASH_TABLE,flg);CHKERRQ(ierr);}
+    ierr = PetscOptionsInt("-mat_mult_overlap","Number of chunks the diagonal block multiply is split into to progress the ghost value messages (0 for no overlap)","MatMult",a->multoverlap,&a->multoverlap,NULL);CHKERRQ(ierr);
+    if (a->multoverlap < 0) SETERRQ1(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_OUTOFRANGE,"-mat_mult_overlap %D must be nonnegative",a->multoverlap);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2700,6 +3056,10 @@ PetscErrorCode  MatMPIAIJSetPreallocation_MPIAIJ(Mat B,PetscInt d_nz,const Petsc
 
   ierr = MatSeqAIJSetPreallocation(b->A,d_nz,d_nnz);CHKERRQ(ierr);
   ierr = MatSeqAIJSetPreallocation(b->B,o_nz,o_nnz);CHKERRQ(ierr);
+  if (b->usehashtable) {
+    ierr = MatSetOption(b->A,MAT_USE_HASH_TABLE,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = MatSetOption(b->B,MAT_USE_HASH_TABLE,PETSC_TRUE);CHKERRQ(ierr);
+  }
   B->preallocated  = PETSC_TRUE;
   B->was_assembled = PETSC_FALSE;
   B->assembled     = PETSC_FALSE;;
@@ -2758,6 +3118,7 @@ PetscErrorCode MatDuplicate_MPIAIJ(Mat matin,MatDuplicateOption cpvalues,Mat *ne
   a->rank         = oldmat->rank;
   a->donotstash   = oldmat->donotstash;
   a->roworiented  = oldmat->roworiented;
+  a->multoverlap  = oldmat->multoverlap;
   a->rowindices   = 0;
   a->rowvalues    = 0;
   a->getrowactive = PETSC_FALSE;
@@ -5500,7 +5861,10 @@ PETSC_INTERN PetscErrorCode MatMatMult_MPIDense_MPIAIJ(Mat A,Mat B,MatReuse scal
    MATMPIAIJ - MATMPIAIJ = "mpiaij" - A matrix type to be used for parallel sparse matrices.
 
    Options Database Keys:
-. -mat_type mpiaij - sets the matrix type to "mpiaij" during a call to MatSetFromOptions()
++ -mat_type mpiaij - sets the matrix type to "mpiaij" during a call to MatSetFromOptions()
+. -mat_mult_overlap <nchunks> - MatMult() splits the diagonal block multiply into nchunks chunks of rows, calls MPI_Testsome() between
+                                them and applies the off-diagonal block for each neighbour as soon as its ghost values have arrived
+- -mat_use_hash_table - accumulate the entries in hash tables until the first final assembly, see MatSetOption() with MAT_USE_HASH_TABLE
 
   Level: beginner
 
@@ -28,6 +28,8 @@ typedef struct { /* used by MatPtAP_MPIAIJ_MPIAIJ() and MatMatMult_MPIAIJ_MPIAIJ
   PetscBool   scalable;        /* flag determines scalable or non-scalable implementation */
   Mat         Rd,Ro,AP_loc,C_loc,C_oth;
   PetscInt    algType;         /* implementation algorithm */
+  PetscHashI  apht;            /* all-at-once algorithm: position in apj and apa of each column of the row of A*P being accumulated */
+  PetscInt    apmax;           /* all-at-once algorithm: maximum number of nonzeros in a row of A*P */
 
   Mat_Merge_SeqsToMPI *merge;
   PetscErrorCode (*destroy)(Mat);
@@ -35,6 +37,20 @@ typedef struct { /* used by MatPtAP_MPIAIJ_MPIAIJ() and MatMatMult_MPIAIJ_MPIAIJ
   PetscErrorCode (*view)(Mat,PetscViewer);
 } Mat_PtAPMPI;
 
+typedef struct { /* used by MatMult_MPIAIJ() with -mat_mult_overlap */
+  PetscBool        usable;              /* the layout of a->Mvctx and the types of a->A and a->B allow the overlap on all processes */
+  PetscObjectId    ctxid;               /* id of the scatter whose communication pattern is used */
+  PetscObjectState nonzerostate;        /* of the matrix when the pieces below were computed */
+  PetscMPIInt      tag;                 /* obtained once, when the structure is created */
+  MPI_Request      *rwaits,*swaits;
+  MPI_Status       *statuses;
+  PetscMPIInt      *done;               /* indices of the receives completed by MPI_Testsome() */
+  PetscScalar      *svalues;            /* values packed for each neighbour */
+  PetscInt         *lstarts;            /* [nrecvs] first entry of lvec received from each neighbour */
+  PetscInt         *pstarts;            /* [nrecvs+1] the pieces of rows of a->B that use the values of each neighbour */
+  PetscInt         *prow,*poff,*plen;   /* row, offset into the column indices of a->B, and length of each piece */
+} Mat_MultOverlap;
+
 typedef struct {
   Mat A,B;                             /* local submatrices: A (diag part),
                                            B (off-diag part) */
@@ -43,11 +59,15 @@ typedef struct {
 
   /* The following variables are used for matrix assembly */
   PetscBool   donotstash;               /* PETSC_TRUE if off processor entries dropped */
+  PetscBool   usehashtable;             /* MAT_USE_HASH_TABLE, passed to A and B when they are preallocated */
   MPI_Request *send_waits;              /* array of send requests */
   MPI_Request *recv_waits;              /* array of receive requests */
   PetscInt    nsends,nrecvs;           /* numbers of sends and receives */
   PetscScalar *svalues,*rvalues;       /* sending and receiving data */
   PetscInt    rmax;                     /* maximum message length */
+  PetscInt         *stashslots;         /* MAT_FROZEN_OFF_PROC_ENTRIES: location in the values of A, or -(location+1) in those of B, of each received entry */
+  PetscObjectState stashslotsstate;     /* nonzero state of A plus that of B when stashslots was computed */
+  PetscObjectId    stashslotsBid;       /* id of B when stashslots was computed, MatDisAssemble_MPIAIJ() replaces B */
 #if defined(PETSC_USE_CTABLE)
   PetscTable colmap;
 #else
@@ -70,6 +90,10 @@ typedef struct {
   /* Used by MatDistribute_MPIAIJ() to allow reuse of previous matrix allocation  and nonzero pattern */
   PetscInt *ld;                    /* number of entries per row left of diagona block */
 
+  /* Used by MatMult() to overlap the diagonal block multiply with the communication */
+  PetscInt        multoverlap;     /* number of chunks the diagonal block multiply is split into, 0 for no overlap */
+  Mat_MultOverlap *mover;
+
   /* Used by MatMatMult() and MatPtAP() */
   Mat_PtAPMPI *ptap;
 
@@ -87,6 +111,7 @@ PETSC_INTERN PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat,MatAssemblyType);
 
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatMultOverlapDestroy_MPIAIJ(Mat_MultOverlap**);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat,MatDuplicateOption,Mat*);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat,PetscInt,IS [],PetscInt);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ_Scalable(Mat,PetscInt,IS [],PetscInt);
@@ -122,6 +147,8 @@ PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_scalable(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(Mat,Mat,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(Mat,Mat,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat*);
 #endif
@@ -359,8 +359,8 @@ PETSC_INTERN PetscErrorCode MatMatMult_MPIAIJ_MPIDense(Mat A,Mat B,MatReuse scal
 }
 
 typedef struct {
-  Mat         workB;
-  PetscScalar *rvalues,*svalues;
+  PetscScalar *bt;                /* ghost rows of B in the order of the columns of aij->B, when the receives are in another order */
+  PetscScalar *rvalues,*svalues;  /* ghost rows of B received and sent, the columns of each row interleaved */
   MPI_Request *rwaits,*swaits;
 } MPIAIJ_MPIDense;
 
@@ -370,7 +370,7 @@ PetscErrorCode MatMPIAIJ_MPIDenseDestroy(void *ctx)
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
-  ierr = MatDestroy(&contents->workB);CHKERRQ(ierr);
+  ierr = PetscFree(contents->bt);CHKERRQ(ierr);
   ierr = PetscFree4(contents->rvalues,contents->svalues,contents->rwaits,contents->swaits);CHKERRQ(ierr);
   ierr = PetscFree(contents);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -393,6 +393,7 @@ PetscErrorCode MatMatMultNumeric_MPIDense(Mat A,Mat B,Mat C)
   VecScatter             ctx   = aij->Mvctx;
   VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
   VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
+  PetscInt               i;
 
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)B,MATMPIDENSE,&flg);CHKERRQ(ierr);
@@ -405,8 +406,13 @@ PetscErrorCode MatMatMultNumeric_MPIDense(Mat A,Mat B,Mat C)
   C->ops->matmultnumeric = MatMatMultNumeric_MPIAIJ_MPIDense;
 
   ierr = PetscNew(&contents);CHKERRQ(ierr);
-  /* Create work matrix used to store off processor rows of B needed for local product */
-  ierr = MatCreateSeqDense(PETSC_COMM_SELF,nz,B->cmap->N,NULL,&contents->workB);CHKERRQ(ierr);
+  /* the off processor rows of B are multiplied in the order they are received unless that differs from the columns of aij->B */
+  for (i=0; i<from->starts[from->n]; i++) {
+    if (from->indices[i] != i) {
+      ierr = PetscMalloc1(nz*B->cmap->N,&contents->bt);CHKERRQ(ierr);
+      break;
+    }
+  }
   /* Create work arrays needed */
   ierr = PetscMalloc4(B->cmap->N*from->starts[from->n],&contents->rvalues,
                       B->cmap->N*to->starts[to->n],&contents->svalues,
@@ -433,7 +439,7 @@ PetscErrorCode MatMatMultSymbolic_MPIAIJ_MPIDense(Mat A,Mat B,PetscReal fill,Mat
   VecScatter             ctx   = aij->Mvctx;
   VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
   VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
-  PetscInt               m     = A->rmap->n,n=B->cmap->n;
+  PetscInt               m     = A->rmap->n,n=B->cmap->n,i;
 
   PetscFunctionBegin;
   ierr = MatCreate(PetscObjectComm((PetscObject)B),C);CHKERRQ(ierr);
@@ -447,8 +453,13 @@ PetscErrorCode MatMatMultSymbolic_MPIAIJ_MPIDense(Mat A,Mat B,PetscReal fill,Mat
   (*C)->ops->matmultnumeric = MatMatMultNumeric_MPIAIJ_MPIDense;
 
   ierr = PetscNew(&contents);CHKERRQ(ierr);
-  /* Create work matrix used to store off processor rows of B needed for local product */
-  ierr = MatCreateSeqDense(PETSC_COMM_SELF,nz,B->cmap->N,NULL,&contents->workB);CHKERRQ(ierr);
+  /* the off processor rows of B are multiplied in the order they are received unless that differs from the columns of aij->B */
+  for (i=0; i<from->starts[from->n]; i++) {
+    if (from->indices[i] != i) {
+      ierr = PetscMalloc1(nz*B->cmap->N,&contents->bt);CHKERRQ(ierr);
+      break;
+    }
+  }
   /* Create work arrays needed */
   ierr = PetscMalloc4(B->cmap->N*from->starts[from->n],&contents->rvalues,
                       B->cmap->N*to->starts[to->n],&contents->svalues,
@@ -465,54 +476,29 @@ PetscErrorCode MatMatMultSymbolic_MPIAIJ_MPIDense(Mat A,Mat B,PetscReal fill,Mat
 
 /*
     Performs an efficient scatter on the rows of B needed by this process; this is
-    a modification of the VecScatterBegin_() routines.
+    a modification of the VecScatterBegin_() routines. All the columns of a row of B
+    travel interleaved in one message per neighbour, and stay interleaved for the
+    multiply with the off-diagonal block.
 */
-PetscErrorCode MatMPIDenseScatter(Mat A,Mat B,Mat C,Mat *outworkB)
+static PetscErrorCode MatMPIDenseScatterBegin_Private(Mat A,Mat B,MPIAIJ_MPIDense *contents)
 {
   Mat_MPIAIJ             *aij = (Mat_MPIAIJ*)A->data;
   PetscErrorCode         ierr;
-  PetscScalar            *b,*w,*svalues,*rvalues;
+  PetscScalar            *b,*svalues = contents->svalues,*rvalues = contents->rvalues;
   VecScatter             ctx   = aij->Mvctx;
   VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
   VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
-  PetscInt               i,j,k;
-  PetscInt               *sindices,*sstarts,*rindices,*rstarts;
-  PetscMPIInt            *sprocs,*rprocs,nrecvs;
-  MPI_Request            *swaits,*rwaits;
+  PetscInt               i,j,k,*sindices = to->indices,*sstarts = to->starts,*rstarts = from->starts;
+  PetscMPIInt            *sprocs = to->procs,*rprocs = from->procs;
   MPI_Comm               comm;
-  PetscMPIInt            tag  = ((PetscObject)ctx)->tag,ncols = B->cmap->N, nrows = aij->B->cmap->n,imdex,nrowsB = B->rmap->n;
-  MPI_Status             status;
-  MPIAIJ_MPIDense        *contents;
-  PetscContainer         container;
-  Mat                    workB;
+  PetscMPIInt            tag  = ((PetscObject)ctx)->tag,ncols = B->cmap->N,nrowsB = B->rmap->n;
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
-  ierr = PetscObjectQuery((PetscObject)C,"workB",(PetscObject*)&container);CHKERRQ(ierr);
-  if (!container) SETERRQ(comm,PETSC_ERR_PLIB,"Container does not exist");
-  ierr = PetscContainerGetPointer(container,(void**)&contents);CHKERRQ(ierr);
-
-  workB = *outworkB = contents->workB;
-  if (nrows != workB->rmap->n) SETERRQ2(comm,PETSC_ERR_PLIB,"Number of rows of workB %D not equal to columns of aij->B %D",nrows,workB->cmap->n);
-  sindices = to->indices;
-  sstarts  = to->starts;
-  sprocs   = to->procs;
-  swaits   = contents->swaits;
-  svalues  = contents->svalues;
-
-  rindices = from->indices;
-  rstarts  = from->starts;
-  rprocs   = from->procs;
-  rwaits   = contents->rwaits;
-  rvalues  = contents->rvalues;
-
   ierr = MatDenseGetArray(B,&b);CHKERRQ(ierr);
-  ierr = MatDenseGetArray(workB,&w);CHKERRQ(ierr);
-
   for (i=0; i<from->n; i++) {
-    ierr = MPI_Irecv(rvalues+ncols*rstarts[i],ncols*(rstarts[i+1]-rstarts[i]),MPIU_SCALAR,rprocs[i],tag,comm,rwaits+i);CHKERRQ(ierr);
+    ierr = MPI_Irecv(rvalues+ncols*rstarts[i],ncols*(rstarts[i+1]-rstarts[i]),MPIU_SCALAR,rprocs[i],tag,comm,contents->rwaits+i);CHKERRQ(ierr);
   }
-
   for (i=0; i<to->n; i++) {
     /* pack a message at a time */
     for (j=0; j<sstarts[i+1]-sstarts[i]; j++) {
@@ -520,47 +506,64 @@ PetscErrorCode MatMPIDenseScatter(Mat A,Mat B,Mat C,Mat *outworkB)
         svalues[ncols*(sstarts[i] + j) + k] = b[sindices[sstarts[i]+j] + nrowsB*k];
       }
     }
-    ierr = MPI_Isend(svalues+ncols*sstarts[i],ncols*(sstarts[i+1]-sstarts[i]),MPIU_SCALAR,sprocs[i],tag,comm,swaits+i);CHKERRQ(ierr);
+    ierr = MPI_Isend(svalues+ncols*sstarts[i],ncols*(sstarts[i+1]-sstarts[i]),MPIU_SCALAR,sprocs[i],tag,comm,contents->swaits+i);CHKERRQ(ierr);
   }
+  ierr = MatDenseRestoreArray(B,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-  nrecvs = from->n;
-  while (nrecvs) {
-    ierr = MPI_Waitany(from->n,rwaits,&imdex,&status);CHKERRQ(ierr);
-    nrecvs--;
-    /* unpack a message at a time */
-    for (j=0; j<rstarts[imdex+1]-rstarts[imdex]; j++) {
-      for (k=0; k<ncols; k++) {
-        w[rindices[rstarts[imdex]+j] + nrows*k] = rvalues[ncols*(rstarts[imdex] + j) + k];
-      }
-    }
-  }
-  if (to->n) {ierr = MPI_Waitall(to->n,swaits,to->sstatus);CHKERRQ(ierr);}
+/*
+   Completes MatMPIDenseScatterBegin_Private(); bt holds the rows of B needed by the off-diagonal block of A, row j
+   (the j-th column of aij->B) at bt + j*B->cmap->N
+*/
+static PetscErrorCode MatMPIDenseScatterEnd_Private(Mat A,Mat B,MPIAIJ_MPIDense *contents,const PetscScalar **bt)
+{
+  Mat_MPIAIJ             *aij = (Mat_MPIAIJ*)A->data;
+  PetscErrorCode         ierr;
+  VecScatter             ctx   = aij->Mvctx;
+  VecScatter_MPI_General *from = (VecScatter_MPI_General*) ctx->fromdata;
+  VecScatter_MPI_General *to   = (VecScatter_MPI_General*) ctx->todata;
+  PetscInt               j,ncols = B->cmap->N;
 
-  ierr = MatDenseRestoreArray(B,&b);CHKERRQ(ierr);
-  ierr = MatDenseRestoreArray(workB,&w);CHKERRQ(ierr);
-  ierr = MatAssemblyBegin(workB,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-  ierr = MatAssemblyEnd(workB,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionBegin;
+  if (from->n) {ierr = MPI_Waitall(from->n,contents->rwaits,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  if (contents->bt) {
+    for (j=0; j<from->starts[from->n]; j++) {
+      ierr = PetscMemcpy(contents->bt+ncols*from->indices[j],contents->rvalues+ncols*j,ncols*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    *bt = contents->bt;
+  } else *bt = contents->rvalues;
+  if (to->n) {ierr = MPI_Waitall(to->n,contents->swaits,to->sstatus);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
-extern PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat,Mat,Mat);
 
 PetscErrorCode MatMatMultNumeric_MPIAIJ_MPIDense(Mat A,Mat B,Mat C)
 {
-  PetscErrorCode ierr;
-  Mat_MPIAIJ     *aij    = (Mat_MPIAIJ*)A->data;
-  Mat_MPIDense   *bdense = (Mat_MPIDense*)B->data;
-  Mat_MPIDense   *cdense = (Mat_MPIDense*)C->data;
-  Mat            workB;
+  PetscErrorCode    ierr;
+  Mat_MPIAIJ        *aij    = (Mat_MPIAIJ*)A->data;
+  Mat_MPIDense      *bdense = (Mat_MPIDense*)B->data;
+  Mat_MPIDense      *cdense = (Mat_MPIDense*)C->data;
+  MPIAIJ_MPIDense   *contents;
+  PetscContainer    container;
+  PetscScalar       *c;
+  const PetscScalar *bt = NULL;
 
   PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)C,"workB",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_PLIB,"Container does not exist");
+  ierr = PetscContainerGetPointer(container,(void**)&contents);CHKERRQ(ierr);
+
+  /* start getting the off processor rows of B, all the columns in one message per neighbour */
+  ierr = MatMPIDenseScatterBegin_Private(A,B,contents);CHKERRQ(ierr);
+
   /* diagonal block of A times all local rows of B*/
   ierr = MatMatMultNumeric_SeqAIJ_SeqDense(aij->A,bdense->A,cdense->A);CHKERRQ(ierr);
 
-  /* get off processor parts of B needed to complete the product */
-  ierr = MatMPIDenseScatter(A,B,C,&workB);CHKERRQ(ierr);
-
-  /* off-diagonal block of A times nonlocal rows of B */
-  ierr = MatMatMultNumericAdd_SeqAIJ_SeqDense(aij->B,workB,cdense->A);CHKERRQ(ierr);
+  /* off-diagonal block of A times the interleaved nonlocal rows of B */
+  ierr = MatMPIDenseScatterEnd_Private(A,B,contents,&bt);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(cdense->A,&c);CHKERRQ(ierr);
+  ierr = MatMatMultNumeric_SeqAIJ_Interleaved_Private(aij->B,B->cmap->N,bt,B->cmap->N,c,((Mat_SeqDense*)cdense->A->data)->lda,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(cdense->A,&c);CHKERRQ(ierr);
   ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -29,6 +29,8 @@ PetscErrorCode MatView_MPIAIJ_PtAP(Mat A,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"using scalable MatPtAP() implementation\n");CHKERRQ(ierr);
       } else if (ptap->algType == 1) {
         ierr = PetscViewerASCIIPrintf(viewer,"using nonscalable MatPtAP() implementation\n");CHKERRQ(ierr);
+      } else if (ptap->algType == 2) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using all-at-once MatPtAP() implementation\n");CHKERRQ(ierr);
       }
     }
   }
@@ -64,6 +66,7 @@ PetscErrorCode MatDestroy_MPIAIJ_PtAP(Mat A)
     ierr = MatDestroy(&ptap->C_loc);CHKERRQ(ierr);
     ierr = MatDestroy(&ptap->C_oth);CHKERRQ(ierr);
     if (ptap->apa) {ierr = PetscFree(ptap->apa);CHKERRQ(ierr);}
+    PetscHashIDestroy(ptap->apht); /* used by alg_allatonce */
 
     if (merge) { /* used by alg_ptap */
       ierr = PetscFree(merge->id_r);CHKERRQ(ierr);
@@ -108,11 +111,11 @@ PETSC_INTERN PetscErrorCode MatPtAP_MPIAIJ_MPIAIJ(Mat A,Mat P,MatReuse scall,Pet
   PetscBool      flg;
   MPI_Comm       comm;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char          *algTypes[2] = {"scalable","nonscalable"};
-  PetscInt            nalg=2;
-#else
-  const char          *algTypes[3] = {"scalable","nonscalable","hypre"};
+  const char          *algTypes[3] = {"scalable","nonscalable","allatonce"};
   PetscInt            nalg=3;
+#else
+  const char          *algTypes[4] = {"scalable","nonscalable","allatonce","hypre"};
+  PetscInt            nalg=4;
 #endif
   PetscInt            pN=P->cmap->N,alg=1; /* set default algorithm */
 
@@ -153,8 +156,14 @@ PETSC_INTERN PetscErrorCode MatPtAP_MPIAIJ_MPIAIJ(Mat A,Mat P,MatReuse scall,Pet
       ierr = MatPtAPSymbolic_MPIAIJ_MPIAIJ(A,P,fill,C);CHKERRQ(ierr);
       ierr = PetscLogEventEnd(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
       break;
-#if defined(PETSC_HAVE_HYPRE)
     case 2:
+      /* merge each row of A*P into C as it is computed, never forming A*P */
+      ierr = PetscLogEventBegin(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
+      ierr = MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(A,P,fill,C);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(MAT_PtAPSymbolic,A,P,0,0);CHKERRQ(ierr);
+      break;
+#if defined(PETSC_HAVE_HYPRE)
+    case 3:
       /* Use boomerAMGBuildCoarseOperator */
       ierr = MatPtAPSymbolic_AIJ_AIJ_wHYPRE(A,P,fill,C);CHKERRQ(ierr);
       PetscFunctionReturn(0);
@@ -604,6 +613,333 @@ PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_scalable(Mat A,Mat P,PetscReal fill
   PetscFunctionReturn(0);
 }
 
+/*
+   Accumulates row i of A*P = Ad*(Pd + Po) + Ao*P_oth in ht, which maps each column to its position in apj[] and apa[].
+   The rows of P owned by this process are read from its diagonal and off-diagonal blocks, so no local copy of P is
+   made. With apj NULL only the columns are put in ht.
+*/
+PETSC_STATIC_INLINE PetscErrorCode MatPtAPAllAtOnceRow_Private(Mat_SeqAIJ *ad,Mat_SeqAIJ *ao,Mat_SeqAIJ *pd,Mat_SeqAIJ *po,Mat_SeqAIJ *p_oth,const PetscInt garray[],PetscInt pcstart,PetscInt i,PetscHashI ht,PetscInt *nap,PetscInt apj[],PetscScalar apa[])
+{
+  PetscInt    j,k,row,col,nz = 0;
+  khint_t     missing;
+  khiter_t    it;
+  PetscScalar av = 0.0;
+
+  for (j=ad->i[i]; j<ad->i[i+1]; j++) {
+    row = ad->j[j];
+    if (apj) av = ad->a[j];
+    for (k=pd->i[row]; k<pd->i[row+1]; k++) {
+      col = pd->j[k] + pcstart;
+      it  = kh_put(HASHI,ht,col,&missing);
+      if (!apj) continue;
+      if (missing) {kh_val(ht,it) = nz; apj[nz] = col; apa[nz++] = av*pd->a[k];}
+      else apa[kh_val(ht,it)] += av*pd->a[k];
+    }
+    for (k=po->i[row]; k<po->i[row+1]; k++) {
+      col = garray[po->j[k]];
+      it  = kh_put(HASHI,ht,col,&missing);
+      if (!apj) continue;
+      if (missing) {kh_val(ht,it) = nz; apj[nz] = col; apa[nz++] = av*po->a[k];}
+      else apa[kh_val(ht,it)] += av*po->a[k];
+    }
+  }
+  if (p_oth) {
+    for (j=ao->i[i]; j<ao->i[i+1]; j++) {
+      row = ao->j[j];
+      if (apj) av = ao->a[j];
+      for (k=p_oth->i[row]; k<p_oth->i[row+1]; k++) {
+        col = p_oth->j[k];
+        it  = kh_put(HASHI,ht,col,&missing);
+        if (!apj) continue;
+        if (missing) {kh_val(ht,it) = nz; apj[nz] = col; apa[nz++] = av*p_oth->a[k];}
+        else apa[kh_val(ht,it)] += av*p_oth->a[k];
+      }
+    }
+  }
+  *nap = apj ? nz : (PetscInt)kh_size(ht);
+  return 0;
+}
+
+/*
+   All-at-once C = P^T*A*P: each row of A*P is formed in a hash accumulator and immediately scattered into the rows
+   of C given by the nonzeros of the same row of P, so A*P, P^T and the local copy of P are never formed. Rows of C
+   owned by other processes are summed in C_oth, whose values are sent with MAT_FROZEN_OFF_PROC_ENTRIES set on C,
+   so after the first product only the values travel along the recorded schedule. P_oth and its communication
+   pattern are kept for repeated numeric products.
+*/
+PetscErrorCode MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *a = (Mat_MPIAIJ*)A->data,*p = (Mat_MPIAIJ*)P->data,*c = (Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ     *ad = (Mat_SeqAIJ*)a->A->data,*ao = (Mat_SeqAIJ*)a->B->data;
+  Mat_SeqAIJ     *pd = (Mat_SeqAIJ*)p->A->data,*po = (Mat_SeqAIJ*)p->B->data,*p_oth = NULL,*c_oth;
+  Mat_PtAPMPI    *ptap = c->ptap;
+  PetscInt       am = A->rmap->n,pcstart = P->cmap->rstart,i,j,k,l,nap,row,*apj = ptap->apj;
+  PetscScalar    *apa = ptap->apa,*ca = ptap->apa + ptap->apmax,pv,*coa;
+  PetscLogDouble flops = 0.0;
+
+  PetscFunctionBegin;
+  if (ptap->reuse == MAT_REUSE_MATRIX) {
+    ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_REUSE_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+  }
+  if (ptap->P_oth) p_oth = (Mat_SeqAIJ*)ptap->P_oth->data;
+  ierr  = MatZeroEntries(C);CHKERRQ(ierr);
+  c_oth = (Mat_SeqAIJ*)ptap->C_oth->data;
+  coa   = c_oth->a;
+  ierr  = PetscMemzero(coa,c_oth->i[ptap->C_oth->rmap->n]*sizeof(PetscScalar));CHKERRQ(ierr);
+
+  for (i=0; i<am; i++) {
+    kh_clear(HASHI,ptap->apht);
+    ierr   = MatPtAPAllAtOnceRow_Private(ad,ao,pd,po,p_oth,p->garray,pcstart,i,ptap->apht,&nap,apj,apa);CHKERRQ(ierr);
+    ierr   = PetscSortIntWithScalarArray(nap,apj,apa);CHKERRQ(ierr);
+    flops += 2.0*nap;
+    /* rows of C owned by this process */
+    for (k=pd->i[i]; k<pd->i[i+1]; k++) {
+      row = pd->j[k] + pcstart;
+      pv  = pd->a[k];
+      for (l=0; l<nap; l++) ca[l] = pv*apa[l];
+      ierr = MatSetValues(C,1,&row,nap,apj,ca,ADD_VALUES);CHKERRQ(ierr);
+    }
+    /* rows of C owned by other processes; the columns of A*P are a subset of those of the row of C_oth */
+    for (k=po->i[i]; k<po->i[i+1]; k++) {
+      row = po->j[k];
+      pv  = po->a[k];
+      for (j=c_oth->i[row],l=0; l<nap; j++) {
+        if (c_oth->j[j] == apj[l]) coa[j] += pv*apa[l++];
+      }
+    }
+    flops += 2.0*nap*(pd->i[i+1]-pd->i[i]+po->i[i+1]-po->i[i]);
+  }
+
+  for (i=0; i<ptap->C_oth->rmap->n; i++) {
+    row  = p->garray[i];
+    ierr = MatSetValues(C,1,&row,c_oth->i[i+1]-c_oth->i[i],c_oth->j+c_oth->i[i],coa+c_oth->i[i],ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+
+  ptap->reuse = MAT_REUSE_MATRIX;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ_allatonce(Mat A,Mat P,PetscReal fill,Mat *C)
+{
+  PetscErrorCode ierr;
+  Mat_PtAPMPI    *ptap;
+  Mat_MPIAIJ     *a = (Mat_MPIAIJ*)A->data,*p = (Mat_MPIAIJ*)P->data,*c;
+  Mat_SeqAIJ     *ad = (Mat_SeqAIJ*)a->A->data,*ao = (Mat_SeqAIJ*)a->B->data;
+  Mat_SeqAIJ     *pd = (Mat_SeqAIJ*)p->A->data,*po = (Mat_SeqAIJ*)p->B->data,*p_oth = NULL,*c_oth;
+  MPI_Comm       comm;
+  PetscMPIInt    size,rank,tagi,tagj,*len_s,*len_si,*len_r,*len_ri,*id_r,nrecv,icompleted;
+  Mat            Cmpi;
+  PetscHashI     *dht,*oht;
+  PetscInt       am = A->rmap->n,pN = P->cmap->N,pn = P->cmap->n,pcstart = P->cmap->rstart,pcend = P->cmap->rend;
+  PetscInt       con = p->B->cmap->n,*prmap = p->garray,*owners = P->cmap->range;
+  PetscInt       i,j,k,l,nap,nbuf = 0,*buf = NULL,*coi,*coj,*owners_co,nsend,proc,len,nrows,nzi;
+  PetscInt       *buf_s,*buf_si,*buf_si_i,**buf_rj,**buf_ri,*dnz,*onz;
+  PetscScalar    *coa;
+  MPI_Request    *swaits,*rwaits;
+  MPI_Status     *sstatus,rstatus;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+
+  /* create struct Mat_PtAPMPI and attached it to C later */
+  ierr          = PetscNew(&ptap);CHKERRQ(ierr);
+  ptap->reuse   = MAT_INITIAL_MATRIX;
+  ptap->algType = 2;
+
+  /* get P_oth by taking rows of P (= non-zero cols of local A) from other processors */
+  ierr = MatGetBrowsOfAoCols_MPIAIJ(A,P,MAT_INITIAL_MATRIX,&ptap->startsj_s,&ptap->startsj_r,&ptap->bufa,&ptap->P_oth);CHKERRQ(ierr);
+  if (ptap->P_oth) p_oth = (Mat_SeqAIJ*)ptap->P_oth->data;
+
+  /* (1) merge the columns of each row of A*P into the rows of C given by the same row of P */
+  /* -------------------------------------------------------------------------------------- */
+  ierr = PetscMalloc2(pn,&dht,con,&oht);CHKERRQ(ierr);
+  for (i=0; i<pn; i++) PetscHashICreate(dht[i]);
+  for (i=0; i<con; i++) PetscHashICreate(oht[i]);
+  PetscHashICreate(ptap->apht);
+  ptap->apmax = 0;
+  for (i=0; i<am; i++) {
+    kh_clear(HASHI,ptap->apht);
+    ierr = MatPtAPAllAtOnceRow_Private(ad,ao,pd,po,p_oth,prmap,pcstart,i,ptap->apht,&nap,NULL,NULL);CHKERRQ(ierr);
+    ptap->apmax = PetscMax(ptap->apmax,nap);
+    if (nap > nbuf) {
+      ierr = PetscFree(buf);CHKERRQ(ierr);
+      nbuf = PetscMax(nap,2*nbuf);
+      ierr = PetscMalloc1(nbuf,&buf);CHKERRQ(ierr);
+    }
+    nap  = 0;
+    ierr = PetscHashIGetKeys(ptap->apht,&nap,buf);CHKERRQ(ierr);
+    for (k=pd->i[i]; k<pd->i[i+1]; k++) {
+      for (l=0; l<nap; l++) PetscHashIAdd(dht[pd->j[k]],buf[l],0);
+    }
+    for (k=po->i[i]; k<po->i[i+1]; k++) {
+      for (l=0; l<nap; l++) PetscHashIAdd(oht[po->j[k]],buf[l],0);
+    }
+  }
+  ierr = PetscFree(buf);CHKERRQ(ierr);
+
+  /* (2) C_oth: the rows of C owned by other processes, with sorted columns */
+  /* ---------------------------------------------------------------------- */
+  ierr   = PetscMalloc1(con+1,&coi);CHKERRQ(ierr);
+  coi[0] = 0;
+  for (i=0; i<con; i++) {
+    PetscHashISize(oht[i],nzi);
+    coi[i+1] = coi[i] + nzi;
+  }
+  ierr = PetscMalloc1(coi[con],&coj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(coi[con],&coa);CHKERRQ(ierr);
+  for (i=0; i<con; i++) {
+    nzi  = coi[i];
+    ierr = PetscHashIGetKeys(oht[i],&nzi,coj);CHKERRQ(ierr);
+    ierr = PetscSortInt(coi[i+1]-coi[i],coj+coi[i]);CHKERRQ(ierr);
+    PetscHashIDestroy(oht[i]);
+  }
+  ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF,con,pN,coi,coj,coa,&ptap->C_oth);CHKERRQ(ierr);
+  /* MatCreateSeqAIJWithArrays() does not free the arrays, but these were obtained from PETSc */
+  c_oth          = (Mat_SeqAIJ*)ptap->C_oth->data;
+  c_oth->free_a  = PETSC_TRUE;
+  c_oth->free_ij = PETSC_TRUE;
+
+  /* (3) send the structure of C_oth to the owners of its rows */
+  /* --------------------------------------------------------- */
+  ierr = PetscMalloc4(size,&len_s,size,&len_si,size,&sstatus,size+2,&owners_co);CHKERRQ(ierr);
+  ierr = PetscMemzero(len_s,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = PetscMemzero(len_si,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  proc = 0;
+  for (i=0; i<con; i++) {
+    while (prmap[i] >= owners[proc+1]) proc++;
+    len_si[proc]++;                   /* num of rows in C_oth to be sent to [proc] */
+    len_s[proc] += coi[i+1] - coi[i]; /* num of nonzeros in C_oth to be sent to [proc] */
+  }
+  len          = 0; /* max length of buf_si[] */
+  owners_co[0] = 0;
+  nsend        = 0;
+  for (proc=0; proc<size; proc++) {
+    owners_co[proc+1] = owners_co[proc] + len_si[proc];
+    if (len_s[proc]) {
+      nsend++;
+      len_si[proc] = 2*(len_si[proc] + 1); /* length of buf_si to be sent to [proc] */
+      len         += len_si[proc];
+    }
+  }
+  ierr = PetscGatherNumberOfMessages(comm,NULL,len_s,&nrecv);CHKERRQ(ierr);
+  ierr = PetscGatherMessageLengths2(comm,nsend,nrecv,len_s,len_si,&id_r,&len_r,&len_ri);CHKERRQ(ierr);
+
+  ierr = PetscCommGetNewTag(comm,&tagj);CHKERRQ(ierr);
+  ierr = PetscPostIrecvInt(comm,tagj,nrecv,id_r,len_r,&buf_rj,&rwaits);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nsend+1,&swaits);CHKERRQ(ierr);
+  for (proc=0,k=0; proc<size; proc++) {
+    if (!len_s[proc]) continue;
+    i    = owners_co[proc];
+    ierr = MPI_Isend(coj+coi[i],len_s[proc],MPIU_INT,proc,tagj,comm,swaits+k);CHKERRQ(ierr);
+    k++;
+  }
+  for (i=0; i<nrecv; i++) {
+    ierr = MPI_Waitany(nrecv,rwaits,&icompleted,&rstatus);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(rwaits);CHKERRQ(ierr);
+  if (nsend) {ierr = MPI_Waitall(nsend,swaits,sstatus);CHKERRQ(ierr);}
+
+  /* send and recv the rows and i-structure:
+       buf_si[0]:                 nrows to be sent
+             [1:nrows]:           row index (local to the receiver)
+             [nrows+1:2*nrows+1]: i-structure index
+  */
+  ierr   = PetscCommGetNewTag(comm,&tagi);CHKERRQ(ierr);
+  ierr   = PetscPostIrecvInt(comm,tagi,nrecv,id_r,len_ri,&buf_ri,&rwaits);CHKERRQ(ierr);
+  ierr   = PetscMalloc1(len+1,&buf_s);CHKERRQ(ierr);
+  buf_si = buf_s;
+  for (proc=0,k=0; proc<size; proc++) {
+    if (!len_s[proc]) continue;
+    nrows       = len_si[proc]/2 - 1;
+    buf_si_i    = buf_si + nrows+1;
+    buf_si[0]   = nrows;
+    buf_si_i[0] = 0;
+    nrows       = 0;
+    for (i=owners_co[proc]; i<owners_co[proc+1]; i++) {
+      buf_si_i[nrows+1] = buf_si_i[nrows] + coi[i+1] - coi[i];
+      buf_si[nrows+1]   = prmap[i] - owners[proc];
+      nrows++;
+    }
+    ierr = MPI_Isend(buf_si,len_si[proc],MPIU_INT,proc,tagi,comm,swaits+k);CHKERRQ(ierr);
+    k++;
+    buf_si += len_si[proc];
+  }
+  for (i=0; i<nrecv; i++) {
+    ierr = MPI_Waitany(nrecv,rwaits,&icompleted,&rstatus);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(rwaits);CHKERRQ(ierr);
+  if (nsend) {ierr = MPI_Waitall(nsend,swaits,sstatus);CHKERRQ(ierr);}
+  ierr = PetscFree4(len_s,len_si,sstatus,owners_co);CHKERRQ(ierr);
+  ierr = PetscFree(len_ri);CHKERRQ(ierr);
+  ierr = PetscFree(swaits);CHKERRQ(ierr);
+  ierr = PetscFree(buf_s);CHKERRQ(ierr);
+
+  /* merge the received columns into the local rows of C */
+  for (k=0; k<nrecv; k++) {
+    nrows    = buf_ri[k][0];
+    buf_si_i = buf_ri[k] + nrows + 1;
+    for (i=0; i<nrows; i++) {
+      for (j=buf_si_i[i]; j<buf_si_i[i+1]; j++) PetscHashIAdd(dht[buf_ri[k][i+1]],buf_rj[k][j],0);
+    }
+  }
+  ierr = PetscFree(id_r);CHKERRQ(ierr);
+  ierr = PetscFree(len_r);CHKERRQ(ierr);
+  ierr = PetscFree(buf_ri[0]);CHKERRQ(ierr);
+  ierr = PetscFree(buf_ri);CHKERRQ(ierr);
+  ierr = PetscFree(buf_rj[0]);CHKERRQ(ierr);
+  ierr = PetscFree(buf_rj);CHKERRQ(ierr);
+
+  /* (4) preallocate C from the local rows */
+  /* ------------------------------------- */
+  ierr = PetscCalloc2(pn,&dnz,pn,&onz);CHKERRQ(ierr);
+  for (i=0; i<pn; i++) {
+    khiter_t it;
+    for (it=kh_begin(dht[i]); it!=kh_end(dht[i]); it++) {
+      if (!kh_exist(dht[i],it)) continue;
+      if (kh_key(dht[i],it) >= pcstart && kh_key(dht[i],it) < pcend) dnz[i]++;
+      else onz[i]++;
+    }
+    PetscHashIDestroy(dht[i]);
+  }
+  ierr = PetscFree2(dht,oht);CHKERRQ(ierr);
+
+  ierr = MatCreate(comm,&Cmpi);CHKERRQ(ierr);
+  ierr = MatSetSizes(Cmpi,pn,pn,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetBlockSizes(Cmpi,PetscAbs(P->cmap->bs),PetscAbs(P->cmap->bs));CHKERRQ(ierr);
+  ierr = MatSetType(Cmpi,MATMPIAIJ);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(Cmpi,0,dnz,0,onz);CHKERRQ(ierr);
+  ierr = PetscFree2(dnz,onz);CHKERRQ(ierr);
+  /* every numeric product sets the same off-process entries in the same order */
+  ierr = MatSetOption(Cmpi,MAT_FROZEN_OFF_PROC_ENTRIES,PETSC_TRUE);CHKERRQ(ierr);
+
+  /* work space for a row of A*P and its multiples */
+  ierr = PetscMalloc1(ptap->apmax,&ptap->apj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*ptap->apmax,&ptap->apa);CHKERRQ(ierr);
+  ierr = PetscInfo3(Cmpi,"All-at-once algorithm: rows of A*P have at most %D nonzeros, C_oth has %D rows and %D nonzeros\n",ptap->apmax,con,coi[con]);CHKERRQ(ierr);
+
+  /* attach the supporting struct to Cmpi for reuse */
+  c = (Mat_MPIAIJ*)Cmpi->data;
+  c->ptap         = ptap;
+  ptap->duplicate = Cmpi->ops->duplicate;
+  ptap->destroy   = Cmpi->ops->destroy;
+  ptap->view      = Cmpi->ops->view;
+
+  /* Cmpi is not ready for use - assembly will be done by MatPtAPNumeric() */
+  Cmpi->assembled        = PETSC_FALSE;
+  Cmpi->ops->ptapnumeric = MatPtAPNumeric_MPIAIJ_MPIAIJ_allatonce;
+  Cmpi->ops->destroy     = MatDestroy_MPIAIJ_PtAP;
+  Cmpi->ops->duplicate   = MatDuplicate_MPIAIJ_MatPtAP;
+  Cmpi->ops->view        = MatView_MPIAIJ_PtAP;
+  *C                     = Cmpi;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatPtAPSymbolic_MPIAIJ_MPIAIJ(Mat A,Mat P,PetscReal fill,Mat *C)
 {
   PetscErrorCode      ierr;
@@ -413,6 +413,88 @@ PetscErrorCode MatSeqAIJSetValuesLocalFast(Mat A,PetscInt m,const PetscInt im[],
   return 0;
 }
 
+/*
+   Accumulates the entries in a->ht when MAT_USE_HASH_TABLE was set before the first assembly; the CSR structure
+   is only built by MatSeqAIJCompressHashTable_Private() at the first final assembly
+*/
+static PetscErrorCode MatSetValues_SeqAIJ_Hash(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       k,l;
+  PetscHashIJKey key;
+  PetscScalar    value;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (k=0; k<m; k++) {
+    if (im[k] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+    if (im[k] >= A->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",im[k],A->rmap->n-1);
+#endif
+    key.i = im[k];
+    for (l=0; l<n; l++) {
+      if (in[l] < 0) continue;
+#if defined(PETSC_USE_DEBUG)
+      if (in[l] >= A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",in[l],A->cmap->n-1);
+#endif
+      key.j = in[l];
+      if (A->structure_only) value = 1.0;
+      else if (a->roworiented) value = v[l + k*n];
+      else value = v[k + l*m];
+      if (value == 0.0 && a->ignorezeroentries && is == ADD_VALUES && key.i != key.j) continue;
+      ierr = PetscHashIJVSetValue(a->ht,key,value,is);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Builds the CSR structure of A from the entries accumulated in a->ht, preallocating exactly the needed space,
+   and destroys the hash table
+*/
+PetscErrorCode MatSeqAIJCompressHashTable_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscHashIJV   ht = a->ht;
+  PetscInt       i,k,nz,m = A->rmap->n,nonew = a->nonew,*nnz,*rows,*cols;
+  PetscScalar    *vals;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ht) PetscFunctionReturn(0);
+  a->ht = NULL;
+  ierr = PetscHashIJVKeySize(ht,&nz);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nz,&rows,nz,&cols,nz,&vals);CHKERRQ(ierr);
+  ierr = PetscHashIJVGetPairs(ht,rows,cols,vals);CHKERRQ(ierr);
+  ierr = PetscHashIJVDestroy(&ht);CHKERRQ(ierr);
+
+  ierr = PetscCalloc1(m,&nnz);CHKERRQ(ierr);
+  for (k=0; k<nz; k++) nnz[rows[k]]++;
+  ierr = MatSeqAIJSetPreallocation(A,0,nnz);CHKERRQ(ierr);
+  ierr = PetscFree(nnz);CHKERRQ(ierr);
+  /* keep the new nonzero policy of the unpreallocated matrix instead of the one set by the exact preallocation */
+  a->nonew = nonew;
+
+  /* a->ilen[] counts the entries placed in each row so far */
+  for (k=0; k<nz; k++) {
+    i = a->i[rows[k]] + a->ilen[rows[k]]++;
+    a->j[i] = cols[k];
+    if (!A->structure_only) a->a[i] = vals[k];
+  }
+  for (i=0; i<m; i++) {
+    if (A->structure_only) {
+      ierr = PetscSortInt(a->ilen[i],a->j+a->i[i]);CHKERRQ(ierr);
+    } else {
+      ierr = PetscSortIntWithScalarArray(a->ilen[i],a->j+a->i[i],a->a+a->i[i]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree3(rows,cols,vals);CHKERRQ(ierr);
+  a->nz = nz;
+  A->nonzerostate++;
+  ierr = PetscInfo2(A,"Built the nonzero structure from a hash table with %D nonzeros in %D rows\n",nz,m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetValues_SeqAIJ(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
@@ -425,6 +507,10 @@ PetscErrorCode MatSetValues_SeqAIJ(Mat A,PetscInt m,const PetscInt im[],PetscInt
   PetscBool      roworiented       = a->roworiented;
 
   PetscFunctionBegin;
+  if (a->ht) {
+    ierr = MatSetValues_SeqAIJ_Hash(A,m,im,n,in,v,is);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   for (k=0; k<m; k++) { /* loop over added rows */
     row = im[k];
     if (row < 0) continue;
@@ -646,6 +732,7 @@ PetscErrorCode MatView_SeqAIJ_ASCII(Mat A,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"];\n %s = spconvert(zzz);\n",name);CHKERRQ(ierr);
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_TRUE);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO || format == PETSC_VIEWER_ASCII_INFO) {
+    ierr = MatSeqAIJLevelsView_Private(a->levels,A->rmap->n,viewer);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   } else if (format == PETSC_VIEWER_ASCII_COMMON) {
     ierr = PetscViewerASCIIUseTabs(viewer,PETSC_FALSE);CHKERRQ(ierr);
@@ -978,6 +1065,75 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+
+/*
+   MatSeqAIJSetUpThreads_Private - Splits the rows traversed by MatMult_SeqAIJ() into a->nthreads contiguous
+   ranges of (nearly) equal work; the work of a row is taken to be its number of nonzeros plus one.
+
+   If firsttouch is set the a[] and j[] arrays are reallocated and copied by the threads that later multiply
+   with them so that on NUMA machines the pages end up in memory close to the thread that uses them.
+*/
+static PetscErrorCode MatSeqAIJSetUpThreads_Private(Mat A,PetscBool firsttouch)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscInt       t,r,m,nt = a->nthreads,*rp;
+  const PetscInt *ii;
+  PetscReal      work;
+
+  PetscFunctionBegin;
+  if (a->compressedrow.use) {
+    m  = a->compressedrow.nrows;
+    ii = a->compressedrow.i;
+  } else {
+    m  = A->rmap->n;
+    ii = a->i;
+  }
+  if (!a->rowpart) {
+    ierr = PetscMalloc1(nt+1,&a->rowpart);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(nt+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  }
+  rp    = a->rowpart;
+  rp[0] = 0;
+  work  = (PetscReal)(m ? ii[m] - ii[0] + m : 0);
+  for (t=1,r=0; t<nt; t++) {
+    while (r < m && (PetscReal)(ii[r] - ii[0] + r) < t*work/nt) r++;
+    rp[t] = r;
+  }
+  rp[nt]          = m;
+  a->rowpartcprow = a->compressedrow.use;
+  a->rowpartstate = A->nonzerostate;
+
+  if (firsttouch && a->singlemalloc && !A->structure_only && m) {
+    PetscInt  mm = A->rmap->n,nz = a->i[mm],*newi,*newj;
+    MatScalar *newa;
+
+    ierr = PetscMalloc3(nz,&newa,nz,&newj,mm+1,&newi);CHKERRQ(ierr);
+    ierr = PetscMemcpy(newi,a->i,(mm+1)*sizeof(PetscInt));CHKERRQ(ierr);
+#pragma omp parallel num_threads(nt)
+    {
+      PetscInt tid,k;
+
+      for (tid=omp_get_thread_num(); tid<nt; tid+=omp_get_num_threads()) {
+        for (k=ii[rp[tid]]; k<ii[rp[tid+1]]; k++) {
+          newj[k] = a->j[k];
+          newa[k] = a->a[k];
+        }
+      }
+    }
+    ierr  = PetscFree3(a->a,a->j,a->i);CHKERRQ(ierr);
+    a->a  = newa;
+    a->j  = newj;
+    a->i  = newi;
+    ierr  = PetscInfo1(A,"Placed matrix entries in memory with first touch by %D threads\n",nt);CHKERRQ(ierr);
+  }
+  ierr = PetscInfo2(A,"Split %D rows among %D threads by nonzero count\n",m,nt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
@@ -990,6 +1146,11 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   PetscFunctionBegin;
   if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
 
+  if (a->ht) {
+    ierr  = MatSeqAIJCompressHashTable_Private(A);CHKERRQ(ierr);
+    ai    = a->i; aj = a->j; aa = a->a;
+    imax  = a->imax; ailen = a->ilen;
+  }
   if (m) rmax = ailen[0]; /* determine row with most nonzeros */
   for (i=1; i<m; i++) {
     /* move each row back by the amount of empty slots (fshift) before it*/
@@ -1037,6 +1198,11 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   if (!A->structure_only) {
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->nthreads > 1) {
+    ierr = MatSeqAIJSetUpThreads_Private(A,(PetscBool)(!a->rowpart || a->rowpartstate != A->nonzerostate));CHKERRQ(ierr);
+  }
+#endif
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
   ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1102,6 +1268,9 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISColoringDestroy(&a->coloring);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
+  ierr = PetscFree(a->rowpart);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelsDestroy_Private(&a->levels);CHKERRQ(ierr);
+  ierr = PetscHashIJVDestroy(&a->ht);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1129,6 +1298,20 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscBool      flg,set;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"SeqAIJ options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_use_hash_table","Accumulate the entries in a hash table until the first assembly, no preallocation needed","MatSetOption",a->ht ? PETSC_TRUE : PETSC_FALSE,&flg,&set);CHKERRQ(ierr);
+  if (set) {ierr = MatSetOption(A,MAT_USE_HASH_TABLE,flg);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
 {
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
@@ -1165,9 +1348,24 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A,MatOption op,PetscBool flg)
   case MAT_STRUCTURE_ONLY:
     /* These options are handled directly by MatSetOption() */
     break;
+  case MAT_USE_HASH_TABLE:
+    if (flg && !a->ht) {
+      if (A->assembled || A->was_assembled || a->nz) {
+        ierr = PetscInfo1(A,"Option %s ignored, the matrix already has a nonzero structure\n",MatOptions[op]);CHKERRQ(ierr);
+      } else {
+        ierr = PetscHashIJVCreate(&a->ht);CHKERRQ(ierr);
+        if (A->preallocated) {ierr = PetscHashIJVResize(a->ht,(PetscInt)(1.3*a->maxnz));CHKERRQ(ierr);}
+      }
+    } else if (!flg && a->ht) {
+      PetscInt nz;
+
+      ierr = PetscHashIJVKeySize(a->ht,&nz);CHKERRQ(ierr);
+      if (nz) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Cannot turn off %s after values have been set, assemble the matrix first",MatOptions[op]);
+      ierr = PetscHashIJVDestroy(&a->ht);CHKERRQ(ierr);
+    }
+    break;
   case MAT_NEW_DIAGONALS:
   case MAT_IGNORE_OFF_PROC_ENTRIES:
-  case MAT_USE_HASH_TABLE:
     ierr = PetscInfo1(A,"Option %s ignored\n",MatOptions[op]);CHKERRQ(ierr);
     break;
   case MAT_USE_INODES:
@@ -1301,6 +1499,39 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   ii   = a->i;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->nthreads > 1) {
+    const PetscInt *rp;
+
+    if (!a->rowpart || a->rowpartcprow != usecprow) {ierr = MatSeqAIJSetUpThreads_Private(A,PETSC_FALSE);CHKERRQ(ierr);}
+    rp = a->rowpart;
+    if (usecprow) {
+      ierr = PetscMemzero(y,m*sizeof(PetscScalar));CHKERRQ(ierr);
+      ii   = a->compressedrow.i;
+      ridx = a->compressedrow.rindex;
+    }
+#pragma omp parallel num_threads(a->nthreads)
+    {
+      PetscInt        t,r,nz;
+      const PetscInt  *cols;
+      const MatScalar *vals;
+      PetscScalar     s;
+
+      /* loop over the parts in case the runtime delivered fewer threads than requested */
+      for (t=omp_get_thread_num(); t<a->nthreads; t+=omp_get_num_threads()) {
+        for (r=rp[t]; r<rp[t+1]; r++) {
+          nz   = ii[r+1] - ii[r];
+          cols = a->j + ii[r];
+          vals = a->a + ii[r];
+          s    = 0.0;
+          PetscSparseDensePlusDot(s,x,vals,cols,nz);
+          if (usecprow) y[ridx[r]] = s;
+          else          y[r]       = s;
+        }
+      }
+    }
+  } else
+#endif
   if (usecprow) { /* use compressed row format */
     ierr = PetscMemzero(y,m*sizeof(PetscScalar));CHKERRQ(ierr);
     m    = a->compressedrow.nrows;
@@ -1452,6 +1683,41 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->nthreads > 1) {
+    const PetscInt *rp;
+
+    if (!a->rowpart || a->rowpartcprow != usecprow) {ierr = MatSeqAIJSetUpThreads_Private(A,PETSC_FALSE);CHKERRQ(ierr);}
+    rp = a->rowpart;
+    ii = a->i;
+    if (usecprow) {
+      if (zz != yy) {
+        ierr = PetscMemcpy(z,y,m*sizeof(PetscScalar));CHKERRQ(ierr);
+      }
+      ii   = a->compressedrow.i;
+      ridx = a->compressedrow.rindex;
+    }
+#pragma omp parallel num_threads(a->nthreads)
+    {
+      PetscInt        t,r,row,nz;
+      const PetscInt  *cols;
+      const MatScalar *vals;
+      PetscScalar     s;
+
+      for (t=omp_get_thread_num(); t<a->nthreads; t+=omp_get_num_threads()) {
+        for (r=rp[t]; r<rp[t+1]; r++) {
+          row  = usecprow ? ridx[r] : r;
+          nz   = ii[r+1] - ii[r];
+          cols = a->j + ii[r];
+          vals = a->a + ii[r];
+          s    = y[row];
+          PetscSparseDensePlusDot(s,x,vals,cols,nz);
+          z[row] = s;
+        }
+      }
+    }
+  } else
+#endif
   if (usecprow) { /* use compressed row format */
     if (zz != yy) {
       ierr = PetscMemcpy(z,y,m*sizeof(PetscScalar));CHKERRQ(ierr);
@@ -3197,7 +3463,7 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         0,
                                 /* 74*/ 0,
                                         MatFDColoringApply_AIJ,
-                                        0,
+                                        MatSetFromOptions_SeqAIJ,
                                         0,
                                         0,
                                 /* 79*/ MatFindZeroDiagonals_SeqAIJ,
@@ -3655,6 +3921,8 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
   b->nz               = 0;
   b->maxnz            = nz;
   B->info.nz_unneeded = (double)b->maxnz;
+  /* the preallocation is the best guess of the size of the hash table; growing it rehashes all the entries */
+  if (b->ht) {ierr = PetscHashIJVResize(b->ht,(PetscInt)(1.3*b->maxnz));CHKERRQ(ierr);}
   if (realalloc) {
     ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_TRUE);CHKERRQ(ierr);
   }
@@ -3858,7 +4126,23 @@ PETSC_INTERN PetscErrorCode MatMatMult_SeqDense_SeqAIJ(Mat A,Mat B,MatReuse scal
    based on compressed sparse row format.
 
    Options Database Keys:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+. -mat_aij_threads <n> - use n OpenMP threads in MatMult() and MatMultAdd(); the rows are divided among the threads by
+                         nonzero count when the matrix is assembled (requires PETSc configured with --with-openmp); also used
+                         by the hash and dense MatMatMult() products with this matrix as first factor
+- -mat_use_hash_table - accumulate the entries in a hash table until the first final assembly, see MatSetOption() with MAT_USE_HASH_TABLE
+
+   Notes:
+   When more than one thread is requested the Inode routines are not used.
+
+   With MAT_USE_HASH_TABLE the entries set before the first final assembly are kept in a hash table and the matrix
+   is preallocated exactly from it during MatAssemblyEnd(), so the cost of assembly does not depend on the
+   preallocation. Later assemblies insert directly into the nonzero structure.
+
+   The ILU, LU, ICC and Cholesky factors of a matrix with more than one thread use the same number of threads in MatSolve():
+   the rows of the triangular factors are grouped into levels whose rows are independent of each other and each level is
+   divided among the threads. The number of levels and the average number of rows per level (the available parallelism)
+   are printed with the factored matrix in -ksp_view and with -info.
 
   Level: beginner
 
@@ -4024,6 +4308,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   b->idiagvalid         = PETSC_FALSE;
   b->ibdiagvalid        = PETSC_FALSE;
   b->keepnonzeropattern = PETSC_FALSE;
+  b->nthreads           = 1;
+  b->rowpart            = 0;
 
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJGetArray_C",MatSeqAIJGetArray_SeqAIJ);CHKERRQ(ierr);
@@ -4063,6 +4349,16 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaij_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaij_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = MatCreate_SeqAIJ_Inode(B);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"Options for SEQAIJ matrix","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_aij_threads","Number of OpenMP threads used by MatMult() and MatMultAdd()","None",b->nthreads,&b->nthreads,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (b->nthreads < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",b->nthreads);
+  if (b->nthreads > 1 && b->inode.use) {
+    b->inode.use = PETSC_FALSE;
+    ierr = PetscInfo(B,"Not using Inode routines due to -mat_aij_threads\n");CHKERRQ(ierr);
+  }
+#endif
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = MatSeqAIJSetTypeFromOptions(B);CHKERRQ(ierr);  /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(0);
@@ -3,6 +3,7 @@
 #define __AIJ_H
 
 #include <petsc/private/matimpl.h>
+#include <petsc/private/hash.h>
 #include <petscctable.h>
 
 /*
@@ -107,11 +108,33 @@ PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat,Mat,MatDuplicateOpti
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
 
+/*
+   Level schedule of the triangular solves with a factored matrix. The rows of a level depend only on rows of
+   earlier levels so MatSolve() eliminates them concurrently; used when the matrix was factored with -mat_aij_threads > 1
+*/
+typedef struct {
+  PetscInt    nthreads;                       /* number of OpenMP threads used by the solves */
+  PetscInt    nlevels[2];                     /* number of levels of the forward [0] and backward [1] solve */
+  PetscInt    *level[2];                      /* rows of level l are rows[s][level[s][l]] ... rows[s][level[s][l+1]-1] */
+  PetscInt    *rows[2];
+  PetscInt    *ti,*tj,*tpos;                  /* SBAIJ factor only: column i of U holds U(tj[k],i) = a[tpos[k]], ti[i] <= k < ti[i+1] */
+  PetscScalar *work;                          /* SBAIJ factor only: the forward solution before scaling with D^{-1} */
+} Mat_SeqAIJ_Levels;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsDestroy_Private(Mat_SeqAIJ_Levels**);
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsView_Private(Mat_SeqAIJ_Levels*,PetscInt,PetscViewer);
+
 typedef struct {
   SEQAIJHEADER(MatScalar);
   Mat_SeqAIJ_Inode inode;
   MatScalar        *saved_values;             /* location for stashing nonzero values of matrix */
 
+  PetscInt         nthreads;                  /* number of OpenMP threads used by MatMult() and MatMultAdd(), set with -mat_aij_threads */
+  PetscInt         *rowpart;                  /* thread t multiplies rows [rowpart[t],rowpart[t+1]), balanced by nonzero count */
+  PetscBool        rowpartcprow;              /* rowpart[] refers to the compressed rows */
+  PetscObjectState rowpartstate;              /* nonzero state of the matrix when rowpart[] was computed */
+  Mat_SeqAIJ_Levels *levels;                  /* factored matrix: level schedule of MatSolve(), NULL if the solves are sequential */
+
   PetscScalar *idiag,*mdiag,*ssor_work;       /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
   PetscBool   idiagvalid;                     /* current idiag[] and mdiag[] are valid */
   PetscScalar *ibdiag;                        /* inverses of block diagonals */
@@ -120,7 +143,10 @@ typedef struct {
 
   ISColoring  coloring;                       /* set with MatADSetColoring() used by MatADSetValues() */
 
+  PetscHashIJV ht;                            /* entries set before the first final assembly with MAT_USE_HASH_TABLE */
+
   PetscScalar         *matmult_abdense;    /* used by MatMatMult() */
+  PetscInt            matmult_nthreads;   /* used by MatMatMult(): threads of the hash and dense products, each with its own row of matmult_abdense */
   Mat_PtAP            *ptap;               /* used by MatPtAP() */
   Mat_MatMatMatMult   *matmatmatmult;      /* used by MatMatMatMult() */
   Mat_RARt            *rart;               /* used by MatRARt() */
@@ -236,6 +262,7 @@ PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
+PETSC_INTERN PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems*,Mat);
 
 PETSC_INTERN PetscErrorCode MatGetSymbolicTranspose_SeqAIJ(Mat,PetscInt *[],PetscInt *[]);
 PETSC_INTERN PetscErrorCode MatGetSymbolicTransposeReduced_SeqAIJ(Mat,PetscInt,PetscInt,PetscInt *[],PetscInt *[]);
@@ -255,6 +282,7 @@ PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Levels(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_InplaceWithPerm(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveAdd_SeqAIJ_inplace(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveAdd_SeqAIJ(Mat,Vec,Vec,Vec);
@@ -278,9 +306,14 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Pe
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Scalable_fast(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat,Mat,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat,Mat,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Dense(Mat,Mat,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Auto(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Dense(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAP_SeqAIJ_SeqAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat,Mat,PetscReal,Mat*);
@@ -315,6 +348,7 @@ PETSC_INTERN PetscErrorCode MatMatMatMultSymbolic_SeqAIJ_SeqAIJ_SeqAIJ(Mat,Mat,M
 PETSC_INTERN PetscErrorCode MatMatMatMultNumeric_SeqAIJ_SeqAIJ_SeqAIJ(Mat,Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatSetValues_SeqAIJ(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[],const PetscScalar[],InsertMode);
+PETSC_INTERN PetscErrorCode MatSeqAIJCompressHashTable_Private(Mat);
 PETSC_INTERN PetscErrorCode MatGetRow_SeqAIJ(Mat,PetscInt,PetscInt*,PetscInt**,PetscScalar**);
 PETSC_INTERN PetscErrorCode MatRestoreRow_SeqAIJ(Mat,PetscInt,PetscInt*,PetscInt**,PetscScalar**);
 PETSC_INTERN PetscErrorCode MatScale_SeqAIJ(Mat,PetscScalar);
@@ -352,6 +386,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat,MatType,MatReuse,Mat
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat,PetscReal,IS,IS);
 PETSC_INTERN PetscErrorCode MatMatMult_SeqDense_SeqAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_Interleaved_Private(Mat,PetscInt,const PetscScalar*,PetscInt,PetscScalar*,PetscInt,InsertMode);
 PETSC_INTERN PetscErrorCode MatRARt_SeqAIJ_SeqAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat,MatAssemblyType);
@@ -366,6 +401,25 @@ PETSC_INTERN PetscErrorCode MatDestroySubMatrix_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDestroySubMatrix_Dummy(Mat);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrix_SeqAIJ(Mat,IS,IS,PetscInt,MatReuse,Mat*);
 
+/*
+    With --with-avx512-kernels the sparse-dense dot products below, and the inode kernels of MatSOR_SeqAIJ_Inode(), are
+    written with AVX-512 gathers; when the compiler only targets AVX2 (with FMA) 4-wide gathers are used instead.
+*/
+#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+#  if defined(__AVX512F__)
+#    define PETSC_USE_AVX512_SPARSEDENSEDOT
+#  elif defined(__AVX2__) && defined(__FMA__)
+#    define PETSC_USE_AVX2_SPARSEDENSEDOT
+#  endif
+#endif
+
+#if defined(PETSC_USE_AVX512_SPARSEDENSEDOT) || defined(PETSC_USE_AVX2_SPARSEDENSEDOT)
+  #include <immintrin.h>
+  #if !defined(_MM_SCALE_8)
+  #define _MM_SCALE_8    8
+  #endif
+#endif
+
 /*
     PetscSparseDenseMinusDot - The inner kernel of triangular solves and Gauss-Siedel smoothing. \sum_i xv[i] * r[xi[i]] for CSR storage
 
@@ -405,6 +459,12 @@ PETSC_INTERN PetscErrorCode MatCreateSubMatrix_SeqAIJ(Mat,IS,IS,PetscInt,MatReus
                                     sum -= (xv[__i]*r[__i1] + xv[__i+1]*r[__i2]);} \
     if (nnz & 0x1) sum -= xv[__i] * r[xi[__i]];}
 
+#elif defined(PETSC_USE_AVX512_SPARSEDENSEDOT)
+#define PetscSparseDenseMinusDot(sum,r,xv,xi,nnz) {(sum) -= PetscSparseDenseDot_AVX512_Private((r),(xv),(xi),(nnz));}
+
+#elif defined(PETSC_USE_AVX2_SPARSEDENSEDOT)
+#define PetscSparseDenseMinusDot(sum,r,xv,xi,nnz) {(sum) -= PetscSparseDenseDot_AVX2_Private((r),(xv),(xi),(nnz));}
+
 #else
 #define PetscSparseDenseMinusDot(sum,r,xv,xi,nnz) { \
     PetscInt __i; \
@@ -452,21 +512,19 @@ PETSC_INTERN PetscErrorCode MatCreateSubMatrix_SeqAIJ(Mat,IS,IS,PetscInt,MatReus
                                     sum += (xv[__i]*r[__i1] + xv[__i+1]*r[__i2]);} \
     if (nnz & 0x1) sum += xv[__i] * r[xi[__i]];}
 
-#elif defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+#elif defined(PETSC_USE_AVX512_SPARSEDENSEDOT)
 #define PetscSparseDensePlusDot(sum,r,xv,xi,nnz) PetscSparseDensePlusDot_AVX512_Private(&(sum),(r),(xv),(xi),(nnz))
 
+#elif defined(PETSC_USE_AVX2_SPARSEDENSEDOT)
+#define PetscSparseDensePlusDot(sum,r,xv,xi,nnz) {(sum) += PetscSparseDenseDot_AVX2_Private((r),(xv),(xi),(nnz));}
+
 #else
 #define PetscSparseDensePlusDot(sum,r,xv,xi,nnz) { \
     PetscInt __i; \
     for (__i=0; __i<nnz; __i++) sum += xv[__i] * r[xi[__i]];}
 #endif
 
-#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  #include <immintrin.h>
-  #if !defined(_MM_SCALE_8)
-  #define _MM_SCALE_8    8
-  #endif
-
+#if defined(PETSC_USE_AVX512_SPARSEDENSEDOT)
 PETSC_STATIC_INLINE void PetscSparseDensePlusDot_AVX512_Private(PetscScalar *sum,const PetscScalar *x,const MatScalar *aa,const PetscInt *aj,PetscInt n)
 {
   __m512d  vec_x,vec_y,vec_vals;
@@ -500,6 +558,56 @@ PETSC_STATIC_INLINE void PetscSparseDensePlusDot_AVX512_Private(PetscScalar *sum
   for(j=0;j<(n&0x07);j++) *sum += aa[j]*x[aj[j]];
 */
 }
+
+/* returns \sum_j aa[j]*x[aj[j]]; the remainder is handled with scalar code since masked gathers need AVX-512VL on KNL */
+PETSC_STATIC_INLINE PetscScalar PetscSparseDenseDot_AVX512_Private(const PetscScalar *x,const MatScalar *aa,const PetscInt *aj,PetscInt n)
+{
+  __m512d     vec_x,vec_y,vec_vals;
+  __m256i     vec_idx;
+  PetscScalar sum = 0.0;
+  PetscInt    j;
+
+  if (n >= 8) {
+    vec_y = _mm512_setzero_pd();
+    for (j=0; j<(n>>3); j++) {
+      vec_idx  = _mm256_loadu_si256((__m256i const*)aj);
+      vec_vals = _mm512_loadu_pd(aa);
+      vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
+      vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y);
+      aj += 8; aa += 8;
+    }
+    sum = _mm512_reduce_add_pd(vec_y);
+  }
+  for (j=0; j<(n&0x07); j++) sum += aa[j]*x[aj[j]];
+  return sum;
+}
+#endif
+
+#if defined(PETSC_USE_AVX2_SPARSEDENSEDOT)
+/* returns \sum_j aa[j]*x[aj[j]] */
+PETSC_STATIC_INLINE PetscScalar PetscSparseDenseDot_AVX2_Private(const PetscScalar *x,const MatScalar *aa,const PetscInt *aj,PetscInt n)
+{
+  __m256d     vec_x,vec_y,vec_vals;
+  __m128i     vec_idx;
+  __m128d     lo;
+  PetscScalar sum = 0.0;
+  PetscInt    j;
+
+  if (n >= 4) {
+    vec_y = _mm256_setzero_pd();
+    for (j=0; j<(n>>2); j++) {
+      vec_idx  = _mm_loadu_si128((__m128i const*)aj);
+      vec_vals = _mm256_loadu_pd(aa);
+      vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8);
+      vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y);
+      aj += 4; aa += 4;
+    }
+    lo  = _mm_add_pd(_mm256_castpd256_pd128(vec_y),_mm256_extractf128_pd(vec_y,1));
+    sum = _mm_cvtsd_f64(_mm_add_sd(lo,_mm_unpackhi_pd(lo,lo)));
+  }
+  for (j=0; j<(n&0x03); j++) sum += aa[j]*x[aj[j]];
+  return sum;
+}
 #endif
 
 /*
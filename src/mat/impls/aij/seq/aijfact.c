@@ -445,6 +445,151 @@ PetscErrorCode MatFactorDumpMatrix(Mat A)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSeqAIJLevelsDestroy_Private(Mat_SeqAIJ_Levels **levels)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*levels) PetscFunctionReturn(0);
+  ierr = PetscFree2((*levels)->level[0],(*levels)->rows[0]);CHKERRQ(ierr);
+  ierr = PetscFree2((*levels)->level[1],(*levels)->rows[1]);CHKERRQ(ierr);
+  ierr = PetscFree3((*levels)->ti,(*levels)->tj,(*levels)->tpos);CHKERRQ(ierr);
+  ierr = PetscFree((*levels)->work);CHKERRQ(ierr);
+  ierr = PetscFree(*levels);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJLevelsView_Private(Mat_SeqAIJ_Levels *levels,PetscInt n,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!levels) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"using level-scheduled triangular solves with %D threads\n",levels->nthreads);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"  forward solve %D levels, average parallelism %g rows per level\n",levels->nlevels[0],levels->nlevels[0] ? (double)n/levels->nlevels[0] : 0.0);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"  backward solve %D levels, average parallelism %g rows per level\n",levels->nlevels[1],levels->nlevels[1] ? (double)n/levels->nlevels[1] : 0.0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   MatSeqAIJLevelsBucket_Private - Given the level lev[i] of each of the n rows, sorts the rows by level;
+   the rows of a level stay in increasing order
+*/
+static PetscErrorCode MatSeqAIJLevelsBucket_Private(Mat_SeqAIJ_Levels *levels,PetscInt s,PetscInt n,const PetscInt lev[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i,nl = 0,*level,*rows;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) nl = PetscMax(nl,lev[i]+1);
+  ierr = PetscMalloc2(nl+1,&level,n,&rows);CHKERRQ(ierr);
+  ierr = PetscMemzero(level,(nl+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) level[lev[i]+1]++;
+  for (i=0; i<nl; i++) level[i+1] += level[i];
+  for (i=0; i<n; i++) rows[level[lev[i]]++] = i;
+  for (i=nl; i>0; i--) level[i] = level[i-1];
+  level[0] = 0;
+
+  levels->nlevels[s] = nl;
+  levels->level[s]   = level;
+  levels->rows[s]    = rows;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqAIJSetUpLevels_Private - Computes the level schedule of the L and U solves of a factored SeqAIJ matrix.
+   A row of L is in the level after the last level of the rows it couples to, a row of U likewise
+   with the rows taken in reverse order.
+*/
+static PetscErrorCode MatSeqAIJSetUpLevels_Private(Mat fact,PetscInt nthreads)
+{
+  Mat_SeqAIJ        *b = (Mat_SeqAIJ*)fact->data;
+  Mat_SeqAIJ_Levels *levels;
+  PetscErrorCode    ierr;
+  const PetscInt    n = fact->rmap->n,*ai = b->i,*aj = b->j,*adiag = b->diag;
+  PetscInt          i,j,*lev;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJLevelsDestroy_Private(&b->levels);CHKERRQ(ierr);
+  ierr = PetscNew(&levels);CHKERRQ(ierr);
+  levels->nthreads = nthreads;
+  ierr = PetscMalloc1(n+1,&lev);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    lev[i] = 0;
+    for (j=ai[i]; j<ai[i+1]; j++) lev[i] = PetscMax(lev[i],lev[aj[j]]+1);
+  }
+  ierr = MatSeqAIJLevelsBucket_Private(levels,0,n,lev);CHKERRQ(ierr);
+  for (i=n-1; i>=0; i--) {
+    lev[i] = 0;
+    for (j=adiag[i+1]+1; j<adiag[i]; j++) lev[i] = PetscMax(lev[i],lev[aj[j]]+1);
+  }
+  ierr = MatSeqAIJLevelsBucket_Private(levels,1,n,lev);CHKERRQ(ierr);
+  ierr = PetscFree(lev);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)fact,(2*n+levels->nlevels[0]+levels->nlevels[1]+2)*sizeof(PetscInt));CHKERRQ(ierr);
+  b->levels = levels;
+  ierr = PetscInfo4(fact,"Level-scheduled triangular solves on %D threads: %D forward and %D backward levels for %D rows\n",nthreads,levels->nlevels[0],levels->nlevels[1],n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSeqSBAIJSetUpLevels_Private - Computes the level schedule of the U^T D and U solves of a SeqSBAIJ matrix
+   obtained with MatCholeskyFactorNumeric_SeqAIJ(). The forward solve with U^T is done by columns of U, so
+   the transpose of the nonzero structure of U is stored as well.
+*/
+static PetscErrorCode MatSeqSBAIJSetUpLevels_Private(Mat fact,PetscInt nthreads)
+{
+  Mat_SeqSBAIJ      *b = (Mat_SeqSBAIJ*)fact->data;
+  Mat_SeqAIJ_Levels *levels;
+  PetscErrorCode    ierr;
+  const PetscInt    n = b->mbs,*ai = b->i,*aj = b->j;
+  PetscInt          i,j,k,nz,*lev,*ti,*tj,*tpos;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJLevelsDestroy_Private(&b->levels);CHKERRQ(ierr);
+  ierr = PetscNew(&levels);CHKERRQ(ierr);
+  levels->nthreads = nthreads;
+  ierr = PetscMalloc1(n+1,&lev);CHKERRQ(ierr);
+
+  /* transpose of the strict upper triangular part; the diagonal is the last entry of each row */
+  nz   = ai[n] - n;
+  ierr = PetscMalloc3(n+1,&ti,nz,&tj,nz,&tpos);CHKERRQ(ierr);
+  ierr = PetscMemzero(ti,(n+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (j=ai[i]; j<ai[i+1]-1; j++) ti[aj[j]+1]++;
+  }
+  for (i=0; i<n; i++) ti[i+1] += ti[i];
+  for (i=0; i<n; i++) lev[i] = ti[i];
+  for (i=0; i<n; i++) {
+    for (j=ai[i]; j<ai[i+1]-1; j++) {
+      k       = lev[aj[j]]++;
+      tj[k]   = i;
+      tpos[k] = j;
+    }
+  }
+  levels->ti   = ti;
+  levels->tj   = tj;
+  levels->tpos = tpos;
+
+  for (i=0; i<n; i++) {
+    lev[i] = 0;
+    for (j=ti[i]; j<ti[i+1]; j++) lev[i] = PetscMax(lev[i],lev[tj[j]]+1);
+  }
+  ierr = MatSeqAIJLevelsBucket_Private(levels,0,n,lev);CHKERRQ(ierr);
+  for (i=n-1; i>=0; i--) {
+    lev[i] = 0;
+    for (j=ai[i]; j<ai[i+1]-1; j++) lev[i] = PetscMax(lev[i],lev[aj[j]]+1);
+  }
+  ierr = MatSeqAIJLevelsBucket_Private(levels,1,n,lev);CHKERRQ(ierr);
+  ierr = PetscFree(lev);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&levels->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)fact,(3*n+2*nz+levels->nlevels[0]+levels->nlevels[1]+3)*sizeof(PetscInt)+n*sizeof(PetscScalar));CHKERRQ(ierr);
+  b->levels = levels;
+  ierr = PetscInfo4(fact,"Level-scheduled triangular solves on %D threads: %D forward and %D backward levels for %D rows\n",nthreads,levels->nlevels[0],levels->nlevels[1],n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
 {
   Mat             C     =B;
@@ -592,6 +737,12 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->nthreads > 1) {
+    ierr          = MatSeqAIJSetUpLevels_Private(C,a->nthreads);CHKERRQ(ierr);
+    C->ops->solve = MatSolve_SeqAIJ_Levels;
+  }
+#endif
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
@@ -2168,6 +2319,13 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *
     B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1;
     B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1;
   }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->nthreads > 1) {
+    ierr                   = MatSeqSBAIJSetUpLevels_Private(B,a->nthreads);CHKERRQ(ierr);
+    B->ops->solve          = MatSolve_SeqSBAIJ_1_Levels;
+    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_Levels;
+  }
+#endif
 
   C->assembled    = PETSC_TRUE;
   C->preallocated = PETSC_TRUE;
@@ -3196,6 +3354,82 @@ PetscErrorCode MatSolve_SeqAIJ(Mat A,Vec bb,Vec xx)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   MatSolve_SeqAIJ_Levels - MatSolve_SeqAIJ() with the rows of each level of the L and U solves divided
+   among the threads; the implicit barrier at the end of each omp for separates the levels
+*/
+PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Levels *levels = a->levels;
+  IS                iscol = a->col,isrow = a->row;
+  PetscErrorCode    ierr;
+  const PetscInt    *ai = a->i,*aj = a->j,*adiag = a->diag;
+  const PetscInt    *rout,*cout,*r,*c;
+  PetscScalar       *x,*tmp;
+  const PetscScalar *b;
+  const MatScalar   *aa = a->a;
+
+  PetscFunctionBegin;
+  if (!A->rmap->n) PetscFunctionReturn(0);
+  if (!levels) {
+    ierr = MatSolve_SeqAIJ(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  tmp  = a->solve_work;
+
+  ierr = ISGetIndices(isrow,&rout);CHKERRQ(ierr); r = rout;
+  ierr = ISGetIndices(iscol,&cout);CHKERRQ(ierr); c = cout;
+
+#pragma omp parallel num_threads(levels->nthreads)
+  {
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar     sum;
+    PetscInt        l,k,i,nz;
+
+    /* forward solve the lower triangular */
+    for (l=0; l<levels->nlevels[0]; l++) {
+#pragma omp for schedule(static)
+      for (k=levels->level[0][l]; k<levels->level[0][l+1]; k++) {
+        i   = levels->rows[0][k];
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        nz  = ai[i+1] - ai[i];
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        tmp[i] = sum;
+      }
+    }
+
+    /* backward solve the upper triangular */
+    for (l=0; l<levels->nlevels[1]; l++) {
+#pragma omp for schedule(static)
+      for (k=levels->level[1][l]; k<levels->level[1][l+1]; k++) {
+        i   = levels->rows[1][k];
+        v   = aa + adiag[i+1]+1;
+        vi  = aj + adiag[i+1]+1;
+        nz  = adiag[i]-adiag[i+1]-1;
+        sum = tmp[i];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+      }
+    }
+  }
+
+  ierr = ISRestoreIndices(isrow,&rout);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(iscol,&cout);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 /*
     This will get a new name and become a varient of MatILUFactor_SeqAIJ() there is no longer separate functions in the matrix function table for dt factors
 */
@@ -2719,6 +2719,67 @@ PetscErrorCode MatColoringPatch_SeqAIJ_Inode(Mat mat,PetscInt ncolors,PetscInt n
 
 #include <petsc/private/kernels/blockinvert.h>
 
+#if defined(PETSC_USE_AVX512_SPARSEDENSEDOT) || defined(PETSC_USE_AVX2_SPARSEDENSEDOT)
+#define PETSC_USE_INODE_SOR_KERNEL
+/*
+   MatInodeMinusDot_Private - For the nr rows of an inode, which share the column indices idx[0:n], computes
+   sum[k] -= v[k][0:n] . x[idx[0:n]]; each gathered vector of x entries is used by all the rows of the node.
+   On return idx and v[k] point past the n entries, as the scalar loops of MatSOR_SeqAIJ_Inode() leave them.
+*/
+PETSC_STATIC_INLINE void MatInodeMinusDot_Private(PetscInt nr,PetscInt n,const PetscScalar *x,const PetscInt **idx,const MatScalar **v,PetscScalar *sum)
+{
+  const PetscInt *ix = *idx;
+  PetscInt       j = 0,k;
+  PetscScalar    xj;
+#if defined(PETSC_USE_AVX512_SPARSEDENSEDOT)
+  __m512d        vec_x,vec_s[5];
+  __m256i        vec_idx;
+
+  for (k=0; k<nr; k++) vec_s[k] = _mm512_setzero_pd();
+  for (; j+8<=n; j+=8) {
+    vec_idx = _mm256_loadu_si256((__m256i const*)(ix+j));
+    vec_x   = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8);
+    for (k=0; k<nr; k++) vec_s[k] = _mm512_fmadd_pd(_mm512_loadu_pd(v[k]+j),vec_x,vec_s[k]);
+  }
+  if (j) for (k=0; k<nr; k++) sum[k] -= _mm512_reduce_add_pd(vec_s[k]);
+#else
+  __m256d        vec_x,vec_s[5];
+  __m128i        vec_idx;
+  __m128d        lo;
+
+  for (k=0; k<nr; k++) vec_s[k] = _mm256_setzero_pd();
+  for (; j+4<=n; j+=4) {
+    vec_idx = _mm_loadu_si128((__m128i const*)(ix+j));
+    vec_x   = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8);
+    for (k=0; k<nr; k++) vec_s[k] = _mm256_fmadd_pd(_mm256_loadu_pd(v[k]+j),vec_x,vec_s[k]);
+  }
+  if (j) {
+    for (k=0; k<nr; k++) {
+      lo      = _mm_add_pd(_mm256_castpd256_pd128(vec_s[k]),_mm256_extractf128_pd(vec_s[k],1));
+      sum[k] -= _mm_cvtsd_f64(_mm_add_sd(lo,_mm_unpackhi_pd(lo,lo)));
+    }
+  }
+#endif
+  for (; j<n; j++) {
+    xj = x[ix[j]];
+    for (k=0; k<nr; k++) sum[k] -= v[k][j]*xj;
+  }
+  *idx = ix + n;
+  for (k=0; k<nr; k++) v[k] += n;
+}
+
+/* applies MatInodeMinusDot_Private() to the sum1,...,sum5 and v1,...,v5 variables of MatSOR_SeqAIJ_Inode() */
+#define MatInodeSORMinusDot(nr,n) do {                                              \
+    const MatScalar *_v[5];                                                         \
+    PetscScalar     _s[5];                                                          \
+    _v[0] = v1;   _v[1] = v2;   _v[2] = v3;   _v[3] = v4;   _v[4] = v5;             \
+    _s[0] = sum1; _s[1] = sum2; _s[2] = sum3; _s[3] = sum4; _s[4] = sum5;           \
+    MatInodeMinusDot_Private(nr,n,x,&idx,_v,_s);                                    \
+    v1   = _v[0]; v2   = _v[1]; v3   = _v[2]; v4   = _v[3]; v5   = _v[4];           \
+    sum1 = _s[0]; sum2 = _s[1]; sum3 = _s[2]; sum4 = _s[3]; sum5 = _s[4];           \
+  } while (0)
+#endif
+
 PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -2820,6 +2881,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         case 1:
 
           sum1 = b[row];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(1,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -2833,6 +2897,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             tmp0  = x[*idx];
             sum1 -= *v1 * tmp0;
           }
+#endif
           t[row]   = sum1;
           x[row++] = sum1*(*ibdiag++);
           break;
@@ -2840,6 +2905,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v2   = a->a + ii[row+1];
           sum1 = b[row];
           sum2 = b[row+1];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(2,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -2855,6 +2923,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum1 -= v1[0] * tmp0;
             sum2 -= v2[0] * tmp0;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           x[row++] = sum1*ibdiag[0] + sum2*ibdiag[2];
@@ -2867,6 +2936,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum1 = b[row];
           sum2 = b[row+1];
           sum3 = b[row+2];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(3,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -2884,6 +2956,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum2 -= v2[0] * tmp0;
             sum3 -= v3[0] * tmp0;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           t[row+2] = sum3;
@@ -2900,6 +2973,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum2 = b[row+1];
           sum3 = b[row+2];
           sum4 = b[row+3];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(4,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -2919,6 +2995,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum3 -= v3[0] * tmp0;
             sum4 -= v4[0] * tmp0;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           t[row+2] = sum3;
@@ -2939,6 +3016,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum3 = b[row+2];
           sum4 = b[row+3];
           sum5 = b[row+4];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(5,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -2960,6 +3040,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum4 -= v4[0] * tmp0;
             sum5 -= v5[0] * tmp0;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           t[row+2] = sum3;
@@ -2994,6 +3075,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         case 1:
 
           sum1 = xb[row];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(1,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3007,6 +3091,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             tmp0  = x[*idx];
             sum1 -= *v1*tmp0;
           }
+#endif
           x[row--] = sum1*(*ibdiag);
           break;
 
@@ -3016,6 +3101,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum2 = xb[row-1];
           /* note that sum1 is associated with the second of the two rows */
           v2 = a->a + diag[row-1] + 2;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(2,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3031,6 +3119,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum1 -= *v1*tmp0;
             sum2 -= *v2*tmp0;
           }
+#endif
           x[row--] = sum2*ibdiag[1] + sum1*ibdiag[3];
           x[row--] = sum2*ibdiag[0] + sum1*ibdiag[2];
           break;
@@ -3041,6 +3130,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum3 = xb[row-2];
           v2   = a->a + diag[row-1] + 2;
           v3   = a->a + diag[row-2] + 3;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(3,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3058,6 +3150,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum2 -= *v2*tmp0;
             sum3 -= *v3*tmp0;
           }
+#endif
           x[row--] = sum3*ibdiag[2] + sum2*ibdiag[5] + sum1*ibdiag[8];
           x[row--] = sum3*ibdiag[1] + sum2*ibdiag[4] + sum1*ibdiag[7];
           x[row--] = sum3*ibdiag[0] + sum2*ibdiag[3] + sum1*ibdiag[6];
@@ -3071,6 +3164,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v2   = a->a + diag[row-1] + 2;
           v3   = a->a + diag[row-2] + 3;
           v4   = a->a + diag[row-3] + 4;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(4,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3090,6 +3186,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum3 -= *v3*tmp0;
             sum4 -= *v4*tmp0;
           }
+#endif
           x[row--] = sum4*ibdiag[3] + sum3*ibdiag[7] + sum2*ibdiag[11] + sum1*ibdiag[15];
           x[row--] = sum4*ibdiag[2] + sum3*ibdiag[6] + sum2*ibdiag[10] + sum1*ibdiag[14];
           x[row--] = sum4*ibdiag[1] + sum3*ibdiag[5] + sum2*ibdiag[9] + sum1*ibdiag[13];
@@ -3106,6 +3203,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v3   = a->a + diag[row-2] + 3;
           v4   = a->a + diag[row-3] + 4;
           v5   = a->a + diag[row-4] + 5;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(5,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3127,6 +3227,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum4 -= *v4*tmp0;
             sum5 -= *v5*tmp0;
           }
+#endif
           x[row--] = sum5*ibdiag[4] + sum4*ibdiag[9] + sum3*ibdiag[14] + sum2*ibdiag[19] + sum1*ibdiag[24];
           x[row--] = sum5*ibdiag[3] + sum4*ibdiag[8] + sum3*ibdiag[13] + sum2*ibdiag[18] + sum1*ibdiag[23];
           x[row--] = sum5*ibdiag[2] + sum4*ibdiag[7] + sum3*ibdiag[12] + sum2*ibdiag[17] + sum1*ibdiag[22];
@@ -3156,6 +3257,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         switch (sizes[i]) {
         case 1:
           sum1 = b[row];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(1,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3169,10 +3273,14 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum1 -= *v1 * tmp0;
             v1++;
           }
+#endif
           t[row]   = sum1;
           sz      = ii[row+1] - diag[row] - 1;
           idx     = a->j + diag[row] + 1;
           v1 += 1;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(1,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3185,6 +3293,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             tmp0  = x[*idx++];
             sum1 -= *v1 * tmp0;
           }
+#endif
           /* in MatSOR_SeqAIJ this line would be
            *
            * x[row] = (1-omega)*x[row]+(sum1+(*bdiag++)*x[row])*(*ibdiag++);
@@ -3200,6 +3309,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v2   = a->a + ii[row+1];
           sum1 = b[row];
           sum2 = b[row+1];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(2,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3215,12 +3327,16 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum2 -= v2[0] * tmp0;
             v1++; v2++;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           sz      = ii[row+1] - diag[row] - 2;
           idx     = a->j + diag[row] + 2;
           v1 += 2;
           v2 += 2;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(2,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3235,6 +3351,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum1 -= v1[0] * tmp0;
             sum2 -= v2[0] * tmp0;
           }
+#endif
           x[row] = sum1*ibdiag[0] + sum2*ibdiag[2];
           x[row+1] = sum1*ibdiag[1] + sum2*ibdiag[3];
           break;
@@ -3244,6 +3361,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum1 = b[row];
           sum2 = b[row+1];
           sum3 = b[row+2];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(3,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3261,6 +3381,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum3 -= v3[0] * tmp0;
             v1++; v2++; v3++;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           t[row+2] = sum3;
@@ -3269,6 +3390,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v1 += 3;
           v2 += 3;
           v3 += 3;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(3,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3285,6 +3409,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum2 -= v2[0] * tmp0;
             sum3 -= v3[0] * tmp0;
           }
+#endif
           x[row] = sum1*ibdiag[0] + sum2*ibdiag[3] + sum3*ibdiag[6];
           x[row+1] = sum1*ibdiag[1] + sum2*ibdiag[4] + sum3*ibdiag[7];
           x[row+2] = sum1*ibdiag[2] + sum2*ibdiag[5] + sum3*ibdiag[8];
@@ -3297,6 +3422,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum2 = b[row+1];
           sum3 = b[row+2];
           sum4 = b[row+3];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(4,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3316,6 +3444,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum4 -= v4[0] * tmp0;
             v1++; v2++; v3++; v4++;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           t[row+2] = sum3;
@@ -3326,6 +3455,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v2 += 4;
           v3 += 4;
           v4 += 4;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(4,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3344,6 +3476,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum3 -= v3[0] * tmp0;
             sum4 -= v4[0] * tmp0;
           }
+#endif
           x[row] =   sum1*ibdiag[0] + sum2*ibdiag[4] + sum3*ibdiag[8] + sum4*ibdiag[12];
           x[row+1] = sum1*ibdiag[1] + sum2*ibdiag[5] + sum3*ibdiag[9] + sum4*ibdiag[13];
           x[row+2] = sum1*ibdiag[2] + sum2*ibdiag[6] + sum3*ibdiag[10] + sum4*ibdiag[14];
@@ -3359,6 +3492,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum3 = b[row+2];
           sum4 = b[row+3];
           sum5 = b[row+4];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(5,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3380,6 +3516,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum5 -= v5[0] * tmp0;
             v1++; v2++; v3++; v4++; v5++;
           }
+#endif
           t[row]   = sum1;
           t[row+1] = sum2;
           t[row+2] = sum3;
@@ -3392,6 +3529,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           v3 += 5;
           v4 += 5;
           v5 += 5;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+          MatInodeSORMinusDot(5,sz);
+#else
           for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3412,6 +3552,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum4 -= v4[0] * tmp0;
             sum5 -= v5[0] * tmp0;
           }
+#endif
           x[row]   = sum1*ibdiag[0] + sum2*ibdiag[5] + sum3*ibdiag[10] + sum4*ibdiag[15] + sum5*ibdiag[20];
           x[row+1] = sum1*ibdiag[1] + sum2*ibdiag[6] + sum3*ibdiag[11] + sum4*ibdiag[16] + sum5*ibdiag[21];
           x[row+2] = sum1*ibdiag[2] + sum2*ibdiag[7] + sum3*ibdiag[12] + sum4*ibdiag[17] + sum5*ibdiag[22];
@@ -3484,6 +3625,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum1 = xb[row];
         }
         /* do sums */
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+        MatInodeSORMinusDot(sizes[i],sz);
+#else
         for (n = 0; n<sz-1; n+=2) {
             i1    = idx[0];
             i2    = idx[1];
@@ -3519,6 +3663,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
             sum1 -= *v1*tmp0;
           }
         }
+#endif
         /* update */
         if (xb == b) {
           /* whole (old way) w/ diag */
@@ -3602,6 +3747,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
       case 1:
 
         sum1 = b[row];
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+        MatInodeSORMinusDot(1,sz);
+#else
         for (n = 0; n<sz-1; n+=2) {
           i1    = idx[0];
           i2    = idx[1];
@@ -3615,6 +3763,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           tmp0  = x[*idx];
           sum1 -= *v1*tmp0;
         }
+#endif
         x[row] = sum1*(*ibdiag);row--;
         break;
 
@@ -3624,6 +3773,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         sum2 = b[row-1];
         /* note that sum1 is associated with the second of the two rows */
         v2 = a->a + diag[row-1] + 2;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+        MatInodeSORMinusDot(2,sz);
+#else
         for (n = 0; n<sz-1; n+=2) {
           i1    = idx[0];
           i2    = idx[1];
@@ -3639,6 +3791,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum1 -= *v1*tmp0;
           sum2 -= *v2*tmp0;
         }
+#endif
         x[row]   = sum2*ibdiag[1] + sum1*ibdiag[3];
         x[row-1] = sum2*ibdiag[0] + sum1*ibdiag[2];
         row     -= 2;
@@ -3650,6 +3803,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         sum3 = b[row-2];
         v2   = a->a + diag[row-1] + 2;
         v3   = a->a + diag[row-2] + 3;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+        MatInodeSORMinusDot(3,sz);
+#else
         for (n = 0; n<sz-1; n+=2) {
           i1    = idx[0];
           i2    = idx[1];
@@ -3667,6 +3823,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum2 -= *v2*tmp0;
           sum3 -= *v3*tmp0;
         }
+#endif
         x[row]   = sum3*ibdiag[2] + sum2*ibdiag[5] + sum1*ibdiag[8];
         x[row-1] = sum3*ibdiag[1] + sum2*ibdiag[4] + sum1*ibdiag[7];
         x[row-2] = sum3*ibdiag[0] + sum2*ibdiag[3] + sum1*ibdiag[6];
@@ -3681,6 +3838,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         v2   = a->a + diag[row-1] + 2;
         v3   = a->a + diag[row-2] + 3;
         v4   = a->a + diag[row-3] + 4;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+        MatInodeSORMinusDot(4,sz);
+#else
         for (n = 0; n<sz-1; n+=2) {
           i1    = idx[0];
           i2    = idx[1];
@@ -3700,6 +3860,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum3 -= *v3*tmp0;
           sum4 -= *v4*tmp0;
         }
+#endif
         x[row]   = sum4*ibdiag[3] + sum3*ibdiag[7] + sum2*ibdiag[11] + sum1*ibdiag[15];
         x[row-1] = sum4*ibdiag[2] + sum3*ibdiag[6] + sum2*ibdiag[10] + sum1*ibdiag[14];
         x[row-2] = sum4*ibdiag[1] + sum3*ibdiag[5] + sum2*ibdiag[9] + sum1*ibdiag[13];
@@ -3717,6 +3878,9 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
         v3   = a->a + diag[row-2] + 3;
         v4   = a->a + diag[row-3] + 4;
         v5   = a->a + diag[row-4] + 5;
+#if defined(PETSC_USE_INODE_SOR_KERNEL)
+        MatInodeSORMinusDot(5,sz);
+#else
         for (n = 0; n<sz-1; n+=2) {
           i1    = idx[0];
           i2    = idx[1];
@@ -3738,6 +3902,7 @@ PetscErrorCode MatSOR_SeqAIJ_Inode(Mat A,Vec bb,PetscReal omega,MatSORType flag,
           sum4 -= *v4*tmp0;
           sum5 -= *v5*tmp0;
         }
+#endif
         x[row]   = sum5*ibdiag[4] + sum4*ibdiag[9] + sum3*ibdiag[14] + sum2*ibdiag[19] + sum1*ibdiag[24];
         x[row-1] = sum5*ibdiag[3] + sum4*ibdiag[8] + sum3*ibdiag[13] + sum2*ibdiag[18] + sum1*ibdiag[23];
         x[row-2] = sum5*ibdiag[2] + sum4*ibdiag[7] + sum3*ibdiag[12] + sum2*ibdiag[17] + sum1*ibdiag[22];
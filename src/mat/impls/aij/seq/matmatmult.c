@@ -20,11 +20,11 @@ PETSC_INTERN PetscErrorCode MatMatMult_SeqAIJ_SeqAIJ(Mat A,Mat B,MatReuse scall,
 {
   PetscErrorCode ierr;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[6] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed"};
-  PetscInt       nalg = 6;
+  const char     *algTypes[9] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","hash","dense","auto"};
+  PetscInt       nalg = 9;
 #else
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","hypre"};
-  PetscInt       nalg = 7;
+  const char     *algTypes[10] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","hash","dense","auto","hypre"};
+  PetscInt       nalg = 10;
 #endif
   PetscInt       alg = 0; /* set default algorithm */
 
@@ -51,8 +51,17 @@ PETSC_INTERN PetscErrorCode MatMatMult_SeqAIJ_SeqAIJ(Mat A,Mat B,MatReuse scall,
     case 5:
       ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(A,B,fill,C);CHKERRQ(ierr);
       break;
-#if defined(PETSC_HAVE_HYPRE)
     case 6:
+      ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(A,B,fill,C);CHKERRQ(ierr);
+      break;
+    case 7:
+      ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Dense(A,B,fill,C);CHKERRQ(ierr);
+      break;
+    case 8:
+      ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Auto(A,B,fill,C);CHKERRQ(ierr);
+      break;
+#if defined(PETSC_HAVE_HYPRE)
+    case 9:
       ierr = MatMatMultSymbolic_AIJ_AIJ_wHYPRE(A,B,fill,C);CHKERRQ(ierr);
       break;
 #endif
@@ -812,6 +821,338 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat *
   PetscFunctionReturn(0);
 }
 
+/*
+   Row-accumulator products: each row of C is formed either in a hash table of at least twice the size of the row
+   (a power of two) or in a dense array of length B->cmap->n (Gustavson). The rows of A are split into contiguous
+   ranges of nearly equal work, one per -mat_aij_threads of A, and the symbolic phase counts each row of C before
+   filling it so the threads write disjoint parts of C.
+*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+#define MatMatMultHash_Private(key,mask) ((PetscInt)(((size_t)(key)*(size_t)2654435761U) & (size_t)(mask)))
+
+/* w[i] is the number of products contributing to row i of A*B, the sum of the lengths of the rows of B selected by row i of A */
+static PetscErrorCode MatMatMultRowWork_Private(Mat A,Mat B,PetscInt w[],PetscInt *wmax,PetscLogDouble *wsum)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  PetscInt   i,j,am = A->rmap->n;
+
+  PetscFunctionBegin;
+  *wmax = 0;
+  *wsum = 0.0;
+  for (i=0; i<am; i++) {
+    w[i] = 0;
+    for (j=a->i[i]; j<a->i[i+1]; j++) w[i] += b->i[a->j[j]+1] - b->i[a->j[j]];
+    *wmax  = PetscMax(*wmax,w[i]);
+    *wsum += w[i];
+  }
+  PetscFunctionReturn(0);
+}
+
+/* thread t forms the rows [rp[t],rp[t+1]); the work of a row is taken to be its number of products plus one */
+static PetscErrorCode MatMatMultRowPartition_Private(PetscInt m,const PetscInt w[],PetscLogDouble wsum,PetscInt nt,PetscInt rp[])
+{
+  PetscInt       t,r = 0;
+  PetscLogDouble work = 0.0;
+
+  PetscFunctionBegin;
+  rp[0] = 0;
+  for (t=1; t<nt; t++) {
+    while (r < m && work < t*(wsum+m)/nt) work += w[r++] + 1;
+    rp[t] = r;
+  }
+  rp[nt] = m;
+  PetscFunctionReturn(0);
+}
+
+/* size of the hash table for a row with at most n entries in the columns [0,bn) */
+PETSC_STATIC_INLINE PetscInt MatMatMultHashSize_Private(PetscInt n,PetscInt bn)
+{
+  PetscInt s = 16;
+
+  while (s < 2*PetscMin(n,bn)) s *= 2;
+  return s;
+}
+
+/*
+   Merges the rows of B selected by row i of A; returns the number of distinct columns and, if crow is given, puts them
+   in crow[] unsorted. A dense table marks each column with the last row that contained it, a hash table is cleared on return.
+*/
+PETSC_STATIC_INLINE PetscInt MatMatMultSymbolicRow_Private(const PetscInt ai[],const PetscInt aj[],const PetscInt bi[],const PetscInt bj[],PetscInt i,PetscInt w,PetscInt bn,PetscBool dense,PetscInt table[],PetscInt crow[])
+{
+  PetscInt j,k,col,h,mask = 0,cnz = 0;
+
+  if (!dense) mask = MatMatMultHashSize_Private(w,bn) - 1;
+  for (j=ai[i]; j<ai[i+1]; j++) {
+    for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+      col = bj[k];
+      if (dense) {
+        if (table[col] == i) continue;
+        table[col] = i;
+      } else {
+        for (h=MatMatMultHash_Private(col,mask); table[h] >= 0 && table[h] != col; h=(h+1)&mask) ;
+        if (table[h] == col) continue;
+        table[h] = col;
+      }
+      if (crow) crow[cnz] = col;
+      cnz++;
+    }
+  }
+  if (!dense) for (h=0; h<=mask; h++) table[h] = -1;
+  return cnz;
+}
+
+/*
+   Sorts the columns of a row of C; unlike PetscSortInt() it does not touch the PETSc function stack, so the threads
+   of the symbolic product can call it
+*/
+static void MatMatMultSortRow_Private(PetscInt n,PetscInt v[])
+{
+  PetscInt i,j,last,vl,tmp;
+
+  while (n > 8) { /* quicksort on the middle element, recursing into the smaller part */
+    tmp = v[0]; v[0] = v[n/2]; v[n/2] = tmp;
+    vl   = v[0];
+    last = 0;
+    for (i=1; i<n; i++) {
+      if (v[i] < vl) {last++; tmp = v[i]; v[i] = v[last]; v[last] = tmp;}
+    }
+    tmp = v[0]; v[0] = v[last]; v[last] = tmp;
+    if (last < n-1-last) {
+      MatMatMultSortRow_Private(last,v);
+      v += last+1; n -= last+1;
+    } else {
+      MatMatMultSortRow_Private(n-1-last,v+last+1);
+      n = last;
+    }
+  }
+  for (i=1; i<n; i++) { /* insertion sort of the short rows and of what the quicksort leaves */
+    vl = v[i];
+    for (j=i; j>0 && v[j-1] > vl; j--) v[j] = v[j-1];
+    v[j] = vl;
+  }
+}
+
+static PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowAccumulator(Mat A,Mat B,PetscReal fill,PetscBool dense,Mat *C)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c;
+  const PetscInt *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j;
+  PetscInt       am = A->rmap->N,bn = B->cmap->N,bm = B->rmap->N,nt = 1,i,t,pass,tsize,wmax,*w,*rp,*ci,*cj = NULL,*table;
+  PetscLogDouble wsum;
+  PetscReal      afill;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = a->nthreads;
+#endif
+  ierr  = PetscMalloc2(am,&w,nt+1,&rp);CHKERRQ(ierr);
+  ierr  = PetscMalloc1(am+1,&ci);CHKERRQ(ierr);
+  ierr  = MatMatMultRowWork_Private(A,B,w,&wmax,&wsum);CHKERRQ(ierr);
+  ierr  = MatMatMultRowPartition_Private(am,w,wsum,nt,rp);CHKERRQ(ierr);
+  tsize = dense ? bn : MatMatMultHashSize_Private(wmax,bn);
+  ierr  = PetscMalloc1(nt*tsize,&table);CHKERRQ(ierr);
+
+  /* the first pass counts the columns of each row of C, the second one puts them in cj */
+  ci[0] = 0;
+  for (pass=0; pass<2; pass++) {
+    for (i=0; i<nt*tsize; i++) table[i] = -1;
+    if (pass) {
+      for (i=0; i<am; i++) ci[i+1] += ci[i];
+      ierr = PetscMalloc1(ci[am]+1,&cj);CHKERRQ(ierr);
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1) private(i)
+#endif
+    for (t=0; t<nt; t++) {
+      for (i=rp[t]; i<rp[t+1]; i++) {
+        if (!pass) ci[i+1] = MatMatMultSymbolicRow_Private(ai,aj,bi,bj,i,w[i],bn,dense,table+t*tsize,NULL);
+        else {
+          MatMatMultSymbolicRow_Private(ai,aj,bi,bj,i,w[i],bn,dense,table+t*tsize,cj+ci[i]);
+          MatMatMultSortRow_Private(ci[i+1]-ci[i],cj+ci[i]);
+        }
+      }
+    }
+  }
+  ierr = PetscFree(table);CHKERRQ(ierr);
+  ierr = PetscFree2(w,rp);CHKERRQ(ierr);
+
+  /* put together the new symbolic matrix */
+  ierr = MatCreateSeqAIJWithArrays(PetscObjectComm((PetscObject)A),am,bn,ci,cj,NULL,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(*C,A,B);CHKERRQ(ierr);
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c                   = (Mat_SeqAIJ*)((*C)->data);
+  c->free_a           = PETSC_TRUE;
+  c->free_ij          = PETSC_TRUE;
+  c->nonew            = 0;
+  c->matmult_nthreads = nt;
+
+  (*C)->ops->matmultnumeric = dense ? MatMatMultNumeric_SeqAIJ_SeqAIJ_Dense : MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/(ai[am]+bi[bm]) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                     = ci[am];
+  c->nz                        = ci[am];
+  (*C)->info.mallocs           = 0;
+  (*C)->info.fill_ratio_given  = fill;
+  (*C)->info.fill_ratio_needed = afill;
+
+#if defined(PETSC_USE_INFO)
+  if (ci[am]) {
+    ierr = PetscInfo4((*C),"%s accumulator on %D threads; Fill ratio: given %g needed %g.\n",dense ? "Dense" : "Hash",nt,(double)fill,(double)afill);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo((*C),"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,PetscReal fill,Mat *C)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowAccumulator(A,B,fill,PETSC_FALSE,C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Dense(Mat A,Mat B,PetscReal fill,Mat *C)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowAccumulator(A,B,fill,PETSC_TRUE,C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Picks the accumulator from the shape of the product: the dense one while its arrays, one row of B->cmap->n entries
+   per thread, stay in cache or the rows of A*B are expected to fill a good part of such a row, the hash one otherwise.
+*/
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Auto(Mat A,Mat B,PetscReal fill,Mat *C)
+{
+  PetscErrorCode ierr;
+  PetscInt       am = A->rmap->n,bn = B->cmap->n,nt = 1,wmax,*w;
+  PetscLogDouble wsum;
+  PetscBool      dense;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = ((Mat_SeqAIJ*)A->data)->nthreads;
+#endif
+  ierr  = PetscMalloc1(am,&w);CHKERRQ(ierr);
+  ierr  = MatMatMultRowWork_Private(A,B,w,&wmax,&wsum);CHKERRQ(ierr);
+  ierr  = PetscFree(w);CHKERRQ(ierr);
+  dense = (PetscBool)(bn*sizeof(PetscScalar) <= 262144 || 16*wsum >= (PetscLogDouble)am*bn);
+  ierr  = PetscInfo5(A,"Rows of A*B have at most %D and on average %g products, B has %D columns: using the %s accumulator on %D threads\n",wmax,am ? wsum/am : 0.0,bn,dense ? "dense" : "hash",nt);CHKERRQ(ierr);
+  ierr  = MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowAccumulator(A,B,fill,dense,C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_RowAccumulator(Mat A,Mat B,Mat C,PetscBool dense)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c = (Mat_SeqAIJ*)C->data;
+  const PetscInt  *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*ci = c->i,*cj = c->j;
+  const MatScalar *aa = a->a,*ba = b->a;
+  PetscInt        am = A->rmap->N,bn = B->cmap->N,nt = PetscMax(c->matmult_nthreads,1),i,t,tsize = 0,wmax,*w,*rp,*keys = NULL,*pos = NULL;
+  PetscScalar     *ca,*acc = NULL;
+  PetscLogDouble  wsum;
+
+  PetscFunctionBegin;
+  if (!c->a) {
+    ierr      = PetscMalloc1(ci[am]+1,&c->a);CHKERRQ(ierr);
+    c->free_a = PETSC_TRUE;
+  }
+  ca   = c->a;
+  ierr = PetscMalloc2(am,&w,nt+1,&rp);CHKERRQ(ierr);
+  ierr = MatMatMultRowWork_Private(A,B,w,&wmax,&wsum);CHKERRQ(ierr);
+  ierr = MatMatMultRowPartition_Private(am,w,wsum,nt,rp);CHKERRQ(ierr);
+  if (dense) {
+    if (!c->matmult_abdense) {ierr = PetscCalloc1(nt*bn,&c->matmult_abdense);CHKERRQ(ierr);}
+    acc = c->matmult_abdense;
+  } else {
+    PetscInt cmax = 0;
+
+    for (i=0; i<am; i++) cmax = PetscMax(cmax,ci[i+1]-ci[i]);
+    tsize = MatMatMultHashSize_Private(cmax,bn);
+    ierr  = PetscMalloc2(nt*tsize,&keys,nt*tsize,&pos);CHKERRQ(ierr);
+    for (i=0; i<nt*tsize; i++) keys[i] = -1;
+  }
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for num_threads(nt) schedule(static,1) private(i)
+#endif
+  for (t=0; t<nt; t++) {
+    PetscInt    j,k,h,col,cnz,mask,*tkeys = dense ? NULL : keys + t*tsize,*tpos = dense ? NULL : pos + t*tsize;
+    PetscScalar av,*tacc = dense ? acc + t*bn : NULL,*crow;
+
+    for (i=rp[t]; i<rp[t+1]; i++) {
+      cnz  = ci[i+1] - ci[i];
+      crow = ca + ci[i];
+      if (dense) {
+        for (j=ai[i]; j<ai[i+1]; j++) {
+          av = aa[j];
+          for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) tacc[bj[k]] += av*ba[k];
+        }
+        for (k=0; k<cnz; k++) {
+          col       = cj[ci[i]+k];
+          crow[k]   = tacc[col];
+          tacc[col] = 0.0;
+        }
+      } else {
+        /* the hash table maps the columns of the row of C to their position */
+        mask = MatMatMultHashSize_Private(cnz,bn) - 1;
+        for (k=0; k<cnz; k++) {
+          col = cj[ci[i]+k];
+          for (h=MatMatMultHash_Private(col,mask); tkeys[h] >= 0; h=(h+1)&mask) ;
+          tkeys[h] = col;
+          tpos[h]  = k;
+          crow[k]  = 0.0;
+        }
+        for (j=ai[i]; j<ai[i+1]; j++) {
+          av = aa[j];
+          for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+            for (h=MatMatMultHash_Private(bj[k],mask); tkeys[h] != bj[k]; h=(h+1)&mask) ;
+            crow[tpos[h]] += av*ba[k];
+          }
+        }
+        for (h=0; h<=mask; h++) tkeys[h] = -1;
+      }
+    }
+  }
+  ierr = PetscFree2(keys,pos);CHKERRQ(ierr);
+  ierr = PetscFree2(w,rp);CHKERRQ(ierr);
+
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*wsum);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_RowAccumulator(A,B,C,PETSC_FALSE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Dense(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_RowAccumulator(A,B,C,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* This routine is not used. Should be removed! */
 PetscErrorCode MatMatTransposeMult_SeqAIJ_SeqAIJ(Mat A,Mat B,MatReuse scall,PetscReal fill,Mat *C)
 {
@@ -1154,174 +1495,86 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqDense(Mat A,Mat B,PetscReal fill,Mat
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqDense(Mat A,Mat B,Mat C)
+/*
+   MatMatMultNumeric_SeqAIJ_Interleaved_Private - computes (or adds, with ADD_VALUES) C = A*B for the k columns of B stored
+   interleaved: entry (r,l) of B is bt[r*ldbt + l]. C is stored by columns with leading dimension ldc.
+
+   Up to MATMATMULT_INTERLEAVE columns are formed in one pass over the rows of A, so for thin B the matrix is streamed once
+   for all the right hand sides instead of once per column (or per group of 4 columns).
+*/
+#define MATMATMULT_INTERLEAVE 16
+PetscErrorCode MatMatMultNumeric_SeqAIJ_Interleaved_Private(Mat A,PetscInt k,const PetscScalar *bt,PetscInt ldbt,PetscScalar *c,PetscInt ldc,InsertMode imode)
 {
-  Mat_SeqAIJ        *a=(Mat_SeqAIJ*)A->data;
-  Mat_SeqDense      *bd = (Mat_SeqDense*)B->data;
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       r[MATMATMULT_INTERLEAVE],aatmp;
+  const PetscScalar *aa,*bp;
+  const PetscInt    *aj,*ii = a->i,*ridx = NULL;
+  PetscInt          m = A->rmap->n,c0,nb,i,j,l,n,row;
   PetscErrorCode    ierr;
-  PetscScalar       *c,*b,r1,r2,r3,r4,*c1,*c2,*c3,*c4,aatmp;
-  const PetscScalar *aa,*b1,*b2,*b3,*b4;
-  const PetscInt    *aj;
-  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,am=A->rmap->n;
-  PetscInt          am4=4*am,bm4=4*bm,col,i,j,n,ajtmp;
 
   PetscFunctionBegin;
-  if (!cm || !cn) PetscFunctionReturn(0);
-  if (B->rmap->n != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number columns in A %D not equal rows in B %D\n",A->cmap->n,B->rmap->n);
-  if (A->rmap->n != C->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number rows in C %D not equal rows in A %D\n",C->rmap->n,A->rmap->n);
-  if (B->cmap->n != C->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number columns in B %D not equal columns in C %D\n",B->cmap->n,C->cmap->n);
-  b = bd->v;
-  ierr = MatDenseGetArray(C,&c);CHKERRQ(ierr);
-  b1 = b; b2 = b1 + bm; b3 = b2 + bm; b4 = b3 + bm;
-  c1 = c; c2 = c1 + am; c3 = c2 + am; c4 = c3 + am;
-  for (col=0; col<cn-4; col += 4) {  /* over columns of C */
-    for (i=0; i<am; i++) {        /* over rows of C in those columns */
-      r1 = r2 = r3 = r4 = 0.0;
-      n  = a->i[i+1] - a->i[i];
-      aj = a->j + a->i[i];
-      aa = a->a + a->i[i];
-      for (j=0; j<n; j++) {
-        aatmp = aa[j]; ajtmp = aj[j]; 
-        r1 += aatmp*b1[ajtmp]; 
-        r2 += aatmp*b2[ajtmp]; 
-        r3 += aatmp*b3[ajtmp]; 
-        r4 += aatmp*b4[ajtmp];
-      }
-      c1[i] = r1;
-      c2[i] = r2;
-      c3[i] = r3;
-      c4[i] = r4;
-    }
-    b1 += bm4; b2 += bm4; b3 += bm4; b4 += bm4;
-    c1 += am4; c2 += am4; c3 += am4; c4 += am4;
+  if (imode == ADD_VALUES && a->compressedrow.use) {
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
   }
-  for (; col<cn; col++) {   /* over extra columns of C */
-    for (i=0; i<am; i++) {  /* over rows of C in those columns */
-      r1 = 0.0;
-      n  = a->i[i+1] - a->i[i];
-      aj = a->j + a->i[i];
-      aa = a->a + a->i[i];
+  for (c0=0; c0<k; c0+=MATMATMULT_INTERLEAVE) {
+    nb = PetscMin(MATMATMULT_INTERLEAVE,k-c0);
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = a->a + ii[i];
+      row = ridx ? ridx[i] : i;
+      for (l=0; l<nb; l++) r[l] = 0.0;
       for (j=0; j<n; j++) {
-        r1 += aa[j]*b1[aj[j]]; 
+        aatmp = aa[j];
+        bp    = bt + aj[j]*ldbt + c0;
+        for (l=0; l<nb; l++) r[l] += aatmp*bp[l];
+      }
+      if (imode == ADD_VALUES) {
+        for (l=0; l<nb; l++) c[(c0+l)*ldc + row] += r[l];
+      } else {
+        for (l=0; l<nb; l++) c[(c0+l)*ldc + row] = r[l];
       }
-      c1[i] = r1;
     }
-    b1 += bm; 
-    c1 += am;
   }
-  ierr = PetscLogFlops(cn*(2.0*a->nz));CHKERRQ(ierr);
-  ierr = MatDenseRestoreArray(C,&c);CHKERRQ(ierr);
-  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(k*(2.0*a->nz));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-/*
-   Note very similar to MatMult_SeqAIJ(), should generate both codes from same base
-*/
-PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat C)
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqDense(Mat A,Mat B,Mat C)
 {
-  Mat_SeqAIJ     *a=(Mat_SeqAIJ*)A->data;
-  Mat_SeqDense   *bd = (Mat_SeqDense*)B->data;
-  PetscErrorCode ierr;
-  PetscScalar    *b,*c,r1,r2,r3,r4,*b1,*b2,*b3,*b4;
-  MatScalar      *aa;
-  PetscInt       cm  = C->rmap->n, cn=B->cmap->n, bm=bd->lda, col, i,j,n,*aj, am = A->rmap->n,*ii,arm;
-  PetscInt       am2 = 2*am, am3 = 3*am,  bm4 = 4*bm,colam,*ridx;
+  Mat_SeqDense      *bd = (Mat_SeqDense*)B->data,*cd = (Mat_SeqDense*)C->data;
+  PetscErrorCode    ierr;
+  PetscScalar       *c,*bt;
+  const PetscScalar *b;
+  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,brows=B->rmap->n,cl=cd->lda;
+  PetscInt          c0,nb,r,l;
 
   PetscFunctionBegin;
   if (!cm || !cn) PetscFunctionReturn(0);
-  b = bd->v;
+  if (B->rmap->n != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number columns in A %D not equal rows in B %D\n",A->cmap->n,B->rmap->n);
+  if (A->rmap->n != C->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number rows in C %D not equal rows in A %D\n",C->rmap->n,A->rmap->n);
+  if (B->cmap->n != C->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number columns in B %D not equal columns in C %D\n",B->cmap->n,C->cmap->n);
+  b    = bd->v;
   ierr = MatDenseGetArray(C,&c);CHKERRQ(ierr);
-  b1   = b; b2 = b1 + bm; b3 = b2 + bm; b4 = b3 + bm;
-
-  if (a->compressedrow.use) { /* use compressed row format */
-    for (col=0; col<cn-4; col += 4) {  /* over columns of C */
-      colam = col*am;
-      arm   = a->compressedrow.nrows;
-      ii    = a->compressedrow.i;
-      ridx  = a->compressedrow.rindex;
-      for (i=0; i<arm; i++) {        /* over rows of C in those columns */
-        r1 = r2 = r3 = r4 = 0.0;
-        n  = ii[i+1] - ii[i];
-        aj = a->j + ii[i];
-        aa = a->a + ii[i];
-        for (j=0; j<n; j++) {
-          r1 += (*aa)*b1[*aj];
-          r2 += (*aa)*b2[*aj];
-          r3 += (*aa)*b3[*aj];
-          r4 += (*aa++)*b4[*aj++];
-        }
-        c[colam       + ridx[i]] += r1;
-        c[colam + am  + ridx[i]] += r2;
-        c[colam + am2 + ridx[i]] += r3;
-        c[colam + am3 + ridx[i]] += r4;
-      }
-      b1 += bm4;
-      b2 += bm4;
-      b3 += bm4;
-      b4 += bm4;
-    }
-    for (; col<cn; col++) {     /* over extra columns of C */
-      colam = col*am;
-      arm   = a->compressedrow.nrows;
-      ii    = a->compressedrow.i;
-      ridx  = a->compressedrow.rindex;
-      for (i=0; i<arm; i++) {  /* over rows of C in those columns */
-        r1 = 0.0;
-        n  = ii[i+1] - ii[i];
-        aj = a->j + ii[i];
-        aa = a->a + ii[i];
-
-        for (j=0; j<n; j++) {
-          r1 += (*aa++)*b1[*aj++];
-        }
-        c[colam + ridx[i]] += r1;
-      }
-      b1 += bm;
-    }
+  if (cn == 1) {
+    ierr = MatMatMultNumeric_SeqAIJ_Interleaved_Private(A,1,b,1,c,cl,INSERT_VALUES);CHKERRQ(ierr);
   } else {
-    for (col=0; col<cn-4; col += 4) {  /* over columns of C */
-      colam = col*am;
-      for (i=0; i<am; i++) {        /* over rows of C in those columns */
-        r1 = r2 = r3 = r4 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = a->a + a->i[i];
-        for (j=0; j<n; j++) {
-          r1 += (*aa)*b1[*aj];
-          r2 += (*aa)*b2[*aj];
-          r3 += (*aa)*b3[*aj];
-          r4 += (*aa++)*b4[*aj++];
-        }
-        c[colam + i]       += r1;
-        c[colam + am + i]  += r2;
-        c[colam + am2 + i] += r3;
-        c[colam + am3 + i] += r4;
+    /* interleave a tile of columns of B so that each row of A is applied to all of them at once */
+    ierr = PetscMalloc1(brows*PetscMin(cn,MATMATMULT_INTERLEAVE),&bt);CHKERRQ(ierr);
+    for (c0=0; c0<cn; c0+=MATMATMULT_INTERLEAVE) {
+      nb = PetscMin(MATMATMULT_INTERLEAVE,cn-c0);
+      for (r=0; r<brows; r++) {
+        for (l=0; l<nb; l++) bt[r*nb+l] = b[(c0+l)*bm + r];
       }
-      b1 += bm4;
-      b2 += bm4;
-      b3 += bm4;
-      b4 += bm4;
-    }
-    for (; col<cn; col++) {     /* over extra columns of C */
-      colam = col*am;
-      for (i=0; i<am; i++) {  /* over rows of C in those columns */
-        r1 = 0.0;
-        n  = a->i[i+1] - a->i[i];
-        aj = a->j + a->i[i];
-        aa = a->a + a->i[i];
-
-        for (j=0; j<n; j++) {
-          r1 += (*aa++)*b1[*aj++];
-        }
-        c[colam + i] += r1;
-      }
-      b1 += bm;
+      ierr = MatMatMultNumeric_SeqAIJ_Interleaved_Private(A,nb,bt,nb,c+c0*cl,cl,INSERT_VALUES);CHKERRQ(ierr);
     }
+    ierr = PetscFree(bt);CHKERRQ(ierr);
   }
-  ierr = PetscLogFlops(cn*2.0*a->nz);CHKERRQ(ierr);
   ierr = MatDenseRestoreArray(C,&c);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
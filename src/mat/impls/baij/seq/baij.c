@@ -2823,6 +2823,9 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
   ierr = PetscOptionsBool("-mat_no_unroll","Do not optimize for block size (slow)",NULL,flg,&flg,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
 
+  B->ops->multtranspose    = MatMultTranspose_SeqBAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ;
+  B->ops->sor              = MatSOR_SeqBAIJ;
   if (!flg) {
     switch (bs) {
     case 1:
@@ -2846,29 +2849,84 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
       B->ops->multadd = MatMultAdd_SeqBAIJ_5;
       break;
     case 6:
-      B->ops->mult    = MatMult_SeqBAIJ_6;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_6;
+      B->ops->mult             = MatMult_SeqBAIJ_6;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_6;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_6_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_6_Fixed;
       break;
     case 7:
-      B->ops->mult    = MatMult_SeqBAIJ_7;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_7;
+      B->ops->mult             = MatMult_SeqBAIJ_7;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_7;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_7_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_7_Fixed;
+      break;
+    case 8:
+      B->ops->mult             = MatMult_SeqBAIJ_8_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_8_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_8_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_8_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_8_Fixed;
       break;
     case 9:
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
-      B->ops->mult    = MatMult_SeqBAIJ_9_AVX2;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_9_AVX2;
+      B->ops->mult             = MatMult_SeqBAIJ_9_AVX2;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_9_AVX2;
 #else
-      B->ops->mult    = MatMult_SeqBAIJ_N;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_N;
+      B->ops->mult             = MatMult_SeqBAIJ_9_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_9_Fixed;
 #endif
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_9_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_9_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_9_Fixed;
+      break;
+    case 10:
+      B->ops->mult             = MatMult_SeqBAIJ_10_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_10_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_10_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_10_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_10_Fixed;
       break;
     case 11:
-      B->ops->mult    = MatMult_SeqBAIJ_11;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_11;
+      B->ops->mult             = MatMult_SeqBAIJ_11;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_11;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_11_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_11_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_11_Fixed;
+      break;
+    case 12:
+      B->ops->mult             = MatMult_SeqBAIJ_12_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_12_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_12_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_12_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_12_Fixed;
+      break;
+    case 13:
+      B->ops->mult             = MatMult_SeqBAIJ_13_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_13_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_13_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_13_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_13_Fixed;
+      break;
+    case 14:
+      B->ops->mult             = MatMult_SeqBAIJ_14_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_14_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_14_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_14_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_14_Fixed;
       break;
     case 15:
-      B->ops->mult    = MatMult_SeqBAIJ_15_ver1;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_N;
+      B->ops->mult             = MatMult_SeqBAIJ_15_ver1;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_15_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_15_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_15_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_15_Fixed;
+      break;
+    case 16:
+      B->ops->mult             = MatMult_SeqBAIJ_16_Fixed;
+      B->ops->multadd          = MatMultAdd_SeqBAIJ_16_Fixed;
+      B->ops->multtranspose    = MatMultTranspose_SeqBAIJ_16_Fixed;
+      B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ_16_Fixed;
+      B->ops->sor              = MatSOR_SeqBAIJ_16_Fixed;
       break;
     default:
       B->ops->mult    = MatMult_SeqBAIJ_N;
@@ -2876,7 +2934,6 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
       break;
     }
   }
-  B->ops->sor = MatSOR_SeqBAIJ;
   b->mbs = mbs;
   b->nbs = nbs;
   if (!skipallocation) {
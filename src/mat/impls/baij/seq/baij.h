@@ -234,6 +234,27 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_7(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_9_AVX2(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_11(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_N(Mat,Vec,Vec,Vec);
+
+/* block size specific kernels generated from baijbs.h, see baijbs.c */
+#define MatSeqBAIJFixedPrototypes(bs) \
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_ ## bs ## _Fixed(Mat,Vec,Vec); \
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_ ## bs ## _Fixed(Mat,Vec,Vec,Vec); \
+PETSC_INTERN PetscErrorCode MatMultTranspose_SeqBAIJ_ ## bs ## _Fixed(Mat,Vec,Vec); \
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqBAIJ_ ## bs ## _Fixed(Mat,Vec,Vec,Vec); \
+PETSC_INTERN PetscErrorCode MatSOR_SeqBAIJ_ ## bs ## _Fixed(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec); \
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_ ## bs ## _NaturalOrdering_Fixed(Mat,Vec,Vec)
+MatSeqBAIJFixedPrototypes(6);
+MatSeqBAIJFixedPrototypes(7);
+MatSeqBAIJFixedPrototypes(8);
+MatSeqBAIJFixedPrototypes(9);
+MatSeqBAIJFixedPrototypes(10);
+MatSeqBAIJFixedPrototypes(11);
+MatSeqBAIJFixedPrototypes(12);
+MatSeqBAIJFixedPrototypes(13);
+MatSeqBAIJFixedPrototypes(14);
+MatSeqBAIJFixedPrototypes(15);
+MatSeqBAIJFixedPrototypes(16);
+
 PETSC_INTERN PetscErrorCode MatLoad_SeqBAIJ(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization_inplace(Mat,PetscBool);
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat,PetscBool);
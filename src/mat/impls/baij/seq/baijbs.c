@@ -0,0 +1,29 @@
+
+/*
+    Block size specific MatMult(), MatMultAdd(), MatMultTranspose(), MatMultTransposeAdd(), MatSOR() and
+    natural ordering MatSolve() for the SeqBAIJ block sizes that have no hand written kernels
+*/
+#include <../src/mat/impls/baij/seq/baij.h>
+
+#define BS 6
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 7
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 8
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 9
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 10
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 11
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 12
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 13
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 14
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 15
+#include <../src/mat/impls/baij/seq/baijbs.h>
+#define BS 16
+#include <../src/mat/impls/baij/seq/baijbs.h>
@@ -0,0 +1,395 @@
+/*
+     Defines the methods MatMult_SeqBAIJ_<BS>_Fixed(), MatMultAdd_SeqBAIJ_<BS>_Fixed(), MatMultTranspose(Add)_SeqBAIJ_<BS>_Fixed(),
+     MatSOR_SeqBAIJ_<BS>_Fixed() and MatSolve_SeqBAIJ_<BS>_NaturalOrdering_Fixed().
+     This is included by baijbs.c with different values for BS
+
+     Since BS is a compile time constant the loops over the block entries are unrolled and vectorized by
+     the compiler; the _N versions copy the x values of each block row into a work array and call BLAS instead.
+     The blocks are stored by columns so the innermost loops run over contiguous entries of a block column.
+*/
+#define PETSCMAP1_a(a,b,c)  a ## _ ## b ## c
+#define PETSCMAP1_b(a,b,c)  PETSCMAP1_a(a,b,c)
+#define PETSCMAP1(a)        PETSCMAP1_b(a,BS,_Fixed)
+#define PETSCMAP2(a)        PETSCMAP1_b(a,BS,_NaturalOrdering_Fixed)
+#define BS2                 (BS*BS)
+
+PetscErrorCode PETSCMAP1(MatMult_SeqBAIJ)(Mat A,Vec xx,Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z,*zarray,sum[BS],xv;
+  const PetscScalar *x,*xb;
+  const MatScalar   *v;
+  PetscErrorCode    ierr;
+  PetscInt          mbs,i,j,k,l,n;
+  const PetscInt    *idx,*ii,*ridx = NULL;
+  PetscBool         usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&zarray);CHKERRQ(ierr);
+
+  idx = a->j;
+  v   = a->a;
+  if (usecprow) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    ierr = PetscMemzero(zarray,BS*a->mbs*sizeof(PetscScalar));CHKERRQ(ierr);
+  } else {
+    mbs = a->mbs;
+    ii  = a->i;
+  }
+  z = zarray;
+
+  for (i=0; i<mbs; i++) {
+    n = ii[1] - ii[0]; ii++;
+    for (l=0; l<BS; l++) sum[l] = 0.0;
+    PetscPrefetchBlock(idx+n,n,0,PETSC_PREFETCH_HINT_NTA);       /* Indices for the next row (assumes same size as this one) */
+    PetscPrefetchBlock(v+BS2*n,BS2*n,0,PETSC_PREFETCH_HINT_NTA); /* Entries for the next row */
+    for (j=0; j<n; j++) {
+      xb = x + BS*(*idx++);
+      for (k=0; k<BS; k++) {
+        xv = xb[k];
+        for (l=0; l<BS; l++) sum[l] += v[l]*xv;
+        v += BS;
+      }
+    }
+    if (usecprow) z = zarray + BS*ridx[i];
+    for (l=0; l<BS; l++) z[l] = sum[l];
+    if (!usecprow) z += BS;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*BS2 - BS*a->nonzerorowcnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PETSCMAP1(MatMultAdd_SeqBAIJ)(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *y = 0,*z = 0,*yarray,*zarray,sum[BS],xv;
+  const PetscScalar *x,*xb;
+  const MatScalar   *v;
+  PetscErrorCode    ierr;
+  PetscInt          mbs = a->mbs,i,j,k,l,n;
+  const PetscInt    *idx,*ii,*ridx = NULL;
+  PetscBool         usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
+
+  idx = a->j;
+  v   = a->a;
+  if (usecprow) {
+    if (zz != yy) {
+      ierr = PetscMemcpy(zarray,yarray,BS*mbs*sizeof(PetscScalar));CHKERRQ(ierr);
+    }
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else {
+    ii = a->i;
+    y  = yarray;
+    z  = zarray;
+  }
+
+  for (i=0; i<mbs; i++) {
+    n = ii[1] - ii[0]; ii++;
+    if (usecprow) {
+      z = zarray + BS*ridx[i];
+      y = yarray + BS*ridx[i];
+    }
+    for (l=0; l<BS; l++) sum[l] = y[l];
+    PetscPrefetchBlock(idx+n,n,0,PETSC_PREFETCH_HINT_NTA);       /* Indices for the next row (assumes same size as this one) */
+    PetscPrefetchBlock(v+BS2*n,BS2*n,0,PETSC_PREFETCH_HINT_NTA); /* Entries for the next row */
+    for (j=0; j<n; j++) {
+      xb = x + BS*(*idx++);
+      for (k=0; k<BS; k++) {
+        xv = xb[k];
+        for (l=0; l<BS; l++) sum[l] += v[l]*xv;
+        v += BS;
+      }
+    }
+    for (l=0; l<BS; l++) z[l] = sum[l];
+    if (!usecprow) {
+      z += BS; y += BS;
+    }
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*BS2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PETSCMAP1(MatMultTransposeAdd_SeqBAIJ)(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z,*zb,sum;
+  const PetscScalar *x,*xb = NULL;
+  const MatScalar   *v;
+  PetscErrorCode    ierr;
+  PetscInt          mbs,i,j,k,l,n;
+  const PetscInt    *idx,*ii,*ridx = NULL;
+  PetscBool         usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  if (yy != zz) { ierr = VecCopy(yy,zz);CHKERRQ(ierr); }
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+
+  idx = a->j;
+  v   = a->a;
+  if (usecprow) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else {
+    mbs = a->mbs;
+    ii  = a->i;
+    xb  = x;
+  }
+
+  for (i=0; i<mbs; i++) {
+    n = ii[1] - ii[0]; ii++;
+    if (usecprow) xb = x + BS*ridx[i];
+    for (j=0; j<n; j++) {
+      zb = z + BS*(*idx++);
+      /* the transpose of the block applied to xb is the inner products of its columns with xb */
+      for (k=0; k<BS; k++) {
+        sum = 0.0;
+        for (l=0; l<BS; l++) sum += v[l]*xb[l];
+        zb[k] += sum;
+        v     += BS;
+      }
+    }
+    if (!usecprow) xb += BS;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*BS2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PETSCMAP1(MatMultTranspose_SeqBAIJ)(Mat A,Vec xx,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(zz,0.0);CHKERRQ(ierr);
+  ierr = PETSCMAP1(MatMultTransposeAdd_SeqBAIJ)(A,xx,zz,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Same algorithm and restrictions as MatSOR_SeqBAIJ(): omega = 1, no shift, the inverses of the
+   diagonal blocks are applied from a->idiag
+*/
+PetscErrorCode PETSCMAP1(MatSOR_SeqBAIJ)(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *x,*t,*xi,s[BS],xv;
+  const MatScalar   *v,*aa = a->a,*idiag;
+  const PetscScalar *b,*bt,*xb;
+  PetscErrorCode    ierr;
+  PetscInt          m = a->mbs,i,nz,j,k,l;
+  const PetscInt    *diag,*ai = a->i,*aj = a->j,*vi;
+
+  PetscFunctionBegin;
+  if (fshift == -1.0) fshift = 0.0; /* negative fshift indicates do not error on zero diagonal; this code never errors on zero diagonal */
+  its = its*lits;
+  if (flag & SOR_EISENSTAT) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support yet for Eisenstat");
+  if (its <= 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D and local its %D both positive",its,lits);
+  if (fshift) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Sorry, no support for diagonal shift");
+  if (omega != 1.0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Sorry, no support for non-trivial relaxation factor");
+  if ((flag & SOR_APPLY_UPPER) || (flag & SOR_APPLY_LOWER)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Sorry, no support for applying upper or lower triangular parts");
+
+  if (!a->idiagvalid) {ierr = MatInvertBlockDiagonal(A,NULL);CHKERRQ(ierr);}
+
+  if (!m) PetscFunctionReturn(0);
+  diag = a->diag;
+  if (!a->sor_workt) {
+    ierr = PetscMalloc1(PetscMax(A->rmap->n,A->cmap->n),&a->sor_workt);CHKERRQ(ierr);
+  }
+  t = a->sor_workt;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      idiag = a->idiag;
+      for (i=0; i<m; i++) {
+        v  = aa + BS2*ai[i];
+        vi = aj + ai[i];
+        nz = diag[i] - ai[i];
+        for (l=0; l<BS; l++) s[l] = b[BS*i+l];
+        for (j=0; j<nz; j++) {
+          xb = x + BS*vi[j];
+          for (k=0; k<BS; k++) {
+            xv = xb[k];
+            for (l=0; l<BS; l++) s[l] -= v[l]*xv;
+            v += BS;
+          }
+        }
+        /* save b - L x for the backward sweep */
+        xi = x + BS*i;
+        for (l=0; l<BS; l++) {t[BS*i+l] = s[l]; xi[l] = 0.0;}
+        for (k=0; k<BS; k++) {
+          for (l=0; l<BS; l++) xi[l] += idiag[l]*s[k];
+          idiag += BS;
+        }
+      }
+      /* for logging purposes assume number of nonzero in lower half is 1/2 of total */
+      ierr = PetscLogFlops(1.0*BS2*a->nz);CHKERRQ(ierr);
+      bt   = t;
+    } else bt = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      idiag = a->idiag+BS2*(m-1);
+      for (i=m-1; i>=0; i--) {
+        v  = aa + BS2*(diag[i]+1);
+        vi = aj + diag[i] + 1;
+        nz = ai[i+1] - diag[i] - 1;
+        for (l=0; l<BS; l++) s[l] = bt[BS*i+l];
+        for (j=0; j<nz; j++) {
+          xb = x + BS*vi[j];
+          for (k=0; k<BS; k++) {
+            xv = xb[k];
+            for (l=0; l<BS; l++) s[l] -= v[l]*xv;
+            v += BS;
+          }
+        }
+        xi = x + BS*i;
+        for (l=0; l<BS; l++) xi[l] = 0.0;
+        for (k=0; k<BS; k++) {
+          for (l=0; l<BS; l++) xi[l] += idiag[l]*s[k];
+          idiag += BS;
+        }
+        idiag -= 2*BS2;
+      }
+      ierr = PetscLogFlops(1.0*BS2*(a->nz));CHKERRQ(ierr);
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      idiag = a->idiag;
+      for (i=0; i<m; i++) {
+        v  = aa + BS2*ai[i];
+        vi = aj + ai[i];
+        nz = ai[i+1] - ai[i];
+        for (l=0; l<BS; l++) s[l] = b[BS*i+l];
+        for (j=0; j<nz; j++) {
+          xb = x + BS*vi[j];
+          for (k=0; k<BS; k++) {
+            xv = xb[k];
+            for (l=0; l<BS; l++) s[l] -= v[l]*xv;
+            v += BS;
+          }
+        }
+        xi = x + BS*i;
+        for (k=0; k<BS; k++) {
+          for (l=0; l<BS; l++) xi[l] += idiag[l]*s[k];
+          idiag += BS;
+        }
+      }
+      ierr = PetscLogFlops(2.0*BS2*a->nz);CHKERRQ(ierr);
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      idiag = a->idiag+BS2*(m-1);
+      for (i=m-1; i>=0; i--) {
+        v  = aa + BS2*ai[i];
+        vi = aj + ai[i];
+        nz = ai[i+1] - ai[i];
+        for (l=0; l<BS; l++) s[l] = b[BS*i+l];
+        for (j=0; j<nz; j++) {
+          xb = x + BS*vi[j];
+          for (k=0; k<BS; k++) {
+            xv = xb[k];
+            for (l=0; l<BS; l++) s[l] -= v[l]*xv;
+            v += BS;
+          }
+        }
+        xi = x + BS*i;
+        for (k=0; k<BS; k++) {
+          for (l=0; l<BS; l++) xi[l] += idiag[l]*s[k];
+          idiag += BS;
+        }
+        idiag -= 2*BS2;
+      }
+      ierr = PetscLogFlops(2.0*BS2*(a->nz));CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Solve with the factored matrix in the data structure of MatLUFactorNumeric_SeqBAIJ_N(): the rows of L (unit diagonal)
+   followed by the rows of U in reverse order, with the inverses of the diagonal blocks stored at adiag[i]
+*/
+PetscErrorCode PETSCMAP2(MatSolve_SeqBAIJ)(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscErrorCode    ierr;
+  const PetscInt    n = a->mbs,*ai = a->i,*aj = a->j,*adiag = a->diag,*vi;
+  PetscInt          i,j,k,l,nz;
+  const MatScalar   *aa = a->a,*v;
+  PetscScalar       *x,*xi,s[BS],xv;
+  const PetscScalar *b,*xb;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+
+  /* forward solve the lower triangular */
+  for (i=0; i<n; i++) {
+    v  = aa + BS2*ai[i];
+    vi = aj + ai[i];
+    nz = ai[i+1] - ai[i];
+    for (l=0; l<BS; l++) s[l] = b[BS*i+l];
+    for (j=0; j<nz; j++) {
+      xb = x + BS*vi[j];
+      for (k=0; k<BS; k++) {
+        xv = xb[k];
+        for (l=0; l<BS; l++) s[l] -= v[l]*xv;
+        v += BS;
+      }
+    }
+    for (l=0; l<BS; l++) x[BS*i+l] = s[l];
+  }
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v  = aa + BS2*(adiag[i+1]+1);
+    vi = aj + adiag[i+1]+1;
+    nz = adiag[i] - adiag[i+1] - 1;
+    xi = x + BS*i;
+    for (l=0; l<BS; l++) s[l] = xi[l];
+    for (j=0; j<nz; j++) {
+      xb = x + BS*vi[j];
+      for (k=0; k<BS; k++) {
+        xv = xb[k];
+        for (l=0; l<BS; l++) s[l] -= v[l]*xv;
+        v += BS;
+      }
+    }
+    /* v now points at the inverse of the diagonal block */
+    for (l=0; l<BS; l++) xi[l] = 0.0;
+    for (k=0; k<BS; k++) {
+      for (l=0; l<BS; l++) xi[l] += v[l]*s[k];
+      v += BS;
+    }
+  }
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*BS2*(a->nz) - BS*A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef PETSCMAP1_a
+#undef PETSCMAP1_b
+#undef PETSCMAP1
+#undef PETSCMAP2
+#undef BS2
+#undef BS
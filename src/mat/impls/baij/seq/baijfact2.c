@@ -236,13 +236,19 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_N(Mat B,Mat A,const MatFactorInfo *inf
   both_identity = (PetscBool) (row_identity && col_identity);
   if (both_identity) {
     switch (bs) {
+    case  8:
+      C->ops->solve = MatSolve_SeqBAIJ_8_NaturalOrdering_Fixed;
+      break;
     case  9:
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
       C->ops->solve = MatSolve_SeqBAIJ_9_NaturalOrdering;
 #else
-      C->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering;
+      C->ops->solve = MatSolve_SeqBAIJ_9_NaturalOrdering_Fixed;
 #endif
       break;
+    case 10:
+      C->ops->solve = MatSolve_SeqBAIJ_10_NaturalOrdering_Fixed;
+      break;
     case 11:
       C->ops->solve = MatSolve_SeqBAIJ_11_NaturalOrdering;
       break;
@@ -255,6 +261,9 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_N(Mat B,Mat A,const MatFactorInfo *inf
     case 14:
       C->ops->solve = MatSolve_SeqBAIJ_14_NaturalOrdering;
       break;
+    case 16:
+      C->ops->solve = MatSolve_SeqBAIJ_16_NaturalOrdering_Fixed;
+      break;
     default:
       C->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering;
       break;
@@ -3,7 +3,7 @@
     This is included by sbaij.c to generate unsigned short and regular versions of these two functions
 */
 
-/* We cut-and-past below from aij.h to make a "no_function" version of PetscSparseDensePlusDot().
+/* We cut-and-past below from aij.h to make "no_function" versions of PetscSparseDensePlusDot() and PetscSparseDenseMinusDot().
  * This is necessary because the USESHORT case cannot use the inlined functions that may be employed. */
 
 #if defined(PETSC_KERNEL_USE_UNROLL_4)
@@ -32,6 +32,32 @@
     for (__i=0; __i<nnz; __i++) sum += xv[__i] * r[xi[__i]];}
 #endif
 
+#if defined(PETSC_KERNEL_USE_UNROLL_4)
+#define PetscSparseDenseMinusDot_no_function(sum,r,xv,xi,nnz) { \
+    if (nnz > 0) { \
+      switch (nnz & 0x3) { \
+      case 3: sum -= *xv++ *r[*xi++]; \
+      case 2: sum -= *xv++ *r[*xi++]; \
+      case 1: sum -= *xv++ *r[*xi++]; \
+        nnz       -= 4;} \
+      while (nnz > 0) { \
+        sum -=  xv[0] * r[xi[0]] - xv[1] * r[xi[1]] - \
+               xv[2] * r[xi[2]] - xv[3] * r[xi[3]]; \
+        xv += 4; xi += 4; nnz -= 4; }}}
+
+#elif defined(PETSC_KERNEL_USE_UNROLL_2)
+#define PetscSparseDenseMinusDot_no_function(sum,r,xv,xi,nnz) { \
+    PetscInt __i,__i1,__i2; \
+    for (__i=0; __i<nnz-1; __i+=2) {__i1 = xi[__i]; __i2=xi[__i+1]; \
+                                    sum -= (xv[__i]*r[__i1] + xv[__i+1]*r[__i2]);} \
+    if (nnz & 0x1) sum -= xv[__i] * r[xi[__i]];}
+
+#else
+#define PetscSparseDenseMinusDot_no_function(sum,r,xv,xi,nnz) { \
+    PetscInt __i; \
+    for (__i=0; __i<nnz; __i++) sum -= xv[__i] * r[xi[__i]];}
+#endif
+
 
 #if defined(USESHORT)
 PetscErrorCode MatMult_SeqSBAIJ_1_Hermitian_ushort(Mat A,Vec xx,Vec zz)
@@ -251,7 +277,11 @@ PetscErrorCode MatSOR_SeqSBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,Pets
           nz2 = ai[i] - ai[PetscMax(i-1,0)] - 1; /* avoid referencing ai[-1], nonsense nz2 is okay on last iteration */
           PETSC_Prefetch(v-nz2-1,0,PETSC_PREFETCH_HINT_NTA);
           PETSC_Prefetch(vj-nz2-1,0,PETSC_PREFETCH_HINT_NTA);
+#ifdef USESHORT
+          PetscSparseDenseMinusDot_no_function(sum,x,v,vj,nz);
+#else
           PetscSparseDenseMinusDot(sum,x,v,vj,nz);
+#endif
           nz = nz2;
 #endif
           x[i] = omega*sum*aidiag[i];
@@ -268,7 +298,11 @@ PetscErrorCode MatSOR_SeqSBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,Pets
           nz2 = ai[i] - ai[PetscMax(i-1,0)] - 1; /* avoid referencing ai[-1], nonsense nz2 is okay on last iteration */
           PETSC_Prefetch(v-nz2-1,0,PETSC_PREFETCH_HINT_NTA);
           PETSC_Prefetch(vj-nz2-1,0,PETSC_PREFETCH_HINT_NTA);
+#ifdef USESHORT
+          PetscSparseDenseMinusDot_no_function(sum,x,v,vj,nz);
+#else
           PetscSparseDenseMinusDot(sum,x,v,vj,nz);
+#endif
           x[i] = (1-omega)*x[i] + omega*sum*aidiag[i];
           nz   = nz2;
           v   -= nz + 1;
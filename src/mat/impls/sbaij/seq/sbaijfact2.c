@@ -1621,6 +1621,76 @@ PetscErrorCode MatSolve_SeqSBAIJ_1(Mat A,Vec bb,Vec xx)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   MatSolve_SeqSBAIJ_1_Levels - MatSolve_SeqSBAIJ_1() with the rows of each level divided among the threads.
+   The forward solve gathers along the columns of U so that the rows of a level write only their own entries.
+*/
+PetscErrorCode MatSolve_SeqSBAIJ_1_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqSBAIJ      *a = (Mat_SeqSBAIJ*)A->data;
+  Mat_SeqAIJ_Levels *levels = a->levels;
+  IS                isrow = a->row;
+  PetscErrorCode    ierr;
+  const PetscInt    *ai = a->i,*aj = a->j,*rp,*adiag = a->diag;
+  const MatScalar   *aa = a->a;
+  const PetscScalar *b;
+  PetscScalar       *x,*t,*w;
+
+  PetscFunctionBegin;
+  if (!levels) {
+    ierr = MatSolve_SeqSBAIJ_1(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  t    = a->solve_work;
+  w    = levels->work;
+  ierr = ISGetIndices(isrow,&rp);CHKERRQ(ierr);
+
+#pragma omp parallel num_threads(levels->nthreads)
+  {
+    const PetscInt  *ti = levels->ti,*tj = levels->tj,*tpos = levels->tpos,*vj;
+    const MatScalar *v;
+    PetscScalar     s;
+    PetscInt        l,i,j,k,nz;
+
+    /* solve U^T*D*y = perm(b) by forward substitution; w holds U^T*D*y before the scaling with D^{-1} */
+    for (l=0; l<levels->nlevels[0]; l++) {
+#pragma omp for schedule(static)
+      for (i=levels->level[0][l]; i<levels->level[0][l+1]; i++) {
+        k = levels->rows[0][i];
+        s = b[rp[k]];
+        for (j=ti[k]; j<ti[k+1]; j++) s += aa[tpos[j]]*w[tj[j]];
+        w[k] = s;
+        t[k] = s*aa[adiag[k]];  /* aa[adiag[k]] = 1/D(k) */
+      }
+    }
+
+    /* solve U*perm(x) = y by back substitution */
+    for (l=0; l<levels->nlevels[1]; l++) {
+#pragma omp for schedule(static)
+      for (i=levels->level[1][l]; i<levels->level[1][l+1]; i++) {
+        k  = levels->rows[1][i];
+        v  = aa + ai[k];
+        vj = aj + ai[k];
+        nz = ai[k+1] - ai[k] - 1;
+        s  = t[k];
+        for (j=0; j<nz; j++) s += v[j]*t[vj[j]];
+        t[k]     = s;
+        x[rp[k]] = s;
+      }
+    }
+  }
+
+  ierr = ISRestoreIndices(isrow,&rp);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(4.0*a->nz - 3.0*a->mbs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode MatSolve_SeqSBAIJ_1_inplace(Mat A,Vec bb,Vec xx)
 {
   Mat_SeqSBAIJ      *a   = (Mat_SeqSBAIJ*)A->data;
@@ -17,6 +17,10 @@
    Options Database Keys:
 . -mat_type sell - sets the matrix type to "sell" during a call to MatSetFromOptions()
 
+   Notes:
+   MatSOR(), ILU(0) (PCILU, or PCBJACOBI/PCASM subdomain solves in parallel) and MatMultTranspose() work directly
+   on the SELL storage, so Krylov solves with these preconditioners do not need a second (AIJ) copy of the operator.
+
   Developer Notes: Subclasses include MATSELLCUSP, MATSELLCUSPARSE, MATSELLPERM, MATSELLCRL, and also automatically switches over to use inodes when
    enough exist.
 
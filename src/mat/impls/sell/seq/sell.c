@@ -673,6 +673,13 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
   const PetscInt    *acolidx=a->colidx;
   PetscInt          i,j,r,row,nnz_in_row,totalslices=a->totalslices;
   PetscErrorCode    ierr;
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+  __m512d           vec_x,vec_vals;
+  PetscScalar       prod[8];
+#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+  __m256d           vec_x,vec_x2,vec_vals;
+  PetscScalar       prod[8];
+#endif
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*aval)
@@ -691,10 +698,44 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
       for (r=0; r<(A->rmap->n & 0x07); ++r) {
         row        = 8*i + r;
         nnz_in_row = a->rlen[row];
-        for (j=0; j<nnz_in_row; ++j) y[acolidx[8*j+r]] += aval[8*j+r] * x[row];
+        for (j=0; j<nnz_in_row; ++j) y[acolidx[a->sliidx[i]+8*j+r]] += aval[a->sliidx[i]+8*j+r] * x[row];
       }
       break;
     }
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+    /* the x entries of a slice are contiguous so they are loaded once; only the update of y has to be scattered,
+       and it is done with scalar stores since rows of a slice may share a column */
+    vec_x = _mm512_loadu_pd(&x[8*i]);
+    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
+      vec_vals = _mm512_loadu_pd(&aval[j]);
+      _mm512_storeu_pd(prod,_mm512_mul_pd(vec_vals,vec_x));
+      y[acolidx[j]]   += prod[0];
+      y[acolidx[j+1]] += prod[1];
+      y[acolidx[j+2]] += prod[2];
+      y[acolidx[j+3]] += prod[3];
+      y[acolidx[j+4]] += prod[4];
+      y[acolidx[j+5]] += prod[5];
+      y[acolidx[j+6]] += prod[6];
+      y[acolidx[j+7]] += prod[7];
+    }
+#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+    vec_x  = _mm256_loadu_pd(&x[8*i]);
+    vec_x2 = _mm256_loadu_pd(&x[8*i+4]);
+    for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
+      vec_vals = _mm256_loadu_pd(&aval[j]);
+      _mm256_storeu_pd(prod,_mm256_mul_pd(vec_vals,vec_x));
+      vec_vals = _mm256_loadu_pd(&aval[j+4]);
+      _mm256_storeu_pd(prod+4,_mm256_mul_pd(vec_vals,vec_x2));
+      y[acolidx[j]]   += prod[0];
+      y[acolidx[j+1]] += prod[1];
+      y[acolidx[j+2]] += prod[2];
+      y[acolidx[j+3]] += prod[3];
+      y[acolidx[j+4]] += prod[4];
+      y[acolidx[j+5]] += prod[5];
+      y[acolidx[j+6]] += prod[6];
+      y[acolidx[j+7]] += prod[7];
+    }
+#else
     for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
       y[acolidx[j]]   += aval[j] * x[8*i];
       y[acolidx[j+1]] += aval[j+1] * x[8*i+1];
@@ -705,6 +746,7 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
       y[acolidx[j+6]] += aval[j+6] * x[8*i+6];
       y[acolidx[j+7]] += aval[j+7] * x[8*i+7];
     }
+#endif
   }
   ierr = PetscLogFlops(2.0*a->sliidx[a->totalslices]);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
@@ -2049,6 +2091,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat C,Mat A,MatDuplicateOption cpval
 
   c->maxallocmat  = a->maxallocmat;
   c->maxallocrow  = a->maxallocrow;
+  c->totalslices  = a->totalslices;
   c->rlenmax      = a->rlenmax;
   c->nz           = a->nz;
   C->preallocated = PETSC_TRUE;
@@ -191,6 +191,11 @@ PETSC_INTERN PetscErrorCode MatShift_SeqSELL(Mat,PetscScalar);
 PETSC_INTERN PetscErrorCode MatSOR_SeqSELL(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqSELL(Mat);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqSELL(Mat,MatDuplicateOption,Mat*);
+PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat,Mat,MatDuplicateOption,PetscBool);
+PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqSELL(Mat,Mat,IS,IS,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatILUFactorNumeric_SeqSELL(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatSolve_SeqSELL(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolveTranspose_SeqSELL(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatEqual_SeqSELL(Mat,Mat,PetscBool*);
 PETSC_INTERN PetscErrorCode MatSeqSELLInvalidateDiagonal(Mat);
 PETSC_INTERN PetscErrorCode MatConvert_SeqSELL_SeqAIJ(Mat,MatType,MatReuse,Mat*);
@@ -0,0 +1,262 @@
+/*
+  Defines the incomplete factorization and triangular solves for the SELL matrix storage format.
+  ILU(0) keeps the sliced ELLPACK layout of the original matrix, so the factor has exactly the
+  same colidx[] and sliidx[] as the matrix and no conversion to AIJ is needed to precondition with it.
+*/
+#include <../src/mat/impls/sell/seq/sell.h>  /*I   "petscmat.h"  I*/
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqsell_petsc(Mat A,MatFactorType ftype,Mat *B)
+{
+  PetscInt       n = A->rmap->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_ILU) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported for SELL matrices; convert to AIJ for LU or Cholesky");
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),B);CHKERRQ(ierr);
+  ierr = MatSetSizes(*B,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*B,MATSEQSELL);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(*B,A,A);CHKERRQ(ierr);
+
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqSELL;
+  (*B)->factortype             = ftype;
+
+  ierr = PetscFree((*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERPETSC,&(*B)->solvertype);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   ILU(0) only: the factor gets the nonzero structure of A, including the padding of the slices.
+*/
+PetscErrorCode MatILUFactorSymbolic_SeqSELL(Mat fact,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  Mat_SeqSELL    *b;
+  PetscInt       i;
+  PetscBool      row_identity,col_identity,missing;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (A->rmap->N != A->cmap->N) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"matrix must be square");
+  if (info->levels > 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"ILU(%D) is not supported for SELL matrices, only ILU(0)",(PetscInt)info->levels);
+  ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(iscol,&col_identity);CHKERRQ(ierr);
+  if (!row_identity || !col_identity) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"SELL matrices only support ILU with the natural ordering");
+  ierr = MatMissingDiagonal(A,&missing,&i);CHKERRQ(ierr);
+  if (missing) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Matrix is missing diagonal entry %D",i);
+
+  ierr = MatDuplicateNoCreate_SeqSELL(fact,A,MAT_DO_NOT_COPY_VALUES,PETSC_TRUE);CHKERRQ(ierr);
+  fact->factortype = MAT_FACTOR_ILU;
+  ierr = MatMarkDiagonal_SeqSELL(fact);CHKERRQ(ierr);
+
+  b    = (Mat_SeqSELL*)fact->data;
+  ierr = PetscObjectReference((PetscObject)isrow);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)iscol);CHKERRQ(ierr);
+  ierr = ISDestroy(&b->row);CHKERRQ(ierr);
+  ierr = ISDestroy(&b->col);CHKERRQ(ierr);
+  b->row = isrow;
+  b->col = iscol;
+
+  fact->info.factor_mallocs    = 0;
+  fact->info.fill_ratio_given  = info->fill;
+  fact->info.fill_ratio_needed = 1.0;
+  fact->ops->lufactornumeric   = MatILUFactorNumeric_SeqSELL;
+  PetscFunctionReturn(0);
+}
+
+/*
+   IKJ variant of ILU(0) done in place on the factor values. pos[] maps a column to its
+   position in val[] for the row being eliminated, so fill outside the pattern is dropped.
+   The diagonal of U is stored inverted, as for AIJ, so the solves only multiply.
+*/
+PetscErrorCode MatILUFactorNumeric_SeqSELL(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqSELL     *a=(Mat_SeqSELL*)A->data,*b=(Mat_SeqSELL*)B->data;
+  const PetscInt  n=A->rmap->n,*bdiag=b->diag,*colidx=b->colidx;
+  PetscInt        i,j,k,nz,nzL,shift,kshift,col,*pos;
+  MatScalar       *bval=b->val,multiplier;
+  const MatScalar *aval=a->val;
+  FactorShiftCtx  sctx;
+  PetscReal       rs;
+  MatScalar       d;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  /* MatPivotSetUp(): initialize shift context sctx */
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+
+  if (info->shifttype == (PetscReal) MAT_SHIFT_POSITIVE_DEFINITE) { /* set sctx.shift_top=max{rs} */
+    sctx.shift_top = info->zeropivot;
+    for (i=0; i<n; i++) {
+      /* calculate sum(|aij|)-RealPart(aii), amt of shift needed for this row */
+      shift = a->sliidx[i>>3]+(i&0x07);
+      d     = aval[bdiag[i]]; /* A and the factor share the same layout */
+      rs    = -PetscAbsScalar(d) - PetscRealPart(d);
+      for (j=0; j<a->rlen[i]; j++) rs += PetscAbsScalar(aval[shift+8*j]);
+      if (rs>sctx.shift_top) sctx.shift_top = rs;
+    }
+    sctx.shift_top *= 1.1;
+    sctx.nshift_max = 5;
+    sctx.shift_lo   = 0.;
+    sctx.shift_hi   = 1.;
+  }
+
+  ierr = PetscMalloc1(n,&pos);CHKERRQ(ierr);
+  for (i=0; i<n; i++) pos[i] = -1;
+
+  do {
+    sctx.newshift = PETSC_FALSE;
+    /* the factor has the layout of A so the values can be loaded at once */
+    ierr = PetscMemcpy(bval,aval,a->sliidx[a->totalslices]*sizeof(MatScalar));CHKERRQ(ierr);
+    for (i=0; i<n; i++) {
+      shift = b->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+      nz    = b->rlen[i];
+      for (j=0; j<nz; j++) pos[colidx[shift+8*j]] = shift+8*j;
+      /* ZeropivotApply() */
+      bval[bdiag[i]] += sctx.shift_amount;  /* shift the diagonal of the matrix */
+
+      /* elimination; the columns of a row are sorted so the L part is eliminated in order */
+      nzL = (bdiag[i]-shift)/8;
+      for (k=0; k<nzL; k++) {
+        multiplier = bval[shift+8*k];
+        if (multiplier != 0.0) {
+          col        = colidx[shift+8*k];
+          multiplier = multiplier*bval[bdiag[col]];
+          bval[shift+8*k] = multiplier;
+          kshift     = b->sliidx[col>>3]+(col&0x07);
+          nz         = b->rlen[col]-(bdiag[col]-kshift)/8-1; /* num of entries in U(col,:) excluding diag */
+          for (j=1; j<=nz; j++) {
+            if (pos[colidx[bdiag[col]+8*j]] >= 0) bval[pos[colidx[bdiag[col]+8*j]]] -= multiplier*bval[bdiag[col]+8*j];
+          }
+          ierr = PetscLogFlops(1+2*nz);CHKERRQ(ierr);
+        }
+      }
+
+      rs = 0.0;
+      for (j=0; j<b->rlen[i]; j++) {
+        pos[colidx[shift+8*j]] = -1;
+        if (shift+8*j != bdiag[i]) rs += PetscAbsScalar(bval[shift+8*j]);
+      }
+
+      sctx.rs = rs;
+      sctx.pv = bval[bdiag[i]];
+      ierr    = MatPivotCheck(B,A,info,&sctx,i);CHKERRQ(ierr);
+      if (sctx.newshift) break; /* break for-loop */
+
+      /* invert diagonal for simpler triangular solves */
+      bval[bdiag[i]] = 1.0/sctx.pv;
+    }
+    if (sctx.newshift) {
+      for (i=0; i<n; i++) pos[i] = -1;
+    }
+
+    /* MatPivotRefine() */
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE && !sctx.newshift && sctx.shift_fraction>0 && sctx.nshift<sctx.nshift_max) {
+      /*
+       * if no shift in this attempt & shifting & started shifting & can refine,
+       * then try lower shift
+       */
+      sctx.shift_hi       = sctx.shift_fraction;
+      sctx.shift_fraction = (sctx.shift_hi+sctx.shift_lo)/2.;
+      sctx.shift_amount   = sctx.shift_fraction * sctx.shift_top;
+      sctx.newshift       = PETSC_TRUE;
+      sctx.nshift++;
+    }
+  } while (sctx.newshift);
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+
+  B->ops->solve          = MatSolve_SeqSELL;
+  B->ops->solvetranspose = MatSolveTranspose_SeqSELL;
+  B->assembled           = PETSC_TRUE;
+  B->preallocated        = PETSC_TRUE;
+  if (sctx.nshift) {
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE) {
+      ierr = PetscInfo4(A,"number of shift_pd tries %D, shift_amount %g, diagonal shifted up by %e fraction top_value %e\n",sctx.nshift,(double)sctx.shift_amount,(double)sctx.shift_fraction,(double)sctx.shift_top);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_NONZERO) {
+      ierr = PetscInfo2(A,"number of shift_nz tries %D, shift_amount %g\n",sctx.nshift,(double)sctx.shift_amount);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_INBLOCKS) {
+      ierr = PetscInfo2(A,"number of shift_inblocks applied %D, each shift_amount %g\n",sctx.nshift,(double)info->shiftamount);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Solves L U x = b with the ILU(0) factor; L has a unit diagonal and the diagonal of U is stored inverted.
+*/
+PetscErrorCode MatSolve_SeqSELL(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  const PetscInt    n=A->rmap->n,*diag=a->diag,*colidx=a->colidx;
+  const MatScalar   *val=a->val;
+  PetscScalar       *x,sum;
+  const PetscScalar *b;
+  PetscInt          i,j,nz,shift;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+
+  /* forward solve the lower triangular */
+  for (i=0; i<n; i++) {
+    shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+    nz    = (diag[i]-shift)/8;
+    sum   = b[i];
+    for (j=0; j<nz; j++) sum -= val[shift+8*j]*x[colidx[shift+8*j]];
+    x[i]  = sum;
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+    nz    = a->rlen[i]-(diag[i]-shift)/8-1;
+    sum   = x[i];
+    for (j=1; j<=nz; j++) sum -= val[diag[i]+8*j]*x[colidx[diag[i]+8*j]];
+    x[i]  = sum*val[diag[i]];
+  }
+
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Solves (L U)^T x = b; both transposed solves sweep the rows of the factor and scatter the updates.
+*/
+PetscErrorCode MatSolveTranspose_SeqSELL(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  const PetscInt    n=A->rmap->n,*diag=a->diag,*colidx=a->colidx;
+  const MatScalar   *val=a->val;
+  PetscScalar       *x,s;
+  PetscInt          i,j,nz,shift;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = VecCopy(bb,xx);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+
+  /* forward solve the U^T */
+  for (i=0; i<n; i++) {
+    shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+    nz    = a->rlen[i]-(diag[i]-shift)/8-1;
+    s     = x[i]*val[diag[i]];
+    for (j=1; j<=nz; j++) x[colidx[diag[i]+8*j]] -= val[diag[i]+8*j]*s;
+    x[i]  = s;
+  }
+
+  /* backward solve the L^T */
+  for (i=n-1; i>=0; i--) {
+    shift = a->sliidx[i>>3]+(i&0x07); /* starting index of the row i */
+    nz    = (diag[i]-shift)/8;
+    s     = x[i];
+    for (j=0; j<nz; j++) x[colidx[shift+8*j]] -= val[shift+8*j]*s;
+  }
+
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -5287,9 +5287,13 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
 .    MAT_NO_OFF_PROC_ENTRIES - you know each process will only set values for its own rows, will generate an error if
         any process sets values for another process. This avoids all reductions in the MatAssembly routines and thus improves
         performance for very large process counts.
--    MAT_SUBSET_OFF_PROC_ENTRIES - you know that the first assembly after setting this flag will set a superset
+.    MAT_SUBSET_OFF_PROC_ENTRIES - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
         functions, instead sending only neighbor messages.
+-    MAT_FROZEN_OFF_PROC_ENTRIES - you know that every assembly after setting this flag sets the same off-process entries,
+        through the same sequence of MatSetValues() calls, as the first one. After the first assembly only the values are
+        sent, along the recorded communication pattern, and no indices are sorted or searched; MPIAIJ adds the received
+        values directly into their locations.
 
    Notes:
    Except for MAT_UNUSED_NONZERO_LOCATION_ERR and  MAT_ROW_ORIENTED all processes that share the matrix must pass the same value in flg!
@@ -5333,6 +5337,12 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
    should be used with MAT_USE_HASH_TABLE flag. This option is currently
    supported by MATMPIBAIJ format only.
 
+   For MATSEQAIJ and MATMPIAIJ matrices MAT_USE_HASH_TABLE must be set before the first MatSetValues().
+   The entries are then accumulated in a hash table and the nonzero structure is built, with exactly
+   the needed space, at the first MAT_FINAL_ASSEMBLY; thus the matrix need not be preallocated and
+   assembly does not slow down when the preallocation is missing or wrong. Later assemblies insert
+   into the nonzero structure as usual.
+
    MAT_KEEP_NONZERO_PATTERN indicates when MatZeroRows() is called the zeroed entries
    are kept in the nonzero structure
 
@@ -5379,6 +5389,9 @@ PetscErrorCode MatSetOption(Mat mat,MatOption op,PetscBool flg)
   case MAT_SUBSET_OFF_PROC_ENTRIES:
     mat->subsetoffprocentries = flg;
     PetscFunctionReturn(0);
+  case MAT_FROZEN_OFF_PROC_ENTRIES:
+    mat->frozenoffprocentries = flg;
+    PetscFunctionReturn(0);
   case MAT_NO_OFF_PROC_ZERO_ROWS:
     mat->nooffproczerorows = flg;
     PetscFunctionReturn(0);
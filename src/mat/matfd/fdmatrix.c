@@ -311,6 +311,49 @@ PetscErrorCode  MatFDColoringSetFunction(MatFDColoring matfd,PetscErrorCode (*f)
   PetscFunctionReturn(0);
 }
 
+/*@C
+   MatFDColoringSetFunctionBatch - Sets a function that evaluates the function at several perturbed vectors
+   in one call, so that the ghost point updates and the setup of the function evaluation are shared by several colors.
+
+   Logically Collective on MatFDColoring
+
+   Input Parameters:
++  coloring - the coloring context
+.  f - the function
+-  fctx - the optional user-defined function context
+
+   Calling sequence of (*f) function:
+$    PetscErrorCode f(void *sctx,PetscInt n,Vec x[],Vec y[],void *fctx)
++  sctx - the SNES (or the dummy context) passed to MatFDColoringApply()
+.  n - the number of vectors
+.  x - the vectors at which to evaluate the function
+.  y - the output vectors, y[i] = F(x[i])
+-  fctx - the user-defined function context
+
+   Level: advanced
+
+   Notes:
+   The function set with MatFDColoringSetFunction() is still required, it computes F at the unperturbed vector.
+
+   The batch function is used for the AIJ and SELL formats when the coloring uses several block columns,
+   see MatFDColoringSetBlockSize() and -mat_fd_coloring_bcols; it is then called with up to bcols vectors.
+   The output vectors share their arrays with the dense block of function differences and are not ghosted.
+   MatFDColoringGetPerturbedColumns() cannot be used inside the batch function.
+
+.keywords: Mat, Jacobian, finite differences, set, function
+
+.seealso: MatFDColoringCreate(), MatFDColoringSetFunction(), MatFDColoringSetBlockSize()
+
+@*/
+PetscErrorCode  MatFDColoringSetFunctionBatch(MatFDColoring matfd,PetscErrorCode (*f)(void*,PetscInt,Vec[],Vec[],void*),void *fctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(matfd,MAT_FDCOLORING_CLASSID,1);
+  matfd->fbatch    = f;
+  matfd->fbatchctx = fctx;
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatFDColoringSetFromOptions - Sets coloring finite difference parameters from
    the options database.
@@ -531,6 +574,8 @@ PetscErrorCode  MatFDColoringDestroy(MatFDColoring *c)
   ierr = VecDestroy(&color->w1);CHKERRQ(ierr);
   ierr = VecDestroy(&color->w2);CHKERRQ(ierr);
   ierr = VecDestroy(&color->w3);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(color->nbatch,&color->wbatch);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(color->nbatch,&color->ybatch);CHKERRQ(ierr);
   ierr = PetscHeaderDestroy(c);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -79,6 +79,7 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   stash->nprocessed  = 0;
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
+  stash->frozen      = NULL;
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_reproduce",&stash->reproduce,NULL);CHKERRQ(ierr);
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -100,6 +101,25 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   PetscFunctionReturn(0);
 }
 
+/*
+   MatStashFrozenDestroy_Private - Destroy the schedule recorded for MAT_FROZEN_OFF_PROC_ENTRIES
+*/
+static PetscErrorCode MatStashFrozenDestroy_Private(MatStashFrozen **frozen)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*frozen) PetscFunctionReturn(0);
+  ierr = PetscFree3((*frozen)->stashrows,(*frozen)->stashcols,(*frozen)->slots);CHKERRQ(ierr);
+  ierr = PetscFree2((*frozen)->sendranks,(*frozen)->sendstarts);CHKERRQ(ierr);
+  ierr = PetscFree2((*frozen)->recvranks,(*frozen)->recvstarts);CHKERRQ(ierr);
+  ierr = PetscFree2((*frozen)->recvrows,(*frozen)->recvcols);CHKERRQ(ierr);
+  ierr = PetscFree2((*frozen)->svalues,(*frozen)->rvalues);CHKERRQ(ierr);
+  ierr = PetscFree2((*frozen)->sendreqs,(*frozen)->recvreqs);CHKERRQ(ierr);
+  ierr = PetscFree(*frozen);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    MatStashDestroy_Private - Destroy the stash
 */
@@ -110,6 +130,7 @@ PetscErrorCode MatStashDestroy_Private(MatStash *stash)
   PetscFunctionBegin;
   ierr = PetscMatStashSpaceDestroy(&stash->space_head);CHKERRQ(ierr);
   if (stash->ScatterDestroy) {ierr = (*stash->ScatterDestroy)(stash);CHKERRQ(ierr);}
+  ierr = MatStashFrozenDestroy_Private(&stash->frozen);CHKERRQ(ierr);
 
   stash->space = 0;
 
@@ -642,6 +663,61 @@ PetscErrorCode MatStashScatterGetMesg_Private(MatStash *stash,PetscMPIInt *nvals
   PetscFunctionReturn(0);
 }
 
+/*
+   MatStashFrozenGetPattern_Private - Determines if the current assembly sends only values along the schedule
+   recorded for MAT_FROZEN_OFF_PROC_ENTRIES and, if so, gives the indices of all the entries that will be received.
+   The indices are the same in every such assembly, so the matrix can compute once where the values go.
+
+   Input Parameter:
+   stash  - the stash
+
+   Output Parameters:
+   active - PETSC_TRUE if the values can be obtained with MatStashFrozenGetValues_Private()
+   n      - the number of (block) entries received
+   rows   - their rows (or block rows)
+   cols   - their columns (or block columns)
+*/
+PetscErrorCode MatStashFrozenGetPattern_Private(MatStash *stash,PetscBool *active,PetscInt *n,const PetscInt **rows,const PetscInt **cols)
+{
+  MatStashFrozen *frozen = stash->frozen;
+
+  PetscFunctionBegin;
+  *active = (frozen && frozen->active && !frozen->nrecvdone) ? PETSC_TRUE : PETSC_FALSE;
+  if (*active) {
+    *n    = frozen->recvstarts[frozen->nrecvranks];
+    *rows = frozen->recvrows;
+    *cols = frozen->recvcols;
+  } else {
+    *n    = 0;
+    *rows = NULL;
+    *cols = NULL;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatStashFrozenGetValues_Private - Waits for all the values of an assembly with MAT_FROZEN_OFF_PROC_ENTRIES; after
+   this MatStashScatterGetMesg_Private() has no messages left.
+
+   Input Parameter:
+   stash - the stash
+
+   Output Parameter:
+   vals  - the received values, in the order of the indices from MatStashFrozenGetPattern_Private()
+*/
+PetscErrorCode MatStashFrozenGetValues_Private(MatStash *stash,const PetscScalar **vals)
+{
+  MatStashFrozen *frozen = stash->frozen;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!frozen || !frozen->active || frozen->nrecvdone) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must call MatStashFrozenGetPattern_Private() first");
+  ierr = MPI_Waitall(frozen->nrecvranks,frozen->recvreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  frozen->nrecvdone = frozen->nrecvranks;
+  *vals = frozen->rvalues;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode MatStashScatterGetMesg_Ref(MatStash *stash,PetscMPIInt *nvals,PetscInt **rows,PetscInt **cols,PetscScalar **vals,PetscInt *flg)
 {
   PetscErrorCode ierr;
@@ -704,11 +780,14 @@ typedef struct {
   PetscScalar vals[1];          /* Actually an array of length bs2 */
 } MatStashBlock;
 
-static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode insertmode)
+/*
+   If slots is not NULL it returns, for each stashed entry, the block of segsendblocks it is combined into
+*/
+static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode insertmode,PetscInt *slots)
 {
   PetscErrorCode ierr;
   PetscMatStashSpace space;
-  PetscInt n = stash->n,bs = stash->bs,bs2 = bs*bs,cnt,*row,*col,*perm,rowstart,i;
+  PetscInt n = stash->n,bs = stash->bs,bs2 = bs*bs,cnt,*row,*col,*perm,rowstart,i,nblocks = 0;
   PetscScalar **valptr;
 
   PetscFunctionBegin;
@@ -736,14 +815,17 @@ static PetscErrorCode MatStashSortCompress_Private(MatStash *stash,InsertMode in
         block->row = row[rowstart];
         block->col = col[colstart];
         ierr = PetscMemcpy(block->vals,valptr[perm[colstart]],bs2*sizeof(block->vals[0]));CHKERRQ(ierr);
+        if (slots) slots[perm[colstart]] = nblocks;
         for (j=colstart+1; j<i && col[j] == col[colstart]; j++) { /* Add any extra stashed blocks at the same (row,col) */
           if (insertmode == ADD_VALUES) {
             for (l=0; l<bs2; l++) block->vals[l] += valptr[perm[j]][l];
           } else {
             ierr = PetscMemcpy(block->vals,valptr[perm[j]],bs2*sizeof(block->vals[0]));CHKERRQ(ierr);
           }
+          if (slots) slots[perm[j]] = nblocks;
         }
         colstart = j;
+        nblocks++;
       }
       rowstart = i;
     }
@@ -826,6 +908,101 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm,const PetscMPIInt ta
   PetscFunctionReturn(0);
 }
 
+/*
+ * Value-only assembly along the schedule recorded for MAT_FROZEN_OFF_PROC_ENTRIES: the stashed values are combined
+ * straight into their blocks of the send buffer, with no sorting and no rendezvous.
+ */
+static PetscErrorCode MatStashScatterBegin_Frozen(Mat mat,MatStash *stash)
+{
+  MatStashFrozen     *frozen = stash->frozen;
+  PetscInt           bs2 = stash->bs*stash->bs,i,k,l;
+  PetscMPIInt        count;
+  PetscMatStashSpace space;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (stash->n != frozen->nstash) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"MAT_FROZEN_OFF_PROC_ENTRIES set, but %D off-process entries were set instead of the %D of the first assembly",stash->n,frozen->nstash);
+  if (mat->insertmode == NOT_SET_VALUES) mat->insertmode = frozen->insertmode;
+  if (frozen->insertmode != NOT_SET_VALUES && mat->insertmode != frozen->insertmode) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"MAT_FROZEN_OFF_PROC_ENTRIES set, but the InsertMode differs from that of the first assembly");
+  if (mat->insertmode == ADD_VALUES) {
+    ierr = PetscMemzero(frozen->svalues,frozen->sendstarts[frozen->nsendranks]*bs2*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+  for (space=stash->space_head,k=0; space; space=space->next) {
+    for (i=0; i<space->local_used; i++,k++) {
+      PetscScalar *sv = &frozen->svalues[frozen->slots[k]*bs2];
+      PetscScalar *v  = &space->val[i*bs2];
+
+      if (PetscUnlikely(space->idx[i] != frozen->stashrows[k] || space->idy[i] != frozen->stashcols[k])) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"MAT_FROZEN_OFF_PROC_ENTRIES set, but off-process entry (%D,%D) was set where the first assembly set (%D,%D)",space->idx[i],space->idy[i],frozen->stashrows[k],frozen->stashcols[k]);
+      if (mat->insertmode == ADD_VALUES) {
+        for (l=0; l<bs2; l++) sv[l] += v[l];
+      } else {
+        for (l=0; l<bs2; l++) sv[l] = v[l];
+      }
+    }
+  }
+  for (i=0; i<frozen->nrecvranks; i++) {
+    ierr = PetscMPIIntCast((frozen->recvstarts[i+1]-frozen->recvstarts[i])*bs2,&count);CHKERRQ(ierr);
+    ierr = MPI_Irecv(&frozen->rvalues[frozen->recvstarts[i]*bs2],count,MPIU_SCALAR,frozen->recvranks[i],frozen->tag,stash->comm,&frozen->recvreqs[i]);CHKERRQ(ierr);
+  }
+  for (i=0; i<frozen->nsendranks; i++) {
+    ierr = PetscMPIIntCast((frozen->sendstarts[i+1]-frozen->sendstarts[i])*bs2,&count);CHKERRQ(ierr);
+    ierr = MPI_Isend(&frozen->svalues[frozen->sendstarts[i]*bs2],count,MPIU_SCALAR,frozen->sendranks[i],frozen->tag,stash->comm,&frozen->sendreqs[i]);CHKERRQ(ierr);
+  }
+  frozen->active    = PETSC_TRUE;
+  frozen->nrecvdone = 0;
+  stash->insertmode = &mat->insertmode;
+  PetscFunctionReturn(0);
+}
+
+/* Hands out the values received from one rank, with the indices recorded for that rank */
+static PetscErrorCode MatStashScatterGetMesg_Frozen(MatStash *stash,PetscMPIInt *n,PetscInt **row,PetscInt **col,PetscScalar **val,PetscInt *flg)
+{
+  MatStashFrozen *frozen = stash->frozen;
+  PetscMPIInt    i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = 0;
+  if (frozen->nrecvdone == frozen->nrecvranks) PetscFunctionReturn(0);
+  ierr = MPI_Waitany(frozen->nrecvranks,frozen->recvreqs,&i,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  frozen->nrecvdone++;
+  ierr = PetscMPIIntCast(frozen->recvstarts[i+1]-frozen->recvstarts[i],n);CHKERRQ(ierr);
+  *row = &frozen->recvrows[frozen->recvstarts[i]];
+  *col = &frozen->recvcols[frozen->recvstarts[i]];
+  *val = &frozen->rvalues[frozen->recvstarts[i]*stash->bs*stash->bs];
+  *flg = 1;
+  PetscFunctionReturn(0);
+}
+
+/*
+ * Completes the schedule of MAT_FROZEN_OFF_PROC_ENTRIES once the recorded assembly has received all its blocks; at
+ * this point recvstarts[i+1] holds the number of blocks received from recvranks[i].
+ */
+static PetscErrorCode MatStashFrozenSetUp_Private(MatStash *stash)
+{
+  MatStashFrozen *frozen = stash->frozen;
+  PetscInt       bs2 = stash->bs*stash->bs,i,b,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<frozen->nrecvranks; i++) frozen->recvstarts[i+1] += frozen->recvstarts[i];
+  ierr = PetscMalloc2(frozen->recvstarts[frozen->nrecvranks],&frozen->recvrows,frozen->recvstarts[frozen->nrecvranks],&frozen->recvcols);CHKERRQ(ierr);
+  for (i=0,k=0; i<frozen->nrecvranks; i++) {
+    for (b=0; b<frozen->recvstarts[i+1]-frozen->recvstarts[i]; b++,k++) {
+      MatStashBlock *block = (MatStashBlock*)&((char*)stash->recvframes[i].buffer)[b*stash->blocktype_size];
+      frozen->recvrows[k] = block->row;
+      frozen->recvcols[k] = block->col;
+    }
+  }
+  ierr = PetscMalloc2(frozen->sendstarts[frozen->nsendranks]*bs2,&frozen->svalues,frozen->recvstarts[frozen->nrecvranks]*bs2,&frozen->rvalues);CHKERRQ(ierr);
+  ierr = PetscMalloc2(frozen->nsendranks,&frozen->sendreqs,frozen->nrecvranks,&frozen->recvreqs);CHKERRQ(ierr);
+  ierr = PetscCommGetNewTag(stash->comm,&frozen->tag);CHKERRQ(ierr);
+  frozen->insertmode = *stash->insertmode;
+  frozen->ready      = PETSC_TRUE;
+  ierr = PetscInfo4(NULL,"Frozen stash sends %D blocks to %d ranks and receives %D blocks from %d ranks\n",frozen->sendstarts[frozen->nsendranks],frozen->nsendranks,frozen->recvstarts[frozen->nrecvranks],frozen->nrecvranks);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -844,12 +1021,33 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   }
 #endif
 
+  if (stash->frozen && (!mat->frozenoffprocentries || !stash->frozen->ready)) {
+    ierr = MatStashFrozenDestroy_Private(&stash->frozen);CHKERRQ(ierr);
+  }
+  if (stash->frozen) {
+    ierr = MatStashScatterBegin_Frozen(mat,stash);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (stash->subset_off_proc && !mat->subsetoffprocentries) { /* We won't use the old scatter context. */
     ierr = MatStashScatterDestroy_BTS(stash);CHKERRQ(ierr);
   }
 
+  if (mat->frozenoffprocentries) { /* Record this assembly; later ones send only values */
+    PetscMatStashSpace space;
+    PetscInt           i,k;
+
+    ierr = PetscNew(&stash->frozen);CHKERRQ(ierr);
+    stash->frozen->nstash = stash->n;
+    ierr = PetscMalloc3(stash->n,&stash->frozen->stashrows,stash->n,&stash->frozen->stashcols,stash->n,&stash->frozen->slots);CHKERRQ(ierr);
+    for (space=stash->space_head,k=0; space; space=space->next) {
+      for (i=0; i<space->local_used; i++,k++) {
+        stash->frozen->stashrows[k] = space->idx[i];
+        stash->frozen->stashcols[k] = space->idy[i];
+      }
+    }
+  }
   ierr = MatStashBlockTypeSetUp(stash);CHKERRQ(ierr);
-  ierr = MatStashSortCompress_Private(stash,mat->insertmode);CHKERRQ(ierr);
+  ierr = MatStashSortCompress_Private(stash,mat->insertmode,stash->frozen ? stash->frozen->slots : NULL);CHKERRQ(ierr);
   ierr = PetscSegBufferGetSize(stash->segsendblocks,&nblocks);CHKERRQ(ierr);
   ierr = PetscSegBufferExtractInPlace(stash->segsendblocks,&sendblocks);CHKERRQ(ierr);
   if (stash->subset_off_proc && mat->subsetoffprocentries) { /* Set up sendhdrs and sendframes for each rank that we sent before */
@@ -907,6 +1105,20 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     if (sendno != stash->nsendranks) SETERRQ2(stash->comm,PETSC_ERR_PLIB,"BTS counted %D sendranks, but %D sends",stash->nsendranks,sendno);
   }
 
+  if (stash->frozen) {
+    MatStashFrozen *frozen = stash->frozen;
+    PetscInt       i;
+
+    frozen->nsendranks = stash->nsendranks;
+    ierr = PetscMalloc2(frozen->nsendranks,&frozen->sendranks,frozen->nsendranks+1,&frozen->sendstarts);CHKERRQ(ierr);
+    frozen->sendstarts[0] = 0;
+    for (i=0; i<frozen->nsendranks; i++) {
+      frozen->sendranks[i]    = stash->sendranks[i];
+      frozen->sendstarts[i+1] = frozen->sendstarts[i] + stash->sendhdr[i].count;
+    }
+    if (frozen->sendstarts[frozen->nsendranks] != (PetscInt)nblocks) SETERRQ2(stash->comm,PETSC_ERR_PLIB,"Frozen stash sends %D of %D blocks",frozen->sendstarts[frozen->nsendranks],(PetscInt)nblocks);
+  }
+
   /* Encode insertmode on the outgoing messages. If we want to support more than two options, we would need a new
    * message or a dummy entry of some sort. */
   if (mat->insertmode == INSERT_VALUES) {
@@ -935,6 +1147,15 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
     stash->use_status = PETSC_FALSE; /* Use count from header instead of from message. */
   }
 
+  if (stash->frozen) {
+    MatStashFrozen *frozen = stash->frozen;
+
+    frozen->nrecvranks = stash->nrecvranks;
+    ierr = PetscMalloc2(frozen->nrecvranks,&frozen->recvranks,frozen->nrecvranks+1,&frozen->recvstarts);CHKERRQ(ierr);
+    ierr = PetscMemcpy(frozen->recvranks,stash->recvranks,frozen->nrecvranks*sizeof(PetscMPIInt));CHKERRQ(ierr);
+    ierr = PetscMemzero(frozen->recvstarts,(frozen->nrecvranks+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  }
+
   ierr = PetscSegBufferExtractInPlace(stash->segrecvframe,&stash->recvframes);CHKERRQ(ierr);
   stash->recvframe_active = NULL;
   stash->recvframe_i      = 0;
@@ -952,6 +1173,10 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
   MatStashBlock *block;
 
   PetscFunctionBegin;
+  if (stash->frozen && stash->frozen->active) {
+    ierr = MatStashScatterGetMesg_Frozen(stash,n,row,col,val,flg);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   *flg = 0;
   while (!stash->recvframe_active || stash->recvframe_i == stash->recvframe_count) {
     if (stash->some_i == stash->some_count) {
@@ -964,6 +1189,7 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
     if (stash->use_status) { /* Count what was actually sent */
       ierr = MPI_Get_count(&stash->some_statuses[stash->some_i],stash->blocktype,&stash->recvframe_count);CHKERRQ(ierr);
     }
+    if (stash->frozen) stash->frozen->recvstarts[stash->some_indices[stash->some_i]+1] = stash->recvframe_count;
     if (stash->recvframe_count > 0) { /* Check for InsertMode consistency */
       block = (MatStashBlock*)&((char*)stash->recvframe_active->buffer)[0];
       if (PetscUnlikely(*stash->insertmode == NOT_SET_VALUES)) *stash->insertmode = block->row < 0 ? INSERT_VALUES : ADD_VALUES;
@@ -990,12 +1216,18 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MPI_Waitall(stash->nsendranks,stash->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
-  if (stash->subset_off_proc) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
-    void *dummy;
-    ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
-  } else {                      /* No reuse, so collect everything. */
-    ierr = MatStashScatterDestroy_BTS(stash);CHKERRQ(ierr);
+  if (stash->frozen && stash->frozen->active) {
+    ierr = MPI_Waitall(stash->frozen->nsendranks,stash->frozen->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    stash->frozen->active = PETSC_FALSE;
+  } else {
+    ierr = MPI_Waitall(stash->nsendranks,stash->sendreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+    if (stash->frozen) {ierr = MatStashFrozenSetUp_Private(stash);CHKERRQ(ierr);}
+    if (stash->subset_off_proc) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
+      void *dummy;
+      ierr = PetscSegBufferExtractInPlace(stash->segrecvblocks,&dummy);CHKERRQ(ierr);
+    } else {                      /* No reuse, so collect everything. */
+      ierr = MatStashScatterDestroy_BTS(stash);CHKERRQ(ierr);
+    }
   }
 
   /* Now update nmaxold to be app 10% more than max n used, this way the
@@ -60,6 +60,7 @@ typedef struct {
 */
 extern PetscErrorCode FormJacobian(SNES,Vec,Mat,Mat,void*);
 extern PetscErrorCode FormFunction(SNES,Vec,Vec,void*);
+extern PetscErrorCode FormFunctionBatch(SNES,PetscInt,Vec[],Vec[],void*);
 extern PetscErrorCode FormInitialGuess(AppCtx*,Vec);
 
 int main(int argc,char **argv)
@@ -73,7 +74,7 @@ int main(int argc,char **argv)
   PetscMPIInt    size;
   PetscReal      bratu_lambda_max = 6.81,bratu_lambda_min = 0.,history[50];
   MatFDColoring  fdcoloring;
-  PetscBool      matrix_free = PETSC_FALSE,flg,fd_coloring = PETSC_FALSE;
+  PetscBool      matrix_free = PETSC_FALSE,flg,fd_coloring = PETSC_FALSE,fd_batch = PETSC_FALSE;
 
   ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
   ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
@@ -138,6 +139,7 @@ int main(int argc,char **argv)
     efficiently using a coloring of the columns of the matrix.
   */
   ierr = PetscOptionsGetBool(NULL,NULL,"-snes_fd_coloring",&fd_coloring,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-snes_fd_coloring_batch",&fd_batch,NULL);CHKERRQ(ierr);
   if (matrix_free && fd_coloring) SETERRQ(PETSC_COMM_SELF,1,"Use only one of -snes_mf, -snes_fd_coloring options!\nYou can do -snes_mf_operator -snes_fd_coloring");
 
   if (fd_coloring) {
@@ -166,6 +168,7 @@ int main(int argc,char **argv)
     */
     ierr = MatFDColoringCreate(J,iscoloring,&fdcoloring);CHKERRQ(ierr);
     ierr = MatFDColoringSetFunction(fdcoloring,(PetscErrorCode (*)(void))FormFunction,&user);CHKERRQ(ierr);
+    if (fd_batch) {ierr = MatFDColoringSetFunctionBatch(fdcoloring,(PetscErrorCode (*)(void*,PetscInt,Vec[],Vec[],void*))FormFunctionBatch,&user);CHKERRQ(ierr);}
     ierr = MatFDColoringSetFromOptions(fdcoloring);CHKERRQ(ierr);
     ierr = MatFDColoringSetUp(J,iscoloring,fdcoloring);CHKERRQ(ierr);
     /*
@@ -370,6 +373,21 @@ PetscErrorCode FormFunction(SNES snes,Vec X,Vec F,void *ptr)
   return 0;
 }
 /* ------------------------------------------------------------------- */
+/*
+   FormFunctionBatch - Evaluates F at several vectors in one call, used by the
+   finite difference coloring to evaluate a block of colors together.
+ */
+PetscErrorCode FormFunctionBatch(SNES snes,PetscInt n,Vec X[],Vec F[],void *ptr)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  for (i=0; i<n; i++) {
+    ierr = FormFunction(snes,X[i],F[i],ptr);CHKERRQ(ierr);
+  }
+  return 0;
+}
+/* ------------------------------------------------------------------- */
 /*
    FormJacobian - Evaluates Jacobian matrix.
 
@@ -462,4 +480,14 @@ PetscErrorCode FormJacobian(SNES snes,Vec X,Mat J,Mat jac,void *ptr)
       suffix: 3
       args: -snes_monitor_short -mat_coloring_type sl -snes_fd_coloring -mx 8 -my 11 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: 4
+      args: -snes_monitor_short -mat_coloring_type sl -snes_fd_coloring -snes_fd_coloring_batch -mat_fd_coloring_bcols 4 -mx 8 -my 11 -ksp_gmres_cgs_refinement_type refine_always
+      output_file: output/ex1_3.out
+
+   test:
+      suffix: 5
+      args: -snes_monitor_short -mat_coloring_type gm -snes_fd_coloring -mx 8 -my 11 -ksp_gmres_cgs_refinement_type refine_always
+      output_file: output/ex1_3.out
+
 TEST*/
@@ -40,10 +40,13 @@ static PetscErrorCode SNESComputeFunctionCtx(SNES snes,Vec x,Vec f,void *ctx)
         get the coloring from the matrix.  This requires that the matrix have nonzero entries
         precomputed.  
 
+        To evaluate the function for several colors in one call, pass a MatFDColoring on which
+        MatFDColoringSetFunctionBatch() has been called as the context.
+
 .keywords: SNES, finite differences, Jacobian, coloring, sparse
 
 .seealso: SNESSetJacobian(), SNESTestJacobian(), SNESComputeJacobianDefault()
-          MatFDColoringCreate(), MatFDColoringSetFunction()
+          MatFDColoringCreate(), MatFDColoringSetFunction(), MatFDColoringSetFunctionBatch()
 
 @*/
 
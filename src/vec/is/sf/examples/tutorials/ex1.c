@@ -386,4 +386,32 @@ int main(int argc,char **argv)
       nsize: 3
       args: -test_bcast -test_sf_distribute -sf_type basic
 
+   test:
+      suffix: window_dynamic_lock
+      nsize: 4
+      args: -test_bcast -test_reduce -test_gather -sf_type window -sf_window_flavor dynamic -sf_window_sync lock
+      requires: define(PETSC_HAVE_MPI_WIN_CREATE) define(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW) define(PETSC_HAVE_MPICH_NUMVERSION)
+
+   test:
+      suffix: window_dynamic_active
+      nsize: 4
+      args: -test_bcast -test_reduce -test_scatter -sf_type window -sf_window_flavor dynamic -sf_window_sync active
+      requires: define(PETSC_HAVE_MPI_WIN_CREATE) define(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW) define(PETSC_HAVE_MPICH_NUMVERSION)
+
+   test:
+      suffix: persistent
+      nsize: 4
+      args: -test_bcast -test_reduce -test_fetchandop -sf_type persistent
+
+   test:
+      suffix: persistent_neighbor
+      nsize: 4
+      args: -test_bcast -test_reduce -test_gather -sf_type persistent -sf_persistent_neighbor
+      requires: define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+   test:
+      suffix: 8_persistent
+      nsize: 3
+      args: -test_bcast -test_sf_distribute -sf_type persistent
+
 TEST*/
@@ -37,7 +37,10 @@ struct _n_PetscSFBasicPack {
   const void       *key;        /* Array used as key for operation */
   char             **root;      /* Packed root data, indexed by leaf rank */
   char             **leaf;      /* Packed leaf data, indexed by root rank */
+  char             *rootbuf;    /* Contiguous storage of root[] */
+  char             *leafbuf;    /* Contiguous storage of the non-distinguished leaf[] */
   MPI_Request      *requests;   /* Array of root requests followed by leaf requests */
+  MPI_Request      *preqs;      /* PETSCSFPERSISTENT: persistent requests bound to root[] and leaf[], root to leaf followed by leaf to root */
   PetscSFBasicPack next;
 };
 
@@ -51,6 +54,13 @@ typedef struct {
   PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */
   PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */
   PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */
+
+  /* PETSCSFPERSISTENT */
+  PetscBool        persistent;  /* Communicate with persistent requests created once per pack */
+  PetscBool        neighbor;    /* Communicate with neighborhood collectives instead of persistent point-to-point requests */
+  MPI_Comm         ncomm[2];    /* Distributed graph communicators for root to leaf [0] and leaf to root [1] communication */
+  PetscMPIInt      *rootcounts,*rootdispls; /* Counts and displacements of the non-distinguished root ranks for neighborhood collectives */
+  PetscMPIInt      *leafcounts,*leafdispls; /* Counts and displacements of the non-distinguished leaf ranks for neighborhood collectives */
 } PetscSF_Basic;
 
 #if !defined(PETSC_HAVE_MPI_TYPE_DUP)
@@ -739,7 +749,11 @@ static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MPI_Waitall(bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks),link->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  if (bas->neighbor) { /* a single request for the neighborhood collective */
+    ierr = MPI_Wait(link->requests,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Waitall(bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks),link->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -767,6 +781,74 @@ static PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,Pe
   PetscFunctionReturn(0);
 }
 
+/*
+   PetscSFBasicPackSetUpPersistent - Creates the persistent requests of a PETSCSFPERSISTENT pack; they are bound to the
+   buffers root[] and leaf[] of the pack which are reused by every operation with the pack's MPI_Datatype.
+   The root to leaf requests are followed by the leaf to root requests, each set laid out as link->requests.
+*/
+static PetscErrorCode PetscSFBasicPackSetUpPersistent(PetscSF sf,PetscSFBasicPack link)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  PetscInt          i,nrootranks,ndrootranks,nleafranks,ndleafranks,nrootreqs,nreqs;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  if (bas->neighbor) {
+    ierr = PetscMalloc1(1,&link->requests);CHKERRQ(ierr);
+    link->requests[0] = MPI_REQUEST_NULL;
+    PetscFunctionReturn(0);
+  }
+  ierr      = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr      = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr      = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  nrootreqs = nrootranks - ndrootranks;
+  nreqs     = nrootreqs + nleafranks - ndleafranks;
+  ierr      = PetscMalloc1(2*nreqs,&link->preqs);CHKERRQ(ierr);
+  for (i=ndrootranks; i<nrootranks; i++) {
+    PetscMPIInt n = rootoffset[i+1] - rootoffset[i];
+    ierr = MPI_Send_init(link->root[i],n,link->unit,rootranks[i],bas->tag,comm,&link->preqs[i-ndrootranks]);CHKERRQ(ierr);
+    ierr = MPI_Recv_init(link->root[i],n,link->unit,rootranks[i],bas->tag,comm,&link->preqs[nreqs+i-ndrootranks]);CHKERRQ(ierr);
+  }
+  for (i=ndleafranks; i<nleafranks; i++) {
+    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+    ierr = MPI_Recv_init(link->leaf[i],n,link->unit,leafranks[i],bas->tag,comm,&link->preqs[nrootreqs+i-ndleafranks]);CHKERRQ(ierr);
+    ierr = MPI_Send_init(link->leaf[i],n,link->unit,leafranks[i],bas->tag,comm,&link->preqs[nreqs+nrootreqs+i-ndleafranks]);CHKERRQ(ierr);
+  }
+  link->requests = link->preqs;
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscSFBasicPackStartPersistent - Starts the communication of the packed data of a PETSCSFPERSISTENT pack,
+   from roots to leaves if leaftoroot is false and from leaves to roots otherwise
+*/
+static PetscErrorCode PetscSFBasicPackStartPersistent(PetscSF sf,PetscSFBasicPack link,PetscBool leaftoroot)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+  PetscInt       nreqs = bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks);
+
+  PetscFunctionBegin;
+  if (bas->neighbor) {
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+    char *rootstart = link->rootbuf + bas->ioffset[bas->ndiranks]*link->unitbytes; /* skip the distinguished (shared memory) rank */
+
+    if (!leaftoroot) {
+      ierr = MPI_Ineighbor_alltoallv(rootstart,bas->rootcounts,bas->rootdispls,link->unit,link->leafbuf,bas->leafcounts,bas->leafdispls,link->unit,bas->ncomm[0],link->requests);CHKERRQ(ierr);
+    } else {
+      ierr = MPI_Ineighbor_alltoallv(link->leafbuf,bas->leafcounts,bas->leafdispls,link->unit,rootstart,bas->rootcounts,bas->rootdispls,link->unit,bas->ncomm[1],link->requests);CHKERRQ(ierr);
+    }
+#endif
+  } else {
+    link->requests = link->preqs + (leaftoroot ? nreqs : 0);
+    if (nreqs) {ierr = MPI_Startall(nreqs,link->requests);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
@@ -792,18 +874,21 @@ static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const voi
   ierr = PetscNew(&link);CHKERRQ(ierr);
   ierr = PetscSFBasicPackTypeSetup(link,unit);CHKERRQ(ierr);
   ierr = PetscMalloc2(nrootranks,&link->root,nleafranks,&link->leaf);CHKERRQ(ierr);
-  for (i=0; i<nrootranks; i++) {
-    ierr = PetscMalloc((rootoffset[i+1]-rootoffset[i])*link->unitbytes,&link->root[i]);CHKERRQ(ierr);
-  }
+  ierr = PetscMalloc2(rootoffset[nrootranks]*link->unitbytes,&link->rootbuf,(leafoffset[nleafranks]-leafoffset[ndleafranks])*link->unitbytes,&link->leafbuf);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) link->root[i] = link->rootbuf + rootoffset[i]*link->unitbytes;
   for (i=0; i<nleafranks; i++) {
     if (i < ndleafranks) {      /* Leaf buffers for distinguished ranks are pointers directly into root buffers */
       if (ndrootranks != 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Cannot match distinguished ranks");
       link->leaf[i] = link->root[0];
       continue;
     }
-    ierr = PetscMalloc((leafoffset[i+1]-leafoffset[i])*link->unitbytes,&link->leaf[i]);CHKERRQ(ierr);
+    link->leaf[i] = link->leafbuf + (leafoffset[i]-leafoffset[ndleafranks])*link->unitbytes;
+  }
+  if (bas->persistent) {
+    ierr = PetscSFBasicPackSetUpPersistent(sf,link);CHKERRQ(ierr);
+  } else {
+    ierr = PetscCalloc1(nrootranks+nleafranks,&link->requests);CHKERRQ(ierr);
   }
-  ierr = PetscCalloc1(nrootranks+nleafranks,&link->requests);CHKERRQ(ierr);
 
 found:
   link->key  = key;
@@ -875,13 +960,21 @@ static PetscErrorCode PetscSFReset_Basic(PetscSF sf)
     PetscInt i;
     next = link->next;
     ierr = MPI_Type_free(&link->unit);CHKERRQ(ierr);
-    for (i=0; i<bas->niranks; i++) {ierr = PetscFree(link->root[i]);CHKERRQ(ierr);}
-    for (i=sf->ndranks; i<sf->nranks; i++) {ierr = PetscFree(link->leaf[i]);CHKERRQ(ierr);} /* Free only non-distinguished leaf buffers */
+    ierr = PetscFree2(link->rootbuf,link->leafbuf);CHKERRQ(ierr);
     ierr = PetscFree2(link->root,link->leaf);CHKERRQ(ierr);
-    ierr = PetscFree(link->requests);CHKERRQ(ierr);
+    if (link->preqs) { /* link->requests points into the persistent requests */
+      PetscInt nreqs = bas->niranks+sf->nranks-(bas->ndiranks+sf->ndranks);
+      for (i=0; i<2*nreqs; i++) {ierr = MPI_Request_free(&link->preqs[i]);CHKERRQ(ierr);}
+      ierr = PetscFree(link->preqs);CHKERRQ(ierr);
+    } else {
+      ierr = PetscFree(link->requests);CHKERRQ(ierr);
+    }
     ierr = PetscFree(link);CHKERRQ(ierr);
   }
   bas->avail = NULL;
+  if (bas->ncomm[0] != MPI_COMM_NULL) {ierr = MPI_Comm_free(&bas->ncomm[0]);CHKERRQ(ierr);}
+  if (bas->ncomm[1] != MPI_COMM_NULL) {ierr = MPI_Comm_free(&bas->ncomm[1]);CHKERRQ(ierr);}
+  ierr = PetscFree4(bas->rootcounts,bas->rootdispls,bas->leafcounts,bas->leafdispls);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -925,6 +1018,12 @@ static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf,MPI_Datatype unit,const
   ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
 
+  if (bas->persistent) {
+    for (i=0; i<nrootranks; i++) (*link->Pack)(rootoffset[i+1]-rootoffset[i],link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
+    ierr = PetscSFBasicPackStartPersistent(sf,link,PETSC_FALSE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
   ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
   /* Eagerly post leaf receives, but only from non-distinguished ranks -- distinguished ranks will receive via shared memory */
   for (i=ndleafranks; i<nleafranks; i++) {
@@ -978,6 +1077,12 @@ PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void
   ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
 
+  if (bas->persistent) {
+    for (i=0; i<nleafranks; i++) (*link->Pack)(leafoffset[i+1]-leafoffset[i],link->bs,leafloc+leafoffset[i],leafdata,link->leaf[i]);
+    ierr = PetscSFBasicPackStartPersistent(sf,link,PETSC_TRUE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
   ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
   /* Eagerly post root receives for non-distinguished ranks */
   for (i=ndrootranks; i<nrootranks; i++) {
@@ -1067,21 +1172,26 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,vo
   ierr      = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
   ierr      = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
   ierr      = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
-  ierr      = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
-  /* Post leaf receives */
-  for (i=ndleafranks; i<nleafranks; i++) {
-    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
-    ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
-  }
-  /* Process local fetch-and-op, post root sends */
-  ierr = PetscSFBasicPackGetFetchAndOp(sf,link,op,&FetchAndOp);CHKERRQ(ierr);
-  for (i=0; i<nrootranks; i++) {
-    PetscMPIInt n          = rootoffset[i+1] - rootoffset[i];
-    void        *packstart = link->root[i];
-
-    (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
-    if (i < ndrootranks) continue; /* shared memory */
-    ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+  ierr      = PetscSFBasicPackGetFetchAndOp(sf,link,op,&FetchAndOp);CHKERRQ(ierr);
+  if (bas->persistent) {
+    for (i=0; i<nrootranks; i++) (*FetchAndOp)(rootoffset[i+1]-rootoffset[i],link->bs,rootloc+rootoffset[i],rootdata,link->root[i]);
+    ierr = PetscSFBasicPackStartPersistent(sf,link,PETSC_FALSE);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
+    /* Post leaf receives */
+    for (i=ndleafranks; i<nleafranks; i++) {
+      PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
+      ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+    }
+    /* Process local fetch-and-op, post root sends */
+    for (i=0; i<nrootranks; i++) {
+      PetscMPIInt n          = rootoffset[i+1] - rootoffset[i];
+      void        *packstart = link->root[i];
+
+      (*FetchAndOp)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
+      if (i < ndrootranks) continue; /* shared memory */
+      ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+    }
   }
   ierr = PetscSFBasicPackWaitall(sf,link);CHKERRQ(ierr);
   for (i=0; i<nleafranks; i++) {
@@ -1112,6 +1222,208 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Basic;
 
   ierr = PetscNewLog(sf,&bas);CHKERRQ(ierr);
+  bas->ncomm[0] = MPI_COMM_NULL;
+  bas->ncomm[1] = MPI_COMM_NULL;
   sf->data = (void*)bas;
   PetscFunctionReturn(0);
 }
+
+/*@
+   PetscSFPersistentSetNeighbor - use MPI-3 neighborhood collectives instead of persistent point-to-point requests with PETSCSFPERSISTENT
+
+   Logically Collective
+
+   Input Arguments:
++  sf - star forest for communication
+-  flg - PETSC_TRUE to communicate with MPI_Ineighbor_alltoallv() on distributed graph communicators
+
+   Options Database Key:
+.  -sf_persistent_neighbor <bool> - use neighborhood collectives
+
+   Notes:
+   Must be called before PetscSFSetUp(). Requires an MPI library that provides MPI-3 neighborhood collectives.
+
+   Level: advanced
+
+.seealso: PetscSFSetFromOptions(), PetscSFPersistentGetNeighbor(), PETSCSFPERSISTENT
+@*/
+PetscErrorCode PetscSFPersistentSetNeighbor(PetscSF sf,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  PetscValidLogicalCollectiveBool(sf,flg,2);
+  ierr = PetscTryMethod(sf,"PetscSFPersistentSetNeighbor_C",(PetscSF,PetscBool),(sf,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFPersistentSetNeighbor_Persistent(PetscSF sf,PetscBool flg)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
+
+  PetscFunctionBegin;
+  if (flg == bas->neighbor) PetscFunctionReturn(0);
+  if (sf->setupcalled) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Must be called before PetscSFSetUp()");
+#if !defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  if (flg) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_SUP_SYS,"MPI library does not provide neighborhood collectives");
+#endif
+  bas->neighbor = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PetscSFPersistentGetNeighbor - get whether PETSCSFPERSISTENT communicates with neighborhood collectives
+
+   Not Collective
+
+   Input Argument:
+.  sf - star forest for communication
+
+   Output Argument:
+.  flg - PETSC_TRUE if MPI_Ineighbor_alltoallv() is used
+
+   Level: advanced
+
+.seealso: PetscSFPersistentSetNeighbor(), PETSCSFPERSISTENT
+@*/
+PetscErrorCode PetscSFPersistentGetNeighbor(PetscSF sf,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  PetscValidPointer(flg,2);
+  ierr = PetscUseMethod(sf,"PetscSFPersistentGetNeighbor_C",(PetscSF,PetscBool*),(sf,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFPersistentGetNeighbor_Persistent(PetscSF sf,PetscBool *flg)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
+
+  PetscFunctionBegin;
+  *flg = bas->neighbor;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFSetUp_Persistent(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFSetUp_Basic(sf);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  {
+    PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
+    PetscInt      i,nrootranks,nleafranks;
+    MPI_Comm      comm;
+
+    if (!bas->neighbor) PetscFunctionReturn(0);
+    ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+    /* The distinguished (shared memory) ranks communicate through the pack buffers and are not part of the graph */
+    nrootranks = bas->niranks - bas->ndiranks;
+    nleafranks = sf->nranks - sf->ndranks;
+    ierr = PetscMalloc4(nrootranks,&bas->rootcounts,nrootranks,&bas->rootdispls,nleafranks,&bas->leafcounts,nleafranks,&bas->leafdispls);CHKERRQ(ierr);
+    for (i=0; i<nrootranks; i++) {
+      ierr = PetscMPIIntCast(bas->ioffset[bas->ndiranks+i+1]-bas->ioffset[bas->ndiranks+i],&bas->rootcounts[i]);CHKERRQ(ierr);
+      ierr = PetscMPIIntCast(bas->ioffset[bas->ndiranks+i]-bas->ioffset[bas->ndiranks],&bas->rootdispls[i]);CHKERRQ(ierr);
+    }
+    for (i=0; i<nleafranks; i++) {
+      ierr = PetscMPIIntCast(sf->roffset[sf->ndranks+i+1]-sf->roffset[sf->ndranks+i],&bas->leafcounts[i]);CHKERRQ(ierr);
+      ierr = PetscMPIIntCast(sf->roffset[sf->ndranks+i]-sf->roffset[sf->ndranks],&bas->leafdispls[i]);CHKERRQ(ierr);
+    }
+    /* Roots send to the ranks referencing them in broadcasts, leaves send to the ranks owning their roots in reductions; edges are weighted by message length */
+    ierr = MPI_Dist_graph_create_adjacent(comm,nleafranks,sf->ranks+sf->ndranks,bas->leafcounts,nrootranks,bas->iranks+bas->ndiranks,bas->rootcounts,MPI_INFO_NULL,0,&bas->ncomm[0]);CHKERRQ(ierr);
+    ierr = MPI_Dist_graph_create_adjacent(comm,nrootranks,bas->iranks+bas->ndiranks,bas->rootcounts,nleafranks,sf->ranks+sf->ndranks,bas->leafcounts,MPI_INFO_NULL,0,&bas->ncomm[1]);CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Persistent(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+  PetscBool      flg,set;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Persistent options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sf_persistent_neighbor","Use MPI-3 neighborhood collectives instead of persistent requests","PetscSFPersistentSetNeighbor",bas->neighbor,&flg,&set);CHKERRQ(ierr);
+  if (set) {ierr = PetscSFPersistentSetNeighbor(sf,flg);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFView_Persistent(PetscSF sf,PetscViewer viewer)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  communication=%s sort=%s\n",bas->neighbor ? "neighborhood collectives" : "persistent requests",sf->rankorder ? "rank-order" : "unordered");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFDuplicate_Persistent(PetscSF sf,PetscSFDuplicateOption opt,PetscSF newsf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFPersistentSetNeighbor(newsf,bas->neighbor);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFDestroy_Persistent(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFPersistentSetNeighbor_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFPersistentGetNeighbor_C",NULL);CHKERRQ(ierr);
+  ierr = PetscSFDestroy_Basic(sf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   PETSCSFPERSISTENT - PetscSF implementation that communicates with persistent requests
+
+   The communication graph of a star forest is fixed once PetscSFSetUp() is called, so this implementation creates
+   MPI_Send_init()/MPI_Recv_init() requests for each MPI_Datatype the first time it is communicated and afterwards
+   only starts them with MPI_Startall(), saving the setup cost of MPI_Isend()/MPI_Irecv() in every halo exchange.
+   Alternatively MPI-3 neighborhood collectives (MPI_Ineighbor_alltoallv()) over distributed graph communicators
+   can be used. Otherwise it behaves like PETSCSFBASIC.
+
+   Options Database Keys:
++  -sf_type persistent - use this implementation
+-  -sf_persistent_neighbor - use neighborhood collectives instead of persistent point-to-point requests
+
+   Level: intermediate
+
+.seealso: PetscSFCreate(), PetscSFSetType(), PetscSFType, PETSCSFBASIC, PetscSFPersistentSetNeighbor()
+M*/
+PETSC_EXTERN PetscErrorCode PetscSFCreate_Persistent(PetscSF sf)
+{
+  PetscSF_Basic  *bas;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFCreate_Basic(sf);CHKERRQ(ierr);
+  sf->ops->SetUp          = PetscSFSetUp_Persistent;
+  sf->ops->SetFromOptions = PetscSFSetFromOptions_Persistent;
+  sf->ops->Destroy        = PetscSFDestroy_Persistent;
+  sf->ops->View           = PetscSFView_Persistent;
+  sf->ops->Duplicate      = PetscSFDuplicate_Persistent;
+
+  bas             = (PetscSF_Basic*)sf->data;
+  bas->persistent = PETSC_TRUE;
+
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFPersistentSetNeighbor_C",PetscSFPersistentSetNeighbor_Persistent);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFPersistentGetNeighbor_C",PetscSFPersistentGetNeighbor_Persistent);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -4,9 +4,11 @@ typedef struct _n_PetscSFDataLink *PetscSFDataLink;
 typedef struct _n_PetscSFWinLink  *PetscSFWinLink;
 
 typedef struct {
-  PetscSFWindowSyncType sync; /* FENCE, LOCK, or ACTIVE synchronization */
-  PetscSFDataLink       link;   /* List of MPI data types and windows, lazily constructed for each data type */
-  PetscSFWinLink        wins;   /* List of active windows */
+  PetscSFWindowSyncType   sync;   /* FENCE, LOCK, or ACTIVE synchronization */
+  PetscSFWindowFlavorType flavor; /* CREATE or DYNAMIC windows */
+  PetscSFDataLink         link;   /* List of MPI data types and windows, lazily constructed for each data type */
+  PetscSFWinLink          wins;   /* List of active windows, and of idle dynamic windows */
+  PetscSF                 dynsf;  /* One root per process and one leaf per remote rank, used to exchange addresses of dynamic windows */
 } PetscSF_Window;
 
 struct _n_PetscSFDataLink {
@@ -17,15 +19,18 @@ struct _n_PetscSFDataLink {
 };
 
 struct _n_PetscSFWinLink {
-  PetscBool      inuse;
-  size_t         bytes;
-  void           *addr;
-  MPI_Win        win;
-  PetscBool      epoch;
-  PetscSFWinLink next;
+  PetscBool               inuse;
+  size_t                  bytes;
+  void                    *addr;
+  MPI_Win                 win;
+  PetscBool               epoch;
+  PetscSFWindowFlavorType flavor;
+  MPI_Aint                *target_disp; /* Displacement of the root array of each remote rank in win, zero unless the window is dynamic */
+  PetscSFWinLink          next;
 };
 
 const char *const PetscSFWindowSyncTypes[] = {"FENCE","LOCK","ACTIVE","PetscSFWindowSyncType","PETSCSF_WINDOW_SYNC_",0};
+const char *const PetscSFWindowFlavorTypes[] = {"CREATE","DYNAMIC","PetscSFWindowFlavorType","PETSCSF_WINDOW_FLAVOR_",0};
 
 /* Built-in MPI_Ops act elementwise inside MPI_Accumulate, but cannot be used with composite types inside collectives (MPIU_Allreduce) */
 static PetscErrorCode PetscSFWindowOpTranslate(MPI_Op *op)
@@ -182,6 +187,112 @@ static PetscErrorCode PetscSFWindowGetSyncType_Window(PetscSF sf,PetscSFWindowSy
   PetscFunctionReturn(0);
 }
 
+/*@C
+   PetscSFWindowSetFlavorType - set the flavor of the MPI windows used for PetscSF communication
+
+   Logically Collective
+
+   Input Arguments:
++  sf - star forest for communication
+-  flavor - window flavor
+
+   Options Database Key:
+.  -sf_window_flavor <flavor> - sets the window flavor CREATE or DYNAMIC (see PetscSFWindowFlavorType)
+
+   Notes:
+   With PETSCSF_WINDOW_FLAVOR_DYNAMIC the windows are created once and reused, so a communication costs a local MPI_Win_attach()
+   and a small message to each rank that references the local roots instead of the collective creation and destruction of a
+   window. Combined with PETSCSF_WINDOW_SYNC_LOCK, communication only synchronizes the ranks that are connected in the graph.
+
+   Level: advanced
+
+.seealso: PetscSFSetFromOptions(), PetscSFWindowGetFlavorType(), PetscSFWindowSetSyncType()
+@*/
+PetscErrorCode PetscSFWindowSetFlavorType(PetscSF sf,PetscSFWindowFlavorType flavor)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(sf,flavor,2);
+  ierr = PetscUseMethod(sf,"PetscSFWindowSetFlavorType_C",(PetscSF,PetscSFWindowFlavorType),(sf,flavor));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFWindowSetFlavorType_Window(PetscSF sf,PetscSFWindowFlavorType flavor)
+{
+  PetscSF_Window *w = (PetscSF_Window*)sf->data;
+
+  PetscFunctionBegin;
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+  if (flavor == PETSCSF_WINDOW_FLAVOR_DYNAMIC) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_SUP_SYS,"Dynamic windows require MPI-3 one-sided support");
+#endif
+  w->flavor = flavor;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscSFWindowGetFlavorType - get the flavor of the MPI windows used for PetscSF communication
+
+   Not Collective
+
+   Input Argument:
+.  sf - star forest for communication
+
+   Output Argument:
+.  flavor - window flavor
+
+   Level: advanced
+
+.seealso: PetscSFSetFromOptions(), PetscSFWindowSetFlavorType()
+@*/
+PetscErrorCode PetscSFWindowGetFlavorType(PetscSF sf,PetscSFWindowFlavorType *flavor)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  PetscValidPointer(flavor,2);
+  ierr = PetscUseMethod(sf,"PetscSFWindowGetFlavorType_C",(PetscSF,PetscSFWindowFlavorType*),(sf,flavor));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFWindowGetFlavorType_Window(PetscSF sf,PetscSFWindowFlavorType *flavor)
+{
+  PetscSF_Window *w = (PetscSF_Window*)sf->data;
+
+  PetscFunctionBegin;
+  *flavor = w->flavor;
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+/* The graph of dynsf has one leaf per remote rank of sf, in the order of sf->ranks, all pointing to the single root on that rank */
+static PetscErrorCode PetscSFWindowGetDynamicSF(PetscSF sf,PetscSF *dynsf)
+{
+  PetscSF_Window *w = (PetscSF_Window*)sf->data;
+  PetscErrorCode ierr;
+  PetscSFNode    *remote;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (!w->dynsf) {
+    ierr = PetscMalloc1(sf->nranks,&remote);CHKERRQ(ierr);
+    for (i=0; i<sf->nranks; i++) {
+      remote[i].rank  = sf->ranks[i];
+      remote[i].index = 0;
+    }
+    ierr = PetscSFCreate(PetscObjectComm((PetscObject)sf),&w->dynsf);CHKERRQ(ierr);
+    ierr = PetscSFSetType(w->dynsf,PETSCSFBASIC);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(w->dynsf,1,sf->nranks,NULL,PETSC_OWN_POINTER,remote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFSetUp(w->dynsf);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)sf,(PetscObject)w->dynsf);CHKERRQ(ierr);
+  }
+  *dynsf = w->dynsf;
+  PetscFunctionReturn(0);
+}
+#endif
+
 /*@C
    PetscSFGetWindow - Get a window for use with a given data type
 
@@ -197,18 +308,20 @@ static PetscErrorCode PetscSFWindowGetSyncType_Window(PetscSF sf,PetscSFWindowSy
 -  startassert - assert parameter for call to MPI_Win_start(), if PETSCSF_WINDOW_SYNC_ACTIVE
 
    Output Arguments:
-.  win - window
++  win - window
+-  target_disp - displacement of the root array of each remote rank (in the order of PetscSFGetRanks()) to be used as target_disp in RMA calls
 
    Level: developer
 
    Developer Notes:
-   This currently always creates a new window. This is more synchronous than necessary. An alternative is to try to
-   reuse an existing window created with the same array. Another alternative is to maintain a cache of windows and reuse
-   whichever one is available, by copying the array into it if necessary.
+   With PETSCSF_WINDOW_FLAVOR_CREATE this creates a new window for every communication, which is collective and more
+   synchronous than necessary. With PETSCSF_WINDOW_FLAVOR_DYNAMIC an idle dynamic window is reused; the array is attached to
+   it and its address is sent to the ranks referencing our roots. Receiving that address also tells the origin that the root
+   array is ready, which is all the synchronization needed to open a passive target epoch.
 
 .seealso: PetscSFGetRanks(), PetscSFWindowGetDataTypes()
 @*/
-static PetscErrorCode PetscSFGetWindow(PetscSF sf,MPI_Datatype unit,void *array,PetscBool epoch,PetscMPIInt fenceassert,PetscMPIInt postassert,PetscMPIInt startassert,MPI_Win *win)
+static PetscErrorCode PetscSFGetWindow(PetscSF sf,MPI_Datatype unit,void *array,PetscBool epoch,PetscMPIInt fenceassert,PetscMPIInt postassert,PetscMPIInt startassert,MPI_Win *win,const MPI_Aint **target_disp)
 {
   PetscSF_Window *w = (PetscSF_Window*)sf->data;
   PetscErrorCode ierr;
@@ -220,26 +333,58 @@ static PetscErrorCode PetscSFGetWindow(PetscSF sf,MPI_Datatype unit,void *array,
   ierr = MPI_Type_get_true_extent(unit,&lb_true,&bytes_true);CHKERRQ(ierr);
   if (lb != 0 || lb_true != 0) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_SUP,"No support for unit type with nonzero lower bound, write petsc-maint@mcs.anl.gov if you want this feature");
   if (bytes != bytes_true) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_SUP,"No support for unit type with modified extent, write petsc-maint@mcs.anl.gov if you want this feature");
-  ierr = PetscNew(&link);CHKERRQ(ierr);
-
-  link->bytes = bytes;
-  link->addr  = array;
 
-  ierr = MPI_Win_create(array,(MPI_Aint)bytes*sf->nroots,(PetscMPIInt)bytes,MPI_INFO_NULL,PetscObjectComm((PetscObject)sf),&link->win);CHKERRQ(ierr);
+  switch (w->flavor) {
+  case PETSCSF_WINDOW_FLAVOR_CREATE:
+    ierr = PetscNew(&link);CHKERRQ(ierr);
+    ierr = PetscCalloc1(sf->nranks,&link->target_disp);CHKERRQ(ierr);
+    ierr = MPI_Win_create(array,(MPI_Aint)bytes*sf->nroots,(PetscMPIInt)bytes,MPI_INFO_NULL,PetscObjectComm((PetscObject)sf),&link->win);CHKERRQ(ierr);
+    link->next = w->wins;
+    w->wins    = link;
+    break;
+#if defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+  case PETSCSF_WINDOW_FLAVOR_DYNAMIC: {
+    PetscSF  dynsf;
+    MPI_Aint addr;
+
+    /* Every process acquires and releases windows in the same order, so all pick the same idle window */
+    for (link=w->wins; link; link=link->next) if (link->flavor == PETSCSF_WINDOW_FLAVOR_DYNAMIC && !link->inuse) break;
+    if (!link) {
+      ierr = PetscNew(&link);CHKERRQ(ierr);
+      ierr = PetscMalloc1(sf->nranks,&link->target_disp);CHKERRQ(ierr);
+      ierr = MPI_Win_create_dynamic(MPI_INFO_NULL,PetscObjectComm((PetscObject)sf),&link->win);CHKERRQ(ierr);
+      link->next = w->wins;
+      w->wins    = link;
+    }
+    if (bytes && sf->nroots) {ierr = MPI_Win_attach(link->win,array,(MPI_Aint)bytes*sf->nroots);CHKERRQ(ierr);}
+    ierr = MPI_Get_address(array,&addr);CHKERRQ(ierr);
+    ierr = PetscSFWindowGetDynamicSF(sf,&dynsf);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(dynsf,MPI_AINT,&addr,link->target_disp);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(dynsf,MPI_AINT,&addr,link->target_disp);CHKERRQ(ierr);
+  } break;
+#endif
+  default: SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_SUP,"Unsupported window flavor");
+  }
 
-  link->epoch = epoch;
-  link->next  = w->wins;
-  link->inuse = PETSC_TRUE;
-  w->wins     = link;
-  *win        = link->win;
+  link->bytes  = bytes;
+  link->addr   = array;
+  link->flavor = w->flavor;
+  link->epoch  = epoch;
+  link->inuse  = PETSC_TRUE;
+  *win         = link->win;
+  *target_disp = link->target_disp;
 
   if (epoch) {
     switch (w->sync) {
     case PETSCSF_WINDOW_SYNC_FENCE:
       ierr = MPI_Win_fence(fenceassert,*win);CHKERRQ(ierr);
       break;
-    case PETSCSF_WINDOW_SYNC_LOCK: /* Handled outside */
-      break;
+    case PETSCSF_WINDOW_SYNC_LOCK:
+#if defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+      /* One shared epoch to all targets, closed in PetscSFRestoreWindow(), so the operation does not block in the Begin phase */
+      ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK,*win);CHKERRQ(ierr);
+#endif
+      break;                    /* otherwise each rank is locked individually outside */
     case PETSCSF_WINDOW_SYNC_ACTIVE: {
       MPI_Group ingroup,outgroup;
       ierr = PetscSFGetGroups(sf,&ingroup,&outgroup);CHKERRQ(ierr);
@@ -277,7 +422,7 @@ static PetscErrorCode PetscSFFindWindow(PetscSF sf,MPI_Datatype unit,const void
   PetscFunctionBegin;
   *win = MPI_WIN_NULL;
   for (link=w->wins; link; link=link->next) {
-    if (array == link->addr) {
+    if (link->inuse && array == link->addr) {
       *win = link->win;
       PetscFunctionReturn(0);
     }
@@ -311,13 +456,12 @@ static PetscErrorCode PetscSFRestoreWindow(PetscSF sf,MPI_Datatype unit,const vo
   PetscFunctionBegin;
   for (p=&w->wins; *p; p=&(*p)->next) {
     link = *p;
-    if (*win == link->win) {
+    if (link->inuse && *win == link->win) {
       if (array != link->addr) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Matched window, but not array");
       if (epoch != link->epoch) {
         if (epoch) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"No epoch to end");
         else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Restoring window without ending epoch");
       }
-      *p = link->next;
       goto found;
     }
   }
@@ -330,7 +474,10 @@ found:
       ierr = MPI_Win_fence(fenceassert,*win);CHKERRQ(ierr);
       break;
     case PETSCSF_WINDOW_SYNC_LOCK:
-      break;                    /* handled outside */
+#if defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+      ierr = MPI_Win_unlock_all(*win);CHKERRQ(ierr);
+#endif
+      break;                    /* otherwise handled outside */
     case PETSCSF_WINDOW_SYNC_ACTIVE: {
       ierr = MPI_Win_complete(*win);CHKERRQ(ierr);
       ierr = MPI_Win_wait(*win);CHKERRQ(ierr);
@@ -339,37 +486,60 @@ found:
     }
   }
 
-  ierr = MPI_Win_free(&link->win);CHKERRQ(ierr);
-  ierr = PetscFree(link);CHKERRQ(ierr);
+  switch (link->flavor) {
+  case PETSCSF_WINDOW_FLAVOR_CREATE:
+    /* MPI_Win_free() waits for all processes, so the targets know that all accesses to their arrays have completed */
+    *p   = link->next;
+    ierr = MPI_Win_free(&link->win);CHKERRQ(ierr);
+    ierr = PetscFree(link->target_disp);CHKERRQ(ierr);
+    ierr = PetscFree(link);CHKERRQ(ierr);
+    break;
+#if defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+  case PETSCSF_WINDOW_FLAVOR_DYNAMIC:
+    if (!epoch || w->sync == PETSCSF_WINDOW_SYNC_LOCK) {
+      PetscSF  dynsf;
+      MPI_Aint done;
+
+      /* Passive target: the unlock completed our accesses at the targets, tell them so before they detach or reuse their arrays */
+      ierr = PetscSFWindowGetDynamicSF(sf,&dynsf);CHKERRQ(ierr);
+      ierr = PetscSFReduceBegin(dynsf,MPI_AINT,link->target_disp,&done,MPIU_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSFReduceEnd(dynsf,MPI_AINT,link->target_disp,&done,MPIU_REPLACE);CHKERRQ(ierr);
+    }
+    if (link->bytes && sf->nroots) {ierr = MPI_Win_detach(link->win,link->addr);CHKERRQ(ierr);}
+    link->addr  = NULL;
+    link->inuse = PETSC_FALSE;
+    break;
+#endif
+  default: SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_PLIB,"Unknown window flavor");
+  }
   *win = MPI_WIN_NULL;
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode PetscSFSetUp_Window(PetscSF sf)
 {
-  PetscSF_Window *w = (PetscSF_Window*)sf->data;
   PetscErrorCode ierr;
-  MPI_Group      ingroup,outgroup;
 
   PetscFunctionBegin;
+  /* The groups for PETSCSF_WINDOW_SYNC_ACTIVE cannot be built here because PetscSFGetGroups() requires a set up PetscSF;
+     they are built on first use in PetscSFGetWindow() */
   ierr = PetscSFSetUpRanks(sf,MPI_GROUP_EMPTY);CHKERRQ(ierr);
-  switch (w->sync) {
-  case PETSCSF_WINDOW_SYNC_ACTIVE:
-    ierr = PetscSFGetGroups(sf,&ingroup,&outgroup);CHKERRQ(ierr);
-  default:
-    break;
-  }
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode PetscSFSetFromOptions_Window(PetscOptionItems *PetscOptionsObject,PetscSF sf)
 {
-  PetscSF_Window *w = (PetscSF_Window*)sf->data;
-  PetscErrorCode ierr;
+  PetscSF_Window          *w = (PetscSF_Window*)sf->data;
+  PetscErrorCode          ierr;
+
+  PetscSFWindowFlavorType flavor = w->flavor;
+  PetscBool               flg;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Window options");CHKERRQ(ierr);
   ierr = PetscOptionsEnum("-sf_window_sync","synchronization type to use for PetscSF Window communication","PetscSFWindowSetSyncType",PetscSFWindowSyncTypes,(PetscEnum)w->sync,(PetscEnum*)&w->sync,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-sf_window_flavor","flavor of the MPI windows used for PetscSF Window communication","PetscSFWindowSetFlavorType",PetscSFWindowFlavorTypes,(PetscEnum)flavor,(PetscEnum*)&flavor,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = PetscSFWindowSetFlavorType(sf,flavor);CHKERRQ(ierr);}
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -398,9 +568,11 @@ static PetscErrorCode PetscSFReset_Window(PetscSF sf)
     wnext = wlink->next;
     if (wlink->inuse) SETERRQ1(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Window still in use with address %p",(void*)wlink->addr);
     ierr = MPI_Win_free(&wlink->win);CHKERRQ(ierr);
+    ierr = PetscFree(wlink->target_disp);CHKERRQ(ierr);
     ierr = PetscFree(wlink);CHKERRQ(ierr);
   }
   w->wins = NULL;
+  ierr = PetscSFDestroy(&w->dynsf);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -413,6 +585,8 @@ static PetscErrorCode PetscSFDestroy_Window(PetscSF sf)
   ierr = PetscFree(sf->data);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowSetSyncType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowGetSyncType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowSetFlavorType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowGetFlavorType_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -425,44 +599,46 @@ static PetscErrorCode PetscSFView_Window(PetscSF sf,PetscViewer viewer)
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
-    ierr = PetscViewerASCIIPrintf(viewer,"  synchronization=%s sort=%s\n",PetscSFWindowSyncTypes[w->sync],sf->rankorder ? "rank-order" : "unordered");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  synchronization=%s flavor=%s sort=%s\n",PetscSFWindowSyncTypes[w->sync],PetscSFWindowFlavorTypes[w->flavor],sf->rankorder ? "rank-order" : "unordered");CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode PetscSFDuplicate_Window(PetscSF sf,PetscSFDuplicateOption opt,PetscSF newsf)
 {
-  PetscSF_Window        *w = (PetscSF_Window*)sf->data;
-  PetscErrorCode        ierr;
-  PetscSFWindowSyncType synctype;
+  PetscSF_Window *w = (PetscSF_Window*)sf->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  synctype = w->sync;
-  if (!sf->setupcalled) {
-    /* HACK: Must use FENCE or LOCK when called from PetscSFGetGroups() because ACTIVE here would cause recursion. */
-    synctype = PETSCSF_WINDOW_SYNC_LOCK;
-  }
-  ierr = PetscSFWindowSetSyncType(newsf,synctype);CHKERRQ(ierr);
+  ierr = PetscSFWindowSetSyncType(newsf,w->sync);CHKERRQ(ierr);
+  ierr = PetscSFWindowSetFlavorType(newsf,w->flavor);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 static PetscErrorCode PetscSFBcastBegin_Window(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
 {
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
   PetscSF_Window     *w = (PetscSF_Window*)sf->data;
+#endif
   PetscErrorCode     ierr;
   PetscInt           i,nranks;
   const PetscMPIInt  *ranks;
   const MPI_Datatype *mine,*remote;
+  const MPI_Aint     *target_disp;
   MPI_Win            win;
 
   PetscFunctionBegin;
   ierr = PetscSFGetRanks(sf,&nranks,&ranks,NULL,NULL,NULL);CHKERRQ(ierr);
   ierr = PetscSFWindowGetDataTypes(sf,unit,&mine,&remote);CHKERRQ(ierr);
-  ierr = PetscSFGetWindow(sf,unit,(void*)rootdata,PETSC_TRUE,MPI_MODE_NOPUT|MPI_MODE_NOPRECEDE,MPI_MODE_NOPUT,0,&win);CHKERRQ(ierr);
+  ierr = PetscSFGetWindow(sf,unit,(void*)rootdata,PETSC_TRUE,MPI_MODE_NOPUT|MPI_MODE_NOPRECEDE,MPI_MODE_NOPUT,0,&win,&target_disp);CHKERRQ(ierr);
   for (i=0; i<nranks; i++) {
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
     if (w->sync == PETSCSF_WINDOW_SYNC_LOCK) {ierr = MPI_Win_lock(MPI_LOCK_SHARED,ranks[i],MPI_MODE_NOCHECK,win);CHKERRQ(ierr);}
-    ierr = MPI_Get(leafdata,1,mine[i],ranks[i],0,1,remote[i],win);CHKERRQ(ierr);
+#endif
+    ierr = MPI_Get(leafdata,1,mine[i],ranks[i],target_disp[i],1,remote[i],win);CHKERRQ(ierr);
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
     if (w->sync == PETSCSF_WINDOW_SYNC_LOCK) {ierr = MPI_Win_unlock(ranks[i],win);CHKERRQ(ierr);}
+#endif
   }
   PetscFunctionReturn(0);
 }
@@ -480,22 +656,29 @@ PetscErrorCode PetscSFBcastEnd_Window(PetscSF sf,MPI_Datatype unit,const void *r
 
 PetscErrorCode PetscSFReduceBegin_Window(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
 {
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
   PetscSF_Window     *w = (PetscSF_Window*)sf->data;
+#endif
   PetscErrorCode     ierr;
   PetscInt           i,nranks;
   const PetscMPIInt  *ranks;
   const MPI_Datatype *mine,*remote;
+  const MPI_Aint     *target_disp;
   MPI_Win            win;
 
   PetscFunctionBegin;
   ierr = PetscSFGetRanks(sf,&nranks,&ranks,NULL,NULL,NULL);CHKERRQ(ierr);
   ierr = PetscSFWindowGetDataTypes(sf,unit,&mine,&remote);CHKERRQ(ierr);
   ierr = PetscSFWindowOpTranslate(&op);CHKERRQ(ierr);
-  ierr = PetscSFGetWindow(sf,unit,rootdata,PETSC_TRUE,MPI_MODE_NOPRECEDE,0,0,&win);CHKERRQ(ierr);
+  ierr = PetscSFGetWindow(sf,unit,rootdata,PETSC_TRUE,MPI_MODE_NOPRECEDE,0,0,&win,&target_disp);CHKERRQ(ierr);
   for (i=0; i<nranks; i++) {
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
     if (w->sync == PETSCSF_WINDOW_SYNC_LOCK) {ierr = MPI_Win_lock(MPI_LOCK_SHARED,ranks[i],MPI_MODE_NOCHECK,win);CHKERRQ(ierr);}
-    ierr = MPI_Accumulate((void*)leafdata,1,mine[i],ranks[i],0,1,remote[i],op,win);CHKERRQ(ierr);
+#endif
+    ierr = MPI_Accumulate((void*)leafdata,1,mine[i],ranks[i],target_disp[i],1,remote[i],op,win);CHKERRQ(ierr);
+#if !defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
     if (w->sync == PETSCSF_WINDOW_SYNC_LOCK) {ierr = MPI_Win_unlock(ranks[i],win);CHKERRQ(ierr);}
+#endif
   }
   PetscFunctionReturn(0);
 }
@@ -509,7 +692,6 @@ static PetscErrorCode PetscSFReduceEnd_Window(PetscSF sf,MPI_Datatype unit,const
   PetscFunctionBegin;
   if (!w->wins) PetscFunctionReturn(0);
   ierr = PetscSFFindWindow(sf,unit,rootdata,&win);CHKERRQ(ierr);
-  ierr = MPI_Win_fence(MPI_MODE_NOSUCCEED,win);CHKERRQ(ierr);
   ierr = PetscSFRestoreWindow(sf,unit,rootdata,PETSC_TRUE,MPI_MODE_NOSUCCEED,&win);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -519,17 +701,18 @@ static PetscErrorCode PetscSFFetchAndOpBegin_Window(PetscSF sf,MPI_Datatype unit
   PetscInt           i,nranks;
   const PetscMPIInt  *ranks;
   const MPI_Datatype *mine,*remote;
+  const MPI_Aint     *target_disp;
   MPI_Win            win;
 
   PetscFunctionBegin;
   ierr = PetscSFGetRanks(sf,&nranks,&ranks,NULL,NULL,NULL);CHKERRQ(ierr);
   ierr = PetscSFWindowGetDataTypes(sf,unit,&mine,&remote);CHKERRQ(ierr);
   ierr = PetscSFWindowOpTranslate(&op);CHKERRQ(ierr);
-  ierr = PetscSFGetWindow(sf,unit,rootdata,PETSC_FALSE,0,0,0,&win);CHKERRQ(ierr);
+  ierr = PetscSFGetWindow(sf,unit,rootdata,PETSC_FALSE,0,0,0,&win,&target_disp);CHKERRQ(ierr);
   for (i=0; i<sf->nranks; i++) {
     ierr = MPI_Win_lock(MPI_LOCK_EXCLUSIVE,sf->ranks[i],0,win);CHKERRQ(ierr);
-    ierr = MPI_Get(leafupdate,1,mine[i],ranks[i],0,1,remote[i],win);CHKERRQ(ierr);
-    ierr = MPI_Accumulate((void*)leafdata,1,mine[i],ranks[i],0,1,remote[i],op,win);CHKERRQ(ierr);
+    ierr = MPI_Get(leafupdate,1,mine[i],ranks[i],target_disp[i],1,remote[i],win);CHKERRQ(ierr);
+    ierr = MPI_Accumulate((void*)leafdata,1,mine[i],ranks[i],target_disp[i],1,remote[i],op,win);CHKERRQ(ierr);
     ierr = MPI_Win_unlock(ranks[i],win);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
@@ -567,11 +750,14 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Window(PetscSF sf)
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Window;
 
   ierr = PetscNewLog(sf,&w);CHKERRQ(ierr);
-  sf->data = (void*)w;
-  w->sync  = PETSCSF_WINDOW_SYNC_FENCE;
+  sf->data  = (void*)w;
+  w->sync   = PETSCSF_WINDOW_SYNC_FENCE;
+  w->flavor = PETSCSF_WINDOW_FLAVOR_CREATE;
 
   ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowSetSyncType_C",PetscSFWindowSetSyncType_Window);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowGetSyncType_C",PetscSFWindowGetSyncType_Window);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowSetFlavorType_C",PetscSFWindowSetFlavorType_Window);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)sf,"PetscSFWindowGetFlavorType_C",PetscSFWindowGetFlavorType_Window);CHKERRQ(ierr);
 
 #if defined(OMPI_MAJOR_VERSION) && (OMPI_MAJOR_VERSION < 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION <= 6))
   {
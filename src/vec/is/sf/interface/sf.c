@@ -797,7 +797,9 @@ PetscErrorCode PetscSFGetGroups(PetscSF sf,MPI_Group *incoming,MPI_Group *outgoi
       remote[i].rank  = sf->ranks[i];
       remote[i].index = 0;
     }
-    ierr = PetscSFDuplicate(sf,PETSCSF_DUPLICATE_CONFONLY,&bgcount);CHKERRQ(ierr);
+    /* Use PETSCSFBASIC, a PETSCSFWINDOW with active synchronization would need the groups being computed here */
+    ierr = PetscSFCreate(PetscObjectComm((PetscObject)sf),&bgcount);CHKERRQ(ierr);
+    ierr = PetscSFSetType(bgcount,PETSCSFBASIC);CHKERRQ(ierr);
     ierr = PetscSFSetGraph(bgcount,1,sf->nranks,NULL,PETSC_COPY_VALUES,remote,PETSC_OWN_POINTER);CHKERRQ(ierr);
     ierr = PetscSFComputeDegreeBegin(bgcount,&indegree);CHKERRQ(ierr);
     ierr = PetscSFComputeDegreeEnd(bgcount,&indegree);CHKERRQ(ierr);
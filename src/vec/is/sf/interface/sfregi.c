@@ -1,6 +1,7 @@
 #include <petsc/private/sfimpl.h>     /*I  "petscsf.h"  I*/
 
 PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF);
+PETSC_EXTERN PetscErrorCode PetscSFCreate_Persistent(PetscSF);
 #if defined(PETSC_HAVE_MPI_WIN_CREATE) && defined(PETSC_HAVE_MPI_TYPE_DUP)
 PETSC_EXTERN PetscErrorCode PetscSFCreate_Window(PetscSF);
 #endif
@@ -27,6 +28,7 @@ PetscErrorCode  PetscSFRegisterAll(void)
   if (PetscSFRegisterAllCalled) PetscFunctionReturn(0);
   PetscSFRegisterAllCalled = PETSC_TRUE;
   ierr = PetscSFRegister(PETSCSFBASIC,  PetscSFCreate_Basic);CHKERRQ(ierr);
+  ierr = PetscSFRegister(PETSCSFPERSISTENT,PetscSFCreate_Persistent);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPI_WIN_CREATE) && defined(PETSC_HAVE_MPI_TYPE_DUP)
   ierr = PetscSFRegister(PETSCSFWINDOW, PetscSFCreate_Window);CHKERRQ(ierr);
 #endif
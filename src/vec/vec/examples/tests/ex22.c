@@ -68,4 +68,10 @@ int main(int argc,char **argv)
    test:
       nsize: 4
 
+   test:
+      suffix: nopack
+      nsize: 4
+      args: -vecscatter_nopack
+      output_file: output/ex22_1.out
+
 TEST*/
@@ -80,4 +80,10 @@ int main(int argc,char **argv)
    test:
       nsize: 2
 
+   test:
+      suffix: nopack
+      nsize: 2
+      args: -vecscatter_nopack
+      output_file: output/ex23_1.out
+
 TEST*/
@@ -0,0 +1,114 @@
+
+static char help[] = "Tests the fused vector operations VecAXPYDotNorm2(), VecAXPBYPCZDotNorm2(), VecWAXPYDotNorm2() and their split phase forms.\n\n";
+
+#include <petscvec.h>
+
+/* compares the fused results with the ones of the separate vector operations */
+static PetscErrorCode Check(const char *name,Vec v,Vec vref,PetscScalar dot,PetscScalar dotref,PetscReal nm,PetscReal nmref)
+{
+  PetscErrorCode ierr;
+  PetscReal      err,ref;
+
+  PetscFunctionBeginUser;
+  ierr = VecAXPY(v,-1.0,vref);CHKERRQ(ierr);
+  ierr = VecNorm(v,NORM_2,&err);CHKERRQ(ierr);
+  ierr = VecNorm(vref,NORM_2,&ref);CHKERRQ(ierr);
+  if (err > 1.e-12*ref) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the vector differs by %g\n",name,(double)err);CHKERRQ(ierr);}
+  if (PetscAbsScalar(dot - dotref) > 1.e-12*PetscAbsScalar(dotref)) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the inner product differs by %g\n",name,(double)PetscAbsScalar(dot - dotref));CHKERRQ(ierr);}
+  if (PetscAbsReal(nm - nmref) > 1.e-12*nmref) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the norm differs by %g\n",name,(double)PetscAbsReal(nm - nmref));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 37;
+  PetscScalar    alpha = 0.5,beta = -2.0,gamma = 3.0,dot,dot2,dotref;
+  PetscReal      nm,nm2,nmref;
+  Vec            x,y,z,u,w,wref;
+  PetscRandom    rctx;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&wref);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(z,rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(u,rctx);CHKERRQ(ierr);
+
+  /* y <- y + alpha x, (y,u) and ||y||^2 */
+  ierr = VecWAXPY(wref,alpha,x,y);CHKERRQ(ierr);
+  ierr = VecDot(wref,u,&dotref);CHKERRQ(ierr);
+  ierr = VecNorm(wref,NORM_2,&nmref);CHKERRQ(ierr);
+  nmref = nmref*nmref;
+  ierr = VecCopy(y,w);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm2(w,alpha,x,u,&dot,&nm);CHKERRQ(ierr);
+  ierr = Check("VecAXPYDotNorm2",w,wref,dot,dotref,nm,nmref);CHKERRQ(ierr);
+  ierr = VecCopy(y,w);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm2(w,alpha,x,NULL,NULL,&nm);CHKERRQ(ierr);
+  ierr = Check("VecAXPYDotNorm2 norm only",w,wref,dotref,dotref,nm,nmref);CHKERRQ(ierr);
+
+  /* w <- alpha x + beta y + gamma w, (w,w) and ||w||^2 with the inner product against the updated vector itself */
+  ierr = VecCopy(z,wref);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(wref,alpha,beta,gamma,x,y);CHKERRQ(ierr);
+  ierr = VecDot(wref,wref,&dotref);CHKERRQ(ierr);
+  ierr = VecCopy(z,w);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZDotNorm2(w,alpha,beta,gamma,x,y,w,&dot,&nm);CHKERRQ(ierr);
+  ierr = Check("VecAXPBYPCZDotNorm2",w,wref,dot,dotref,nm,PetscRealPart(dotref));CHKERRQ(ierr);
+
+  /* w <- alpha x + y, (w,z) and ||w||^2 */
+  ierr = VecWAXPY(wref,alpha,x,y);CHKERRQ(ierr);
+  ierr = VecDot(wref,z,&dotref);CHKERRQ(ierr);
+  ierr = VecNorm(wref,NORM_2,&nmref);CHKERRQ(ierr);
+  nmref = nmref*nmref;
+  ierr = VecWAXPYDotNorm2(w,alpha,x,y,z,&dot,&nm);CHKERRQ(ierr);
+  ierr = Check("VecWAXPYDotNorm2",w,wref,dot,dotref,nm,nmref);CHKERRQ(ierr);
+
+  /* split phase: two fused operations and a VecDot() share one reduction */
+  ierr = VecCopy(y,w);CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm2Begin(w,alpha,x,u,&dot,&nm);CHKERRQ(ierr);
+  ierr = VecWAXPYDotNorm2Begin(z,beta,x,y,u,&dot2,&nm2);CHKERRQ(ierr);
+  ierr = VecDotBegin(x,u,&dotref);CHKERRQ(ierr);
+  ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)x));CHKERRQ(ierr);
+  ierr = VecAXPYDotNorm2End(w,alpha,x,u,&dot,&nm);CHKERRQ(ierr);
+  ierr = VecWAXPYDotNorm2End(z,beta,x,y,u,&dot2,&nm2);CHKERRQ(ierr);
+  ierr = VecDotEnd(x,u,&dotref);CHKERRQ(ierr);
+  ierr = VecWAXPY(wref,alpha,x,y);CHKERRQ(ierr);
+  ierr = VecDot(wref,u,&dotref);CHKERRQ(ierr);
+  ierr = VecNorm(wref,NORM_2,&nmref);CHKERRQ(ierr);
+  ierr = Check("VecAXPYDotNorm2Begin/End",w,wref,dot,dotref,nm,nmref*nmref);CHKERRQ(ierr);
+  ierr = VecWAXPY(wref,beta,x,y);CHKERRQ(ierr);
+  ierr = VecDot(wref,u,&dotref);CHKERRQ(ierr);
+  ierr = VecNorm(wref,NORM_2,&nmref);CHKERRQ(ierr);
+  ierr = Check("VecWAXPYDotNorm2Begin/End",z,wref,dot2,dotref,nm2,nmref*nmref);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Fused vector operations done\n");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&wref);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+   test:
+      suffix: 2
+      nsize: 3
+
+TEST*/
@@ -23,6 +23,9 @@ PETSC_INTERN PetscErrorCode VecMAXPY_Seq(Vec,PetscInt,const PetscScalar*,Vec*);
 PETSC_INTERN PetscErrorCode VecAYPX_Seq(Vec,PetscScalar,Vec);
 PETSC_INTERN PetscErrorCode VecWAXPY_Seq(Vec,PetscScalar,Vec,Vec);
 PETSC_INTERN PetscErrorCode VecAXPBYPCZ_Seq(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPYDotNorm2_Seq(Vec,PetscScalar,Vec,Vec,PetscScalar*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecAXPBYPCZDotNorm2_Seq(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecWAXPYDotNorm2_Seq(Vec,PetscScalar,Vec,Vec,Vec,PetscScalar*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecMaxPointwiseDivide_Seq(Vec,Vec,PetscReal*);
 PETSC_INTERN PetscErrorCode VecPlaceArray_Seq(Vec,const PetscScalar*);
 PETSC_INTERN PetscErrorCode VecResetArray_Seq(Vec);
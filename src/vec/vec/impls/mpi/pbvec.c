@@ -468,7 +468,14 @@ static struct _VecOps DvOps = { VecDuplicate_MPI, /* 1 */
                                 VecStrideSubSetGather_Default,
                                 VecStrideSubSetScatter_Default,
                                 0,
-                                0
+                                0,
+                                0,
+                                0,
+                                0,
+                                0,
+                                VecAXPYDotNorm2_Seq,
+                                VecAXPBYPCZDotNorm2_Seq,
+                                VecWAXPYDotNorm2_Seq
 };
 
 /*
@@ -151,3 +151,140 @@ PetscErrorCode VecAXPBYPCZ_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscS
   ierr = VecRestoreArray(zin,&zz);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/*
+   The fused operations below update a vector and return, for the updated vector v, the local parts of
+   (v,z) (if dot is not NULL) and of v'*conj(v) (if nm is not NULL) from the same sweep. z may be v itself.
+*/
+PetscErrorCode VecAXPYDotNorm2_Seq(Vec yin,PetscScalar alpha,Vec xin,Vec zin,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = yin->map->n,i;
+  const PetscScalar *xx,*zz = NULL;
+  PetscScalar       *yy,sum = 0.0;
+  PetscReal         nsum = 0.0;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+  if (dot) {
+    if (zin == yin) zz = yy;
+    else {ierr = VecGetArrayRead(zin,&zz);CHKERRQ(ierr);}
+  }
+  if (dot && nm) {
+    for (i=0; i<n; i++) {
+      yy[i] += alpha*xx[i];
+      sum   += yy[i]*PetscConj(zz[i]);
+      nsum  += PetscRealPart(yy[i]*PetscConj(yy[i]));
+    }
+  } else if (dot) {
+    for (i=0; i<n; i++) {
+      yy[i] += alpha*xx[i];
+      sum   += yy[i]*PetscConj(zz[i]);
+    }
+  } else if (nm) {
+    for (i=0; i<n; i++) {
+      yy[i] += alpha*xx[i];
+      nsum  += PetscRealPart(yy[i]*PetscConj(yy[i]));
+    }
+  } else {
+    for (i=0; i<n; i++) yy[i] += alpha*xx[i];
+  }
+  if (dot && zin != yin) {ierr = VecRestoreArrayRead(zin,&zz);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  if (dot) *dot = sum;
+  if (nm)  *nm  = nsum;
+  ierr = PetscLogFlops((2.0 + (dot ? 2.0 : 0.0) + (nm ? 2.0 : 0.0))*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBYPCZDotNorm2_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin,Vec uin,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = zin->map->n,i;
+  const PetscScalar *xx,*yy,*uu = NULL;
+  PetscScalar       *zz,sum = 0.0;
+  PetscReal         nsum = 0.0;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&yy);CHKERRQ(ierr);
+  ierr = VecGetArray(zin,&zz);CHKERRQ(ierr);
+  if (dot) {
+    if (uin == zin) uu = zz;
+    else {ierr = VecGetArrayRead(uin,&uu);CHKERRQ(ierr);}
+  }
+  if (dot && nm) {
+    for (i=0; i<n; i++) {
+      zz[i]  = alpha*xx[i] + beta*yy[i] + gamma*zz[i];
+      sum   += zz[i]*PetscConj(uu[i]);
+      nsum  += PetscRealPart(zz[i]*PetscConj(zz[i]));
+    }
+  } else if (dot) {
+    for (i=0; i<n; i++) {
+      zz[i]  = alpha*xx[i] + beta*yy[i] + gamma*zz[i];
+      sum   += zz[i]*PetscConj(uu[i]);
+    }
+  } else if (nm) {
+    for (i=0; i<n; i++) {
+      zz[i]  = alpha*xx[i] + beta*yy[i] + gamma*zz[i];
+      nsum  += PetscRealPart(zz[i]*PetscConj(zz[i]));
+    }
+  } else {
+    for (i=0; i<n; i++) zz[i] = alpha*xx[i] + beta*yy[i] + gamma*zz[i];
+  }
+  if (dot && uin != zin) {ierr = VecRestoreArrayRead(uin,&uu);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zin,&zz);CHKERRQ(ierr);
+  if (dot) *dot = sum;
+  if (nm)  *nm  = nsum;
+  ierr = PetscLogFlops((5.0 + (dot ? 2.0 : 0.0) + (nm ? 2.0 : 0.0))*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecWAXPYDotNorm2_Seq(Vec win,PetscScalar alpha,Vec xin,Vec yin,Vec zin,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = win->map->n,i;
+  const PetscScalar *xx,*yy,*zz = NULL;
+  PetscScalar       *ww,sum = 0.0;
+  PetscReal         nsum = 0.0;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&yy);CHKERRQ(ierr);
+  ierr = VecGetArray(win,&ww);CHKERRQ(ierr);
+  if (dot) {
+    if (zin == win) zz = ww;
+    else {ierr = VecGetArrayRead(zin,&zz);CHKERRQ(ierr);}
+  }
+  if (dot && nm) {
+    for (i=0; i<n; i++) {
+      ww[i]  = alpha*xx[i] + yy[i];
+      sum   += ww[i]*PetscConj(zz[i]);
+      nsum  += PetscRealPart(ww[i]*PetscConj(ww[i]));
+    }
+  } else if (dot) {
+    for (i=0; i<n; i++) {
+      ww[i]  = alpha*xx[i] + yy[i];
+      sum   += ww[i]*PetscConj(zz[i]);
+    }
+  } else if (nm) {
+    for (i=0; i<n; i++) {
+      ww[i]  = alpha*xx[i] + yy[i];
+      nsum  += PetscRealPart(ww[i]*PetscConj(ww[i]));
+    }
+  } else {
+    for (i=0; i<n; i++) ww[i] = alpha*xx[i] + yy[i];
+  }
+  if (dot && zin != win) {ierr = VecRestoreArrayRead(zin,&zz);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);
+  ierr = VecRestoreArray(win,&ww);CHKERRQ(ierr);
+  if (dot) *dot = sum;
+  if (nm)  *nm  = nsum;
+  ierr = PetscLogFlops((2.0 + (dot ? 2.0 : 0.0) + (nm ? 2.0 : 0.0))*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
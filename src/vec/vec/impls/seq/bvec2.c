@@ -862,7 +862,14 @@ static struct _VecOps DvOps = {VecDuplicate_Seq, /* 1 */
                                VecStrideSubSetGather_Default,
                                VecStrideSubSetScatter_Default,
                                0,
-                               0
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               VecAXPYDotNorm2_Seq,
+                               VecAXPBYPCZDotNorm2_Seq,
+                               VecWAXPYDotNorm2_Seq
 };
 
 
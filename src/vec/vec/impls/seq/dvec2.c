@@ -6,6 +6,191 @@
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
+/*
+    With eight or more vectors VecMAXPY_Seq() sweeps x in pieces of VEC_MULTI_BLOCK entries that stay in cache while
+    the y vectors stream past them eight at a time, so x is read from memory once per panel of VEC_MULTI_PANEL vectors
+    rather than once per four vectors. With --with-avx512-kernels the eight vector kernels use AVX-512 intrinsics, or
+    AVX2 with FMA when the compiler only targets that, and VecMDot_Seq() is blocked the same way; the plain C form of
+    the eight vector dot product does not vectorize and is slower than the four vector kernels below.
+*/
+#define VEC_MULTI_BLOCK 2048
+#define VEC_MULTI_PANEL 128
+
+#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+#  if defined(__AVX512F__)
+#    define PETSC_USE_AVX512_MULTI
+#  elif defined(__AVX2__) && defined(__FMA__)
+#    define PETSC_USE_AVX2_MULTI
+#  endif
+#endif
+#if defined(PETSC_USE_AVX512_MULTI) || defined(PETSC_USE_AVX2_MULTI)
+#include <immintrin.h>
+#endif
+
+#if defined(PETSC_USE_AVX2_MULTI)
+PETSC_STATIC_INLINE PetscScalar VecMultiSum_AVX2(__m256d v)
+{
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),_mm256_extractf128_pd(v,1));
+  return _mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s)));
+}
+#endif
+
+#if defined(PETSC_USE_AVX512_MULTI) || defined(PETSC_USE_AVX2_MULTI)
+/* z[k] += y[k]^H x for the eight vectors y[0..7] of length n */
+static void VecMDot8_Kernel(PetscInt n,const PetscScalar *PETSC_RESTRICT x,const PetscScalar *const *y,PetscScalar *z)
+{
+  const PetscScalar *y0 = y[0],*y1 = y[1],*y2 = y[2],*y3 = y[3],*y4 = y[4],*y5 = y[5],*y6 = y[6],*y7 = y[7];
+  PetscScalar       sum0 = 0.0,sum1 = 0.0,sum2 = 0.0,sum3 = 0.0,sum4 = 0.0,sum5 = 0.0,sum6 = 0.0,sum7 = 0.0,xi;
+  PetscInt          i = 0;
+#if defined(PETSC_USE_AVX512_MULTI)
+  __m512d           s0 = _mm512_setzero_pd(),s1 = s0,s2 = s0,s3 = s0,s4 = s0,s5 = s0,s6 = s0,s7 = s0,xv;
+
+  for (; i<n-7; i+=8) {
+    xv = _mm512_loadu_pd(x+i);
+    s0 = _mm512_fmadd_pd(_mm512_loadu_pd(y0+i),xv,s0);
+    s1 = _mm512_fmadd_pd(_mm512_loadu_pd(y1+i),xv,s1);
+    s2 = _mm512_fmadd_pd(_mm512_loadu_pd(y2+i),xv,s2);
+    s3 = _mm512_fmadd_pd(_mm512_loadu_pd(y3+i),xv,s3);
+    s4 = _mm512_fmadd_pd(_mm512_loadu_pd(y4+i),xv,s4);
+    s5 = _mm512_fmadd_pd(_mm512_loadu_pd(y5+i),xv,s5);
+    s6 = _mm512_fmadd_pd(_mm512_loadu_pd(y6+i),xv,s6);
+    s7 = _mm512_fmadd_pd(_mm512_loadu_pd(y7+i),xv,s7);
+  }
+  sum0 = _mm512_reduce_add_pd(s0); sum1 = _mm512_reduce_add_pd(s1);
+  sum2 = _mm512_reduce_add_pd(s2); sum3 = _mm512_reduce_add_pd(s3);
+  sum4 = _mm512_reduce_add_pd(s4); sum5 = _mm512_reduce_add_pd(s5);
+  sum6 = _mm512_reduce_add_pd(s6); sum7 = _mm512_reduce_add_pd(s7);
+#elif defined(PETSC_USE_AVX2_MULTI)
+  __m256d           s0 = _mm256_setzero_pd(),s1 = s0,s2 = s0,s3 = s0,s4 = s0,s5 = s0,s6 = s0,s7 = s0,xv;
+
+  for (; i<n-3; i+=4) {
+    xv = _mm256_loadu_pd(x+i);
+    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(y0+i),xv,s0);
+    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(y1+i),xv,s1);
+    s2 = _mm256_fmadd_pd(_mm256_loadu_pd(y2+i),xv,s2);
+    s3 = _mm256_fmadd_pd(_mm256_loadu_pd(y3+i),xv,s3);
+    s4 = _mm256_fmadd_pd(_mm256_loadu_pd(y4+i),xv,s4);
+    s5 = _mm256_fmadd_pd(_mm256_loadu_pd(y5+i),xv,s5);
+    s6 = _mm256_fmadd_pd(_mm256_loadu_pd(y6+i),xv,s6);
+    s7 = _mm256_fmadd_pd(_mm256_loadu_pd(y7+i),xv,s7);
+  }
+  sum0 = VecMultiSum_AVX2(s0); sum1 = VecMultiSum_AVX2(s1);
+  sum2 = VecMultiSum_AVX2(s2); sum3 = VecMultiSum_AVX2(s3);
+  sum4 = VecMultiSum_AVX2(s4); sum5 = VecMultiSum_AVX2(s5);
+  sum6 = VecMultiSum_AVX2(s6); sum7 = VecMultiSum_AVX2(s7);
+#endif
+  for (; i<n; i++) {
+    xi    = x[i];
+    sum0 += xi*PetscConj(y0[i]); sum1 += xi*PetscConj(y1[i]);
+    sum2 += xi*PetscConj(y2[i]); sum3 += xi*PetscConj(y3[i]);
+    sum4 += xi*PetscConj(y4[i]); sum5 += xi*PetscConj(y5[i]);
+    sum6 += xi*PetscConj(y6[i]); sum7 += xi*PetscConj(y7[i]);
+  }
+  z[0] += sum0; z[1] += sum1; z[2] += sum2; z[3] += sum3;
+  z[4] += sum4; z[5] += sum5; z[6] += sum6; z[7] += sum7;
+}
+
+static PetscErrorCode VecMDot_Seq_Multi(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,np,i,j,k,bs;
+  PetscScalar       sum;
+  const PetscScalar *x,*yy[VEC_MULTI_PANEL],*yb[8];
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(z,nv*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+  for (; nv>0; nv-=np, yin+=np, z+=np) {
+    np = PetscMin(nv,VEC_MULTI_PANEL);
+    for (k=0; k<np; k++) {ierr = VecGetArrayRead(yin[k],&yy[k]);CHKERRQ(ierr);}
+    for (i=0; i<n; i+=VEC_MULTI_BLOCK) {
+      bs = PetscMin(n-i,VEC_MULTI_BLOCK);
+      for (k=0; k+8<=np; k+=8) {
+        for (j=0; j<8; j++) yb[j] = yy[k+j] + i;
+        VecMDot8_Kernel(bs,x+i,yb,z+k);
+      }
+      for (; k<np; k++) {
+        for (sum=0.0, j=0; j<bs; j++) sum += x[i+j]*PetscConj(yy[k][i+j]);
+        z[k] += sum;
+      }
+    }
+    for (k=0; k<np; k++) {ierr = VecRestoreArrayRead(yin[k],&yy[k]);CHKERRQ(ierr);}
+  }
+  ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/* x += \sum_k alpha[k] y[k] for the eight vectors y[0..7] of length n */
+static void VecMAXPY8_Kernel(PetscInt n,PetscScalar *PETSC_RESTRICT x,const PetscScalar *alpha,const PetscScalar *const *y)
+{
+  const PetscScalar *y0 = y[0],*y1 = y[1],*y2 = y[2],*y3 = y[3],*y4 = y[4],*y5 = y[5],*y6 = y[6],*y7 = y[7];
+  const PetscScalar a0 = alpha[0],a1 = alpha[1],a2 = alpha[2],a3 = alpha[3],a4 = alpha[4],a5 = alpha[5],a6 = alpha[6],a7 = alpha[7];
+  PetscInt          i = 0;
+#if defined(PETSC_USE_AVX512_MULTI)
+  __m512d           va0 = _mm512_set1_pd(a0),va1 = _mm512_set1_pd(a1),va2 = _mm512_set1_pd(a2),va3 = _mm512_set1_pd(a3);
+  __m512d           va4 = _mm512_set1_pd(a4),va5 = _mm512_set1_pd(a5),va6 = _mm512_set1_pd(a6),va7 = _mm512_set1_pd(a7),xv;
+
+  for (; i<n-7; i+=8) {
+    xv = _mm512_loadu_pd(x+i);
+    xv = _mm512_fmadd_pd(va0,_mm512_loadu_pd(y0+i),xv);
+    xv = _mm512_fmadd_pd(va1,_mm512_loadu_pd(y1+i),xv);
+    xv = _mm512_fmadd_pd(va2,_mm512_loadu_pd(y2+i),xv);
+    xv = _mm512_fmadd_pd(va3,_mm512_loadu_pd(y3+i),xv);
+    xv = _mm512_fmadd_pd(va4,_mm512_loadu_pd(y4+i),xv);
+    xv = _mm512_fmadd_pd(va5,_mm512_loadu_pd(y5+i),xv);
+    xv = _mm512_fmadd_pd(va6,_mm512_loadu_pd(y6+i),xv);
+    xv = _mm512_fmadd_pd(va7,_mm512_loadu_pd(y7+i),xv);
+    _mm512_storeu_pd(x+i,xv);
+  }
+#elif defined(PETSC_USE_AVX2_MULTI)
+  __m256d           va0 = _mm256_set1_pd(a0),va1 = _mm256_set1_pd(a1),va2 = _mm256_set1_pd(a2),va3 = _mm256_set1_pd(a3);
+  __m256d           va4 = _mm256_set1_pd(a4),va5 = _mm256_set1_pd(a5),va6 = _mm256_set1_pd(a6),va7 = _mm256_set1_pd(a7),xv;
+
+  for (; i<n-3; i+=4) {
+    xv = _mm256_loadu_pd(x+i);
+    xv = _mm256_fmadd_pd(va0,_mm256_loadu_pd(y0+i),xv);
+    xv = _mm256_fmadd_pd(va1,_mm256_loadu_pd(y1+i),xv);
+    xv = _mm256_fmadd_pd(va2,_mm256_loadu_pd(y2+i),xv);
+    xv = _mm256_fmadd_pd(va3,_mm256_loadu_pd(y3+i),xv);
+    xv = _mm256_fmadd_pd(va4,_mm256_loadu_pd(y4+i),xv);
+    xv = _mm256_fmadd_pd(va5,_mm256_loadu_pd(y5+i),xv);
+    xv = _mm256_fmadd_pd(va6,_mm256_loadu_pd(y6+i),xv);
+    xv = _mm256_fmadd_pd(va7,_mm256_loadu_pd(y7+i),xv);
+    _mm256_storeu_pd(x+i,xv);
+  }
+#endif
+  for (; i<n; i++) x[i] += a0*y0[i] + a1*y1[i] + a2*y2[i] + a3*y3[i] + a4*y4[i] + a5*y5[i] + a6*y6[i] + a7*y7[i];
+}
+
+static PetscErrorCode VecMAXPY_Seq_Multi(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *y)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,np,i,j,k,bs;
+  PetscScalar       *x;
+  const PetscScalar *yy[VEC_MULTI_PANEL],*yb[8];
+
+  PetscFunctionBegin;
+  ierr = VecGetArray(xin,&x);CHKERRQ(ierr);
+  for (; nv>0; nv-=np, y+=np, alpha+=np) {
+    np = PetscMin(nv,VEC_MULTI_PANEL);
+    for (k=0; k<np; k++) {ierr = VecGetArrayRead(y[k],&yy[k]);CHKERRQ(ierr);}
+    for (i=0; i<n; i+=VEC_MULTI_BLOCK) {
+      bs = PetscMin(n-i,VEC_MULTI_BLOCK);
+      for (k=0; k+8<=np; k+=8) {
+        for (j=0; j<8; j++) yb[j] = yy[k+j] + i;
+        VecMAXPY8_Kernel(bs,x+i,alpha+k,yb);
+      }
+      for (; k<np; k++) {
+        for (j=0; j<bs; j++) x[i+j] += alpha[k]*yy[k][i+j];
+      }
+    }
+    for (k=0; k<np; k++) {ierr = VecRestoreArrayRead(y[k],&yy[k]);CHKERRQ(ierr);}
+  }
+  ierr = VecRestoreArray(xin,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
@@ -19,6 +204,13 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+#if defined(PETSC_USE_AVX512_MULTI) || defined(PETSC_USE_AVX2_MULTI)
+  if (nv >= 8) {
+    ierr = VecMDot_Seq_Multi(xin,nv,yin,z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   sum0 = 0.0;
   sum1 = 0.0;
   sum2 = 0.0;
@@ -100,6 +292,13 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+#if defined(PETSC_USE_AVX512_MULTI) || defined(PETSC_USE_AVX2_MULTI)
+  if (nv >= 8) {
+    ierr = VecMDot_Seq_Multi(xin,nv,yin,z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   sum0 = 0.;
   sum1 = 0.;
   sum2 = 0.;
@@ -566,6 +765,10 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
 
   PetscFunctionBegin;
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  if (nv >= 8) {
+    ierr = VecMAXPY_Seq_Multi(xin,nv,alpha,y);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   switch (j_rem=nv&0x3) {
   case 3:
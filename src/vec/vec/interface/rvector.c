@@ -796,6 +796,233 @@ PetscErrorCode  VecWAXPY(Vec w,PetscScalar alpha,Vec x,Vec y)
   PetscFunctionReturn(0);
 }
 
+/* sums the local results of a fused operation over the communicator of v with one reduction */
+static PetscErrorCode VecFusedAllreduce_Private(Vec v,PetscScalar *dot,PetscReal *nm)
+{
+  PetscScalar    work[2],sum[2];
+  PetscMPIInt    cnt = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (dot) work[cnt++] = *dot;
+  if (nm)  work[cnt++] = *nm;
+  if (!cnt) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(VEC_ReduceCommunication,v,0,0,0);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,sum,cnt,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)v));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceCommunication,v,0,0,0);CHKERRQ(ierr);
+  cnt  = 0;
+  if (dot) *dot = sum[cnt++];
+  if (nm)  *nm  = PetscRealPart(sum[cnt]);
+  PetscFunctionReturn(0);
+}
+
+/* the fallback of the fused operations for vector types that do not provide them */
+static PetscErrorCode VecFusedDotNorm2_Private(Vec v,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (dot && nm) {
+    ierr = VecDotBegin(v,z,dot);CHKERRQ(ierr);
+    ierr = VecNormBegin(v,NORM_2,nm);CHKERRQ(ierr);
+    ierr = VecDotEnd(v,z,dot);CHKERRQ(ierr);
+    ierr = VecNormEnd(v,NORM_2,nm);CHKERRQ(ierr);
+  } else if (dot) {
+    ierr = VecDot(v,z,dot);CHKERRQ(ierr);
+  } else if (nm) {
+    ierr = VecNorm(v,NORM_2,nm);CHKERRQ(ierr);
+  }
+  if (nm) *nm = (*nm)*(*nm);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPYDotNorm2 - Computes y = y + alpha x and, in the same sweep over the vectors and with a single
+   global reduction, the inner product of the new y with z and the square of its 2-norm.
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  alpha - the scalar
+.  x - the vector added to y
+-  z - the vector of the inner product, which may be y; ignored if dot is NULL
+
+   Input/Output Parameter:
+.  y - the vector updated
+
+   Output Parameters:
++  dot - (y,z) as computed by VecDot(y,z), or NULL
+-  nm - the square of the 2-norm of y, or NULL
+
+   Level: intermediate
+
+   Notes: For vector types without the fused operation this calls VecAXPY(), VecDot() and VecNorm().
+   VecAXPYDotNorm2Begin() and VecAXPYDotNorm2End() allow the reduction to be overlapped with other work.
+
+   Concepts: vector^fused operations
+
+.seealso: VecAXPY(), VecDot(), VecDotNorm2(), VecAXPBYPCZDotNorm2(), VecWAXPYDotNorm2(), VecAXPYDotNorm2Begin()
+@*/
+PetscErrorCode VecAXPYDotNorm2(Vec y,PetscScalar alpha,Vec x,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidType(y,1);
+  PetscValidType(x,3);
+  PetscCheckSameTypeAndComm(x,3,y,1);
+  VecCheckSameSize(x,3,y,1);
+  if (dot) {
+    PetscValidHeaderSpecific(z,VEC_CLASSID,4);
+    PetscCheckSameTypeAndComm(z,4,y,1);
+    VecCheckSameSize(z,4,y,1);
+  }
+  if (x == y) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  PetscValidLogicalCollectiveScalar(y,alpha,2);
+  VecLocked(y,1);
+
+  if (!y->ops->axpydotnorm2_local) {
+    ierr = VecAXPY(y,alpha,x);CHKERRQ(ierr);
+    ierr = VecFusedDotNorm2_Private(y,z,dot,nm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*y->ops->axpydotnorm2_local)(y,alpha,x,z,dot,nm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  ierr = VecFusedAllreduce_Private(y,dot,nm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPBYPCZDotNorm2 - Computes z = alpha x + beta y + gamma z and, in the same sweep over the vectors and
+   with a single global reduction, the inner product of the new z with u and the square of its 2-norm.
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  alpha,beta,gamma - the scalars
+.  x, y - the vectors combined into z, they must be different from each other and from z
+-  u - the vector of the inner product, which may be z; ignored if dot is NULL
+
+   Input/Output Parameter:
+.  z - the vector updated
+
+   Output Parameters:
++  dot - (z,u) as computed by VecDot(z,u), or NULL
+-  nm - the square of the 2-norm of z, or NULL
+
+   Level: intermediate
+
+   Notes: For vector types without the fused operation this calls VecAXPBYPCZ(), VecDot() and VecNorm().
+   VecAXPBYPCZDotNorm2Begin() and VecAXPBYPCZDotNorm2End() allow the reduction to be overlapped with other work.
+
+   Concepts: vector^fused operations
+
+.seealso: VecAXPBYPCZ(), VecDot(), VecDotNorm2(), VecAXPYDotNorm2(), VecWAXPYDotNorm2(), VecAXPBYPCZDotNorm2Begin()
+@*/
+PetscErrorCode VecAXPBYPCZDotNorm2(Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec x,Vec y,Vec u,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(z,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,5);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,6);
+  PetscValidType(z,1);
+  PetscValidType(x,5);
+  PetscValidType(y,6);
+  PetscCheckSameTypeAndComm(x,5,y,6);
+  PetscCheckSameTypeAndComm(x,5,z,1);
+  VecCheckSameSize(x,5,y,6);
+  VecCheckSameSize(x,5,z,1);
+  if (dot) {
+    PetscValidHeaderSpecific(u,VEC_CLASSID,7);
+    PetscCheckSameTypeAndComm(u,7,z,1);
+    VecCheckSameSize(u,7,z,1);
+  }
+  if (x == y || x == z || y == z) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x, y, and z must be different vectors");
+  PetscValidLogicalCollectiveScalar(z,alpha,2);
+  PetscValidLogicalCollectiveScalar(z,beta,3);
+  PetscValidLogicalCollectiveScalar(z,gamma,4);
+
+  if (!z->ops->axpbypczdotnorm2_local) {
+    ierr = VecAXPBYPCZ(z,alpha,beta,gamma,x,y);CHKERRQ(ierr);
+    ierr = VecFusedDotNorm2_Private(z,u,dot,nm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*z->ops->axpbypczdotnorm2_local)(z,alpha,beta,gamma,x,y,u,dot,nm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)z);CHKERRQ(ierr);
+  ierr = VecFusedAllreduce_Private(z,dot,nm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecWAXPYDotNorm2 - Computes w = alpha x + y and, in the same sweep over the vectors and with a single
+   global reduction, the inner product of w with z and the square of its 2-norm.
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  alpha - the scalar
+.  x, y - the vectors, they must be different from w
+-  z - the vector of the inner product, which may be w; ignored if dot is NULL
+
+   Output Parameters:
++  w - the result
+.  dot - (w,z) as computed by VecDot(w,z), or NULL
+-  nm - the square of the 2-norm of w, or NULL
+
+   Level: intermediate
+
+   Notes: For vector types without the fused operation this calls VecWAXPY(), VecDot() and VecNorm().
+   VecWAXPYDotNorm2Begin() and VecWAXPYDotNorm2End() allow the reduction to be overlapped with other work.
+
+   Concepts: vector^fused operations
+
+.seealso: VecWAXPY(), VecDot(), VecDotNorm2(), VecAXPYDotNorm2(), VecAXPBYPCZDotNorm2(), VecWAXPYDotNorm2Begin()
+@*/
+PetscErrorCode VecWAXPYDotNorm2(Vec w,PetscScalar alpha,Vec x,Vec y,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(w,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,4);
+  PetscValidType(w,1);
+  PetscValidType(x,3);
+  PetscValidType(y,4);
+  PetscCheckSameTypeAndComm(x,3,y,4);
+  PetscCheckSameTypeAndComm(y,4,w,1);
+  VecCheckSameSize(x,3,y,4);
+  VecCheckSameSize(x,3,w,1);
+  if (dot) {
+    PetscValidHeaderSpecific(z,VEC_CLASSID,5);
+    PetscCheckSameTypeAndComm(z,5,w,1);
+    VecCheckSameSize(z,5,w,1);
+  }
+  if (w == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Result vector w cannot be same as input vector y");
+  if (w == x) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Result vector w cannot be same as input vector x");
+  PetscValidLogicalCollectiveScalar(y,alpha,2);
+
+  if (!w->ops->waxpydotnorm2_local) {
+    ierr = VecWAXPY(w,alpha,x,y);CHKERRQ(ierr);
+    ierr = VecFusedDotNorm2_Private(w,z,dot,nm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*w->ops->waxpydotnorm2_local)(w,alpha,x,y,z,dot,nm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)w);CHKERRQ(ierr);
+  ierr = VecFusedAllreduce_Private(w,dot,nm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 
 /*@C
    VecSetValues - Inserts or adds values into certain locations of a vector.
@@ -762,3 +762,295 @@ PetscErrorCode  VecMTDotEnd(Vec x,PetscInt nv,const Vec y[],PetscScalar result[]
   ierr = VecMDotEnd(x,nv,y,result);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* ----------------------------------------------------------------------------------------------------*/
+/*
+      Split phase versions of the fused vector operations VecAXPYDotNorm2(), VecAXPBYPCZDotNorm2() and
+   VecWAXPYDotNorm2(). The xxxBegin() performs the vector update and the local part of the reductions,
+   the xxxEnd() returns the inner product and the squared norm.
+*/
+
+/* the local results of the fused operations for vector types that do not provide them */
+static PetscErrorCode VecFusedLocal_Private(Vec v,Vec z,PetscScalar *ldot,PetscReal *lnm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ldot) {
+    if (!v->ops->dot_local) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Vector does not suppport local dots");
+    ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = (*v->ops->dot_local)(v,z,ldot);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  }
+  if (lnm) {
+    if (!v->ops->norm_local) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Vector does not support local norms");
+    ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = (*v->ops->norm_local)(v,NORM_2,lnm);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    *lnm = (*lnm)*(*lnm);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecFusedBegin_Private(Vec v,PetscScalar *ldot,PetscReal *lnm)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  ierr = PetscSplitReductionGet(PetscObjectComm((PetscObject)v),&sr);CHKERRQ(ierr);
+  if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
+  while (sr->numopsbegin + 2 > sr->maxops) {
+    ierr = PetscSplitReductionExtend(sr);CHKERRQ(ierr);
+  }
+  if (ldot) {
+    sr->reducetype[sr->numopsbegin] = REDUCE_SUM;
+    sr->invecs[sr->numopsbegin]     = (void*)v;
+    sr->lvalues[sr->numopsbegin++]  = *ldot;
+  }
+  if (lnm) {
+    sr->reducetype[sr->numopsbegin] = REDUCE_SUM;
+    sr->invecs[sr->numopsbegin]     = (void*)v;
+    sr->lvalues[sr->numopsbegin++]  = *lnm;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecFusedEnd_Private(Vec v,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  ierr = PetscSplitReductionGet(PetscObjectComm((PetscObject)v),&sr);CHKERRQ(ierr);
+  ierr = PetscSplitReductionEnd(sr);CHKERRQ(ierr);
+  if (sr->numopsend + (dot ? 1 : 0) + (nm ? 1 : 0) > sr->numopsbegin) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Called VecxxxEnd() more times then VecxxxBegin()");
+  if ((dot || nm) && (void*)v != sr->invecs[sr->numopsend]) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Called VecxxxEnd() in a different order or with a different vector than VecxxxBegin()");
+  if (dot) *dot = sr->gvalues[sr->numopsend++];
+  if (nm)  *nm  = PetscRealPart(sr->gvalues[sr->numopsend++]);
+  if (sr->numopsend == sr->numopsbegin) {
+    sr->state       = STATE_BEGIN;
+    sr->numopsend   = 0;
+    sr->numopsbegin = 0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPYDotNorm2Begin - Starts a split phase VecAXPYDotNorm2(): computes y = y + alpha x and starts the
+   inner product of the new y with z and its squared 2-norm.
+
+   Input Parameters:
++   y - the vector updated
+.   alpha - the scalar
+.   x - the vector added to y
+.   z - the vector of the inner product, which may be y; ignored if dot is NULL
+.   dot - where the inner product will go, or NULL if it is not wanted
+-   nm - where the square of the 2-norm will go, or NULL if it is not wanted
+
+   Level: advanced
+
+   Notes:
+   Each call to VecAXPYDotNorm2Begin() should be paired with a call to VecAXPYDotNorm2End() with the same dot
+   and nm pointers being NULL or not. The update of y is complete on return.
+
+.seealso: VecAXPYDotNorm2End(), VecAXPYDotNorm2(), VecDotBegin(), VecNormBegin(), PetscCommSplitReductionBegin()
+@*/
+PetscErrorCode VecAXPYDotNorm2Begin(Vec y,PetscScalar alpha,Vec x,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+  PetscScalar    ldot;
+  PetscReal      lnm;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  if (dot) PetscValidHeaderSpecific(z,VEC_CLASSID,4);
+  if (x == y) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  VecLocked(y,1);
+  if (y->ops->axpydotnorm2_local) {
+    ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = (*y->ops->axpydotnorm2_local)(y,alpha,x,z,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  } else {
+    ierr = VecAXPY(y,alpha,x);CHKERRQ(ierr);
+    ierr = VecFusedLocal_Private(y,z,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+  }
+  ierr = VecFusedBegin_Private(y,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPYDotNorm2End - Ends a split phase VecAXPYDotNorm2().
+
+   Input Parameters:
++   y - the vector updated
+.   alpha - the scalar
+.   x - the vector added to y
+-   z - the vector of the inner product
+
+   Output Parameters:
++   dot - the inner product (y,z), or NULL
+-   nm - the square of the 2-norm of y, or NULL
+
+   Level: advanced
+
+   Notes:
+   Each call to VecAXPYDotNorm2Begin() should be paired with a call to VecAXPYDotNorm2End().
+
+.seealso: VecAXPYDotNorm2Begin(), VecAXPYDotNorm2(), VecDotEnd(), VecNormEnd()
+@*/
+PetscErrorCode VecAXPYDotNorm2End(Vec y,PetscScalar alpha,Vec x,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  ierr = VecFusedEnd_Private(y,dot,nm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPBYPCZDotNorm2Begin - Starts a split phase VecAXPBYPCZDotNorm2(): computes z = alpha x + beta y + gamma z
+   and starts the inner product of the new z with u and its squared 2-norm.
+
+   Input Parameters:
++   z - the vector updated
+.   alpha,beta,gamma - the scalars
+.   x, y - the vectors combined into z, they must be different from each other and from z
+.   u - the vector of the inner product, which may be z; ignored if dot is NULL
+.   dot - where the inner product will go, or NULL if it is not wanted
+-   nm - where the square of the 2-norm will go, or NULL if it is not wanted
+
+   Level: advanced
+
+   Notes:
+   Each call to VecAXPBYPCZDotNorm2Begin() should be paired with a call to VecAXPBYPCZDotNorm2End() with the same
+   dot and nm pointers being NULL or not. The update of z is complete on return.
+
+.seealso: VecAXPBYPCZDotNorm2End(), VecAXPBYPCZDotNorm2(), VecDotBegin(), VecNormBegin(), PetscCommSplitReductionBegin()
+@*/
+PetscErrorCode VecAXPBYPCZDotNorm2Begin(Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec x,Vec y,Vec u,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+  PetscScalar    ldot;
+  PetscReal      lnm;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(z,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,5);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,6);
+  if (dot) PetscValidHeaderSpecific(u,VEC_CLASSID,7);
+  if (x == y || x == z || y == z) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x, y, and z must be different vectors");
+  if (z->ops->axpbypczdotnorm2_local) {
+    ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = (*z->ops->axpbypczdotnorm2_local)(z,alpha,beta,gamma,x,y,u,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject)z);CHKERRQ(ierr);
+  } else {
+    ierr = VecAXPBYPCZ(z,alpha,beta,gamma,x,y);CHKERRQ(ierr);
+    ierr = VecFusedLocal_Private(z,u,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+  }
+  ierr = VecFusedBegin_Private(z,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecAXPBYPCZDotNorm2End - Ends a split phase VecAXPBYPCZDotNorm2().
+
+   Input Parameters:
++   z - the vector updated
+.   alpha,beta,gamma - the scalars
+.   x, y - the vectors combined into z
+-   u - the vector of the inner product
+
+   Output Parameters:
++   dot - the inner product (z,u), or NULL
+-   nm - the square of the 2-norm of z, or NULL
+
+   Level: advanced
+
+.seealso: VecAXPBYPCZDotNorm2Begin(), VecAXPBYPCZDotNorm2(), VecDotEnd(), VecNormEnd()
+@*/
+PetscErrorCode VecAXPBYPCZDotNorm2End(Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec x,Vec y,Vec u,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(z,VEC_CLASSID,1);
+  ierr = VecFusedEnd_Private(z,dot,nm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecWAXPYDotNorm2Begin - Starts a split phase VecWAXPYDotNorm2(): computes w = alpha x + y and starts the inner
+   product of w with z and its squared 2-norm.
+
+   Input Parameters:
++   w - the result vector
+.   alpha - the scalar
+.   x, y - the vectors, they must be different from w
+.   z - the vector of the inner product, which may be w; ignored if dot is NULL
+.   dot - where the inner product will go, or NULL if it is not wanted
+-   nm - where the square of the 2-norm will go, or NULL if it is not wanted
+
+   Level: advanced
+
+   Notes:
+   Each call to VecWAXPYDotNorm2Begin() should be paired with a call to VecWAXPYDotNorm2End() with the same dot
+   and nm pointers being NULL or not. The result w is complete on return.
+
+.seealso: VecWAXPYDotNorm2End(), VecWAXPYDotNorm2(), VecDotBegin(), VecNormBegin(), PetscCommSplitReductionBegin()
+@*/
+PetscErrorCode VecWAXPYDotNorm2Begin(Vec w,PetscScalar alpha,Vec x,Vec y,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+  PetscScalar    ldot;
+  PetscReal      lnm;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(w,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,4);
+  if (dot) PetscValidHeaderSpecific(z,VEC_CLASSID,5);
+  if (w == x || w == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Result vector w cannot be same as input vector x or y");
+  if (w->ops->waxpydotnorm2_local) {
+    ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = (*w->ops->waxpydotnorm2_local)(w,alpha,x,y,z,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscObjectStateIncrease((PetscObject)w);CHKERRQ(ierr);
+  } else {
+    ierr = VecWAXPY(w,alpha,x,y);CHKERRQ(ierr);
+    ierr = VecFusedLocal_Private(w,z,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+  }
+  ierr = VecFusedBegin_Private(w,dot ? &ldot : NULL,nm ? &lnm : NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecWAXPYDotNorm2End - Ends a split phase VecWAXPYDotNorm2().
+
+   Input Parameters:
++   w - the result vector
+.   alpha - the scalar
+.   x, y - the vectors
+-   z - the vector of the inner product
+
+   Output Parameters:
++   dot - the inner product (w,z), or NULL
+-   nm - the square of the 2-norm of w, or NULL
+
+   Level: advanced
+
+.seealso: VecWAXPYDotNorm2Begin(), VecWAXPYDotNorm2(), VecDotEnd(), VecNormEnd()
+@*/
+PetscErrorCode VecWAXPYDotNorm2End(Vec w,PetscScalar alpha,Vec x,Vec y,Vec z,PetscScalar *dot,PetscReal *nm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(w,VEC_CLASSID,1);
+  ierr = VecFusedEnd_Private(w,dot,nm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
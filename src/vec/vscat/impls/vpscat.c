@@ -218,7 +218,7 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI3(VecScatter ctx)
      message passing.
   */
 #if !defined(PETSC_HAVE_BROKEN_REQUEST_FREE)
-  if (!to->use_alltoallv && !to->use_window) {   /* currently the to->requests etc are ALWAYS allocated even if not used */
+  if (!to->use_alltoallv && !to->use_window && !to->use_datatypes) {   /* currently the to->requests etc are ALWAYS allocated even if not used */
     if (to->requests) {
       for (i=0; i<to->n; i++) {
         ierr = MPI_Request_free(to->requests + i);CHKERRQ(ierr);
@@ -235,7 +235,7 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI3(VecScatter ctx)
     cannot free the requests. It may be fixed now, if not then put the following
     code inside a if (!to->use_readyreceiver) {
   */
-  if (!to->use_alltoallv && !to->use_window) {    /* currently the from->requests etc are ALWAYS allocated even if not used */
+  if (!to->use_alltoallv && !to->use_window && !to->use_datatypes) {    /* currently the from->requests etc are ALWAYS allocated even if not used */
     if (from->requests) {
       for (i=0; i<from->n; i++) {
         ierr = MPI_Request_free(from->requests + i);CHKERRQ(ierr);
@@ -249,6 +249,10 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI3(VecScatter ctx)
     }
   }
 #endif
+  if (to->use_datatypes) {
+    ierr = VecScatterDestroyTypes_PtoP_Private(to);CHKERRQ(ierr);
+    ierr = VecScatterDestroyTypes_PtoP_Private(from);CHKERRQ(ierr);
+  }
   if (to->sharedwin != MPI_WIN_NULL) {ierr = MPI_Win_free(&to->sharedwin);CHKERRQ(ierr);}
   if (from->sharedwin != MPI_WIN_NULL) {ierr = MPI_Win_free(&from->sharedwin);CHKERRQ(ierr);}
   ierr = PetscFree(to->sharedspaces);CHKERRQ(ierr);
@@ -405,6 +409,15 @@ PetscErrorCode VecScatterCopy_PtoP_X(VecScatter in,VecScatter out)
     tag          = ((PetscObject)out)->tag;
     ierr         = PetscObjectGetComm((PetscObject)out,&comm);CHKERRQ(ierr);
 
+    if (in_to->use_datatypes) {
+      out_to->use_datatypes     = out_from->use_datatypes     = PETSC_TRUE;
+      out_to->use_readyreceiver = out_from->use_readyreceiver = PETSC_FALSE;
+      out_to->tag               = out_from->tag               = tag;
+      ierr = VecScatterCreateTypes_PtoP_Private(out_to);CHKERRQ(ierr);
+      ierr = VecScatterCreateTypes_PtoP_Private(out_from);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+
     /* Register the receives that you will use later (sends for scatter reverse) */
     for (i=0; i<out_from->n; i++) {
       ierr = MPI_Recv_init(Srvalues+bs*rstarts[i],bs*rstarts[i+1]-bs*rstarts[i],MPIU_SCALAR,rprocs[i],tag,comm,rwaits+i);CHKERRQ(ierr);
@@ -2661,6 +2674,12 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI3(VecScatter_MPI_General *from,Vec
   ierr = PetscOptionsGetBool(NULL,NULL,"-vecscatter_window",&to->use_window,NULL);CHKERRQ(ierr);
   from->use_window = to->use_window;
 
+  to->use_datatypes = PETSC_FALSE;
+  if (!to->use_alltoallv && !to->use_window) {
+    ierr = PetscOptionsGetBool(NULL,NULL,"-vecscatter_nopack",&to->use_datatypes,NULL);CHKERRQ(ierr);
+  }
+  from->use_datatypes = to->use_datatypes;
+
   if (to->use_alltoallv) {
     ierr       = PetscMalloc2(size,&to->counts,size,&to->displs);CHKERRQ(ierr);
     ierr       = PetscMemzero(to->counts,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
@@ -2753,6 +2772,18 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI3(VecScatter_MPI_General *from,Vec
     }
     ierr = MPI_Waitall(from->n,request,status);CHKERRQ(ierr);
     ierr = PetscFree2(request,status);CHKERRQ(ierr);
+  } else if (to->use_datatypes) {
+    ierr = PetscInfo(ctx,"Using MPI datatypes to send from and receive into the vector arrays\n");CHKERRQ(ierr);
+    ierr = PetscMalloc1(to->n,&to->rev_requests);CHKERRQ(ierr);
+    ierr = PetscMalloc1(from->n,&from->rev_requests);CHKERRQ(ierr);
+    ctx->packtogether       = PETSC_FALSE;
+    to->use_readyreceiver   = PETSC_FALSE;
+    from->use_readyreceiver = PETSC_FALSE;
+    to->tag                 = tag;
+    from->tag               = tagr;
+    ierr = VecScatterCreateTypes_PtoP_Private(to);CHKERRQ(ierr);
+    ierr = VecScatterCreateTypes_PtoP_Private(from);CHKERRQ(ierr);
+    ctx->ops->copy = VecScatterCopy_PtoP_X;
   } else {
     PetscBool   use_rsend = PETSC_FALSE, use_ssend = PETSC_FALSE;
     PetscInt    *sstarts  = to->starts,  *rstarts = from->starts;
@@ -137,7 +137,7 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
      message passing.
   */
 #if !defined(PETSC_HAVE_BROKEN_REQUEST_FREE)
-  if (!to->use_alltoallv && !to->use_window) {   /* currently the to->requests etc are ALWAYS allocated even if not used */
+  if (!to->use_alltoallv && !to->use_window && !to->use_datatypes) {   /* currently the to->requests etc are ALWAYS allocated even if not used */
     if (to->requests) {
       for (i=0; i<to->n; i++) {
         ierr = MPI_Request_free(to->requests + i);CHKERRQ(ierr);
@@ -154,7 +154,7 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
     cannot free the requests. It may be fixed now, if not then put the following
     code inside a if (!to->use_readyreceiver) {
   */
-  if (!to->use_alltoallv && !to->use_window) {    /* currently the from->requests etc are ALWAYS allocated even if not used */
+  if (!to->use_alltoallv && !to->use_window && !to->use_datatypes) {    /* currently the from->requests etc are ALWAYS allocated even if not used */
     if (from->requests) {
       for (i=0; i<from->n; i++) {
         ierr = MPI_Request_free(from->requests + i);CHKERRQ(ierr);
@@ -169,6 +169,11 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
   }
 #endif
 
+  if (to->use_datatypes) {
+    ierr = VecScatterDestroyTypes_PtoP_Private(to);CHKERRQ(ierr);
+    ierr = VecScatterDestroyTypes_PtoP_Private(from);CHKERRQ(ierr);
+  }
+
   ierr = PetscFree(to->local.vslots);CHKERRQ(ierr);
   ierr = PetscFree(from->local.vslots);CHKERRQ(ierr);
   ierr = PetscFree2(to->counts,to->displs);CHKERRQ(ierr);
@@ -221,6 +226,64 @@ PetscErrorCode VecScatterLocalOptimizeCopy_Private_MPI1(VecScatter scatter,VecSc
   PetscFunctionReturn(0);
 }
 
+/* --------------------------------------------------------------------------------------*/
+/*
+    Builds for each message of one side of the scatter an MPI datatype selecting the entries of the local vector
+    array that are sent (or received) so that the message can go directly from (or into) the array without packing.
+    Runs of consecutive blocks are merged into a single block of the datatype.
+*/
+PetscErrorCode VecScatterCreateTypes_PtoP_Private(VecScatter_MPI_General *gen)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,k,len,nruns,maxlen = 0,bs = gen->bs,n = gen->starts[gen->n];
+  PetscInt       *sorted;
+  PetscMPIInt    *blens,*displs,mpinruns;
+
+  PetscFunctionBegin;
+  for (i=0; i<gen->n; i++) maxlen = PetscMax(maxlen,gen->starts[i+1]-gen->starts[i]);
+  ierr = PetscMalloc1(gen->n,&gen->dtypes);CHKERRQ(ierr);
+  ierr = PetscMalloc3(maxlen,&blens,maxlen,&displs,n,&sorted);CHKERRQ(ierr);
+  for (i=0; i<gen->n; i++) {
+    const PetscInt *idx = gen->indices + gen->starts[i];
+
+    len   = gen->starts[i+1] - gen->starts[i];
+    nruns = 0;
+    for (j=0; j<len; j=k) {
+      for (k=j+1; k<len && idx[k] == idx[k-1] + bs; k++) ;
+      ierr = PetscMPIIntCast(idx[j],displs+nruns);CHKERRQ(ierr);
+      ierr = PetscMPIIntCast(bs*(k-j),blens+nruns);CHKERRQ(ierr);
+      nruns++;
+    }
+    ierr = PetscMPIIntCast(nruns,&mpinruns);CHKERRQ(ierr);
+    ierr = MPI_Type_indexed(mpinruns,blens,displs,MPIU_SCALAR,gen->dtypes+i);CHKERRQ(ierr);
+    ierr = MPI_Type_commit(gen->dtypes+i);CHKERRQ(ierr);
+  }
+
+  /* an MPI receive buffer may not contain the same location twice */
+  ierr = PetscMemcpy(sorted,gen->indices,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscSortInt(n,sorted);CHKERRQ(ierr);
+  gen->dtypes_recv = PETSC_TRUE;
+  for (i=1; i<n; i++) {
+    if (sorted[i] < sorted[i-1] + bs) {gen->dtypes_recv = PETSC_FALSE; break;}
+  }
+  ierr = PetscFree3(blens,displs,sorted);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScatterDestroyTypes_PtoP_Private(VecScatter_MPI_General *gen)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (!gen->dtypes) PetscFunctionReturn(0);
+  for (i=0; i<gen->n; i++) {
+    ierr = MPI_Type_free(gen->dtypes+i);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(gen->dtypes);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* --------------------------------------------------------------------------------------*/
 
 PetscErrorCode VecScatterCopy_PtoP_X_MPI1(VecScatter in,VecScatter out)
@@ -310,6 +373,15 @@ PetscErrorCode VecScatterCopy_PtoP_X_MPI1(VecScatter in,VecScatter out)
     tag          = ((PetscObject)out)->tag;
     ierr         = PetscObjectGetComm((PetscObject)out,&comm);CHKERRQ(ierr);
 
+    if (in_to->use_datatypes) {
+      out_to->use_datatypes     = out_from->use_datatypes     = PETSC_TRUE;
+      out_to->use_readyreceiver = out_from->use_readyreceiver = PETSC_FALSE;
+      out_to->tag               = out_from->tag               = tag;
+      ierr = VecScatterCreateTypes_PtoP_Private(out_to);CHKERRQ(ierr);
+      ierr = VecScatterCreateTypes_PtoP_Private(out_from);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+
     /* Register the receives that you will use later (sends for scatter reverse) */
     for (i=0; i<out_from->n; i++) {
       ierr = MPI_Recv_init(Srvalues+bs*rstarts[i],bs*rstarts[i+1]-bs*rstarts[i],MPIU_SCALAR,rprocs[i],tag,comm,rwaits+i);CHKERRQ(ierr);
@@ -2346,6 +2418,12 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI1(VecScatter_MPI_General *from,Vec
   from->use_window = to->use_window;
 #endif
 
+  to->use_datatypes = PETSC_FALSE;
+  if (!to->use_alltoallv && !to->use_window) {
+    ierr = PetscOptionsGetBool(NULL,NULL,"-vecscatter_nopack",&to->use_datatypes,NULL);CHKERRQ(ierr);
+  }
+  from->use_datatypes = to->use_datatypes;
+
   if (to->use_alltoallv) {
 
     ierr       = PetscMalloc2(size,&to->counts,size,&to->displs);CHKERRQ(ierr);
@@ -2438,6 +2516,18 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI1(VecScatter_MPI_General *from,Vec
     ierr = MPI_Waitall(from->n,request,status);CHKERRQ(ierr);
     ierr = PetscFree2(request,status);CHKERRQ(ierr);
 #endif
+  } else if (to->use_datatypes) {
+    ierr = PetscInfo(ctx,"Using MPI datatypes to send from and receive into the vector arrays\n");CHKERRQ(ierr);
+    ierr = PetscMalloc1(to->n,&to->rev_requests);CHKERRQ(ierr);
+    ierr = PetscMalloc1(from->n,&from->rev_requests);CHKERRQ(ierr);
+    ctx->packtogether       = PETSC_FALSE;
+    to->use_readyreceiver   = PETSC_FALSE;
+    from->use_readyreceiver = PETSC_FALSE;
+    to->tag                 = tag;
+    from->tag               = tagr;
+    ierr = VecScatterCreateTypes_PtoP_Private(to);CHKERRQ(ierr);
+    ierr = VecScatterCreateTypes_PtoP_Private(from);CHKERRQ(ierr);
+    ctx->ops->copy = VecScatterCopy_PtoP_X_MPI1;
   } else {
     PetscBool   use_rsend = PETSC_FALSE, use_ssend = PETSC_FALSE;
     PetscInt    *sstarts  = to->starts,  *rstarts = from->starts;
@@ -66,11 +66,26 @@ PetscErrorCode PETSCMAP1(VecScatterBeginMPI1)(VecScatter ctx,Vec xin,Vec yin,Ins
   else yv = xv;
 
   if (!(mode & SCATTER_LOCAL)) {
-    if (!from->use_readyreceiver && !to->sendfirst && !to->use_alltoallv && !to->use_window) {
+    if (!from->use_readyreceiver && !to->sendfirst && !to->use_alltoallv && !to->use_window && !to->use_datatypes) {
       /* post receives since they were not previously posted    */
       if (nrecvs) {ierr = MPI_Startall_irecv(from->starts[nrecvs]*bs,nrecvs,rwaits);CHKERRQ(ierr);}
     }
 
+    if (to->use_datatypes) {
+      /* send directly from the vector array; receive directly into it unless the values must be combined with those in it */
+      MPI_Comm comm = PetscObjectComm((PetscObject)ctx);
+
+      for (i=0; i<nrecvs; i++) {
+        if (addv == INSERT_VALUES && from->dtypes_recv) {
+          ierr = MPI_Irecv(yv,1,from->dtypes[i],from->procs[i],to->tag,comm,rwaits+i);CHKERRQ(ierr);
+        } else {
+          ierr = MPI_Irecv(from->values+bs*from->starts[i],bs*(from->starts[i+1]-from->starts[i]),MPIU_SCALAR,from->procs[i],to->tag,comm,rwaits+i);CHKERRQ(ierr);
+        }
+      }
+      for (i=0; i<nsends; i++) {
+        ierr = MPI_Isend(xv,1,to->dtypes[i],to->procs[i],to->tag,comm,swaits+i);CHKERRQ(ierr);
+      }
+    } else
 #if defined(PETSC_HAVE_MPI_ALLTOALLW)  && !defined(PETSC_USE_64BIT_INDICES)
     if (to->use_alltoallw && addv == INSERT_VALUES) {
       ierr = MPI_Alltoallw(xv,to->wcounts,to->wdispls,to->types,yv,from->wcounts,from->wdispls,from->types,PetscObjectComm((PetscObject)ctx));CHKERRQ(ierr);
@@ -102,7 +117,7 @@ PetscErrorCode PETSCMAP1(VecScatterBeginMPI1)(VecScatter ctx,Vec xin,Vec yin,Ins
       }
     }
 
-    if (!from->use_readyreceiver && to->sendfirst && !to->use_alltoallv && !to->use_window) {
+    if (!from->use_readyreceiver && to->sendfirst && !to->use_alltoallv && !to->use_window && !to->use_datatypes) {
       /* post receives since they were not previously posted   */
       if (nrecvs) {ierr = MPI_Startall_irecv(from->starts[nrecvs]*bs,nrecvs,rwaits);CHKERRQ(ierr);}
     }
@@ -173,6 +188,11 @@ PetscErrorCode PETSCMAP1(VecScatterEndMPI1)(VecScatter ctx,Vec xin,Vec yin,Inser
   } else if (!to->use_alltoallw) {
     /* unpack one at a time */
     count = nrecvs;
+    if (to->use_datatypes && addv == INSERT_VALUES && from->dtypes_recv) {
+      /* the messages were received directly into the vector array */
+      if (nrecvs) {ierr = MPI_Waitall(nrecvs,rwaits,rstatus);CHKERRQ(ierr);}
+      count = 0;
+    }
     while (count) {
       if (ctx->reproduce) {
         imdex = count - 1;
@@ -229,7 +229,8 @@ PetscErrorCode VecScatterRegister(const char sname[], PetscErrorCode (*function)
 .  -vecscatter_packtogether - Pack all messages before sending, receive all messages before unpacking
 .  -vecscatter_alltoall     - Uses MPI all to all communication for scatter
 .  -vecscatter_window       - Use MPI 2 window operations to move data
-.  -vecscatter_nopack       - Avoid packing to work vector when possible (if used with -vecscatter_alltoall then will use MPI_Alltoallw()
+.  -vecscatter_nopack       - Avoid packing to work vector when possible: messages are sent from (and inserted values received into) the vector
+                              arrays using MPI datatypes built once when the scatter is created (if used with -vecscatter_alltoall then will use MPI_Alltoallw()
 -  -vecscatter_reproduce    - insure that the order of the communications are done the same for each scatter, this under certain circumstances
                               will make the results of scatters deterministic when otherwise they are not (it may be slower also).
 
@@ -238,7 +239,7 @@ $
 $                               MPI Datatypes (no packing)  sendfirst   merge        packtogether  persistent*
 $                                _nopack                   _sendfirst    _merge      _packtogether                -vecscatter_
 $ ----------------------------------------------------------------------------------------------------------------------------
-$    Message passing    Send       p                           X            X           X         always
+$    Message passing    Send       X                           X            X           X         always
 $                      Ssend       p                           X            X           X         always          _ssend
 $                      Rsend       p                        nonsense        X           X         always          _rsend
 $    AlltoAll  v or w              X                        nonsense     always         X         nonsense        _alltoall
@@ -249,6 +250,8 @@ $   because the in and out array may be different for each call to VecScatterBeg
 $
 $    p indicates possible, but not implemented. X indicates implemented
 $
+   With -vecscatter_nopack the messages are sent directly from the array of xin so xin must not be changed between
+   VecScatterBegin() and VecScatterEnd(); values that are added (or received into repeated locations) still go through the work vector.
 
     Level: intermediate
 